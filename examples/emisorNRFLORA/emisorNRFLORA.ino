@@ -65,5 +65,11 @@ void loop() {
   Serial.print(mensaje);
   Serial.println("'");
   
-  radio->enviar(mensaje + "\n"); // Añadimos '\n' como delimitador
+  // Enviamos el mensaje y el delimitador '\n' como dos segmentos de un
+  // mismo paquete, sin concatenarlos en un nuevo String.
+  Segmento partes[2] = {
+    { reinterpret_cast<const uint8_t*>(mensaje.c_str()), mensaje.length() },
+    { reinterpret_cast<const uint8_t*>("\n"), 1 }
+  };
+  radio->enviar(partes, 2);
 }
\ No newline at end of file
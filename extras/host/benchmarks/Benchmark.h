@@ -0,0 +1,142 @@
+/**
+ * @file Benchmark.h
+ * @brief Utilidades comunes de los benchmarks de `extras/host/benchmarks`.
+ * @details Cada benchmark añade filas (nombre + columnas numéricas) a un `Informe`, que se
+ * imprime como tabla, CSV (`--csv`) o JSON (`--json`). `--rapido` reduce las iteraciones
+ * (lo usa `ctest` para comprobar que siguen funcionando). Hay dos relojes: el virtual del
+ * host (`host::ahoraMicros()`, tiempo en el aire y esperas de la radio) y el de pared
+ * (`relojNs()`, coste de CPU del código en el host); `ciclos()` da ese coste en ciclos.
+ */
+
+#ifndef HOST_BENCHMARK_H
+#define HOST_BENCHMARK_H
+
+#include <Arduino.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace benchmark {
+
+enum Formato { TABLA, CSV, JSON };
+
+struct Opciones {
+  Formato formato;
+  bool rapido;
+};
+
+inline Opciones leerOpciones(int argc, char** argv) {
+  Opciones opciones = {TABLA, false};
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--csv") == 0) opciones.formato = CSV;
+    else if (strcmp(argv[i], "--json") == 0) opciones.formato = JSON;
+    else if (strcmp(argv[i], "--rapido") == 0) opciones.rapido = true;
+  }
+  return opciones;
+}
+
+/**
+ * @brief Reloj de pared monotónico en nanosegundos.
+ */
+inline uint64_t relojNs() {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * @brief Contador de ciclos del procesador (TSC en x86-64, a frecuencia nominal constante).
+ * @details En otras arquitecturas devuelve `relojNs()`: los "ciclos" son entonces nanosegundos.
+ */
+inline uint64_t ciclos() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return relojNs();
+#endif
+}
+
+typedef std::vector<std::pair<std::string, double> > Columnas;
+
+/**
+ * @brief Tabla de resultados con columnas numéricas.
+ */
+class Informe {
+public:
+  explicit Informe(const char* titulo) : _titulo(titulo) {}
+
+  void agregar(const std::string& nombre, const Columnas& columnas) {
+    _filas.push_back(std::make_pair(nombre, columnas));
+  }
+
+  void imprimir(Formato formato) const {
+    if (formato == CSV) _imprimirCsv();
+    else if (formato == JSON) _imprimirJson();
+    else _imprimirTabla();
+  }
+
+private:
+  std::string _titulo;
+  std::vector<std::pair<std::string, Columnas> > _filas;
+
+  static void _imprimirNumero(double valor) {
+    if (valor == static_cast<double>(static_cast<long long>(valor))) printf("%lld", static_cast<long long>(valor));
+    else printf("%.3f", valor);
+  }
+
+  void _imprimirTabla() const {
+    printf("== %s ==\n", _titulo.c_str());
+    if (_filas.empty()) return;
+    printf("%-28s", "caso");
+    for (size_t c = 0; c < _filas[0].second.size(); ++c) printf(" %16s", _filas[0].second[c].first.c_str());
+    printf("\n");
+    for (size_t f = 0; f < _filas.size(); ++f) {
+      printf("%-28s", _filas[f].first.c_str());
+      for (size_t c = 0; c < _filas[f].second.size(); ++c) {
+        double valor = _filas[f].second[c].second;
+        if (valor == static_cast<double>(static_cast<long long>(valor))) printf(" %16lld", static_cast<long long>(valor));
+        else printf(" %16.3f", valor);
+      }
+      printf("\n");
+    }
+  }
+
+  void _imprimirCsv() const {
+    if (_filas.empty()) return;
+    printf("benchmark,caso");
+    for (size_t c = 0; c < _filas[0].second.size(); ++c) printf(",%s", _filas[0].second[c].first.c_str());
+    printf("\n");
+    for (size_t f = 0; f < _filas.size(); ++f) {
+      printf("%s,%s", _titulo.c_str(), _filas[f].first.c_str());
+      for (size_t c = 0; c < _filas[f].second.size(); ++c) {
+        printf(",");
+        _imprimirNumero(_filas[f].second[c].second);
+      }
+      printf("\n");
+    }
+  }
+
+  void _imprimirJson() const {
+    printf("{\"benchmark\":\"%s\",\"casos\":[", _titulo.c_str());
+    for (size_t f = 0; f < _filas.size(); ++f) {
+      printf("%s{\"caso\":\"%s\"", f ? "," : "", _filas[f].first.c_str());
+      for (size_t c = 0; c < _filas[f].second.size(); ++c) {
+        printf(",\"%s\":", _filas[f].second[c].first.c_str());
+        _imprimirNumero(_filas[f].second[c].second);
+      }
+      printf("}");
+    }
+    printf("]}\n");
+  }
+};
+
+} // namespace benchmark
+
+#endif // HOST_BENCHMARK_H
@@ -0,0 +1,135 @@
+/**
+ * @file bench_delta.cpp
+ * @brief Compresión y ciclos por muestra de `CodificadorDelta` con series de sensores típicas.
+ * @details Cada serie son lecturas en centésimas (punto fijo con escala 100) que se añaden de
+ * una en una a payloads de 64 bytes; al llenarse uno se empieza otro, como haría un nodo. Se
+ * comparan el formato varint y el empaquetado de 4, 6 y 8 bits con el texto de los ejemplos
+ * (`"21.37,"`, columna `compresion_texto`) y con enteros de 4 bytes (`compresion_binario`).
+ * Cada payload se decodifica y se compara con la serie original.
+ */
+
+#include <Arduino.h>
+#include <UniversalRadioWSN.h>
+
+#include <math.h>
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+
+namespace {
+
+const size_t TAM_PAYLOAD = 64;
+
+enum Serie { TEMPERATURA, HUMEDAD_CON_RUIDO, CONTADOR, RUIDO_16_BITS };
+
+const char* const NOMBRES_SERIE[] = {"temperatura", "humedad_ruido", "contador", "ruido_16b"};
+
+/**
+ * @brief Serie de `numMuestras` lecturas en centésimas.
+ */
+std::vector<int32_t> generar(Serie serie, size_t numMuestras) {
+  std::mt19937 azar(31 + serie);
+  std::normal_distribution<double> normal(0.0, 1.0);
+  std::vector<int32_t> muestras(numMuestras);
+  double valor = 2137.0;
+  for (size_t i = 0; i < numMuestras; ++i) {
+    switch (serie) {
+      case TEMPERATURA: // Paseo aleatorio de unas pocas centésimas por lectura
+        valor += 3.0 * normal(azar);
+        muestras[i] = (int32_t)lround(valor);
+        break;
+      case HUMEDAD_CON_RUIDO: // Ciclo lento con ruido del sensor
+        muestras[i] = (int32_t)lround(5500.0 + 1500.0 * sin(i / 500.0) + 30.0 * normal(azar));
+        break;
+      case CONTADOR: // Pulsos acumulados: solo crece
+        muestras[i] = (i ? muestras[i - 1] : 0) + (int32_t)(azar() % 4);
+        break;
+      case RUIDO_16_BITS: // Peor caso: sin relación entre muestras
+        muestras[i] = (int32_t)(azar() % 65536) - 32768;
+        break;
+    }
+  }
+  return muestras;
+}
+
+/// Bytes de la serie como texto con dos decimales separado por comas (como en los ejemplos).
+size_t bytesTexto(const std::vector<int32_t>& muestras) {
+  size_t total = 0;
+  char texto[24];
+  for (size_t i = 0; i < muestras.size(); ++i) {
+    int32_t v = muestras[i];
+    total += (size_t)snprintf(texto, sizeof(texto), "%s%ld.%02ld,", v < 0 ? "-" : "", labs(v) / 100, labs(v) % 100);
+  }
+  return total;
+}
+
+volatile uint32_t sumidero; ///< Evita que el compilador elimine los bucles medidos.
+
+void medir(benchmark::Informe& informe, Serie serie, uint8_t bits, size_t numMuestras) {
+  std::vector<int32_t> muestras = generar(serie, numMuestras);
+  std::vector<uint8_t> memoria(numMuestras * 5 + TAM_PAYLOAD); // Peor caso: 5 bytes por muestra
+  std::vector<size_t> longitudes;
+  longitudes.reserve(numMuestras);
+
+  uint8_t* payload = memoria.data();
+  size_t usados = 0;
+  uint64_t inicio = benchmark::ciclos();
+  CodificadorDelta codificador(payload, TAM_PAYLOAD, bits);
+  for (size_t i = 0; i < numMuestras; ++i) {
+    if (!codificador.agregar(muestras[i])) {
+      longitudes.push_back(codificador.longitud());
+      usados += codificador.longitud();
+      codificador = CodificadorDelta(memoria.data() + usados, TAM_PAYLOAD, bits);
+      codificador.agregar(muestras[i]);
+    }
+  }
+  longitudes.push_back(codificador.longitud());
+  usados += codificador.longitud();
+  uint64_t ciclosCodificar = benchmark::ciclos() - inicio;
+
+  size_t siguiente = 0;
+  size_t posicion = 0;
+  uint32_t errores = 0;
+  inicio = benchmark::ciclos();
+  for (size_t p = 0; p < longitudes.size(); ++p) {
+    DecodificadorDelta decodificador(memoria.data() + posicion, longitudes[p], bits);
+    int32_t valor;
+    while (decodificador.siguiente(valor)) errores += (siguiente >= numMuestras || valor != muestras[siguiente++]);
+    posicion += longitudes[p];
+  }
+  uint64_t ciclosDecodificar = benchmark::ciclos() - inicio;
+  sumidero = errores;
+  if (errores != 0 || siguiente != numMuestras) {
+    fprintf(stderr, "%s bits=%u: %u muestras de %u, %u errores\n", NOMBRES_SERIE[serie], (unsigned)bits,
+            (unsigned)siguiente, (unsigned)numMuestras, (unsigned)errores);
+    exit(1);
+  }
+
+  char nombre[48];
+  if (bits == CodificadorDelta::BITS_VARINT) snprintf(nombre, sizeof(nombre), "%s_varint", NOMBRES_SERIE[serie]);
+  else snprintf(nombre, sizeof(nombre), "%s_%ubits", NOMBRES_SERIE[serie], (unsigned)bits);
+  benchmark::Columnas columnas;
+  columnas.push_back(std::make_pair("bytes_muestra", (double)usados / numMuestras));
+  columnas.push_back(std::make_pair("muestras_paquete", (double)numMuestras / longitudes.size()));
+  columnas.push_back(std::make_pair("compresion_texto", (double)bytesTexto(muestras) / usados));
+  columnas.push_back(std::make_pair("compresion_binario", 4.0 * numMuestras / usados));
+  columnas.push_back(std::make_pair("ciclos_muestra_cod", (double)ciclosCodificar / numMuestras));
+  columnas.push_back(std::make_pair("ciclos_muestra_dec", (double)ciclosDecodificar / numMuestras));
+  informe.agregar(nombre, columnas);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  benchmark::Opciones opciones = benchmark::leerOpciones(argc, argv);
+  size_t numMuestras = opciones.rapido ? 2000 : 2000000;
+
+  benchmark::Informe informe("delta");
+  const uint8_t formatos[4] = {CodificadorDelta::BITS_VARINT, 4, 6, 8};
+  for (int s = TEMPERATURA; s <= RUIDO_16_BITS; ++s) {
+    for (int f = 0; f < 4; ++f) medir(informe, (Serie)s, formatos[f], numMuestras);
+  }
+  informe.imprimir(opciones.formato);
+  return 0;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file bench_despacho.cpp
+ * @brief Coste por llamada del despacho estático (`RadioBase`) frente al virtual (`RadioInterface`).
+ * @details Dos radios:
+ * - `memoria`: una radio mínima en RAM, cuyo trabajo por llamada es casi nulo, así que la
+ *   diferencia es el propio despacho (llamada indirecta por vtable frente a inlining).
+ * - `lora_anillo`: `LoraNucleo`/`LoraRadio` con recepción por interrupción, donde
+ *   `hayDatosDisponibles()` solo consulta el anillo en RAM.
+ *
+ * La ruta virtual llama a través de un `RadioInterface*` que el compilador no puede resolver
+ * (leído de una variable `volatile`), como ocurre con `radio = new LoraRadio(...)` en un sketch.
+ * `bytes_objeto` es el tamaño de cada objeto: el adaptador añade el puntero a la vtable.
+ * Un `ns_estatico` cercano a 0 indica que el compilador inlineó la llamada y simplificó el bucle.
+ */
+
+#include <Arduino.h>
+#include <UniversalRadioWSN.h>
+
+#include "Benchmark.h"
+
+namespace {
+
+/**
+ * @brief Radio en RAM: `enviar()` cuenta bytes y `leer()` entrega un paquete fijo.
+ */
+class RadioMemoria : public RadioBase<RadioMemoria> {
+public:
+  using RadioBase<RadioMemoria>::enviar;
+
+  RadioMemoria() : _bytesEnviados(0), _pendiente(8) {}
+
+  bool iniciar() { return true; }
+  bool enviar(const uint8_t* buffer, size_t longitud) {
+    _bytesEnviados += longitud + buffer[0];
+    return true;
+  }
+  int hayDatosDisponibles() { return _pendiente; }
+  size_t leer(uint8_t* buffer, size_t maxLongitud) {
+    size_t n = (size_t)_pendiente < maxLongitud ? (size_t)_pendiente : maxLongitud;
+    memset(buffer, 0x5A, n);
+    return n;
+  }
+
+private:
+  uint32_t _bytesEnviados;
+  int _pendiente;
+};
+
+class RadioMemoriaVirtual : public RadioAdaptador<RadioMemoria> {};
+
+LoRaConfig configuracionLora() {
+  LoRaConfig config;
+  config.frequency = 868E6;
+  config.spreadingFactor = 7;
+  config.signalBandwidth = 125E3;
+  config.codingRate = 5;
+  config.syncWord = 0x12;
+  config.txPower = 14;
+  config.csPin = 10;
+  config.resetPin = -1;
+  config.irqPin = 2;
+  return config;
+}
+
+volatile uint32_t sumidero; ///< Evita que el compilador elimine los bucles medidos.
+
+/**
+ * @brief Bucle de llamadas resuelto en compilación: el compilador puede inlinear cada una.
+ */
+template <class R>
+uint64_t medirEstatico(RadioBase<R>& radio, int operacion, uint32_t iteraciones) {
+  uint8_t buffer[16] = {1};
+  uint32_t acumulado = 0;
+  uint64_t inicio = benchmark::relojNs();
+  for (uint32_t i = 0; i < iteraciones; ++i) {
+    buffer[0] = (uint8_t)i;
+    if (operacion == 0) acumulado += radio.enviar(buffer, 8);
+    else if (operacion == 1) acumulado += radio.hayDatosDisponibles();
+    else acumulado += radio.leer(buffer, sizeof(buffer));
+  }
+  uint64_t ns = benchmark::relojNs() - inicio;
+  sumidero = acumulado;
+  return ns;
+}
+
+/**
+ * @brief El mismo bucle a través de `RadioInterface`: una llamada indirecta por iteración.
+ */
+uint64_t medirVirtual(RadioInterface* volatile& radioVolatil, int operacion, uint32_t iteraciones) {
+  RadioInterface* radio = radioVolatil;
+  uint8_t buffer[16] = {1};
+  uint32_t acumulado = 0;
+  uint64_t inicio = benchmark::relojNs();
+  for (uint32_t i = 0; i < iteraciones; ++i) {
+    buffer[0] = (uint8_t)i;
+    if (operacion == 0) acumulado += radio->enviar(buffer, 8);
+    else if (operacion == 1) acumulado += radio->hayDatosDisponibles();
+    else acumulado += radio->leer(buffer, sizeof(buffer));
+  }
+  uint64_t ns = benchmark::relojNs() - inicio;
+  sumidero = acumulado;
+  return ns;
+}
+
+const char* const OPERACIONES[] = {"enviar", "hayDatosDisponibles", "leer"};
+
+void agregar(benchmark::Informe& informe, const char* radio, int operacion, uint64_t nsEstatico,
+             uint64_t nsVirtual, uint32_t iteraciones, size_t bytesEstatico, size_t bytesVirtual) {
+  char nombre[64];
+  snprintf(nombre, sizeof(nombre), "%s_%s", radio, OPERACIONES[operacion]);
+  benchmark::Columnas columnas;
+  columnas.push_back(std::make_pair("ns_estatico", static_cast<double>(nsEstatico) / iteraciones));
+  columnas.push_back(std::make_pair("ns_virtual", static_cast<double>(nsVirtual) / iteraciones));
+  columnas.push_back(std::make_pair("ns_extra_virtual",
+                                    (static_cast<double>(nsVirtual) - static_cast<double>(nsEstatico)) / iteraciones));
+  columnas.push_back(std::make_pair("bytes_objeto_estatico", static_cast<double>(bytesEstatico)));
+  columnas.push_back(std::make_pair("bytes_objeto_virtual", static_cast<double>(bytesVirtual)));
+  informe.agregar(nombre, columnas);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  benchmark::Opciones opciones = benchmark::leerOpciones(argc, argv);
+  uint32_t iteraciones = opciones.rapido ? 10000 : 20000000;
+
+  benchmark::Informe informe("despacho");
+
+  RadioMemoria memoria;
+  RadioMemoriaVirtual memoriaVirtual;
+  RadioInterface* volatile punteroMemoria = &memoriaVirtual;
+  for (int op = 0; op < 3; ++op) {
+    uint64_t estatico = medirEstatico(memoria, op, iteraciones);
+    uint64_t virtualNs = medirVirtual(punteroMemoria, op, iteraciones);
+    agregar(informe, "memoria", op, estatico, virtualNs, iteraciones, sizeof(RadioMemoria),
+            sizeof(RadioMemoriaVirtual));
+  }
+
+  // LoRa con anillo: hayDatosDisponibles() no accede al módulo, solo a la RAM
+  host::reiniciar();
+  AnilloPaquetesEstatico<4, 64> anilloEstatico;
+  AnilloPaquetesEstatico<4, 64> anilloVirtual;
+  LoraNucleo loraEstatico(configuracionLora());
+  loraEstatico.habilitarRecepcionPorInterrupcion(anilloEstatico);
+  loraEstatico.iniciar();
+  uint64_t estatico = medirEstatico(loraEstatico, 1, iteraciones);
+  LoraRadio loraVirtual(configuracionLora());
+  loraVirtual.habilitarRecepcionPorInterrupcion(anilloVirtual);
+  loraVirtual.iniciar();
+  RadioInterface* volatile punteroLora = &loraVirtual;
+  uint64_t virtualNs = medirVirtual(punteroLora, 1, iteraciones);
+  agregar(informe, "lora_anillo", 1, estatico, virtualNs, iteraciones, sizeof(LoraNucleo), sizeof(LoraRadio));
+
+  informe.imprimir(opciones.formato);
+  return 0;
+}
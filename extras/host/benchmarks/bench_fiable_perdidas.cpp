@@ -0,0 +1,187 @@
+/**
+ * @file bench_fiable_perdidas.cpp
+ * @brief Goodput de `RadioFiable` sobre LoRa según la tasa de pérdidas y el tamaño de ventana.
+ * @details El emisor es un `LoraRadio` (recepción por interrupción, para oír los ACKs justo
+ * después de transmitir) y el receptor otro módulo del LoRa falso, que pierde cada paquete
+ * (datos y ACKs) con la probabilidad de `host::lora::fijarProbabilidadPerdida()`. El tiempo
+ * es el del reloj virtual: tiempo en el aire de datos y ACKs más las esperas del RTO. Con
+ * ventana 1 (parada y espera) cada pérdida detiene el enlace un RTO; con ventana 8 el
+ * emisor sigue enviando mensajes nuevos mientras espera y solo repite los que faltan.
+ */
+
+#include <Arduino.h>
+#include <LoRa.h>
+#include <UniversalRadioWSN.h>
+
+#include <deque>
+#include <vector>
+
+#include "Benchmark.h"
+
+namespace {
+
+const size_t TAM_MENSAJE = 32;
+
+LoRaConfig configuracion() {
+  LoRaConfig config;
+  config.frequency = 868E6;
+  config.spreadingFactor = 7;
+  config.signalBandwidth = 125E3;
+  config.codingRate = 5;
+  config.syncWord = 0x12;
+  config.txPower = 14;
+  config.csPin = 10;
+  config.resetPin = -1;
+  config.irqPin = 2;
+  return config;
+}
+
+/**
+ * @brief `RadioInterface` mínima sobre un segundo módulo del LoRa falso (el `LoraRadio` usa el global).
+ * @details El módulo se sondea cada milisegundo virtual y cada paquete pasa a una cola, como
+ * haría un receptor que atiende su radio mientras el otro nodo transmite seguido (los
+ * paquetes duran decenas de ms, así que no se pierde ninguno por sondear tarde).
+ */
+class RadioLoRaPar : public RadioInterface {
+public:
+  RadioLoRaPar() : _transmitiendo(false) {}
+
+  bool iniciar() override {
+    _modulo.setSyncWord(0x12);
+    if (!_modulo.begin(868E6)) return false;
+    _modulo.receive();
+    _programarSondeo();
+    return true;
+  }
+  bool enviar(const uint8_t* buffer, size_t longitud) override {
+    _sondear(); // El paquete recibido está en la FIFO que la transmisión va a sobrescribir
+    if (!_modulo.beginPacket()) return false;
+    _transmitiendo = true; // parsePacket() sacaría al módulo de TX
+    _modulo.write(buffer, longitud);
+    bool enviado = _modulo.endPacket() == 1;
+    _transmitiendo = false;
+    _modulo.receive();
+    return enviado;
+  }
+  int hayDatosDisponibles() override { return _cola.empty() ? 0 : (int)_cola.front().size(); }
+  size_t leer(uint8_t* buffer, size_t maxLongitud) override {
+    if (_cola.empty()) return 0;
+    size_t longitud = _cola.front().size() < maxLongitud ? _cola.front().size() : maxLongitud;
+    memcpy(buffer, _cola.front().data(), longitud);
+    _cola.pop_front();
+    return longitud;
+  }
+
+private:
+  LoRaClass _modulo;
+  std::deque<std::vector<uint8_t> > _cola;
+  bool _transmitiendo;
+
+  void _programarSondeo() {
+    host::programar(host::ahoraMicros() + 1000, [this]() {
+      _sondear();
+      _programarSondeo();
+    });
+  }
+
+  void _sondear() {
+    if (_transmitiendo) return;
+    int longitud = _modulo.parsePacket();
+    if (longitud > 0) {
+      std::vector<uint8_t> paquete((size_t)longitud);
+      for (int i = 0; i < longitud; ++i) paquete[(size_t)i] = (uint8_t)_modulo.read();
+      _cola.push_back(paquete);
+    }
+    _modulo.receive(); // parsePacket() deja el módulo en RX_SINGLE o en standby
+  }
+};
+
+void medir(benchmark::Informe& informe, uint8_t ventana, double perdida, uint32_t numMensajes) {
+  host::reiniciar();
+  host::desconectarSpi();
+  LoRa.reiniciarModulo();
+  host::lora::fijarProbabilidadPerdida(perdida, 14);
+
+  AnilloPaquetesEstatico<8, 64> anillo;
+  LoraRadio lora(configuracion());
+  lora.habilitarRecepcionPorInterrupcion(anillo);
+  RadioLoRaPar par;
+  RadioFiableEstatica<8, TAM_MENSAJE> emisor(lora);
+  RadioFiableEstatica<8, TAM_MENSAJE> receptor(par);
+  emisor.fijarVentana(ventana);
+  emisor.fijarRTOInicial(500);
+  if (!emisor.iniciar() || !receptor.iniciar()) {
+    fprintf(stderr, "no se pudo iniciar la radio\n");
+    exit(1);
+  }
+
+  uint8_t mensaje[TAM_MENSAJE];
+  memset(mensaje, 0x5A, sizeof(mensaje));
+  uint32_t enviados = 0;
+  uint32_t recibidos = 0;
+  int32_t ultimo = -1;
+  uint64_t inicioUs = host::ahoraMicros();
+  uint64_t limiteUs = inicioUs + numMensajes * 60ULL * 1000000ULL; // Holgado incluso con un 40% de pérdidas
+  while (host::ahoraMicros() < limiteUs) {
+    bool actividad = false;
+    if (enviados < numMensajes) {
+      mensaje[0] = (uint8_t)enviados;
+      mensaje[1] = (uint8_t)(enviados >> 8);
+      if (emisor.enviar(mensaje, sizeof(mensaje))) {
+        enviados++;
+        actividad = true;
+      }
+    } else {
+      emisor.procesar();
+      if (emisor.pendientesConfirmacion() == 0) break;
+    }
+    uint8_t buffer[TAM_MENSAJE];
+    while (receptor.hayDatosDisponibles() > 0) {
+      receptor.leer(buffer, sizeof(buffer));
+      int32_t indice = (int32_t)(buffer[0] | (buffer[1] << 8));
+      if (indice <= ultimo) {
+        fprintf(stderr, "ventana %u, pérdida %.2f: mensaje %d después de %d\n", (unsigned)ventana, perdida,
+                (int)indice, (int)ultimo);
+        exit(1);
+      }
+      ultimo = indice;
+      recibidos++;
+      actividad = true;
+    }
+    if (!actividad) delay(1);
+  }
+  double segundos = (double)(host::ahoraMicros() - inicioUs) / 1e6;
+  if (enviados != numMensajes || (perdida == 0.0 && recibidos != numMensajes)) {
+    fprintf(stderr, "ventana %u, pérdida %.2f: enviados %u, recibidos %u de %u\n", (unsigned)ventana, perdida,
+            (unsigned)enviados, (unsigned)recibidos, (unsigned)numMensajes);
+    exit(1);
+  }
+
+  const EstadisticasFiabilidad& estadisticas = emisor.estadisticas();
+  char nombre[32];
+  snprintf(nombre, sizeof(nombre), "v%u_p%02d", (unsigned)ventana, (int)(perdida * 100.0 + 0.5));
+  benchmark::Columnas columnas;
+  columnas.push_back(std::make_pair("perdida_pct", perdida * 100.0));
+  columnas.push_back(std::make_pair("goodput_bps", recibidos * 8.0 * TAM_MENSAJE / segundos));
+  columnas.push_back(std::make_pair("entregados_pct", 100.0 * recibidos / numMensajes));
+  columnas.push_back(std::make_pair("tx_mensaje", (double)(enviados + estadisticas.retransmisiones) / numMensajes));
+  columnas.push_back(std::make_pair("rtt_ms", (double)emisor.rttMs()));
+  columnas.push_back(std::make_pair("rto_ms", (double)emisor.rtoMs()));
+  informe.agregar(nombre, columnas);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  benchmark::Opciones opciones = benchmark::leerOpciones(argc, argv);
+  uint32_t numMensajes = opciones.rapido ? 40 : 2000;
+
+  benchmark::Informe informe("fiable_perdidas");
+  const uint8_t ventanas[2] = {1, 8};
+  const double perdidas[6] = {0.0, 0.05, 0.1, 0.2, 0.3, 0.4};
+  for (int v = 0; v < 2; ++v) {
+    for (int p = 0; p < 6; ++p) medir(informe, ventanas[v], perdidas[p], numMensajes);
+  }
+  informe.imprimir(opciones.formato);
+  return 0;
+}
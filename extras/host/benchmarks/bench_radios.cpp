@@ -0,0 +1,273 @@
+/**
+ * @file bench_radios.cpp
+ * @brief Coste de la capa de adaptación: `enviar()` y `leer()` de `LoraRadio`, `NrfRadio` y `XBeeRadio`.
+ * @details Cada radio trabaja contra su driver falso instrumentado (LoRa, RF24 y un UART en
+ * memoria) con varios tamaños de payload. Por operación se mide:
+ * - `llamadas_driver`: llamadas a la API del driver (`LoRa.read()`, `RF24::available()`,
+ *   `Stream::read()`...). En LoRa y RF24 cada una es al menos una transacción SPI.
+ * - `bytes_copiados`: bytes que cruzan la API del driver (escritos en la FIFO o el UART, o
+ *   leídos de ellos).
+ * - `lecturas_reloj`: llamadas a `millis()`/`micros()`.
+ * - `ns_op`: tiempo de CPU del host, incluido el del driver falso.
+ *
+ * `leer` es la secuencia habitual `hayDatosDisponibles()` + `leer()`. Las filas `leer_anterior`
+ * repiten, directamente sobre el driver, el bucle de lectura que usaban `LoraRadio` (un
+ * `available()` antes de cada byte) y `XBeeRadio` (`readBytes()`, que consulta el reloj dos
+ * veces por byte) antes de leer el tamaño una sola vez, como referencia.
+ */
+
+#include <Arduino.h>
+#include <LoRa.h>
+#include <RF24.h>
+#include <UniversalRadioWSN.h>
+
+#include "Benchmark.h"
+#include "PuertoSerieFalso.h"
+
+namespace {
+
+const size_t TAMANOS[] = {8, 32, 64, 112, 255};
+const size_t NUM_TAMANOS = sizeof(TAMANOS) / sizeof(TAMANOS[0]);
+
+/**
+ * @brief Contadores acumulados de una operación.
+ */
+struct Medida {
+  uint64_t llamadas;
+  uint64_t bytes;
+  uint64_t reloj;
+  uint64_t ns;
+  uint32_t operaciones;
+};
+
+/**
+ * @brief Contadores del driver en un instante; `medir()` acumula la diferencia.
+ */
+struct Contadores {
+  uint64_t llamadas;
+  uint64_t bytes;
+  uint64_t reloj;
+};
+
+Contadores contadoresLoRa() {
+  const LlamadasLoRa& l = LoRa.llamadas();
+  Contadores c = {(uint64_t)l.parsePacket + l.available + l.read + l.write + l.beginPacket + l.endPacket, l.bytes,
+                  host::lecturasReloj()};
+  return c;
+}
+
+Contadores contadoresRF24() {
+  const LlamadasRF24& l = RF24::llamadasTotales();
+  Contadores c = {(uint64_t)l.write + l.writeFast + l.txStandBy + l.available + l.getDynamicPayloadSize + l.read +
+                      l.startListening + l.stopListening + l.powerUp,
+                  l.bytes, host::lecturasReloj()};
+  return c;
+}
+
+Contadores contadoresPuerto(const PuertoSerieFalso& puerto) {
+  Contadores c = {(uint64_t)puerto.consultas() + puerto.lecturas() + puerto.escrituras(), puerto.bytes(),
+                  host::lecturasReloj()};
+  return c;
+}
+
+/**
+ * @brief Ejecuta `operacion` y acumula en `medida` sus llamadas al driver, bytes y tiempo.
+ */
+template <class FuncionContadores, class Operacion>
+void medir(Medida& medida, FuncionContadores contadores, Operacion operacion) {
+  Contadores antes = contadores();
+  uint64_t inicio = benchmark::relojNs();
+  operacion();
+  medida.ns += benchmark::relojNs() - inicio;
+  Contadores despues = contadores();
+  medida.llamadas += despues.llamadas - antes.llamadas;
+  medida.bytes += despues.bytes - antes.bytes;
+  medida.reloj += despues.reloj - antes.reloj;
+  medida.operaciones++;
+}
+
+void agregar(benchmark::Informe& informe, const char* radio, const char* operacion, size_t tam, const Medida& m) {
+  char nombre[48];
+  snprintf(nombre, sizeof(nombre), "%s_%s_%u", radio, operacion, (unsigned)tam);
+  double n = m.operaciones ? (double)m.operaciones : 1.0;
+  benchmark::Columnas columnas;
+  columnas.push_back(std::make_pair("llamadas_driver", m.llamadas / n));
+  columnas.push_back(std::make_pair("bytes_copiados", m.bytes / n));
+  columnas.push_back(std::make_pair("lecturas_reloj", m.reloj / n));
+  columnas.push_back(std::make_pair("ns_op", m.ns / n));
+  informe.agregar(nombre, columnas);
+}
+
+void comprobar(bool condicion, const char* radio, const char* operacion, size_t tam) {
+  if (condicion) return;
+  fprintf(stderr, "%s_%s_%u: resultado incorrecto\n", radio, operacion, (unsigned)tam);
+  exit(1);
+}
+
+void reiniciarHost() {
+  host::reiniciar();
+  host::desconectarSpi();
+  LoRa.reiniciarModulo();
+  RF24::llamadasTotales() = LlamadasRF24();
+}
+
+// --- LoRa ---
+
+LoRaConfig configuracionLora() {
+  LoRaConfig config;
+  config.frequency = 868E6;
+  config.spreadingFactor = 7;
+  config.signalBandwidth = 125E3;
+  config.codingRate = 5;
+  config.syncWord = 0x12;
+  config.txPower = 14;
+  config.csPin = 10;
+  config.resetPin = -1;
+  config.irqPin = 2;
+  return config;
+}
+
+void enviarDesdePar(LoRaClass& par, const uint8_t* datos, size_t tam) {
+  par.beginPacket();
+  par.write(datos, tam);
+  par.endPacket();
+}
+
+void medirLora(benchmark::Informe& informe, size_t tam, uint32_t repeticiones) {
+  reiniciarHost();
+  LoraRadio radio(configuracionLora());
+  radio.iniciar();
+  LoRaClass par;
+  par.setSyncWord(0x12);
+  par.begin(868E6);
+
+  uint8_t payload[255];
+  memset(payload, 0x3C, sizeof(payload));
+  uint8_t buffer[255];
+  Medida enviar = Medida(), leer = Medida(), anterior = Medida();
+  for (uint32_t r = 0; r < repeticiones; ++r) {
+    par.receive();
+    medir(enviar, contadoresLoRa, [&]() { comprobar(radio.enviar(payload, tam), "lora", "enviar", tam); });
+    par.parsePacket();
+
+    radio.hayDatosDisponibles(); // Arma RX_SINGLE
+    enviarDesdePar(par, payload, tam);
+    medir(leer, contadoresLoRa, [&]() {
+      comprobar(radio.hayDatosDisponibles() == (int)tam && radio.leer(buffer, sizeof(buffer)) == tam, "lora", "leer",
+                tam);
+    });
+
+    LoRa.parsePacket(); // Arma RX_SINGLE
+    enviarDesdePar(par, payload, tam);
+    medir(anterior, contadoresLoRa, [&]() {
+      size_t leidos = 0;
+      if (LoRa.parsePacket() > 0) {
+        while (LoRa.available() && leidos < sizeof(buffer)) buffer[leidos++] = (uint8_t)LoRa.read();
+        volatile int rssi = LoRa.packetRssi();
+        (void)rssi;
+        volatile bool truncada = LoRa.available() != 0;
+        (void)truncada;
+      }
+      comprobar(leidos == tam, "lora", "leer_anterior", tam);
+    });
+  }
+  agregar(informe, "lora", "enviar", tam, enviar);
+  agregar(informe, "lora", "leer", tam, leer);
+  agregar(informe, "lora", "leer_anterior", tam, anterior);
+}
+
+// --- NRF24L01 ---
+
+const byte DIRECCION_A[6] = "NODOA";
+const byte DIRECCION_B[6] = "NODOB";
+
+NrfConfig configuracionNrf(uint8_t pinCe, uint8_t pinCsn, const byte* escritura, const byte* lectura) {
+  NrfConfig config;
+  config.cePin = pinCe;
+  config.csnPin = pinCsn;
+  config.writeAddress = escritura;
+  config.readAddress = lectura;
+  config.channel = 108;
+  config.dataRate = 2;
+  config.paLevel = 0;
+  return config;
+}
+
+void medirNrf(benchmark::Informe& informe, size_t tam, uint32_t repeticiones) {
+  reiniciarHost();
+  NrfRadio radio(configuracionNrf(7, 8, DIRECCION_B, DIRECCION_A));
+  NrfRadio par(configuracionNrf(17, 18, DIRECCION_A, DIRECCION_B));
+  radio.iniciar();
+  par.iniciar();
+
+  uint8_t payload[32];
+  memset(payload, 0x3C, sizeof(payload));
+  uint8_t buffer[32];
+  Medida enviar = Medida(), leer = Medida();
+  for (uint32_t r = 0; r < repeticiones; ++r) {
+    medir(enviar, contadoresRF24, [&]() { comprobar(radio.enviar(payload, tam), "nrf", "enviar", tam); });
+    par.leer(buffer, sizeof(buffer));
+
+    par.enviar(payload, tam);
+    medir(leer, contadoresRF24, [&]() {
+      comprobar(radio.hayDatosDisponibles() == (int)tam && radio.leer(buffer, sizeof(buffer)) == tam, "nrf", "leer",
+                tam);
+    });
+  }
+  agregar(informe, "nrf", "enviar", tam, enviar);
+  agregar(informe, "nrf", "leer", tam, leer);
+}
+
+// --- XBee (modo transparente) ---
+
+void medirXBee(benchmark::Informe& informe, size_t tam, uint32_t repeticiones) {
+  reiniciarHost();
+  PuertoSerieFalso puerto(256);
+  PuertoSerieFalso par;
+  puerto.conectar(par);
+  XBeeRadio radio(puerto, 9600, -1, -1);
+  radio.iniciar();
+
+  uint8_t payload[255];
+  memset(payload, 0x3C, sizeof(payload));
+  uint8_t buffer[255];
+  Medida enviar = Medida(), leer = Medida(), anterior = Medida();
+  for (uint32_t r = 0; r < repeticiones; ++r) {
+    medir(enviar, [&]() { return contadoresPuerto(puerto); },
+          [&]() { comprobar(radio.enviar(payload, tam), "xbee", "enviar", tam); });
+    while (par.available() > 0) par.read();
+
+    par.write(payload, tam);
+    medir(leer, [&]() { return contadoresPuerto(puerto); }, [&]() {
+      comprobar(radio.hayDatosDisponibles() == (int)tam && radio.leer(buffer, sizeof(buffer)) == tam, "xbee", "leer",
+                tam);
+    });
+
+    par.write(payload, tam);
+    medir(anterior, [&]() { return contadoresPuerto(puerto); }, [&]() {
+      int disponibles = puerto.available(); // hayDatosDisponibles()
+      disponibles = puerto.available();     // leer()
+      comprobar(puerto.readBytes(buffer, (size_t)disponibles) == tam, "xbee", "leer_anterior", tam);
+    });
+  }
+  agregar(informe, "xbee", "enviar", tam, enviar);
+  agregar(informe, "xbee", "leer", tam, leer);
+  agregar(informe, "xbee", "leer_anterior", tam, anterior);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  benchmark::Opciones opciones = benchmark::leerOpciones(argc, argv);
+  uint32_t repeticiones = opciones.rapido ? 10 : 1000;
+  host::silenciarSerial(true);
+
+  benchmark::Informe informe("radios");
+  for (size_t t = 0; t < NUM_TAMANOS; ++t) medirLora(informe, TAMANOS[t], repeticiones);
+  for (size_t t = 0; t < NUM_TAMANOS && TAMANOS[t] <= 32; ++t) medirNrf(informe, TAMANOS[t], repeticiones);
+  for (size_t t = 0; t < NUM_TAMANOS && TAMANOS[t] <= XBEE_RADIO_TAM_BUFFER_RX; ++t) {
+    medirXBee(informe, TAMANOS[t], repeticiones);
+  }
+  informe.imprimir(opciones.formato);
+  return 0;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file bench_rafaga_nrf.cpp
+ * @brief Paquetes por segundo del NRF24L01: `enviar()` paquete a paquete frente a `enviarRafaga()`.
+ * @details Contra el RF24 falso: el tiempo es el del reloj virtual (tiempo en el aire, ACK,
+ * asentamiento de 130 µs y el cambio RX->TX de `stopListening()`), así que el resultado
+ * refleja el protocolo y no la CPU del host. El receptor consume cada paquete al llegar.
+ */
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <RF24.h>
+#include <UniversalRadioWSN.h>
+
+#include "Benchmark.h"
+
+namespace {
+
+const byte DIRECCION_EMISOR[6] = "EMISR";
+const byte DIRECCION_RECEPTOR[6] = "RECPT";
+
+NrfConfig configuracion(uint16_t tasa) {
+  NrfConfig config;
+  config.cePin = 7;
+  config.csnPin = 8;
+  config.writeAddress = DIRECCION_RECEPTOR;
+  config.readAddress = DIRECCION_EMISOR;
+  config.channel = 90;
+  config.dataRate = tasa;
+  config.paLevel = 0;
+  return config;
+}
+
+rf24_datarate_e tasaRf24(uint16_t tasa) {
+  return tasa == 250 ? RF24_250KBPS : (tasa == 2 ? RF24_2MBPS : RF24_1MBPS);
+}
+
+void medir(benchmark::Informe& informe, uint16_t tasa, bool rafaga, uint32_t numPaquetes) {
+  host::reiniciar();
+  host::desconectarSpi();
+
+  RF24 receptor(17, 18);
+  receptor.begin();
+  receptor.setChannel(90);
+  receptor.setDataRate(tasaRf24(tasa));
+  receptor.enableDynamicPayloads();
+  receptor.openReadingPipe(1, DIRECCION_RECEPTOR);
+  receptor.startListening();
+  receptor.consumirAlRecibir(true);
+
+  NrfNucleo emisor(configuracion(tasa));
+  emisor.iniciar();
+
+  uint8_t payload[NrfNucleo::TAM_MAX_PAYLOAD];
+  memset(payload, 0x3C, sizeof(payload));
+  std::vector<uint8_t> bloque(static_cast<size_t>(numPaquetes) * sizeof(payload), 0x3C);
+
+  RF24::llamadasTotales() = LlamadasRF24();
+  uint64_t inicioVirtual = host::ahoraMicros();
+  uint64_t inicioPared = benchmark::relojNs();
+  if (rafaga) {
+    emisor.enviarRafaga(bloque.data(), bloque.size());
+  } else {
+    for (uint32_t i = 0; i < numPaquetes; ++i) emisor.enviar(payload, sizeof(payload));
+  }
+  uint64_t paredNs = benchmark::relojNs() - inicioPared;
+  double segundos = static_cast<double>(host::ahoraMicros() - inicioVirtual) / 1e6;
+
+  char nombre[48];
+  snprintf(nombre, sizeof(nombre), "%s_%s", tasa == 250 ? "250k" : (tasa == 2 ? "2M" : "1M"),
+           rafaga ? "rafaga" : "enviar");
+  uint32_t entregados = receptor.paquetesRecibidos();
+  const LlamadasRF24& llamadas = RF24::llamadasTotales();
+  benchmark::Columnas columnas;
+  columnas.push_back(std::make_pair("paquetes", static_cast<double>(entregados)));
+  columnas.push_back(std::make_pair("paquetes_s", entregados / segundos));
+  columnas.push_back(std::make_pair("kbit_s_util", entregados * 8.0 * sizeof(payload) / segundos / 1000.0));
+  columnas.push_back(std::make_pair("cambios_modo", static_cast<double>(llamadas.stopListening + llamadas.startListening)));
+  columnas.push_back(std::make_pair("escrituras", static_cast<double>(llamadas.write + llamadas.writeFast)));
+  columnas.push_back(std::make_pair("ns_host_paquete", static_cast<double>(paredNs) / numPaquetes));
+  informe.agregar(nombre, columnas);
+  if (entregados != numPaquetes) {
+    fprintf(stderr, "%s: entregados %u de %u\n", nombre, static_cast<unsigned>(entregados),
+            static_cast<unsigned>(numPaquetes));
+    exit(1);
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  benchmark::Opciones opciones = benchmark::leerOpciones(argc, argv);
+  uint32_t numPaquetes = opciones.rapido ? 30 : 3000;
+
+  benchmark::Informe informe("rafaga_nrf");
+  const uint16_t tasas[3] = {250, 1, 2};
+  for (int t = 0; t < 3; ++t) {
+    medir(informe, tasas[t], false, numPaquetes);
+    medir(informe, tasas[t], true, numPaquetes);
+  }
+  informe.imprimir(opciones.formato);
+  return 0;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file bench_reed_solomon.cpp
+ * @brief Ciclos por byte de datos del codificador y del decodificador Reed-Solomon (`ReedSolomon.h`).
+ * @details Para cada paridad mide una palabra corta (64 bytes de datos, un paquete LoRa típico)
+ * y una completa (255 bytes en total). El decodificador se mide sin errores (solo recalcula la
+ * paridad), con la mitad de los errores corregibles y con el máximo (`paridad / 2`), que
+ * añade síndromes, Berlekamp-Massey, búsqueda de Chien y Forney. Las posiciones y valores de
+ * los errores cambian en cada palabra, y cada corrección se comprueba contra el original.
+ */
+
+#include <Arduino.h>
+#include <UniversalRadioWSN.h>
+
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+
+namespace {
+
+volatile uint32_t sumidero; ///< Evita que el compilador elimine los bucles medidos.
+
+/**
+ * @brief Palabras código consecutivas en memoria: `k` bytes de datos y `paridad` de paridad.
+ */
+struct Palabras {
+  size_t k;
+  size_t n;
+  std::vector<uint8_t> memoria;
+
+  uint8_t* datos(size_t i) { return memoria.data() + i * n; }
+  uint8_t* paridad(size_t i) { return memoria.data() + i * n + k; }
+};
+
+void agregarFila(benchmark::Informe& informe, const char* nombre, uint64_t ciclos, uint64_t ns, double bytes) {
+  benchmark::Columnas columnas;
+  columnas.push_back(std::make_pair("ciclos_byte", ciclos / bytes));
+  columnas.push_back(std::make_pair("ns_byte", ns / bytes));
+  columnas.push_back(std::make_pair("mbyte_s", bytes * 1000.0 / ns));
+  informe.agregar(nombre, columnas);
+}
+
+void medir(benchmark::Informe& informe, uint8_t paridad, uint8_t k, size_t bytesObjetivo) {
+  ReedSolomon rs(paridad);
+  std::mt19937 azar(paridad * 256u + k);
+  size_t numPalabras = bytesObjetivo / k + 1;
+  Palabras palabras = {k, (size_t)k + paridad, std::vector<uint8_t>(numPalabras * (k + paridad))};
+  for (size_t i = 0; i < numPalabras; ++i) {
+    for (size_t j = 0; j < k; ++j) palabras.datos(i)[j] = (uint8_t)azar();
+  }
+  double bytes = (double)numPalabras * k;
+  char nombre[48];
+
+  uint64_t inicioCiclos = benchmark::ciclos();
+  uint64_t inicioNs = benchmark::relojNs();
+  for (size_t i = 0; i < numPalabras; ++i) {
+    uint8_t* registro = palabras.paridad(i);
+    memset(registro, 0, paridad);
+    const uint8_t* datos = palabras.datos(i);
+    for (size_t j = 0; j < k; ++j) rs.codificarByte(registro, 1, datos[j]);
+  }
+  snprintf(nombre, sizeof(nombre), "p%u_k%u_codificar", (unsigned)paridad, (unsigned)k);
+  agregarFila(informe, nombre, benchmark::ciclos() - inicioCiclos, benchmark::relojNs() - inicioNs, bytes);
+  std::vector<uint8_t> original = palabras.memoria;
+
+  const uint8_t numErrores[3] = {0, (uint8_t)(paridad / 4), (uint8_t)(paridad / 2)};
+  for (int e = 0; e < 3; ++e) {
+    palabras.memoria = original;
+    for (size_t i = 0; i < numPalabras; ++i) {
+      // Errores en posiciones distintas de toda la palabra (datos y paridad)
+      for (uint8_t j = 0; j < numErrores[e]; ++j) {
+        size_t posicion;
+        do {
+          posicion = azar() % palabras.n;
+        } while (palabras.memoria[i * palabras.n + posicion] != original[i * palabras.n + posicion]);
+        palabras.memoria[i * palabras.n + posicion] ^= (uint8_t)(1 + azar() % 255);
+      }
+    }
+
+    uint32_t corregidos = 0;
+    inicioCiclos = benchmark::ciclos();
+    inicioNs = benchmark::relojNs();
+    for (size_t i = 0; i < numPalabras; ++i) {
+      corregidos += (uint32_t)rs.corregir(palabras.datos(i), k, palabras.paridad(i), 1);
+    }
+    uint64_t ciclos = benchmark::ciclos() - inicioCiclos;
+    uint64_t ns = benchmark::relojNs() - inicioNs;
+    sumidero = corregidos;
+    if (corregidos != numPalabras * numErrores[e] || palabras.memoria != original) {
+      fprintf(stderr, "p%u_k%u: %u bytes corregidos de %u\n", (unsigned)paridad, (unsigned)k, (unsigned)corregidos,
+              (unsigned)(numPalabras * numErrores[e]));
+      exit(1);
+    }
+    snprintf(nombre, sizeof(nombre), "p%u_k%u_decodificar_%ue", (unsigned)paridad, (unsigned)k,
+             (unsigned)numErrores[e]);
+    agregarFila(informe, nombre, ciclos, ns, bytes);
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  benchmark::Opciones opciones = benchmark::leerOpciones(argc, argv);
+  size_t bytesObjetivo = opciones.rapido ? 5000 : 1000000;
+
+  benchmark::Informe informe("reed_solomon");
+  const uint8_t paridades[3] = {8, 16, 32};
+  for (int p = 0; p < 3; ++p) {
+    medir(informe, paridades[p], 64, bytesObjetivo);
+    medir(informe, paridades[p], (uint8_t)(255 - paridades[p]), bytesObjetivo);
+  }
+  informe.imprimir(opciones.formato);
+  return 0;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file bench_slip.cpp
+ * @brief Coste por byte de la delimitación SLIP (`TramaSlip.h`) según la longitud y el contenido.
+ * @details `DecodificadorSlip::procesar()` atiende un byte por llamada con un número acotado
+ * de comparaciones, así que el tiempo por byte no debe depender de la longitud de la trama
+ * ni de lo que quede en la línea. Se mide con tres contenidos: sin bytes especiales, aleatorio
+ * y solo END/ESC (el peor caso, que duplica los bytes en la línea). `ns_byte_linea` es por
+ * byte recibido (incluidos escapes y delimitadores) y `ns_byte_util` por byte de contenido.
+ * Cada trama tiene un contenido distinto, para que el predictor de saltos del host no
+ * memorice una trama repetida y abarate las cortas.
+ */
+
+#include <Arduino.h>
+#include <UniversalRadioWSN.h>
+
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+
+namespace {
+
+enum Contenido { SIN_ESPECIALES, ALEATORIO, SOLO_ESPECIALES };
+
+const char* const NOMBRES_CONTENIDO[] = {"sin_especiales", "aleatorio", "solo_especiales"};
+
+/**
+ * @brief `Print` que copia en un vector, para medir la codificación sin el coste de un UART.
+ */
+class SumideroMemoria : public Print {
+public:
+  std::vector<uint8_t> datos;
+
+  size_t write(uint8_t byte) override {
+    datos.push_back(byte);
+    return 1;
+  }
+  size_t write(const uint8_t* buffer, size_t longitud) override {
+    datos.insert(datos.end(), buffer, buffer + longitud);
+    return longitud;
+  }
+  using Print::write;
+};
+
+std::vector<uint8_t> generar(Contenido contenido, size_t longitud, std::mt19937& azar) {
+  std::vector<uint8_t> trama(longitud);
+  for (size_t i = 0; i < longitud; ++i) {
+    uint8_t byte = static_cast<uint8_t>(azar());
+    if (contenido == SIN_ESPECIALES && (byte == SLIP_END || byte == SLIP_ESC)) byte = 0x00;
+    if (contenido == SOLO_ESPECIALES) byte = (byte & 1) ? SLIP_END : SLIP_ESC;
+    trama[i] = byte;
+  }
+  return trama;
+}
+
+volatile uint32_t sumidero; ///< Evita que el compilador elimine los bucles medidos.
+
+void medir(benchmark::Informe& informe, Contenido contenido, size_t longitud, size_t bytesObjetivo) {
+  std::mt19937 azar(static_cast<uint32_t>(longitud));
+  size_t repeticiones = bytesObjetivo / longitud + 1;
+  std::vector<uint8_t> contenidos = generar(contenido, repeticiones * longitud, azar);
+
+  // Codificación: varias tramas seguidas en memoria, que luego se decodifican
+  SumideroMemoria linea;
+  linea.datos.reserve(repeticiones * (2 * longitud + 2));
+  uint64_t inicio = benchmark::relojNs();
+  for (size_t r = 0; r < repeticiones; ++r) {
+    Segmento segmento = {contenidos.data() + r * longitud, longitud};
+    escribirTramaSlip(linea, &segmento, 1);
+  }
+  uint64_t nsCodificar = benchmark::relojNs() - inicio;
+
+  std::vector<uint8_t> buffer(longitud);
+  DecodificadorSlip decodificador(buffer.data(), static_cast<uint16_t>(longitud));
+  uint32_t tramas = 0;
+  inicio = benchmark::relojNs();
+  for (size_t i = 0; i < linea.datos.size(); ++i) {
+    if (decodificador.procesar(linea.datos[i])) {
+      tramas++;
+      decodificador.liberar();
+    }
+  }
+  uint64_t nsDecodificar = benchmark::relojNs() - inicio;
+  sumidero = tramas;
+  if (tramas != repeticiones || decodificador.errores() != 0) {
+    fprintf(stderr, "%s_%u: %u tramas de %u\n", NOMBRES_CONTENIDO[contenido], static_cast<unsigned>(longitud),
+            static_cast<unsigned>(tramas), static_cast<unsigned>(repeticiones));
+    exit(1);
+  }
+
+  double bytesLinea = static_cast<double>(linea.datos.size());
+  double bytesUtiles = static_cast<double>(repeticiones * longitud);
+  char nombre[48];
+  snprintf(nombre, sizeof(nombre), "%s_%u", NOMBRES_CONTENIDO[contenido], static_cast<unsigned>(longitud));
+  benchmark::Columnas columnas;
+  columnas.push_back(std::make_pair("expansion", bytesLinea / bytesUtiles));
+  columnas.push_back(std::make_pair("ns_byte_linea_dec", nsDecodificar / bytesLinea));
+  columnas.push_back(std::make_pair("ns_byte_util_dec", nsDecodificar / bytesUtiles));
+  columnas.push_back(std::make_pair("ns_byte_util_cod", nsCodificar / bytesUtiles));
+  informe.agregar(nombre, columnas);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  benchmark::Opciones opciones = benchmark::leerOpciones(argc, argv);
+  size_t bytesObjetivo = opciones.rapido ? 20000 : 20000000;
+
+  benchmark::Informe informe("slip");
+  const size_t longitudes[5] = {16, 64, 256, 1024, 4096};
+  for (int c = SIN_ESPECIALES; c <= SOLO_ESPECIALES; ++c) {
+    for (int l = 0; l < 5; ++l) medir(informe, static_cast<Contenido>(c), longitudes[l], bytesObjetivo);
+  }
+  informe.imprimir(opciones.formato);
+  return 0;
+}
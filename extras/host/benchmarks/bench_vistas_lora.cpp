@@ -0,0 +1,131 @@
+/**
+ * @file bench_vistas_lora.cpp
+ * @brief Coste de recibir un paquete LoRa: `leerComoString()` frente a `leer()` y `tomarPaquete()`.
+ * @details Por paquete y tamaño de payload se mide, contra el LoRa falso:
+ * - `reservas_string` y `bytes_string`: memoria dinámica y bytes copiados por `String`.
+ * - `bytes_copiados`: total copiado en RAM, la copia de la FIFO a un buffer más la del `String`.
+ * - `lecturas_fifo`: llamadas a `LoRa.read()` (un byte de la FIFO por SPI cada una).
+ * - `registros_spi`: accesos a registros del módulo (`parsePacket()`, `read()`, RSSI...).
+ * - `ns_host`: tiempo de CPU del host en la lectura.
+ *
+ * `leerComoString()` copia el paquete dos veces (buffer del stack y `String`, con su reserva
+ * en el heap); `leer()` una, en el buffer del llamador; `tomarPaquete()` en sondeo una, en el
+ * buffer del driver; y con el anillo la copia la hace la interrupción y la lectura no toca
+ * el bus SPI.
+ */
+
+#include <Arduino.h>
+#include <LoRa.h>
+#include <UniversalRadioWSN.h>
+
+#include "Benchmark.h"
+
+namespace {
+
+enum Modo { MODO_STRING, MODO_LEER, MODO_VISTA_SONDEO, MODO_VISTA_ANILLO };
+
+const char* const NOMBRES_MODO[] = {"leerComoString", "leer", "tomarPaquete_sondeo", "tomarPaquete_anillo"};
+
+LoRaConfig configuracion() {
+  LoRaConfig config;
+  config.frequency = 868E6;
+  config.spreadingFactor = 7;
+  config.signalBandwidth = 125E3;
+  config.codingRate = 5;
+  config.syncWord = 0x12;
+  config.txPower = 14;
+  config.csPin = 10;
+  config.resetPin = -1;
+  config.irqPin = 2;
+  return config;
+}
+
+void medir(benchmark::Informe& informe, Modo modo, size_t tamPayload, uint32_t numPaquetes) {
+  host::reiniciar();
+  host::desconectarSpi();
+  LoRa.reiniciarModulo();
+
+  AnilloPaquetesEstatico<4, 256> anillo;
+  LoraRadio radio(configuracion());
+  if (modo == MODO_VISTA_ANILLO) radio.habilitarRecepcionPorInterrupcion(anillo);
+  radio.iniciar();
+
+  LoRaClass par;
+  par.setSyncWord(0x12);
+  par.begin(868E6);
+
+  uint8_t payload[255];
+  memset(payload, 'A', sizeof(payload)); // Sin ceros: leerComoString() corta en el primero
+  uint8_t buffer[255];
+  radio.hayDatosDisponibles(); // En sondeo arma RX_SINGLE
+
+  uint32_t reservas = 0;
+  uint32_t bytesString = 0;
+  uint32_t lecturasFifo = 0;
+  uint32_t registros = 0;
+  uint64_t paredNs = 0;
+  size_t recibidos = 0;
+  for (uint32_t i = 0; i < numPaquetes; ++i) {
+    par.beginPacket();
+    par.write(payload, tamPayload);
+    par.endPacket();
+
+    uint32_t reservasAntes = host::reservasString();
+    uint32_t bytesAntes = host::bytesCopiadosString();
+    LlamadasLoRa antes = LoRa.llamadas();
+    uint64_t inicio = benchmark::relojNs();
+    if (radio.hayDatosDisponibles() > 0) {
+      if (modo == MODO_STRING) {
+        String texto = radio.leerComoString();
+        recibidos += texto.length();
+      } else if (modo == MODO_LEER) {
+        recibidos += radio.leer(buffer, sizeof(buffer));
+      } else {
+        VistaPaquete vista;
+        if (radio.tomarPaquete(vista)) {
+          recibidos += vista.longitud;
+          radio.liberarPaquete();
+        }
+      }
+    }
+    paredNs += benchmark::relojNs() - inicio;
+    reservas += host::reservasString() - reservasAntes;
+    bytesString += host::bytesCopiadosString() - bytesAntes;
+    lecturasFifo += LoRa.llamadas().read - antes.read;
+    registros += LoRa.llamadas().registros - antes.registros;
+    radio.hayDatosDisponibles(); // En sondeo rearma RX_SINGLE para el siguiente paquete
+  }
+
+  char nombre[48];
+  snprintf(nombre, sizeof(nombre), "%s_%u", NOMBRES_MODO[modo], static_cast<unsigned>(tamPayload));
+  benchmark::Columnas columnas;
+  columnas.push_back(std::make_pair("reservas_string", static_cast<double>(reservas) / numPaquetes));
+  columnas.push_back(std::make_pair("bytes_string", static_cast<double>(bytesString) / numPaquetes));
+  columnas.push_back(std::make_pair("bytes_copiados", static_cast<double>(bytesString + recibidos) / numPaquetes));
+  columnas.push_back(std::make_pair("lecturas_fifo", static_cast<double>(lecturasFifo) / numPaquetes));
+  columnas.push_back(std::make_pair("registros_spi", static_cast<double>(registros) / numPaquetes));
+  columnas.push_back(std::make_pair("ns_host", static_cast<double>(paredNs) / numPaquetes));
+  informe.agregar(nombre, columnas);
+  if (recibidos != static_cast<size_t>(numPaquetes) * tamPayload) {
+    fprintf(stderr, "%s: recibidos %u de %u bytes\n", nombre, static_cast<unsigned>(recibidos),
+            static_cast<unsigned>(numPaquetes * tamPayload));
+    exit(1);
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  benchmark::Opciones opciones = benchmark::leerOpciones(argc, argv);
+  uint32_t numPaquetes = opciones.rapido ? 10 : 2000;
+
+  benchmark::Informe informe("vistas_lora");
+  const size_t tamanos[4] = {16, 64, 128, 255};
+  for (int t = 0; t < 4; ++t) {
+    for (int m = MODO_STRING; m <= MODO_VISTA_ANILLO; ++m) {
+      medir(informe, static_cast<Modo>(m), tamanos[t], numPaquetes);
+    }
+  }
+  informe.imprimir(opciones.formato);
+  return 0;
+}
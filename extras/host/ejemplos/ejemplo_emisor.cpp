@@ -0,0 +1,56 @@
+/**
+ * @file ejemplo_emisor.cpp
+ * @brief Ejecuta `examples/emisorNRFLORA` en el host con el driver LoRa falso.
+ * @details Un segundo módulo LoRa falso, configurado como el receptor del ejemplo, escucha
+ * en el mismo éter y muestra lo que le llega. Termina con éxito si recibe los N mensajes
+ * (argumento, 3 por defecto) con el texto esperado.
+ */
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <LoRa.h>
+#include <UniversalRadioWSN.h>
+
+#include <stdio.h>
+
+namespace sketch {
+#include "emisorNRFLORA/emisorNRFLORA.ino"
+}
+
+int main(int argc, char** argv) {
+  long mensajes = argc > 1 ? atol(argv[1]) : 3;
+
+  LoRaClass par;
+  par.setSpreadingFactor(7);
+  par.setSignalBandwidth(125E3);
+  par.setCodingRate4(5);
+  par.setSyncWord(0xF3);
+  par.begin(410E6);
+
+  long recibidos = 0;
+  bool correctos = true;
+  host::alEsperar([&]() {
+    int longitud = par.parsePacket();
+    if (longitud <= 0) return;
+    char texto[256];
+    int n = 0;
+    while (par.available() > 0 && n < 255) texto[n++] = static_cast<char>(par.read());
+    texto[n] = '\0';
+    recibidos++;
+    String esperado = "Hola Mundo! Mensaje #" + String(recibidos) + "\n";
+    if (!esperado.equals(texto)) correctos = false;
+    printf("[par LoRa] %d bytes: '%.*s'\n", n, n > 0 ? n - 1 : 0, texto);
+  });
+
+  sketch::setup();
+  for (long i = 0; i < mensajes; ++i) sketch::loop();
+  delay(0);
+
+  if (recibidos != mensajes || !correctos) {
+    printf("FALLO: el par recibió %ld de %ld mensajes%s\n", recibidos, mensajes,
+           correctos ? "" : " (con texto inesperado)");
+    return 1;
+  }
+  printf("OK: %ld mensajes recibidos\n", recibidos);
+  return 0;
+}
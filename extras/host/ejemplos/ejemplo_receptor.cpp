@@ -0,0 +1,54 @@
+/**
+ * @file ejemplo_receptor.cpp
+ * @brief Ejecuta `examples/receptorNRFLORA` en el host con el driver LoRa falso.
+ * @details Un segundo módulo LoRa falso hace de emisor del ejemplo: transmite
+ * "Hola Mundo! Mensaje #k\n" cada 3 s en el mismo éter. Termina con éxito si el sketch
+ * recibe los N mensajes (argumento, 3 por defecto).
+ */
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <LoRa.h>
+#include <UniversalRadioWSN.h>
+
+#include <stdio.h>
+
+namespace sketch {
+#include "receptorNRFLORA/receptorNRFLORA.ino"
+}
+
+int main(int argc, char** argv) {
+  long mensajes = argc > 1 ? atol(argv[1]) : 3;
+
+  LoRaClass par;
+  par.setSpreadingFactor(7);
+  par.setSignalBandwidth(125E3);
+  par.setCodingRate4(5);
+  par.setSyncWord(0xF3);
+  par.begin(410E6);
+
+  for (long k = 1; k <= mensajes; ++k) {
+    host::programar(static_cast<uint64_t>(k) * 3000000ULL, [&par, k]() {
+      String mensaje = "Hola Mundo! Mensaje #" + String(k);
+      par.beginPacket();
+      par.print(mensaje);
+      par.write('\n');
+      par.endPacket(true);
+    });
+  }
+
+  sketch::setup();
+  uint64_t fin = static_cast<uint64_t>(mensajes + 1) * 3000000ULL;
+  while (host::ahoraMicros() < fin) {
+    sketch::loop();
+    yield();
+  }
+
+  uint32_t recibidos = sketch::radio->obtenerEstadisticas().tramasRecibidas;
+  if (recibidos != static_cast<uint32_t>(mensajes)) {
+    printf("FALLO: el sketch recibió %u de %ld mensajes\n", (unsigned)recibidos, mensajes);
+    return 1;
+  }
+  printf("OK: %u mensajes recibidos\n", (unsigned)recibidos);
+  return 0;
+}
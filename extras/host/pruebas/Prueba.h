@@ -0,0 +1,106 @@
+/**
+ * @file Prueba.h
+ * @brief Mínimo marco de pruebas para los ejecutables de `extras/host/pruebas`.
+ * @details Cada `PRUEBA(nombre)` se registra sola y se ejecuta con el entorno del host
+ * recién reiniciado (reloj a 0, pines, bus SPI, módulo `LoRa` global y canales sin
+ * pérdidas). Un `COMPROBAR` fallido informa de archivo y línea y aborta esa prueba.
+ * El ejecutable termina con código distinto de 0 si alguna falla (lo que mira `ctest`).
+ */
+
+#ifndef HOST_PRUEBA_H
+#define HOST_PRUEBA_H
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <LoRa.h>
+#include <RF24.h>
+
+#include <stdio.h>
+
+#include <vector>
+
+namespace pruebas {
+
+struct Caso {
+  const char* nombre;
+  void (*funcion)();
+};
+
+inline std::vector<Caso>& casos() {
+  static std::vector<Caso> lista;
+  return lista;
+}
+
+struct Registro {
+  Registro(const char* nombre, void (*funcion)()) {
+    Caso caso = {nombre, funcion};
+    casos().push_back(caso);
+  }
+};
+
+struct Fallo {};
+
+inline bool& hayFallo() {
+  static bool fallo = false;
+  return fallo;
+}
+
+inline void fallar(const char* archivo, int linea, const char* expresion) {
+  printf("  %s:%d: falló: %s\n", archivo, linea, expresion);
+  hayFallo() = true;
+  throw Fallo();
+}
+
+/**
+ * @brief Deja el entorno como al arrancar el MCU.
+ */
+inline void reiniciarEntorno() {
+  host::reiniciar();
+  host::desconectarSpi();
+  host::estadisticasSpi() = host::EstadisticasSpi{0, 0};
+  host::lora::fijarProbabilidadPerdida(0.0);
+  host::nrf::fijarProbabilidadPerdida(0.0);
+  LoRa.reiniciarModulo();
+}
+
+/**
+ * @brief Ejecuta todas las pruebas registradas.
+ * @return 0 si todas pasan.
+ */
+inline int ejecutar() {
+  int fallidas = 0;
+  for (size_t i = 0; i < casos().size(); ++i) {
+    reiniciarEntorno();
+    hayFallo() = false;
+    try {
+      casos()[i].funcion();
+    } catch (const Fallo&) {
+    }
+    printf("[%s] %s\n", hayFallo() ? "FALLO" : " OK  ", casos()[i].nombre);
+    if (hayFallo()) fallidas++;
+  }
+  printf("%d de %u pruebas fallidas\n", fallidas, static_cast<unsigned>(casos().size()));
+  return fallidas == 0 ? 0 : 1;
+}
+
+} // namespace pruebas
+
+#define PRUEBA(nombre)                                                   \
+  static void nombre();                                                  \
+  static pruebas::Registro registro_##nombre(#nombre, nombre);           \
+  static void nombre()
+
+#define COMPROBAR(expresion) \
+  do { if (!(expresion)) pruebas::fallar(__FILE__, __LINE__, #expresion); } while (0)
+
+#define COMPROBAR_IGUAL(obtenido, esperado)                                                        \
+  do {                                                                                             \
+    long long obtenido_ = static_cast<long long>(obtenido);                                        \
+    long long esperado_ = static_cast<long long>(esperado);                                        \
+    if (obtenido_ != esperado_) {                                                                  \
+      printf("  %s = %lld, se esperaba %lld\n", #obtenido, obtenido_, esperado_);                  \
+      pruebas::fallar(__FILE__, __LINE__, #obtenido " == " #esperado);                             \
+    }                                                                                              \
+  } while (0)
+
+#endif // HOST_PRUEBA_H
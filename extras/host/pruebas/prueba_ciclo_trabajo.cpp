@@ -0,0 +1,137 @@
+/**
+ * @file prueba_ciclo_trabajo.cpp
+ * @brief `ContadorCicloTrabajo` con `LoraRadio`: solo se cobran las tramas que llegan al aire.
+ */
+
+#include "Prueba.h"
+
+#include <UniversalRadioWSN.h>
+
+namespace {
+
+LoRaConfig configuracion() {
+  LoRaConfig config;
+  config.frequency = 868E6;
+  config.spreadingFactor = 7;
+  config.signalBandwidth = 125E3;
+  config.codingRate = 5;
+  config.syncWord = 0x12;
+  config.txPower = 14;
+  config.csPin = 10;
+  config.resetPin = -1;
+  config.irqPin = 2;
+  return config;
+}
+
+/**
+ * @brief Pone el módulo a transmitir por su cuenta, para que `LoRa.beginPacket()` falle.
+ */
+void ocuparTransmisor() {
+  LoRa.beginPacket();
+  LoRa.write(0x55);
+  LoRa.endPacket(true);
+}
+
+const uint8_t DATOS[12] = {0};
+
+/**
+ * @brief Tiempo cobrado desde `antes`, descontando la recarga del 1% desde el instante 0.
+ */
+uint32_t cobrado(ContadorCicloTrabajo& contador, uint32_t antes) {
+  return antes + millis() * 10 - contador.presupuestoRestanteUs();
+}
+
+} // namespace
+
+PRUEBA(devolver_no_supera_el_maximo) {
+  ContadorCicloTrabajo contador(10, 1000); // 10 ms de presupuesto
+  COMPROBAR(contador.consumir(4000));
+  contador.devolver(4000);
+  COMPROBAR_IGUAL(contador.presupuestoRestanteUs(), 10000u);
+  contador.devolver(4000);
+  COMPROBAR_IGUAL(contador.presupuestoRestanteUs(), 10000u);
+}
+
+PRUEBA(ldro_como_la_libreria_lora) {
+  COMPROBAR(!loraOptimizacionBajaTasa(11, 125000)); // Símbolo de 16.38 ms, truncado a 16
+  COMPROBAR(loraOptimizacionBajaTasa(12, 125000));
+  COMPROBAR(loraOptimizacionBajaTasa(11, 62500));
+  COMPROBAR(!loraOptimizacionBajaTasa(12, 250000));
+}
+
+PRUEBA(envio_bloqueante_cobra_el_tiempo_en_el_aire) {
+  ContadorCicloTrabajo contador(10);
+  LoraRadio radio(configuracion());
+  radio.limitarCicloTrabajo(contador);
+  COMPROBAR(radio.iniciar());
+
+  uint32_t antes = contador.presupuestoRestanteUs();
+  COMPROBAR(radio.enviar(DATOS, sizeof(DATOS)));
+  COMPROBAR_IGUAL(cobrado(contador, antes), radio.tiempoEnAireUs(sizeof(DATOS)));
+}
+
+PRUEBA(radio_ocupada_no_cobra) {
+  ContadorCicloTrabajo contador(10);
+  LoraRadio radio(configuracion());
+  radio.limitarCicloTrabajo(contador);
+  COMPROBAR(radio.iniciar());
+
+  uint32_t antes = contador.presupuestoRestanteUs();
+  ocuparTransmisor();
+  COMPROBAR(!radio.enviar(DATOS, sizeof(DATOS))); // beginPacket() falla
+  COMPROBAR_IGUAL(contador.presupuestoRestanteUs(), antes);
+  COMPROBAR_IGUAL(radio.obtenerEstadisticas().rechazosOcupada, 1u);
+}
+
+PRUEBA(paquete_sin_leer_no_cobra) {
+  ContadorCicloTrabajo contador(10);
+  LoraRadio radio(configuracion());
+  radio.limitarCicloTrabajo(contador);
+  COMPROBAR(radio.iniciar());
+  LoRaClass par;
+  par.setSyncWord(0x12);
+  par.begin(868E6);
+
+  radio.hayDatosDisponibles(); // Arma RX_SINGLE
+  par.beginPacket();
+  par.write(DATOS, 4);
+  par.endPacket();
+  COMPROBAR_IGUAL(radio.hayDatosDisponibles(), 4);
+
+  uint32_t antes = contador.presupuestoRestanteUs();
+  COMPROBAR(!radio.enviar(DATOS, sizeof(DATOS)));
+  COMPROBAR_IGUAL(contador.presupuestoRestanteUs(), antes);
+}
+
+PRUEBA(trama_encolada_descartada_se_devuelve) {
+  ContadorCicloTrabajo contador(10);
+  AnilloPaquetesEstatico<4, 32> cola;
+  LoraRadio radio(configuracion());
+  radio.limitarCicloTrabajo(contador);
+  radio.habilitarTransmisionAsincrona(cola);
+  COMPROBAR(radio.iniciar());
+
+  uint32_t antes = contador.presupuestoRestanteUs();
+  ocuparTransmisor();
+  COMPROBAR(radio.enviar(DATOS, sizeof(DATOS))); // Se encola y se descarta al arrancar
+  COMPROBAR_IGUAL(radio.obtenerEstadisticas().tramasNoEntregadas, 1u);
+  COMPROBAR_IGUAL(contador.presupuestoRestanteUs(), antes);
+}
+
+PRUEBA(trama_encolada_transmitida_se_cobra) {
+  ContadorCicloTrabajo contador(10);
+  AnilloPaquetesEstatico<4, 32> cola;
+  LoraRadio radio(configuracion());
+  radio.limitarCicloTrabajo(contador);
+  radio.habilitarTransmisionAsincrona(cola);
+  COMPROBAR(radio.iniciar());
+
+  uint32_t antes = contador.presupuestoRestanteUs();
+  COMPROBAR(radio.enviar(DATOS, sizeof(DATOS)));
+  COMPROBAR(radio.enviar(DATOS, sizeof(DATOS)));
+  while (radio.transmisionesPendientes() > 0) host::avanzarHastaEvento();
+  COMPROBAR_IGUAL(radio.obtenerEstadisticas().tramasNoEntregadas, 0u);
+  COMPROBAR_IGUAL(cobrado(contador, antes), 2 * radio.tiempoEnAireUs(sizeof(DATOS)));
+}
+
+int main() { return pruebas::ejecutar(); }
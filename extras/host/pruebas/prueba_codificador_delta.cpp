@@ -0,0 +1,193 @@
+/**
+ * @file prueba_codificador_delta.cpp
+ * @brief `CodificadorDelta`/`DecodificadorDelta`: ida y vuelta en varint y empaquetado de bits,
+ * escapes, diferencias extremas, buffer lleno y relleno del último byte.
+ */
+
+#include "Prueba.h"
+
+#include <UniversalRadioWSN.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Codifica `valores` en un buffer de `capacidad` bytes y comprueba que se decodifican
+ * exactamente los que cupieron.
+ * @return Muestras que cupieron.
+ */
+size_t idaYVuelta(const std::vector<int32_t>& valores, uint8_t bits, size_t capacidad = 512) {
+  std::vector<uint8_t> buffer(capacidad);
+  CodificadorDelta codificador(buffer.data(), buffer.size(), bits);
+  size_t cupieron = 0;
+  while (cupieron < valores.size() && codificador.agregar(valores[cupieron])) cupieron++;
+  COMPROBAR_IGUAL(codificador.muestras(), cupieron);
+
+  DecodificadorDelta decodificador(codificador.datos(), codificador.longitud(), bits);
+  int32_t valor;
+  for (size_t i = 0; i < cupieron; ++i) {
+    COMPROBAR(decodificador.siguiente(valor));
+    COMPROBAR_IGUAL(valor, valores[i]);
+  }
+  COMPROBAR(!decodificador.siguiente(valor));
+  return cupieron;
+}
+
+} // namespace
+
+PRUEBA(zigzag_ordena_por_magnitud) {
+  COMPROBAR_IGUAL(zigzagCodificar(0), 0u);
+  COMPROBAR_IGUAL(zigzagCodificar(-1), 1u);
+  COMPROBAR_IGUAL(zigzagCodificar(1), 2u);
+  COMPROBAR_IGUAL(zigzagCodificar(INT32_MAX), 0xFFFFFFFEu);
+  COMPROBAR_IGUAL(zigzagCodificar(INT32_MIN), 0xFFFFFFFFu);
+  COMPROBAR_IGUAL(zigzagDecodificar(0xFFFFFFFFu), INT32_MIN);
+  COMPROBAR_IGUAL(aPuntoFijo(21.37f, 100), 2137);
+  COMPROBAR_IGUAL(aPuntoFijo(-0.125f, 100), -13);
+}
+
+PRUEBA(ida_y_vuelta_aleatoria_en_todos_los_formatos) {
+  std::mt19937 azar(17);
+  for (uint8_t bits = CodificadorDelta::BITS_VARINT; bits <= 31; ++bits) {
+    std::vector<int32_t> valores;
+    int32_t valor = (int32_t)azar();
+    for (int i = 0; i < 100; ++i) {
+      // Sobre todo diferencias pequeñas, con alguna que necesita escape
+      int32_t paso = (azar() % 8 == 0) ? (int32_t)azar() : (int32_t)(azar() % 15) - 7;
+      valor = (int32_t)((uint32_t)valor + (uint32_t)paso);
+      valores.push_back(valor);
+    }
+    COMPROBAR_IGUAL(idaYVuelta(valores, bits), valores.size());
+  }
+}
+
+PRUEBA(diferencias_extremas) {
+  // Diferencias de INT32_MAX, INT32_MIN y las que dan la vuelta al rango
+  std::vector<int32_t> valores;
+  valores.push_back(INT32_MAX);
+  valores.push_back(INT32_MIN);
+  valores.push_back(0);
+  valores.push_back(INT32_MIN);
+  valores.push_back(INT32_MAX);
+  valores.push_back(-1);
+  valores.push_back(INT32_MAX);
+  for (uint8_t bits = CodificadorDelta::BITS_VARINT; bits <= 31; ++bits) {
+    COMPROBAR_IGUAL(idaYVuelta(valores, bits), valores.size());
+  }
+
+  // En varint la diferencia INT32_MIN (zig-zag 0xFFFFFFFF) ocupa 5 bytes
+  uint8_t buffer[5];
+  CodificadorDelta codificador(buffer, sizeof(buffer));
+  COMPROBAR(codificador.agregar(INT32_MIN));
+  COMPROBAR_IGUAL(codificador.longitud(), 5u);
+}
+
+PRUEBA(escape_con_el_codigo_de_todo_unos) {
+  // Con 4 bits, el código 15 es el escape: zig-zag 14 (7) cabe, 15 (-8) ya no
+  uint8_t buffer[16];
+  CodificadorDelta codificador(buffer, sizeof(buffer), 4);
+  COMPROBAR(codificador.agregar(7));
+  COMPROBAR_IGUAL(codificador.longitud(), 1u);
+  COMPROBAR(codificador.agregar(-1));
+  COMPROBAR_IGUAL(codificador.longitud(), 5u); // 4 + 4 + 32 bits
+  COMPROBAR(codificador.agregar(-1));
+  COMPROBAR_IGUAL(codificador.longitud(), 6u);
+
+  DecodificadorDelta decodificador(buffer, codificador.longitud(), 4);
+  int32_t valor;
+  COMPROBAR(decodificador.siguiente(valor));
+  COMPROBAR_IGUAL(valor, 7);
+  COMPROBAR(decodificador.siguiente(valor));
+  COMPROBAR_IGUAL(valor, -1);
+  COMPROBAR(decodificador.siguiente(valor));
+  COMPROBAR_IGUAL(valor, -1);
+  COMPROBAR(!decodificador.siguiente(valor));
+}
+
+PRUEBA(buffer_lleno_rechaza_sin_modificarlo) {
+  for (uint8_t bits = CodificadorDelta::BITS_VARINT; bits <= 31; bits = (uint8_t)(bits + 3)) {
+    uint8_t buffer[12];
+    memset(buffer, 0xA5, sizeof(buffer));
+    CodificadorDelta codificador(buffer, sizeof(buffer), bits);
+    int32_t valor = 0;
+    while (codificador.agregar(valor)) valor += 3;
+
+    uint8_t copia[sizeof(buffer)];
+    memcpy(copia, buffer, sizeof(buffer));
+    size_t longitud = codificador.longitud();
+    uint16_t muestras = codificador.muestras();
+    COMPROBAR(muestras > 0);
+
+    // Ni una diferencia pequeña ni una que necesita escape entran, y nada cambia
+    COMPROBAR(!codificador.agregar(valor));
+    COMPROBAR(!codificador.agregar(INT32_MIN));
+    COMPROBAR(memcmp(copia, buffer, sizeof(buffer)) == 0);
+    COMPROBAR_IGUAL(codificador.longitud(), longitud);
+    COMPROBAR_IGUAL(codificador.muestras(), muestras);
+
+    // Lo codificado se decodifica entero
+    DecodificadorDelta decodificador(buffer, longitud, bits);
+    int32_t leido;
+    uint16_t decodificadas = 0;
+    while (decodificador.siguiente(leido)) COMPROBAR_IGUAL(leido, 3 * decodificadas++);
+    COMPROBAR_IGUAL(decodificadas, muestras);
+  }
+}
+
+PRUEBA(varint_que_no_cabe_entero_no_escribe_en_el_hueco) {
+  uint8_t buffer[12];
+  memset(buffer, 0xA5, sizeof(buffer));
+  CodificadorDelta codificador(buffer, sizeof(buffer));
+  for (int i = 0; i < 10; ++i) COMPROBAR(codificador.agregar(0));
+
+  // Quedan 2 bytes libres y la diferencia necesita 5
+  COMPROBAR(!codificador.agregar(INT32_MIN));
+  COMPROBAR_IGUAL(buffer[10], 0xA5);
+  COMPROBAR_IGUAL(buffer[11], 0xA5);
+  COMPROBAR_IGUAL(codificador.longitud(), 10u);
+  COMPROBAR(codificador.agregar(-100)); // 2 bytes: todavía cabe
+  COMPROBAR_IGUAL(codificador.longitud(), 12u);
+}
+
+PRUEBA(relleno_del_ultimo_byte_no_produce_muestras) {
+  // Con 1 bit por diferencia cada muestra repetida es un 0 y el relleno son unos (escapes
+  // incompletos): para cualquier número de bits de relleno, el decodificador se detiene.
+  for (size_t n = 1; n <= 17; ++n) {
+    uint8_t buffer[8];
+    CodificadorDelta codificador(buffer, sizeof(buffer), 1);
+    COMPROBAR(codificador.agregar(0));
+    for (size_t i = 1; i < n; ++i) COMPROBAR(codificador.agregar(0));
+    COMPROBAR_IGUAL(codificador.longitud(), (n + 7) / 8);
+
+    DecodificadorDelta decodificador(buffer, codificador.longitud(), 1);
+    int32_t valor;
+    size_t decodificadas = 0;
+    while (decodificador.siguiente(valor)) {
+      COMPROBAR_IGUAL(valor, 0);
+      decodificadas++;
+    }
+    COMPROBAR_IGUAL(decodificadas, n);
+  }
+
+  // Un escape completo sí cabe tras ceros: 1 + 32 bits
+  std::vector<int32_t> valores(7, 0);
+  valores.push_back(5);
+  COMPROBAR_IGUAL(idaYVuelta(valores, 1, 5), valores.size());
+}
+
+PRUEBA(datos_truncados_o_corruptos) {
+  uint8_t buffer[8];
+  CodificadorDelta codificador(buffer, sizeof(buffer));
+  COMPROBAR(codificador.agregar(100000)); // 3 bytes
+  DecodificadorDelta truncado(buffer, 2);
+  int32_t valor;
+  COMPROBAR(!truncado.siguiente(valor));
+
+  const uint8_t demasiados[6] = {0x80, 0x80, 0x80, 0x80, 0x80, 0x00};
+  DecodificadorDelta corrupto(demasiados, sizeof(demasiados));
+  COMPROBAR(!corrupto.siguiente(valor));
+}
+
+int main() { return pruebas::ejecutar(); }
@@ -0,0 +1,249 @@
+/**
+ * @file prueba_drivers.cpp
+ * @brief Prueba de humo de los tres drivers (a través de `RadioInterface`) sobre los falsos del host,
+ * y energía asíncrona del XBee con `on_sleep` movido por la prueba.
+ */
+
+#include "Prueba.h"
+#include "PuertoSerieFalso.h"
+
+#include <UniversalRadioWSN.h>
+
+#include <vector>
+
+namespace {
+
+LoRaConfig configLora(uint8_t pinCs, uint8_t pinIrq) {
+  LoRaConfig config;
+  config.frequency = 868E6;
+  config.spreadingFactor = 7;
+  config.signalBandwidth = 125E3;
+  config.codingRate = 5;
+  config.syncWord = 0x12;
+  config.txPower = 14;
+  config.csPin = pinCs;
+  config.resetPin = -1;
+  config.irqPin = pinIrq;
+  return config;
+}
+
+NrfConfig configNrf(uint8_t pinCe, uint8_t pinCsn, const byte* escritura, const byte* lectura) {
+  NrfConfig config;
+  config.cePin = pinCe;
+  config.csnPin = pinCsn;
+  config.writeAddress = escritura;
+  config.readAddress = lectura;
+  config.channel = 108;
+  config.dataRate = 1;
+  config.paLevel = 0;
+  return config;
+}
+
+const uint8_t PIN_SLEEP_RQ = 5;
+const uint8_t PIN_ON_SLEEP = 6;
+
+/// Estados recibidos por el callback de `habilitarEnergiaAsincrona()`.
+std::vector<EstadoEnergiaXBee> cambiosEnergia;
+
+void alCambiarEnergia(EstadoEnergiaXBee estado) { cambiosEnergia.push_back(estado); }
+
+/// Dispositivo que ocupa el CSN del NRF en el bus `SPI` y no responde (líneas en alto).
+class DispositivoMudo : public host::DispositivoSpi {
+public:
+  uint8_t transferir(uint8_t) override { return 0xFF; }
+};
+
+} // namespace
+
+PRUEBA(lora_envia_y_el_par_recibe) {
+  LoraRadio radio(configLora(10, 2));
+  COMPROBAR(radio.iniciar());
+
+  LoRaClass par;
+  par.setSyncWord(0x12);
+  par.begin(868E6);
+  par.receive();
+
+  const char texto[] = "hola";
+  COMPROBAR(radio.enviar(reinterpret_cast<const uint8_t*>(texto), 4));
+  COMPROBAR_IGUAL(par.parsePacket(), 4);
+  char recibido[5] = {0};
+  for (int i = 0; i < 4; ++i) recibido[i] = static_cast<char>(par.read());
+  COMPROBAR(strcmp(recibido, "hola") == 0);
+}
+
+PRUEBA(lora_recibe_por_sondeo) {
+  LoraRadio radio(configLora(10, 2));
+  COMPROBAR(radio.iniciar());
+
+  LoRaClass par;
+  par.setSyncWord(0x12);
+  par.begin(868E6);
+
+  COMPROBAR_IGUAL(radio.hayDatosDisponibles(), 0); // Arma RX_SINGLE
+  par.beginPacket();
+  par.print("abc");
+  par.endPacket();
+
+  COMPROBAR_IGUAL(radio.hayDatosDisponibles(), 3);
+  uint8_t buffer[8];
+  COMPROBAR_IGUAL(radio.leer(buffer, sizeof(buffer)), 3);
+  COMPROBAR(memcmp(buffer, "abc", 3) == 0);
+  COMPROBAR_IGUAL(radio.obtenerRSSI(), -40);
+}
+
+PRUEBA(nrf_envia_con_ack) {
+  const byte direccionA[6] = "NODOA";
+  const byte direccionB[6] = "NODOB";
+  NrfRadio a(configNrf(7, 8, direccionB, direccionA));
+  NrfRadio b(configNrf(17, 18, direccionA, direccionB));
+  COMPROBAR(a.iniciar());
+  COMPROBAR(b.iniciar());
+
+  const uint8_t datos[3] = {1, 2, 3};
+  COMPROBAR(a.enviar(datos, sizeof(datos)));
+  COMPROBAR_IGUAL(b.hayDatosDisponibles(), 3);
+  uint8_t buffer[32];
+  COMPROBAR_IGUAL(b.leer(buffer, sizeof(buffer)), 3);
+  COMPROBAR(memcmp(buffer, datos, 3) == 0);
+
+  // Sin nadie escuchando en la dirección: MAX_RT.
+  b.dormir();
+  COMPROBAR(!a.enviar(datos, sizeof(datos)));
+}
+
+PRUEBA(nrf_iniciar_falla_si_el_modulo_no_responde_en_spi) {
+  // Simula un NRF en otro bus: por `SPI` no se lee su registro CONFIG
+  DispositivoMudo mudo;
+  host::conectarSpi(8, &mudo);
+  const byte direccion[6] = "NODOA";
+  NrfNucleo radio(configNrf(7, 8, direccion, direccion));
+  COMPROBAR(!radio.iniciar());
+  host::desconectarSpi(&mudo);
+  COMPROBAR(radio.iniciar());
+}
+
+PRUEBA(nrf_despertar_no_bloquea) {
+  const byte direccionA[6] = "NODOA";
+  const byte direccionB[6] = "NODOB";
+  NrfRadio a(configNrf(7, 8, direccionB, direccionA));
+  NrfNucleo b(configNrf(17, 18, direccionA, direccionB));
+  COMPROBAR(a.iniciar());
+  COMPROBAR(b.iniciar());
+  b.dormir();
+
+  uint32_t powerUps = RF24::llamadasTotales().powerUp;
+  uint64_t inicio = host::ahoraMicros();
+  COMPROBAR(b.despertar());
+  COMPROBAR_IGUAL(host::ahoraMicros() - inicio, 0u);
+  COMPROBAR_IGUAL(RF24::llamadasTotales().powerUp, powerUps);
+  COMPROBAR(!b.listo());
+
+  // Al terminar el arranque vuelve a escuchar
+  delay(NRF_RADIO_ARRANQUE_US / 1000);
+  COMPROBAR(b.listo());
+  const uint8_t datos[3] = {4, 5, 6};
+  COMPROBAR(a.enviar(datos, sizeof(datos)));
+  COMPROBAR_IGUAL(b.hayDatosDisponibles(), 3);
+}
+
+PRUEBA(xbee_transparente_en_bucle) {
+  PuertoSerieFalso puertoA;
+  PuertoSerieFalso puertoB;
+  puertoA.conectar(puertoB);
+  XBeeRadio a(puertoA, 9600, -1, -1);
+  XBeeRadio b(puertoB, 9600, -1, -1);
+  COMPROBAR(a.iniciar());
+  COMPROBAR(b.iniciar());
+
+  COMPROBAR(a.enviar("hola xbee"));
+  COMPROBAR_IGUAL(b.hayDatosDisponibles(), 9);
+  String recibido = b.leerComoString();
+  COMPROBAR(recibido == "hola xbee");
+}
+
+PRUEBA(xbee_energia_asincrona_por_interrupcion) {
+  PuertoSerieFalso puerto;
+  XBeeRadio radio(puerto, 9600, PIN_SLEEP_RQ, PIN_ON_SLEEP);
+  host::fijarPin(PIN_ON_SLEEP, HIGH);
+  COMPROBAR(radio.iniciar());
+  cambiosEnergia.clear();
+  radio.habilitarEnergiaAsincrona(alCambiarEnergia);
+
+  // dormir() solo baja sleep_rq; el flanco de on_sleep termina la transición
+  COMPROBAR(radio.dormir());
+  COMPROBAR_IGUAL(digitalRead(PIN_SLEEP_RQ), LOW);
+  COMPROBAR_IGUAL(radio.estadoEnergia(), XBEE_DURMIENDO);
+  COMPROBAR(cambiosEnergia.empty());
+  host::fijarPin(PIN_ON_SLEEP, LOW);
+  COMPROBAR_IGUAL(cambiosEnergia.size(), 1u);
+  COMPROBAR_IGUAL(cambiosEnergia.back(), XBEE_DORMIDO);
+  COMPROBAR_IGUAL(radio.estadoEnergia(), XBEE_DORMIDO);
+
+  COMPROBAR(!radio.enviar("hola")); // Sin cola, se rechaza mientras no está despierto
+  COMPROBAR(radio.despertar());
+  COMPROBAR_IGUAL(digitalRead(PIN_SLEEP_RQ), HIGH);
+  COMPROBAR_IGUAL(radio.estadoEnergia(), XBEE_DESPERTANDO);
+  host::fijarPin(PIN_ON_SLEEP, HIGH);
+  COMPROBAR_IGUAL(cambiosEnergia.size(), 2u);
+  COMPROBAR_IGUAL(cambiosEnergia.back(), XBEE_DESPIERTO);
+  COMPROBAR(radio.enviar("hola"));
+}
+
+PRUEBA(xbee_energia_asincrona_por_sondeo_y_timeout) {
+  PuertoSerieFalso puerto;
+  XBeeRadio radio(puerto, 9600, PIN_SLEEP_RQ, PIN_ON_SLEEP);
+  host::fijarPin(PIN_ON_SLEEP, HIGH);
+  COMPROBAR(radio.iniciar());
+  cambiosEnergia.clear();
+  radio.habilitarEnergiaAsincrona(alCambiarEnergia, false);
+
+  // Sin interrupción, el cambio de on_sleep se detecta en procesarEnergia()
+  COMPROBAR(radio.dormir());
+  host::fijarPin(PIN_ON_SLEEP, LOW);
+  COMPROBAR(cambiosEnergia.empty());
+  radio.procesarEnergia();
+  COMPROBAR_IGUAL(cambiosEnergia.size(), 1u);
+  COMPROBAR_IGUAL(cambiosEnergia.back(), XBEE_DORMIDO);
+
+  // on_sleep no sube: al agotar TIMEOUT_ENERGIA_MS el estado es el que indica el pin
+  COMPROBAR(radio.despertar());
+  delay(XBeeNucleo::TIMEOUT_ENERGIA_MS - 1);
+  radio.procesarEnergia();
+  COMPROBAR_IGUAL(radio.estadoEnergia(), XBEE_DESPERTANDO);
+  COMPROBAR_IGUAL(cambiosEnergia.size(), 1u);
+  delay(1);
+  radio.procesarEnergia();
+  COMPROBAR_IGUAL(cambiosEnergia.size(), 2u);
+  COMPROBAR_IGUAL(cambiosEnergia.back(), XBEE_DORMIDO);
+  COMPROBAR_IGUAL(radio.estadoEnergia(), XBEE_DORMIDO);
+}
+
+PRUEBA(xbee_dormir_sin_estar_despierto_conserva_la_cola) {
+  PuertoSerieFalso puerto;
+  XBeeRadio radio(puerto, 9600, PIN_SLEEP_RQ, PIN_ON_SLEEP);
+  AnilloPaquetesEstatico<4, 32> cola;
+  host::fijarPin(PIN_ON_SLEEP, HIGH);
+  COMPROBAR(radio.iniciar());
+  radio.habilitarTransmisionAsincrona(cola);
+  radio.habilitarEnergiaAsincrona();
+
+  COMPROBAR(radio.dormir());
+  host::fijarPin(PIN_ON_SLEEP, LOW);
+  COMPROBAR(radio.enviar("uno"));
+  COMPROBAR_IGUAL(radio.transmisionesPendientes(), 1);
+
+  // Con el módulo dormido, dormir() no escribe la cola en el UART
+  COMPROBAR(radio.dormir());
+  COMPROBAR(puerto.salida().empty());
+  COMPROBAR_IGUAL(radio.transmisionesPendientes(), 1);
+
+  COMPROBAR(radio.despertar());
+  host::fijarPin(PIN_ON_SLEEP, HIGH);
+  radio.procesarEnergia();
+  COMPROBAR_IGUAL(radio.transmisionesPendientes(), 0);
+  const char esperado[] = "uno";
+  COMPROBAR(puerto.salida() == std::vector<uint8_t>(esperado, esperado + 3));
+}
+
+int main() { return pruebas::ejecutar(); }
@@ -0,0 +1,127 @@
+/**
+ * @file prueba_lora_asincrona.cpp
+ * @brief Transmisión LoRa asíncrona (`habilitarTransmisionAsincrona()`).
+ * @details Comprueba que la interrupción TX done queda en el pin DIO0 configurado aunque la
+ * cola se habilite antes de `iniciar()`, y mide el tiempo de CPU que `enviar()` devuelve
+ * a la aplicación frente al envío bloqueante (reloj virtual: solo cuenta el tiempo que
+ * el llamador pasa esperando a la radio).
+ */
+
+#include "Prueba.h"
+
+#include <UniversalRadioWSN.h>
+
+namespace {
+
+const uint8_t TAM_TRAMA = 20;
+
+LoRaConfig configuracion() {
+  LoRaConfig config;
+  config.frequency = 868E6;
+  config.spreadingFactor = 7;
+  config.signalBandwidth = 125E3;
+  config.codingRate = 5;
+  config.syncWord = 0x12;
+  config.txPower = 14;
+  config.csPin = 10;
+  config.resetPin = -1;
+  config.irqPin = 3; // Distinto del DIO0 por defecto de la librería (2)
+  return config;
+}
+
+uint16_t completadas = 0;
+uint16_t exitosas = 0;
+
+void alCompletar(uint16_t, bool exito) {
+  completadas++;
+  if (exito) exitosas++;
+}
+
+/**
+ * @brief Envía `numTramas` tramas y devuelve el tiempo total (µs) que el llamador estuvo dentro de `enviar()`.
+ */
+uint64_t tiempoBloqueadoUs(LoraRadio& radio, uint16_t numTramas) {
+  uint8_t trama[TAM_TRAMA];
+  memset(trama, 0x5A, sizeof(trama));
+  uint64_t bloqueado = 0;
+  for (uint16_t i = 0; i < numTramas; ++i) {
+    uint64_t antes = host::ahoraMicros();
+    COMPROBAR(radio.enviar(trama, sizeof(trama)));
+    bloqueado += host::ahoraMicros() - antes;
+  }
+  return bloqueado;
+}
+
+} // namespace
+
+PRUEBA(tx_done_en_el_pin_configurado_si_se_habilita_antes_de_iniciar) {
+  completadas = exitosas = 0;
+  AnilloPaquetesEstatico<4, 64> cola;
+  LoraRadio radio(configuracion());
+  radio.habilitarTransmisionAsincrona(cola, alCompletar); // Antes de setPins()
+  COMPROBAR(radio.iniciar());
+
+  LoRaClass par;
+  par.setSyncWord(0x12);
+  par.begin(868E6);
+  par.receive();
+
+  uint8_t trama[TAM_TRAMA] = {0};
+  for (int i = 0; i < 3; ++i) COMPROBAR(radio.enviar(trama, sizeof(trama)));
+  host::avanzarMicros(500000);
+
+  COMPROBAR_IGUAL(completadas, 3);
+  COMPROBAR_IGUAL(exitosas, 3);
+  COMPROBAR_IGUAL(radio.tramasCompletadas(), radio.ultimaTramaEncolada());
+  COMPROBAR_IGUAL(radio.transmisionesPendientes(), 0);
+  COMPROBAR_IGUAL(par.paquetesRecibidos(), 3);
+}
+
+PRUEBA(habilitar_despues_de_iniciar) {
+  completadas = exitosas = 0;
+  AnilloPaquetesEstatico<4, 64> cola;
+  LoraRadio radio(configuracion());
+  COMPROBAR(radio.iniciar());
+  radio.habilitarTransmisionAsincrona(cola, alCompletar);
+
+  uint8_t trama[TAM_TRAMA] = {0};
+  COMPROBAR(radio.enviar(trama, sizeof(trama)));
+  COMPROBAR(radio.enviar(trama, sizeof(trama)));
+  host::avanzarMicros(300000);
+  COMPROBAR_IGUAL(completadas, 2);
+}
+
+PRUEBA(tiempo_de_cpu_devuelto) {
+  const uint16_t NUM_TRAMAS = 3; // Caben en la cola: ninguna espera por cola llena
+  uint32_t aire = tiempoEnAireLoRaUs(configuracion(), TAM_TRAMA);
+
+  uint64_t bloqueante;
+  {
+    LoraRadio radio(configuracion());
+    COMPROBAR(radio.iniciar());
+    bloqueante = tiempoBloqueadoUs(radio, NUM_TRAMAS);
+  }
+  pruebas::reiniciarEntorno();
+
+  uint64_t asincrono;
+  completadas = exitosas = 0;
+  {
+    AnilloPaquetesEstatico<4, 64> cola;
+    LoraRadio radio(configuracion());
+    radio.habilitarTransmisionAsincrona(cola, alCompletar);
+    COMPROBAR(radio.iniciar());
+    asincrono = tiempoBloqueadoUs(radio, NUM_TRAMAS);
+    host::avanzarMicros(static_cast<uint64_t>(NUM_TRAMAS) * aire + 1000);
+    COMPROBAR_IGUAL(exitosas, NUM_TRAMAS);
+  }
+
+  printf("  tiempo en el aire por trama: %u us\n", static_cast<unsigned>(aire));
+  printf("  bloqueado en enviar(): bloqueante %llu us, asincrono %llu us (%u tramas)\n",
+         static_cast<unsigned long long>(bloqueante), static_cast<unsigned long long>(asincrono), NUM_TRAMAS);
+  printf("  tiempo de CPU devuelto: %llu us\n", static_cast<unsigned long long>(bloqueante - asincrono));
+
+  COMPROBAR(bloqueante >= static_cast<uint64_t>(NUM_TRAMAS) * aire);
+  COMPROBAR_IGUAL(asincrono, 0);
+}
+
+int main() { return pruebas::ejecutar(); }
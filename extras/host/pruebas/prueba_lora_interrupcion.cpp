@@ -0,0 +1,135 @@
+/**
+ * @file prueba_lora_interrupcion.cpp
+ * @brief Recepción LoRa por interrupción (`habilitarRecepcionPorInterrupcion()`) ante una ráfaga.
+ * @details Un módulo par transmite paquetes numerados uno tras otro, sin pausa, mientras el
+ * bucle principal solo atiende la radio cada 200 ms. Con el anillo, la interrupción DIO0
+ * vacía cada paquete de la FIFO antes de que llegue el siguiente: no se pierde ninguno.
+ */
+
+#include "Prueba.h"
+
+#include <UniversalRadioWSN.h>
+
+namespace {
+
+const uint8_t TAM_PAQUETE = 20;
+const uint32_t PERIODO_BUCLE_MS = 200;
+
+LoRaConfig configuracion() {
+  LoRaConfig config;
+  config.frequency = 868E6;
+  config.spreadingFactor = 7;
+  config.signalBandwidth = 125E3;
+  config.codingRate = 5;
+  config.syncWord = 0x12;
+  config.txPower = 14;
+  config.csPin = 10;
+  config.resetPin = -1;
+  config.irqPin = 3;
+  return config;
+}
+
+/**
+ * @brief Programa en `par` una ráfaga de `numPaquetes` paquetes seguidos (100 µs entre uno y otro).
+ * @return Instante en que termina el último.
+ */
+uint64_t programarRafaga(LoRaClass& par, uint16_t numPaquetes) {
+  uint32_t aire = tiempoEnAireLoRaUs(7, 125000, 5, TAM_PAQUETE) + 100;
+  uint64_t inicio = host::ahoraMicros() + 1000;
+  for (uint16_t i = 0; i < numPaquetes; ++i) {
+    host::programar(inicio + static_cast<uint64_t>(i) * aire, [&par, i]() {
+      uint8_t paquete[TAM_PAQUETE];
+      memset(paquete, 0xA5, sizeof(paquete));
+      paquete[0] = static_cast<uint8_t>(i);
+      paquete[1] = static_cast<uint8_t>(i >> 8);
+      par.beginPacket();
+      par.write(paquete, sizeof(paquete));
+      par.endPacket(true);
+    });
+  }
+  return inicio + static_cast<uint64_t>(numPaquetes) * aire;
+}
+
+struct Recepcion {
+  uint16_t recibidos;
+  bool enOrden;
+};
+
+/**
+ * @brief Bucle principal: atiende la radio cada `PERIODO_BUCLE_MS` hasta `fin`.
+ */
+Recepcion consumir(LoraRadio& radio, uint64_t fin) {
+  Recepcion r = {0, true};
+  while (host::ahoraMicros() < fin + 2 * PERIODO_BUCLE_MS * 1000ULL) {
+    while (radio.hayDatosDisponibles() > 0) {
+      uint8_t buffer[255];
+      size_t longitud = radio.leer(buffer, sizeof(buffer));
+      uint16_t secuencia = static_cast<uint16_t>(buffer[0] | (buffer[1] << 8));
+      if (longitud != TAM_PAQUETE || secuencia != r.recibidos) r.enOrden = false;
+      r.recibidos++;
+    }
+    delay(PERIODO_BUCLE_MS);
+  }
+  return r;
+}
+
+LoRaClass* nuevoPar() {
+  LoRaClass* par = new LoRaClass();
+  par->setSyncWord(0x12);
+  par->begin(868E6);
+  return par;
+}
+
+} // namespace
+
+PRUEBA(rafaga_sin_perdidas_con_anillo) {
+  const uint16_t NUM_PAQUETES = 200;
+  AnilloPaquetesEstatico<8, 64> anillo;
+  LoraRadio radio(configuracion());
+  radio.habilitarRecepcionPorInterrupcion(anillo);
+  COMPROBAR(radio.iniciar());
+
+  LoRaClass* par = nuevoPar();
+  Recepcion r = consumir(radio, programarRafaga(*par, NUM_PAQUETES));
+
+  COMPROBAR_IGUAL(r.recibidos, NUM_PAQUETES);
+  COMPROBAR(r.enOrden);
+  COMPROBAR_IGUAL(radio.paquetesDescartados(), 0);
+  COMPROBAR_IGUAL(LoRa.paquetesSobrescritos(), 0);
+  COMPROBAR_IGUAL(radio.obtenerEstadisticas().tramasRecibidas, NUM_PAQUETES);
+  COMPROBAR_IGUAL(radio.obtenerEstadisticas().desbordamientosRx, 0);
+  delete par;
+}
+
+PRUEBA(anillo_lleno_cuenta_los_descartes) {
+  const uint16_t NUM_PAQUETES = 20;
+  AnilloPaquetesEstatico<4, 64> anillo; // 3 ranuras útiles
+  LoraRadio radio(configuracion());
+  radio.habilitarRecepcionPorInterrupcion(anillo); // Antes de iniciar(): se arma en iniciar()
+  COMPROBAR(radio.iniciar());
+
+  LoRaClass* par = nuevoPar();
+  host::avanzarMicros(programarRafaga(*par, NUM_PAQUETES) + 1000 - host::ahoraMicros());
+
+  COMPROBAR_IGUAL(anillo.pendientes(), 3);
+  COMPROBAR_IGUAL(radio.paquetesDescartados(), NUM_PAQUETES - 3);
+  COMPROBAR_IGUAL(radio.obtenerEstadisticas().desbordamientosRx, NUM_PAQUETES - 3);
+  COMPROBAR_IGUAL(LoRa.paquetesSobrescritos(), 0); // Ni uno se quedó en la FIFO
+  delete par;
+}
+
+PRUEBA(sondeo_pierde_la_rafaga) {
+  // Referencia: el mismo bucle por sondeo solo ve el último paquete de cada periodo.
+  const uint16_t NUM_PAQUETES = 200;
+  LoraRadio radio(configuracion());
+  COMPROBAR(radio.iniciar());
+
+  LoRaClass* par = nuevoPar();
+  radio.hayDatosDisponibles(); // Arma RX_SINGLE
+  Recepcion r = consumir(radio, programarRafaga(*par, NUM_PAQUETES));
+
+  COMPROBAR(r.recibidos < NUM_PAQUETES / 2);
+  delete par;
+}
+
+int main() { return pruebas::ejecutar(); }
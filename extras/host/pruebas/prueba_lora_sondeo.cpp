@@ -0,0 +1,118 @@
+/**
+ * @file prueba_lora_sondeo.cpp
+ * @brief Recepción LoRa por sondeo: `hayDatosDisponibles()` seguido de `tomarPaquete()`.
+ * @details `parsePacket()` limpia las banderas IRQ y rearma la recepción, así que debe
+ * llamarse una sola vez por paquete: la longitud queda pendiente en `LoraNucleo` hasta
+ * que el paquete se lee. Sin eso, el bucle de los decoradores (`hayDatosDisponibles()` y
+ * luego `tomarPaquete()`) perdía todos los paquetes.
+ */
+
+#include "Prueba.h"
+
+#include <UniversalRadioWSN.h>
+
+namespace {
+
+LoRaConfig configuracion() {
+  LoRaConfig config;
+  config.frequency = 868E6;
+  config.spreadingFactor = 7;
+  config.signalBandwidth = 125E3;
+  config.codingRate = 5;
+  config.syncWord = 0x12;
+  config.txPower = 14;
+  config.csPin = 10;
+  config.resetPin = -1;
+  config.irqPin = 2;
+  return config;
+}
+
+void transmitir(LoRaClass& par, const uint8_t* datos, size_t longitud) {
+  par.beginPacket();
+  par.write(datos, longitud);
+  par.endPacket();
+}
+
+} // namespace
+
+PRUEBA(tomar_paquete_tras_hay_datos_no_vuelve_a_parsear) {
+  LoraRadio radio(configuracion());
+  COMPROBAR(radio.iniciar());
+  LoRaClass par;
+  par.setSyncWord(0x12);
+  par.begin(868E6);
+
+  COMPROBAR_IGUAL(radio.hayDatosDisponibles(), 0); // Arma RX_SINGLE
+  const uint8_t datos[5] = {1, 2, 3, 4, 5};
+  transmitir(par, datos, sizeof(datos));
+
+  uint32_t antes = LoRa.llamadas().parsePacket;
+  COMPROBAR_IGUAL(radio.hayDatosDisponibles(), 5);
+  COMPROBAR_IGUAL(radio.hayDatosDisponibles(), 5); // Repetir la consulta no pierde el paquete
+  VistaPaquete vista;
+  COMPROBAR(radio.tomarPaquete(vista));
+  COMPROBAR_IGUAL(vista.longitud, 5u);
+  COMPROBAR(memcmp(vista.datos, datos, sizeof(datos)) == 0);
+  radio.liberarPaquete();
+  COMPROBAR_IGUAL(LoRa.llamadas().parsePacket - antes, 1u);
+  COMPROBAR_IGUAL(radio.obtenerEstadisticas().tramasRecibidas, 1u);
+}
+
+PRUEBA(leer_sin_hay_datos_previo_parsea_una_vez) {
+  LoraRadio radio(configuracion());
+  COMPROBAR(radio.iniciar());
+  LoRaClass par;
+  par.setSyncWord(0x12);
+  par.begin(868E6);
+
+  uint8_t buffer[8];
+  COMPROBAR_IGUAL(radio.leer(buffer, sizeof(buffer)), 0u); // Arma RX_SINGLE
+  const uint8_t datos[3] = {7, 8, 9};
+  transmitir(par, datos, sizeof(datos));
+  COMPROBAR_IGUAL(radio.leer(buffer, sizeof(buffer)), 3u);
+  COMPROBAR(memcmp(buffer, datos, sizeof(datos)) == 0);
+  COMPROBAR_IGUAL(radio.hayDatosDisponibles(), 0);
+}
+
+PRUEBA(enviar_con_paquete_sin_leer_se_rechaza) {
+  LoraRadio radio(configuracion());
+  COMPROBAR(radio.iniciar());
+  LoRaClass par;
+  par.setSyncWord(0x12);
+  par.begin(868E6);
+
+  COMPROBAR_IGUAL(radio.hayDatosDisponibles(), 0);
+  const uint8_t datos[4] = {0xAA, 0xBB, 0xCC, 0xDD};
+  transmitir(par, datos, sizeof(datos));
+  COMPROBAR_IGUAL(radio.hayDatosDisponibles(), 4);
+
+  // TX y RX comparten la FIFO: transmitir ahora sobrescribiría el paquete sin leer
+  COMPROBAR(!radio.enviar(datos, sizeof(datos)));
+  COMPROBAR_IGUAL(radio.obtenerEstadisticas().rechazosOcupada, 1u);
+
+  uint8_t buffer[8];
+  COMPROBAR_IGUAL(radio.leer(buffer, sizeof(buffer)), 4u);
+  COMPROBAR(memcmp(buffer, datos, sizeof(datos)) == 0);
+  COMPROBAR(radio.enviar(datos, sizeof(datos)));
+}
+
+PRUEBA(decorador_recibe_en_modo_sondeo) {
+  LoraRadio radio(configuracion());
+  RadioFragmentadaEstatica<2, 512> fragmentada(radio);
+  COMPROBAR(fragmentada.iniciar());
+  LoRaClass par;
+  par.setSyncWord(0x12);
+  par.begin(868E6);
+
+  COMPROBAR_IGUAL(fragmentada.hayDatosDisponibles(), 0);
+  const uint8_t fragmento[6] = {42, 0x80 /* último, índice 0 */, 'h', 'o', 'l', 'a'};
+  transmitir(par, fragmento, sizeof(fragmento));
+
+  COMPROBAR_IGUAL(fragmentada.hayDatosDisponibles(), 4);
+  uint8_t buffer[16];
+  COMPROBAR_IGUAL(fragmentada.leer(buffer, sizeof(buffer)), 4u);
+  COMPROBAR(memcmp(buffer, "hola", 4) == 0);
+  COMPROBAR_IGUAL(fragmentada.estadisticas().mensajesRecibidos, 1u);
+}
+
+int main() { return pruebas::ejecutar(); }
@@ -0,0 +1,206 @@
+/**
+ * @file prueba_nrf_concentrador.cpp
+ * @brief `NrfNucleo` en modo concentrador: recepción por los seis pipes con el pipe de origen,
+ * rechazo de direcciones base no válidas y respuestas de bajada en el payload del ACK.
+ */
+
+#include "Prueba.h"
+
+#include <UniversalRadioWSN.h>
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+const byte BASE_HUB[NrfNucleo::TAM_DIRECCION] = {0xA0, 'H', 'U', 'B', '1'};
+const byte DIRECCION_HUB[6] = "GWTX0";
+
+NrfConfig configNrf(uint8_t pinCe, uint8_t pinCsn, const byte* escritura, const byte* lectura) {
+  NrfConfig config;
+  config.cePin = pinCe;
+  config.csnPin = pinCsn;
+  config.writeAddress = escritura;
+  config.readAddress = lectura;
+  config.channel = 108;
+  config.dataRate = 1;
+  config.paLevel = 0;
+  return config;
+}
+
+/// Seis nodos sensores, el nodo `i` con `writeAddress` en el pipe `i` del concentrador.
+struct Nodos {
+  byte direcciones[NrfNucleo::NUM_TUBOS][NrfNucleo::TAM_DIRECCION];
+  byte lecturas[NrfNucleo::NUM_TUBOS][NrfNucleo::TAM_DIRECCION];
+  std::vector<std::unique_ptr<NrfNucleo> > radios;
+
+  explicit Nodos(const byte* base) {
+    for (uint8_t i = 0; i < NrfNucleo::NUM_TUBOS; ++i) {
+      NrfNucleo::direccionTubo(base, i, direcciones[i]);
+      memcpy(lecturas[i], "NODO0", NrfNucleo::TAM_DIRECCION);
+      lecturas[i][4] = (byte)('0' + i);
+      radios.emplace_back(new NrfNucleo(configNrf(20 + i, 30 + i, direcciones[i], lecturas[i])));
+    }
+  }
+};
+
+} // namespace
+
+PRUEBA(direccion_tubo_incrementa_el_primer_byte) {
+  byte direccion[NrfNucleo::TAM_DIRECCION];
+  NrfNucleo::direccionTubo(BASE_HUB, 5, direccion);
+  COMPROBAR_IGUAL(direccion[0], 0xA5);
+  COMPROBAR(memcmp(direccion + 1, BASE_HUB + 1, NrfNucleo::TAM_DIRECCION - 1) == 0);
+}
+
+PRUEBA(bases_que_dan_la_vuelta_o_empiezan_en_cero_se_rechazan) {
+  byte base[NrfNucleo::TAM_DIRECCION] = {0x00, 'H', 'U', 'B', '1'};
+  NrfNucleo hub(configNrf(7, 8, DIRECCION_HUB, DIRECCION_HUB));
+  COMPROBAR(!NrfNucleo::direccionBaseValida(base));
+  COMPROBAR(!hub.habilitarConcentrador(base));
+  base[0] = 0xFB;
+  COMPROBAR(!NrfNucleo::direccionBaseValida(base));
+  COMPROBAR(!hub.habilitarConcentrador(base));
+  base[0] = 0xFA;
+  COMPROBAR(NrfNucleo::direccionBaseValida(base));
+  base[0] = 0x01;
+  COMPROBAR(NrfNucleo::direccionBaseValida(base));
+  COMPROBAR(hub.habilitarConcentrador(base));
+}
+
+PRUEBA(concentrador_recibe_por_los_seis_pipes) {
+  NrfNucleo hub(configNrf(7, 8, DIRECCION_HUB, DIRECCION_HUB));
+  COMPROBAR(hub.habilitarConcentrador(BASE_HUB));
+  COMPROBAR(hub.iniciar());
+  Nodos nodos(BASE_HUB);
+  for (uint8_t i = 0; i < NrfNucleo::NUM_TUBOS; ++i) COMPROBAR(nodos.radios[i]->iniciar());
+
+  // En orden inverso, para que el pipe no coincida por casualidad con el orden de llegada
+  for (int i = NrfNucleo::NUM_TUBOS - 1; i >= 0; --i) {
+    uint8_t dato = (uint8_t)(0x40 + i);
+    COMPROBAR(nodos.radios[i]->enviar(&dato, 1));
+    uint8_t buffer[NrfNucleo::TAM_MAX_PAYLOAD];
+    COMPROBAR_IGUAL(hub.hayDatosDisponibles(), 1);
+    COMPROBAR_IGUAL(hub.leer(buffer, sizeof(buffer)), 1u);
+    COMPROBAR_IGUAL(buffer[0], dato);
+    COMPROBAR_IGUAL(hub.ultimoTubo(), (uint8_t)i);
+  }
+  COMPROBAR_IGUAL(hub.hayDatosDisponibles(), 0);
+}
+
+PRUEBA(varios_paquetes_en_la_fifo_conservan_su_pipe) {
+  NrfNucleo hub(configNrf(7, 8, DIRECCION_HUB, DIRECCION_HUB));
+  COMPROBAR(hub.iniciar());
+  COMPROBAR(hub.habilitarConcentrador(BASE_HUB)); // Después de iniciar()
+  Nodos nodos(BASE_HUB);
+  const uint8_t orden[3] = {4, 0, 2};
+  for (int k = 0; k < 3; ++k) {
+    COMPROBAR(nodos.radios[orden[k]]->iniciar());
+    uint8_t dato = orden[k];
+    COMPROBAR(nodos.radios[orden[k]]->enviar(&dato, 1));
+  }
+
+  VistaPaquete vista;
+  for (int k = 0; k < 3; ++k) {
+    COMPROBAR(hub.tomarPaquete(vista));
+    COMPROBAR_IGUAL(vista.datos[0], orden[k]);
+    COMPROBAR_IGUAL(hub.ultimoTubo(), orden[k]);
+    hub.liberarPaquete();
+  }
+}
+
+PRUEBA(el_pipe_0_sigue_recibiendo_despues_de_enviar) {
+  Nodos nodos(BASE_HUB);
+  // El hub responde al nodo 0: `enviar()` ocupa el pipe 0 con la dirección de escritura
+  NrfNucleo hub(configNrf(7, 8, nodos.lecturas[0], DIRECCION_HUB));
+  COMPROBAR(hub.habilitarConcentrador(BASE_HUB));
+  COMPROBAR(hub.iniciar());
+  COMPROBAR(nodos.radios[0]->iniciar());
+
+  uint8_t orden = 0x11;
+  COMPROBAR(hub.enviar(&orden, 1));
+  uint8_t buffer[NrfNucleo::TAM_MAX_PAYLOAD];
+  COMPROBAR_IGUAL(nodos.radios[0]->hayDatosDisponibles(), 1);
+  COMPROBAR_IGUAL(nodos.radios[0]->leer(buffer, sizeof(buffer)), 1u);
+  COMPROBAR_IGUAL(buffer[0], orden);
+
+  // Al volver a escuchar, el pipe 0 recupera la dirección del concentrador
+  uint8_t dato = 0x22;
+  COMPROBAR(nodos.radios[0]->enviar(&dato, 1));
+  COMPROBAR_IGUAL(hub.hayDatosDisponibles(), 1);
+  COMPROBAR_IGUAL(hub.leer(buffer, sizeof(buffer)), 1u);
+  COMPROBAR_IGUAL(buffer[0], dato);
+  COMPROBAR_IGUAL(hub.ultimoTubo(), 0);
+}
+
+PRUEBA(respuesta_precargada_llega_al_nodo_en_el_ack) {
+  NrfNucleo hub(configNrf(7, 8, DIRECCION_HUB, DIRECCION_HUB));
+  COMPROBAR(hub.habilitarConcentrador(BASE_HUB));
+  hub.habilitarPayloadsEnAck();
+  COMPROBAR(hub.iniciar());
+  Nodos nodos(BASE_HUB);
+  for (uint8_t i = 0; i < NrfNucleo::NUM_TUBOS; ++i) {
+    nodos.radios[i]->habilitarPayloadsEnAck();
+    COMPROBAR(nodos.radios[i]->iniciar());
+  }
+
+  const uint8_t respuesta[3] = {'o', 'k', 3};
+  COMPROBAR(hub.precargarRespuesta(3, respuesta, sizeof(respuesta)));
+
+  // Otro pipe no consume la respuesta
+  uint8_t buffer[NrfNucleo::TAM_MAX_PAYLOAD];
+  uint8_t dato = 0x51;
+  COMPROBAR(nodos.radios[1]->enviar(&dato, 1));
+  COMPROBAR_IGUAL(nodos.radios[1]->hayDatosDisponibles(), 0);
+  COMPROBAR_IGUAL(hub.hayDatosDisponibles(), 1);
+  COMPROBAR_IGUAL(hub.leer(buffer, sizeof(buffer)), 1u);
+  COMPROBAR_IGUAL(hub.ultimoTubo(), 1);
+
+  // Subida por el pipe 3 y bajada en su ACK
+  dato = 0x53;
+  COMPROBAR(nodos.radios[3]->enviar(&dato, 1));
+  COMPROBAR_IGUAL(hub.hayDatosDisponibles(), 1);
+  COMPROBAR_IGUAL(hub.leer(buffer, sizeof(buffer)), 1u);
+  COMPROBAR_IGUAL(buffer[0], dato);
+  COMPROBAR_IGUAL(hub.ultimoTubo(), 3);
+
+  COMPROBAR_IGUAL(nodos.radios[3]->hayDatosDisponibles(), (int)sizeof(respuesta));
+  COMPROBAR_IGUAL(nodos.radios[3]->leer(buffer, sizeof(buffer)), sizeof(respuesta));
+  COMPROBAR(memcmp(buffer, respuesta, sizeof(respuesta)) == 0);
+  COMPROBAR_IGUAL(nodos.radios[3]->ultimoTubo(), 0);
+
+  // Consumida: el siguiente envío del nodo 3 llega con un ACK vacío
+  COMPROBAR(nodos.radios[3]->enviar(&dato, 1));
+  COMPROBAR_IGUAL(nodos.radios[3]->hayDatosDisponibles(), 0);
+}
+
+PRUEBA(precargar_con_la_fifo_de_transmision_llena_se_rechaza) {
+  NrfNucleo hub(configNrf(7, 8, DIRECCION_HUB, DIRECCION_HUB));
+  COMPROBAR(hub.habilitarConcentrador(BASE_HUB));
+  COMPROBAR(hub.iniciar());
+  const uint8_t respuesta[2] = {1, 2};
+  COMPROBAR(!hub.precargarRespuesta(0, respuesta, sizeof(respuesta))); // Sin habilitarPayloadsEnAck()
+
+  hub.habilitarPayloadsEnAck(); // Después de iniciar()
+  uint8_t grande[NrfNucleo::TAM_MAX_PAYLOAD + 1] = {0};
+  COMPROBAR(!hub.precargarRespuesta(0, grande, sizeof(grande)));
+  COMPROBAR(!hub.precargarRespuesta(NrfNucleo::NUM_TUBOS, respuesta, sizeof(respuesta)));
+
+  // La FIFO de tres niveles es compartida por todos los pipes
+  for (uint8_t tubo = 0; tubo < NrfNucleo::NIVELES_FIFO_TX; ++tubo) {
+    COMPROBAR(hub.precargarRespuesta(tubo, respuesta, sizeof(respuesta)));
+  }
+  COMPROBAR(!hub.precargarRespuesta(4, respuesta, sizeof(respuesta)));
+
+  // Un paquete por el pipe 1 consume su respuesta y libera un nivel
+  Nodos nodos(BASE_HUB);
+  nodos.radios[1]->habilitarPayloadsEnAck();
+  COMPROBAR(nodos.radios[1]->iniciar());
+  uint8_t dato = 9;
+  COMPROBAR(nodos.radios[1]->enviar(&dato, 1));
+  COMPROBAR_IGUAL(nodos.radios[1]->hayDatosDisponibles(), (int)sizeof(respuesta));
+  COMPROBAR(hub.precargarRespuesta(4, respuesta, sizeof(respuesta)));
+  COMPROBAR(!hub.precargarRespuesta(5, respuesta, sizeof(respuesta)));
+}
+
+int main() { return pruebas::ejecutar(); }
@@ -0,0 +1,173 @@
+/**
+ * @file prueba_radio_agregada.cpp
+ * @brief `RadioAgregada`: empaquetado hasta el MTU, vaciado por llenado, por plazo, con
+ * `vaciar()` y al dormir, y separación de las tramas recibidas (con prefijos incoherentes).
+ */
+
+#include "EnlaceMemoria.h"
+#include "Prueba.h"
+
+#include <UniversalRadioWSN.h>
+
+#include <vector>
+
+namespace {
+
+const size_t MTU = 32;
+
+std::vector<uint8_t> mensaje(size_t longitud, uint8_t semilla) {
+  std::vector<uint8_t> datos(longitud);
+  for (size_t i = 0; i < longitud; ++i) datos[i] = (uint8_t)(semilla + i);
+  return datos;
+}
+
+/// Lee el siguiente mensaje, o un vector vacío si no hay.
+std::vector<uint8_t> recibir(RadioInterface& radio) {
+  uint8_t buffer[255];
+  int disponible = radio.hayDatosDisponibles();
+  if (disponible <= 0) return std::vector<uint8_t>();
+  size_t leidos = radio.leer(buffer, sizeof(buffer));
+  if (leidos != (size_t)disponible) return std::vector<uint8_t>();
+  return std::vector<uint8_t>(buffer, buffer + leidos);
+}
+
+} // namespace
+
+PRUEBA(empaqueta_hasta_el_mtu_y_vacia_si_el_siguiente_no_cabe) {
+  EnlaceMemoria a(MTU);
+  RadioAgregada radio(a);
+  COMPROBAR_IGUAL(radio.obtenerMTU(), MTU - RadioAgregada::TAM_PREFIJO);
+
+  // Cinco mensajes de 5 bytes ocupan 30 de 32: el sexto ya no cabe
+  for (uint8_t i = 0; i < 5; ++i) {
+    std::vector<uint8_t> datos = mensaje(5, (uint8_t)(10 * i));
+    COMPROBAR(radio.enviar(datos.data(), datos.size()));
+  }
+  COMPROBAR(a.enviados().empty());
+  COMPROBAR_IGUAL(radio.mensajesPendientes(), 5);
+
+  std::vector<uint8_t> sexto = mensaje(5, 50);
+  COMPROBAR(radio.enviar(sexto.data(), sexto.size()));
+  COMPROBAR_IGUAL(a.enviados().size(), 1u);
+  COMPROBAR_IGUAL(a.enviados()[0].size(), 30u);
+  COMPROBAR_IGUAL(a.enviados()[0][0], 5);
+  COMPROBAR_IGUAL(a.enviados()[0][6], 5);
+  COMPROBAR_IGUAL(a.enviados()[0][7], 10);
+  COMPROBAR_IGUAL(radio.mensajesPendientes(), 1);
+  COMPROBAR_IGUAL(radio.estadisticas().vaciadosPorLlenado, 1u);
+
+  // Un mensaje del MTU completo llena una trama él solo
+  std::vector<uint8_t> grande = mensaje(radio.obtenerMTU(), 1);
+  COMPROBAR(radio.enviar(grande.data(), grande.size()));
+  COMPROBAR_IGUAL(a.enviados().size(), 2u);
+  COMPROBAR_IGUAL(a.enviados()[1].size(), 6u);
+  COMPROBAR(radio.enviar(sexto.data(), 1));
+  COMPROBAR_IGUAL(a.enviados().size(), 3u);
+  COMPROBAR_IGUAL(a.enviados()[2].size(), MTU);
+  COMPROBAR_IGUAL(radio.estadisticas().vaciadosPorLlenado, 3u);
+
+  std::vector<uint8_t> demasiado = mensaje(MTU, 2);
+  COMPROBAR(!radio.enviar(demasiado.data(), demasiado.size()));
+  COMPROBAR(!radio.enviar(demasiado.data(), 0));
+  COMPROBAR_IGUAL(radio.estadisticas().mensajesEnviados, 7u);
+  COMPROBAR_IGUAL(radio.mensajesPorTramaX100(), 233);
+}
+
+PRUEBA(vacia_al_vencer_el_plazo) {
+  EnlaceMemoria a(MTU), b(MTU);
+  a.conectar(b);
+  RadioAgregada radio(a);
+  radio.fijarPlazo(50);
+
+  COMPROBAR(radio.enviar("uno"));
+  delay(30);
+  COMPROBAR(radio.enviar("dos")); // El plazo cuenta desde el primer mensaje
+  delay(19);
+  radio.procesar();
+  COMPROBAR(a.enviados().empty());
+  delay(1);
+  radio.procesar();
+  COMPROBAR_IGUAL(a.enviados().size(), 1u);
+  COMPROBAR_IGUAL(radio.mensajesPendientes(), 0);
+  COMPROBAR_IGUAL(radio.estadisticas().vaciadosPorPlazo, 1u);
+
+  // hayDatosDisponibles() también atiende el plazo
+  COMPROBAR(radio.enviar("tres"));
+  delay(50);
+  COMPROBAR_IGUAL(radio.hayDatosDisponibles(), 0);
+  COMPROBAR_IGUAL(a.enviados().size(), 2u);
+  COMPROBAR_IGUAL(radio.estadisticas().vaciadosPorPlazo, 2u);
+}
+
+PRUEBA(vaciar_y_dormir_envian_la_trama_en_curso) {
+  EnlaceMemoria a(MTU);
+  RadioAgregada radio(a);
+
+  COMPROBAR(radio.vaciar()); // Nada que enviar
+  COMPROBAR(a.enviados().empty());
+
+  COMPROBAR(radio.enviar("ab"));
+  COMPROBAR(radio.enviar("cde"));
+  COMPROBAR(radio.vaciar());
+  COMPROBAR_IGUAL(a.enviados().size(), 1u);
+  const uint8_t esperada[7] = {2, 'a', 'b', 3, 'c', 'd', 'e'};
+  COMPROBAR(a.enviados()[0] == EnlaceMemoria::Paquete(esperada, esperada + sizeof(esperada)));
+  COMPROBAR(radio.vaciar());
+  COMPROBAR_IGUAL(a.enviados().size(), 1u);
+
+  COMPROBAR(radio.enviar("f"));
+  COMPROBAR(radio.dormir());
+  COMPROBAR_IGUAL(a.enviados().size(), 2u);
+  COMPROBAR_IGUAL(a.dormidas(), 1u);
+  COMPROBAR_IGUAL(radio.estadisticas().tramasEnviadas, 2u);
+  COMPROBAR_IGUAL(radio.estadisticas().bytesMensajes, 6u);
+  COMPROBAR_IGUAL(radio.estadisticas().bytesTramas, 9u);
+  COMPROBAR_IGUAL(radio.eficienciaPorMil(), 666);
+}
+
+PRUEBA(separa_la_trama_recibida_en_mensajes) {
+  EnlaceMemoria a(MTU), b(MTU);
+  a.conectar(b);
+  RadioAgregada emisor(a), receptor(b);
+
+  std::vector<uint8_t> mensajes[3] = {mensaje(4, 1), mensaje(1, 2), mensaje(9, 3)};
+  for (int i = 0; i < 3; ++i) COMPROBAR(emisor.enviar(mensajes[i].data(), mensajes[i].size()));
+  COMPROBAR(emisor.vaciar());
+
+  COMPROBAR(recibir(receptor) == mensajes[0]);
+  VistaPaquete vista;
+  COMPROBAR(receptor.tomarPaquete(vista));
+  COMPROBAR(std::vector<uint8_t>(vista.datos, vista.datos + vista.longitud) == mensajes[1]);
+  COMPROBAR(receptor.tomarPaquete(vista)); // Sin liberar, la misma vista
+  COMPROBAR_IGUAL(vista.longitud, 1u);
+  receptor.liberarPaquete();
+  COMPROBAR(recibir(receptor) == mensajes[2]);
+  COMPROBAR(recibir(receptor).empty());
+  COMPROBAR_IGUAL(receptor.estadisticas().tramasRecibidas, 1u);
+  COMPROBAR_IGUAL(receptor.estadisticas().mensajesRecibidos, 3u);
+}
+
+PRUEBA(prefijo_incoherente_descarta_el_resto_de_la_trama) {
+  EnlaceMemoria b(MTU);
+  RadioAgregada receptor(b);
+
+  // Primer mensaje correcto; el segundo dice tener 9 bytes y solo quedan 2
+  const uint8_t cortada[7] = {3, 'a', 'b', 'c', 9, 'x', 'y'};
+  // Prefijo 0 al principio: la trama entera es inválida
+  const uint8_t vacia[3] = {0, 'z', 'z'};
+  const uint8_t valida[3] = {2, 'o', 'k'};
+  b.entrada().push_back(EnlaceMemoria::Paquete(cortada, cortada + sizeof(cortada)));
+  b.entrada().push_back(EnlaceMemoria::Paquete(vacia, vacia + sizeof(vacia)));
+  b.entrada().push_back(EnlaceMemoria::Paquete(valida, valida + sizeof(valida)));
+
+  const uint8_t abc[3] = {'a', 'b', 'c'};
+  const uint8_t ok[2] = {'o', 'k'};
+  COMPROBAR(recibir(receptor) == std::vector<uint8_t>(abc, abc + 3));
+  COMPROBAR(recibir(receptor) == std::vector<uint8_t>(ok, ok + 2));
+  COMPROBAR(recibir(receptor).empty());
+  COMPROBAR_IGUAL(receptor.estadisticas().tramasRecibidas, 3u);
+  COMPROBAR_IGUAL(receptor.estadisticas().tramasInvalidas, 2u);
+  COMPROBAR_IGUAL(receptor.estadisticas().mensajesRecibidos, 2u);
+}
+
+int main() { return pruebas::ejecutar(); }
@@ -0,0 +1,126 @@
+/**
+ * @file prueba_radio_fec.cpp
+ * @brief `RadioFEC`: recuperación de ráfagas de errores con entrelazado, paquetes
+ * irrecuperables, límite de MTU y recorte de la paridad del constructor.
+ */
+
+#include "EnlaceMemoria.h"
+#include "Prueba.h"
+
+#include <UniversalRadioWSN.h>
+
+#include <vector>
+
+namespace {
+
+std::vector<uint8_t> mensaje(size_t longitud, uint8_t semilla) {
+  std::vector<uint8_t> datos(longitud);
+  for (size_t i = 0; i < longitud; ++i) datos[i] = (uint8_t)(semilla + i * 31 + (i >> 3));
+  return datos;
+}
+
+/// Lee el siguiente mensaje, o un vector vacío si no hay.
+std::vector<uint8_t> recibir(RadioInterface& radio) {
+  uint8_t buffer[255];
+  int disponible = radio.hayDatosDisponibles();
+  if (disponible <= 0) return std::vector<uint8_t>();
+  size_t leidos = radio.leer(buffer, sizeof(buffer));
+  if (leidos != (size_t)disponible) return std::vector<uint8_t>();
+  return std::vector<uint8_t>(buffer, buffer + leidos);
+}
+
+/// Daña `longitud` bytes consecutivos desde `inicio` (ningún byte queda igual).
+void danar(EnlaceMemoria::Paquete& paquete, size_t inicio, size_t longitud) {
+  for (size_t i = inicio; i < inicio + longitud && i < paquete.size(); ++i) paquete[i] ^= (uint8_t)(0x5A + i);
+}
+
+} // namespace
+
+PRUEBA(recupera_cualquier_rafaga_de_profundidad_por_paridad_medios) {
+  const uint8_t PARIDAD = 8, PROFUNDIDAD = 4;
+  const size_t RAFAGA = PROFUNDIDAD * PARIDAD / 2;
+  EnlaceMemoria a, b;
+  a.conectar(b);
+  RadioFEC emisor(a, PARIDAD, PROFUNDIDAD), receptor(b, PARIDAD, PROFUNDIDAD);
+  COMPROBAR_IGUAL(emisor.sobrecarga(), (size_t)PROFUNDIDAD * PARIDAD);
+
+  std::vector<uint8_t> datos = mensaje(101, 3);
+  COMPROBAR(emisor.enviar(datos.data(), datos.size()));
+  EnlaceMemoria::Paquete original = b.entrada().front();
+  b.entrada().clear();
+  COMPROBAR_IGUAL(original.size(), datos.size() + emisor.sobrecarga());
+
+  // La ráfaga en cualquier posición, también sobre la paridad
+  for (size_t inicio = 0; inicio + RAFAGA <= original.size(); ++inicio) {
+    EnlaceMemoria::Paquete danado = original;
+    danar(danado, inicio, RAFAGA);
+    b.entrada().push_back(danado);
+    COMPROBAR(recibir(receptor) == datos);
+  }
+  size_t posiciones = original.size() - RAFAGA + 1;
+  COMPROBAR_IGUAL(receptor.estadisticas().paquetesCorregidos, posiciones);
+  COMPROBAR_IGUAL(receptor.estadisticas().bytesCorregidos, posiciones * RAFAGA);
+  COMPROBAR_IGUAL(receptor.estadisticas().paquetesIrrecuperables, 0u);
+}
+
+PRUEBA(paquete_irrecuperable_se_descarta) {
+  EnlaceMemoria a, b;
+  a.conectar(b);
+  RadioFEC emisor(a, 4, 2), receptor(b, 4, 2);
+
+  std::vector<uint8_t> datos = mensaje(40, 9);
+  COMPROBAR(emisor.enviar(datos.data(), datos.size()));
+  danar(b.entrada().front(), 10, 12); // 6 errores por palabra, corrige 2
+
+  // Un paquete que no llega ni a la paridad
+  uint8_t corto[4] = {1, 2, 3, 4};
+  b.entrada().push_back(EnlaceMemoria::Paquete(corto, corto + sizeof(corto)));
+
+  // Detrás, uno válido: se entrega
+  std::vector<uint8_t> otro = mensaje(20, 1);
+  COMPROBAR(emisor.enviar(otro.data(), otro.size()));
+
+  COMPROBAR(recibir(receptor) == otro);
+  COMPROBAR_IGUAL(receptor.estadisticas().paquetesRecibidos, 3u);
+  COMPROBAR_IGUAL(receptor.estadisticas().paquetesIrrecuperables, 2u);
+  COMPROBAR(recibir(receptor).empty());
+}
+
+PRUEBA(rechaza_mensajes_mayores_que_el_mtu) {
+  EnlaceMemoria a(64), b(64);
+  a.conectar(b);
+  RadioFEC emisor(a, 8, 2), receptor(b, 8, 2);
+  COMPROBAR_IGUAL(emisor.obtenerMTU(), 64u - 16u);
+
+  std::vector<uint8_t> datos = mensaje(emisor.obtenerMTU() + 1, 5);
+  COMPROBAR(!emisor.enviar(datos.data(), datos.size()));
+  COMPROBAR(a.enviados().empty());
+  COMPROBAR_IGUAL(emisor.estadisticas().paquetesEnviados, 0u);
+
+  datos.pop_back();
+  COMPROBAR(emisor.enviar(datos.data(), datos.size()));
+  COMPROBAR_IGUAL(a.enviados().back().size(), 64u);
+  COMPROBAR(recibir(receptor) == datos);
+
+  // Sin sitio para el mensaje tras la paridad
+  RadioFEC sinSitio(a, 32, 2);
+  COMPROBAR_IGUAL(sinSitio.obtenerMTU(), 0u);
+  COMPROBAR(!sinSitio.enviar(datos.data(), 1));
+}
+
+PRUEBA(paridad_fuera_de_rango_se_recorta) {
+  EnlaceMemoria a, b;
+  a.conectar(b);
+  RadioFEC sinParidad(a, 0), receptor(b, 0);
+  COMPROBAR_IGUAL(sinParidad.sobrecarga(), 2u);
+  RadioFEC excesiva(a, 200);
+  COMPROBAR_IGUAL(excesiva.sobrecarga(), (size_t)ReedSolomon::MAX_PARIDAD);
+
+  std::vector<uint8_t> datos = mensaje(30, 7);
+  COMPROBAR(sinParidad.enviar(datos.data(), datos.size()));
+  danar(b.entrada().front(), 12, 1);
+  COMPROBAR(recibir(receptor) == datos);
+  COMPROBAR_IGUAL(receptor.estadisticas().bytesCorregidos, 1u);
+}
+
+int main() { return pruebas::ejecutar(); }
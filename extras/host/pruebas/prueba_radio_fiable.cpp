@@ -0,0 +1,130 @@
+/**
+ * @file prueba_radio_fiable.cpp
+ * @brief `RadioFiable`: entrega en orden y resincronización cuando uno de los nodos se reinicia.
+ */
+
+#include "EnlaceMemoria.h"
+#include "Prueba.h"
+
+#include <UniversalRadioWSN.h>
+
+namespace {
+
+typedef RadioFiableEstatica<8, 16> Fiable;
+
+void enviarMensaje(Fiable& emisor, uint8_t valor) {
+  uint8_t mensaje[4] = {valor, valor, valor, valor};
+  COMPROBAR(emisor.enviar(mensaje, sizeof(mensaje)));
+}
+
+/// Lee el siguiente mensaje en orden, o -1 si no hay.
+int recibirMensaje(Fiable& receptor) {
+  uint8_t buffer[16];
+  if (receptor.hayDatosDisponibles() <= 0) return -1;
+  COMPROBAR_IGUAL(receptor.leer(buffer, sizeof(buffer)), 4u);
+  return buffer[0];
+}
+
+} // namespace
+
+PRUEBA(entrega_en_orden) {
+  EnlaceMemoria a, b;
+  a.conectar(b);
+  Fiable emisor(a), receptor(b);
+  COMPROBAR(emisor.iniciar());
+  COMPROBAR(receptor.iniciar());
+
+  for (uint8_t i = 0; i < 5; ++i) enviarMensaje(emisor, i);
+  for (int i = 0; i < 5; ++i) COMPROBAR_IGUAL(recibirMensaje(receptor), i);
+  emisor.procesar();
+  COMPROBAR_IGUAL(emisor.pendientesConfirmacion(), 0u);
+  COMPROBAR_IGUAL(emisor.estadisticas().mensajesConfirmados, 5u);
+}
+
+PRUEBA(reinicio_del_emisor_cerca_de_la_base_del_receptor) {
+  EnlaceMemoria a, b;
+  a.conectar(b);
+  Fiable receptor(b);
+  receptor.iniciar();
+  {
+    Fiable emisor(a);
+    emisor.fijarSesion(1);
+    emisor.iniciar();
+    for (uint8_t i = 0; i < 3; ++i) enviarMensaje(emisor, 10 + i);
+    for (int i = 0; i < 3; ++i) COMPROBAR_IGUAL(recibirMensaje(receptor), 10 + i);
+  }
+  a.vaciar(); // ACKs que ya nadie espera
+
+  // El nodo arranca de nuevo y vuelve a numerar desde 0, a solo 3 de la base del receptor:
+  // sin la sesión, el receptor tomaría los mensajes por duplicados ya entregados.
+  Fiable emisor(a);
+  emisor.fijarSesion(2);
+  emisor.iniciar();
+  for (uint8_t i = 0; i < 3; ++i) enviarMensaje(emisor, 20 + i);
+  for (int i = 0; i < 3; ++i) COMPROBAR_IGUAL(recibirMensaje(receptor), 20 + i);
+  COMPROBAR_IGUAL(receptor.estadisticas().duplicados, 0u);
+  emisor.procesar();
+  COMPROBAR_IGUAL(emisor.pendientesConfirmacion(), 0u);
+}
+
+PRUEBA(reinicio_del_emisor_descarta_mensajes_sin_leer) {
+  EnlaceMemoria a, b;
+  a.conectar(b);
+  Fiable receptor(b);
+  receptor.iniciar();
+  {
+    Fiable emisor(a);
+    emisor.fijarSesion(1);
+    emisor.iniciar();
+    enviarMensaje(emisor, 1);
+    enviarMensaje(emisor, 2);
+  }
+  a.vaciar();
+
+  Fiable emisor(a);
+  emisor.fijarSesion(2);
+  emisor.iniciar();
+  enviarMensaje(emisor, 30);
+  COMPROBAR_IGUAL(recibirMensaje(receptor), 30);
+  COMPROBAR_IGUAL(recibirMensaje(receptor), -1);
+}
+
+PRUEBA(ack_de_otra_sesion_no_confirma) {
+  EnlaceMemoria a, b;
+  a.conectar(b);
+  Fiable emisor(a);
+  emisor.fijarSesion(7);
+  emisor.iniciar();
+  enviarMensaje(emisor, 1);
+  b.vaciar(); // El mensaje no llega
+
+  // ACK que confirma las secuencias 0-3 de un arranque anterior (sesión 6)
+  const uint8_t ackViejo[RadioFiable::TAM_ACK] = {0x02, 6, 4, 0, 0};
+  b.enviar(ackViejo, sizeof(ackViejo));
+  emisor.procesar();
+  COMPROBAR_IGUAL(emisor.pendientesConfirmacion(), 1u);
+  COMPROBAR_IGUAL(emisor.estadisticas().mensajesConfirmados, 0u);
+}
+
+PRUEBA(reinicio_del_receptor_adopta_la_numeracion_del_emisor) {
+  EnlaceMemoria a, b;
+  a.conectar(b);
+  Fiable emisor(a);
+  emisor.iniciar();
+  {
+    Fiable receptor(b);
+    receptor.iniciar();
+    for (uint8_t i = 0; i < 5; ++i) enviarMensaje(emisor, i);
+    for (int i = 0; i < 5; ++i) COMPROBAR_IGUAL(recibirMensaje(receptor), i);
+    emisor.procesar();
+  }
+
+  Fiable receptor(b);
+  receptor.iniciar();
+  enviarMensaje(emisor, 40);
+  COMPROBAR_IGUAL(recibirMensaje(receptor), 40);
+  emisor.procesar();
+  COMPROBAR_IGUAL(emisor.pendientesConfirmacion(), 0u);
+}
+
+int main() { return pruebas::ejecutar(); }
@@ -0,0 +1,191 @@
+/**
+ * @file prueba_radio_fragmentada.cpp
+ * @brief `RadioFragmentada`: reensamblado fuera de orden, límite de 32 fragmentos, caducidad,
+ * expulsión de la ranura más antigua y fragmentos duplicados.
+ */
+
+#include "EnlaceMemoria.h"
+#include "Prueba.h"
+
+#include <UniversalRadioWSN.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+/// MTU de la radio: 8 bytes de datos por fragmento.
+const size_t MTU = 10;
+const size_t CARGA = MTU - RadioFragmentada::TAM_CABECERA;
+
+typedef RadioFragmentadaEstatica<2, 300> Fragmentada;
+
+std::vector<uint8_t> mensaje(size_t longitud, uint8_t semilla) {
+  std::vector<uint8_t> datos(longitud);
+  for (size_t i = 0; i < longitud; ++i) datos[i] = (uint8_t)(semilla + i * 13);
+  return datos;
+}
+
+/// Lee el siguiente mensaje, o un vector vacío si no hay.
+std::vector<uint8_t> recibir(RadioInterface& radio) {
+  std::vector<uint8_t> buffer(1024);
+  int disponible = radio.hayDatosDisponibles();
+  if (disponible <= 0) return std::vector<uint8_t>();
+  size_t leidos = radio.leer(buffer.data(), buffer.size());
+  if (leidos != (size_t)disponible) return std::vector<uint8_t>();
+  buffer.resize(leidos);
+  return buffer;
+}
+
+} // namespace
+
+PRUEBA(reensambla_fragmentos_fuera_de_orden) {
+  EnlaceMemoria a(MTU), b(MTU);
+  a.conectar(b);
+  Fragmentada emisor(a), receptor(b);
+
+  std::vector<uint8_t> datos = mensaje(50, 1);
+  COMPROBAR(emisor.enviar(datos.data(), datos.size()));
+  COMPROBAR_IGUAL(b.entrada().size(), (50 + CARGA - 1) / CARGA);
+  std::reverse(b.entrada().begin(), b.entrada().end());
+  std::swap(b.entrada()[1], b.entrada()[4]);
+
+  COMPROBAR(recibir(receptor) == datos);
+  COMPROBAR_IGUAL(receptor.estadisticas().mensajesRecibidos, 1u);
+  COMPROBAR_IGUAL(receptor.estadisticas().fragmentosDescartados, 0u);
+  COMPROBAR_IGUAL(receptor.hayDatosDisponibles(), 0);
+}
+
+PRUEBA(admite_hasta_32_fragmentos) {
+  EnlaceMemoria a(MTU), b(MTU);
+  a.conectar(b);
+  Fragmentada emisor(a), receptor(b);
+
+  COMPROBAR_IGUAL(emisor.obtenerMTU(), RadioFragmentada::MAX_FRAGMENTOS * CARGA);
+  std::vector<uint8_t> demasiado = mensaje(RadioFragmentada::MAX_FRAGMENTOS * CARGA + 1, 2);
+  COMPROBAR(!emisor.enviar(demasiado.data(), demasiado.size()));
+  COMPROBAR(a.enviados().empty());
+
+  // 32 fragmentos: el mapa de recibidos se llena por completo (0xFFFFFFFF)
+  std::vector<uint8_t> datos = mensaje(RadioFragmentada::MAX_FRAGMENTOS * CARGA, 3);
+  COMPROBAR(emisor.enviar(datos.data(), datos.size()));
+  COMPROBAR_IGUAL(a.enviados().size(), (size_t)RadioFragmentada::MAX_FRAGMENTOS);
+  std::swap(b.entrada().front(), b.entrada().back());
+  COMPROBAR(recibir(receptor) == datos);
+}
+
+PRUEBA(mensaje_incompleto_caduca) {
+  EnlaceMemoria a(MTU), b(MTU);
+  a.conectar(b);
+  Fragmentada emisor(a), receptor(b);
+  receptor.fijarTiempoMaximoReensamblado(100);
+
+  std::vector<uint8_t> datos = mensaje(20, 4);
+  COMPROBAR(emisor.enviar(datos.data(), datos.size()));
+  EnlaceMemoria::Paquete ultimo = b.entrada().back();
+  b.entrada().pop_back();
+  COMPROBAR_IGUAL(receptor.hayDatosDisponibles(), 0);
+  COMPROBAR_IGUAL(receptor.estadisticas().bytesReensambladoMax, 2 * CARGA);
+
+  delay(101);
+  COMPROBAR_IGUAL(receptor.hayDatosDisponibles(), 0);
+  COMPROBAR_IGUAL(receptor.estadisticas().mensajesCaducados, 1u);
+
+  // El último fragmento llega tarde: empieza un mensaje nuevo que nunca se completa
+  b.entrada().push_back(ultimo);
+  COMPROBAR_IGUAL(receptor.hayDatosDisponibles(), 0);
+  delay(101);
+  COMPROBAR_IGUAL(receptor.hayDatosDisponibles(), 0);
+  COMPROBAR_IGUAL(receptor.estadisticas().mensajesCaducados, 2u);
+  COMPROBAR_IGUAL(receptor.estadisticas().mensajesRecibidos, 0u);
+}
+
+PRUEBA(sin_ranuras_se_expulsa_el_mensaje_mas_antiguo) {
+  EnlaceMemoria a(MTU), b(MTU);
+  a.conectar(b);
+  Fragmentada emisor(a), receptor(b);
+
+  // Tres mensajes sin su último fragmento, con dos ranuras
+  std::vector<uint8_t> datos[3];
+  EnlaceMemoria::Paquete ultimos[3];
+  for (int i = 0; i < 3; ++i) {
+    datos[i] = mensaje(20, (uint8_t)(10 * i));
+    COMPROBAR(emisor.enviar(datos[i].data(), datos[i].size()));
+    ultimos[i] = b.entrada().back();
+    b.entrada().pop_back();
+    COMPROBAR_IGUAL(receptor.hayDatosDisponibles(), 0);
+    delay(1);
+  }
+  COMPROBAR_IGUAL(receptor.estadisticas().mensajesCaducados, 1u);
+  COMPROBAR_IGUAL(receptor.estadisticas().ranurasOcupadasMax, 2);
+
+  // El primero se expulsó; el segundo y el tercero siguen en curso
+  b.entrada().push_back(ultimos[1]);
+  COMPROBAR(recibir(receptor) == datos[1]);
+  b.entrada().push_back(ultimos[2]);
+  COMPROBAR(recibir(receptor) == datos[2]);
+  b.entrada().push_back(ultimos[0]);
+  COMPROBAR(recibir(receptor).empty());
+  COMPROBAR_IGUAL(receptor.estadisticas().mensajesRecibidos, 2u);
+}
+
+PRUEBA(ranuras_completas_sin_leer_no_se_expulsan) {
+  EnlaceMemoria a(MTU), b(MTU);
+  a.conectar(b);
+  Fragmentada emisor(a), receptor(b);
+
+  std::vector<uint8_t> uno = mensaje(12, 1), dos = mensaje(12, 2), tres = mensaje(12, 3);
+  COMPROBAR(emisor.enviar(uno.data(), uno.size()));
+  COMPROBAR(emisor.enviar(dos.data(), dos.size()));
+  COMPROBAR(emisor.enviar(tres.data(), tres.size()));
+  COMPROBAR(recibir(receptor) == uno);
+  COMPROBAR_IGUAL(receptor.estadisticas().fragmentosDescartados, 2u);
+  COMPROBAR(recibir(receptor) == dos);
+  COMPROBAR(recibir(receptor).empty());
+}
+
+PRUEBA(duplicado_de_un_mensaje_completo_sin_leer_no_se_entrega_dos_veces) {
+  EnlaceMemoria a(MTU), b(MTU);
+  a.conectar(b);
+  Fragmentada emisor(a), receptor(b);
+
+  std::vector<uint8_t> corto = mensaje(5, 7);
+  std::vector<uint8_t> largo = mensaje(30, 8);
+  COMPROBAR(emisor.enviar(corto.data(), corto.size()));
+  COMPROBAR(emisor.enviar(largo.data(), largo.size()));
+  // Cada fragmento llega dos veces (ej. un reintento cuyo ACK se perdió)
+  std::deque<EnlaceMemoria::Paquete> repetidos;
+  for (size_t i = 0; i < b.entrada().size(); ++i) {
+    repetidos.push_back(b.entrada()[i]);
+    repetidos.push_back(b.entrada()[i]);
+  }
+  b.entrada() = repetidos;
+
+  COMPROBAR(recibir(receptor) == corto);
+  COMPROBAR(recibir(receptor) == largo);
+  COMPROBAR(recibir(receptor).empty());
+  COMPROBAR_IGUAL(receptor.estadisticas().mensajesRecibidos, 2u);
+  COMPROBAR_IGUAL(receptor.estadisticas().fragmentosDescartados, 1u + 4u);
+}
+
+PRUEBA(memoria_de_reensamblado_mayor_de_64_kib) {
+  const uint16_t TAM = 40000;
+  const size_t MTU_GRANDE = TAM / RadioFragmentada::MAX_FRAGMENTOS + RadioFragmentada::TAM_CABECERA;
+  EnlaceMemoria a(MTU_GRANDE), b(MTU_GRANDE);
+  a.conectar(b);
+  std::vector<RanuraReensamblado> ranurasEmisor(1), ranurasReceptor(2);
+  std::vector<uint8_t> memoriaEmisor(TAM), memoriaReceptor(2 * TAM);
+  RadioFragmentada emisor(a, ranurasEmisor.data(), memoriaEmisor.data(), 1, TAM);
+  RadioFragmentada receptor(b, ranurasReceptor.data(), memoriaReceptor.data(), 2, TAM);
+  COMPROBAR_IGUAL(receptor.obtenerMTU(), (size_t)TAM);
+
+  std::vector<uint8_t> datos[2] = {mensaje(TAM, 1), mensaje(TAM, 2)};
+  for (int i = 0; i < 2; ++i) {
+    COMPROBAR(emisor.enviar(datos[i].data(), datos[i].size()));
+    b.entrada().pop_back(); // Sin el último fragmento: ambos quedan en curso
+  }
+  COMPROBAR_IGUAL(receptor.hayDatosDisponibles(), 0);
+  COMPROBAR_IGUAL(receptor.estadisticas().bytesReensambladoMax, 2u * (TAM - (MTU_GRANDE - RadioFragmentada::TAM_CABECERA)));
+}
+
+int main() { return pruebas::ejecutar(); }
@@ -0,0 +1,92 @@
+/**
+ * @file prueba_simulador.cpp
+ * @brief Modelo de canal de `SimuladorRed`: sombreado por enlace y captura frente a la suma de interferentes.
+ */
+
+#include "Prueba.h"
+
+#include <SimuladorRed.h>
+
+namespace {
+
+/**
+ * @brief Envía `numPaquetes` paquetes de 10 bytes, uno cada segundo, empezando en `inicioUs`.
+ */
+class Emisor : public AplicacionNodo {
+public:
+  Emisor(uint64_t inicioUs, uint32_t numPaquetes) : _inicioUs(inicioUs), _pendientes(numPaquetes) {}
+
+  uint64_t ejecutar(NodoSimulado& nodo, uint64_t ahoraUs) override {
+    if (ahoraUs < _inicioUs) return _inicioUs;
+    if (_pendientes == 0) return SimuladorRed::NUNCA;
+    uint8_t datos[10] = {0};
+    nodo.enviar(datos, sizeof(datos));
+    _pendientes--;
+    return ahoraUs + 1000000ULL;
+  }
+
+private:
+  uint64_t _inicioUs;
+  uint32_t _pendientes;
+};
+
+ModeloAire modeloLora(int potencia) {
+  LoRaConfig config = {868000000, potencia, 7, 125000, 5, 0x12, 0, 0, 0};
+  return ModeloAire::lora(config);
+}
+
+} // namespace
+
+PRUEBA(sombreado_fijo_por_enlace) {
+  ParametrosCanal canal;
+  canal.sombreado_dB = 8.0;
+  SimuladorRed sim(canal, 7);
+  size_t receptor = sim.agregarNodo(modeloLora(14), 0, 0);
+  size_t emisor = sim.agregarNodo(modeloLora(14), 300, 0);
+  sim.nodo(receptor).fijarCapacidades(4, 32);
+  sim.nodo(emisor).fijarDestino(receptor);
+  sim.asignarAplicacion(emisor, new Emisor(0, 20));
+  sim.ejecutarHasta(30000000ULL);
+
+  NodoSimulado& r = sim.nodo(receptor);
+  COMPROBAR_IGUAL(r.informe().recibidos, 20u);
+  uint8_t buffer[16];
+  r.leer(buffer, sizeof(buffer));
+  int rssi = r.obtenerRSSI();
+  while (r.hayDatosDisponibles() > 0) {
+    r.leer(buffer, sizeof(buffer));
+    COMPROBAR_IGUAL(r.obtenerRSSI(), rssi); // Mismo enlace, misma atenuación
+  }
+}
+
+PRUEBA(captura_con_un_interferente_debil) {
+  SimuladorRed sim;
+  size_t receptor = sim.agregarNodo(modeloLora(14), 0, 0);
+  size_t emisor = sim.agregarNodo(modeloLora(14), 100, 0);
+  size_t interferente = sim.agregarNodo(modeloLora(7), -100, 0); // 7 dB por debajo
+  sim.nodo(emisor).fijarDestino(receptor);
+  sim.asignarAplicacion(emisor, new Emisor(0, 1));
+  sim.asignarAplicacion(interferente, new Emisor(0, 1));
+  sim.ejecutarHasta(1000000ULL);
+
+  COMPROBAR_IGUAL(sim.nodo(emisor).informe().entregados, 1u); // 7 dB > umbral de 6 dB
+}
+
+PRUEBA(sin_captura_frente_a_la_suma_de_interferentes) {
+  SimuladorRed sim;
+  size_t receptor = sim.agregarNodo(modeloLora(14), 0, 0);
+  size_t emisor = sim.agregarNodo(modeloLora(14), 100, 0);
+  size_t interferenteA = sim.agregarNodo(modeloLora(7), -100, 0);
+  size_t interferenteB = sim.agregarNodo(modeloLora(7), 0, 100);
+  sim.nodo(emisor).fijarDestino(receptor);
+  sim.asignarAplicacion(emisor, new Emisor(0, 1));
+  sim.asignarAplicacion(interferenteA, new Emisor(0, 1));
+  sim.asignarAplicacion(interferenteB, new Emisor(0, 1));
+  sim.ejecutarHasta(1000000ULL);
+
+  // Cada interferente queda 7 dB por debajo, pero juntos solo 4 dB: no hay captura
+  COMPROBAR_IGUAL(sim.nodo(emisor).informe().entregados, 0u);
+  COMPROBAR(sim.nodo(receptor).informe().colisiones >= 1u);
+}
+
+int main() { return pruebas::ejecutar(); }
@@ -0,0 +1,159 @@
+/**
+ * @file prueba_slip.cpp
+ * @brief Fuzz de la delimitación SLIP (`TramaSlip.h`) y de `XBeeRadio::usarTramasSlip()`.
+ * @details Tramas aleatorias con muchos bytes END/ESC, entregadas en trozos de tamaño
+ * aleatorio, deben reconstruirse exactas; y ruido arbitrario no debe escribir fuera del
+ * buffer ni impedir que la siguiente trama válida se decodifique.
+ */
+
+#include "Prueba.h"
+#include "PuertoSerieFalso.h"
+
+#include <UniversalRadioWSN.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Trama aleatoria de 1 a `longitudMaxima` bytes; una cuarta parte son END o ESC.
+ */
+std::vector<uint8_t> tramaAleatoria(std::mt19937& azar, size_t longitudMaxima) {
+  std::vector<uint8_t> trama(1 + azar() % longitudMaxima);
+  for (size_t i = 0; i < trama.size(); ++i) {
+    uint32_t r = azar();
+    if (r % 8 == 0) trama[i] = SLIP_END;
+    else if (r % 8 == 1) trama[i] = SLIP_ESC;
+    else trama[i] = static_cast<uint8_t>(r >> 8);
+  }
+  return trama;
+}
+
+std::vector<uint8_t> codificar(const std::vector<uint8_t>& trama) {
+  std::vector<uint8_t> salida(2 * trama.size() + 2);
+  EscritorMemoria escritor(salida.data(), salida.size());
+  Segmento segmento = {trama.data(), trama.size()};
+  size_t escritos = escribirTramaSlip(escritor, &segmento, 1);
+  salida.resize(escritos);
+  return salida;
+}
+
+} // namespace
+
+PRUEBA(ida_y_vuelta_aleatoria) {
+  std::mt19937 azar(12);
+  std::vector<std::vector<uint8_t> > tramas;
+  std::vector<uint8_t> linea;
+  for (int i = 0; i < 2000; ++i) {
+    tramas.push_back(tramaAleatoria(azar, 200));
+    std::vector<uint8_t> codificada = codificar(tramas.back());
+    linea.insert(linea.end(), codificada.begin(), codificada.end());
+  }
+
+  uint8_t buffer[200];
+  DecodificadorSlip decodificador(buffer, sizeof(buffer));
+  size_t siguiente = 0;
+  for (size_t i = 0; i < linea.size(); ++i) {
+    if (!decodificador.procesar(linea[i])) continue;
+    COMPROBAR(siguiente < tramas.size());
+    COMPROBAR_IGUAL(decodificador.longitud(), tramas[siguiente].size());
+    COMPROBAR(memcmp(decodificador.trama(), tramas[siguiente].data(), tramas[siguiente].size()) == 0);
+    decodificador.liberar();
+    siguiente++;
+  }
+  COMPROBAR_IGUAL(siguiente, tramas.size());
+  COMPROBAR_IGUAL(decodificador.errores(), 0u);
+}
+
+PRUEBA(ruido_no_desborda_y_resincroniza) {
+  std::mt19937 azar(34);
+  const uint16_t CAPACIDAD = 64;
+  uint8_t memoria[CAPACIDAD + 16];
+  memset(memoria, 0xA5, sizeof(memoria));
+  DecodificadorSlip decodificador(memoria + 8, CAPACIDAD);
+
+  for (int i = 0; i < 200000; ++i) {
+    // Ruido con END y ESC frecuentes, para recorrer todos los estados
+    uint32_t r = azar();
+    uint8_t byte = (r % 4 == 0) ? SLIP_END : ((r % 4 == 1) ? SLIP_ESC : static_cast<uint8_t>(r >> 8));
+    if (decodificador.procesar(byte)) {
+      COMPROBAR(decodificador.longitud() > 0 && decodificador.longitud() <= CAPACIDAD);
+      decodificador.liberar();
+    }
+  }
+  for (int i = 0; i < 8; ++i) {
+    COMPROBAR_IGUAL(memoria[i], 0xA5);
+    COMPROBAR_IGUAL(memoria[8 + CAPACIDAD + i], 0xA5);
+  }
+
+  // Tras el ruido, la primera trama válida se decodifica entera (su END inicial resincroniza)
+  std::vector<uint8_t> trama = tramaAleatoria(azar, CAPACIDAD);
+  std::vector<uint8_t> codificada = codificar(trama);
+  bool completa = false;
+  for (size_t i = 0; i < codificada.size(); ++i) completa = decodificador.procesar(codificada[i]);
+  COMPROBAR(completa);
+  COMPROBAR_IGUAL(decodificador.longitud(), trama.size());
+  COMPROBAR(memcmp(decodificador.trama(), trama.data(), trama.size()) == 0);
+}
+
+PRUEBA(xbee_entrega_una_trama_por_lectura_aunque_llegue_troceada) {
+  std::mt19937 azar(56);
+  PuertoSerieFalso puerto;
+  XBeeRadio radio(puerto, 9600, -1, -1);
+  COMPROBAR(radio.iniciar());
+  radio.usarTramasSlip();
+
+  std::vector<std::vector<uint8_t> > tramas;
+  std::vector<uint8_t> linea;
+  for (int i = 0; i < 300; ++i) {
+    tramas.push_back(tramaAleatoria(azar, XBEE_RADIO_TAM_BUFFER_RX));
+    std::vector<uint8_t> codificada = codificar(tramas.back());
+    linea.insert(linea.end(), codificada.begin(), codificada.end());
+  }
+
+  size_t siguiente = 0;
+  size_t posicion = 0;
+  uint8_t buffer[XBEE_RADIO_TAM_BUFFER_RX];
+  while (posicion < linea.size()) {
+    // Lo que haya llegado al UART: de 1 byte a varias tramas de golpe
+    size_t trozo = 1 + azar() % 300;
+    if (trozo > linea.size() - posicion) trozo = linea.size() - posicion;
+    puerto.inyectar(linea.data() + posicion, trozo);
+    posicion += trozo;
+
+    while (radio.hayDatosDisponibles() > 0) {
+      COMPROBAR(siguiente < tramas.size());
+      COMPROBAR_IGUAL(static_cast<size_t>(radio.hayDatosDisponibles()), tramas[siguiente].size());
+      COMPROBAR_IGUAL(radio.leer(buffer, sizeof(buffer)), tramas[siguiente].size());
+      COMPROBAR(memcmp(buffer, tramas[siguiente].data(), tramas[siguiente].size()) == 0);
+      siguiente++;
+    }
+  }
+  COMPROBAR_IGUAL(siguiente, tramas.size());
+  COMPROBAR_IGUAL(radio.tramasErroneas(), 0u);
+}
+
+PRUEBA(xbee_escritura_corta_de_trama_slip_falla) {
+  PuertoSerieFalso puerto;
+  XBeeRadio radio(puerto, 9600, -1, -1);
+  COMPROBAR(radio.iniciar());
+  radio.usarTramasSlip();
+
+  const uint8_t datos[6] = {1, SLIP_END, 2, SLIP_ESC, 3, 4};
+  COMPROBAR_IGUAL(longitudTramaSlip(nullptr, 0), 2u);
+  Segmento segmento = {datos, sizeof(datos)};
+  COMPROBAR_IGUAL(longitudTramaSlip(&segmento, 1), 10u);
+
+  COMPROBAR(radio.enviar(datos, sizeof(datos)));
+  COMPROBAR(puerto.salida() == codificar(std::vector<uint8_t>(datos, datos + sizeof(datos))));
+
+  // El UART acepta solo parte de la trama (con escapes ocupa 10 bytes)
+  puerto.limitarEscritura(9);
+  COMPROBAR(!radio.enviar(datos, sizeof(datos)));
+  EstadisticasRadio estadisticas = radio.obtenerEstadisticas();
+  COMPROBAR_IGUAL(estadisticas.enviosFallidos, 1u);
+  COMPROBAR_IGUAL(estadisticas.tramasEnviadas, 1u);
+}
+
+int main() { return pruebas::ejecutar(); }
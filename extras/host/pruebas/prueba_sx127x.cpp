@@ -0,0 +1,183 @@
+/**
+ * @file prueba_sx127x.cpp
+ * @brief `Sx127xNucleo` contra el emulador de registros `Sx127xFalso`: ráfagas sobre la FIFO,
+ * detección por DIO0 y rechazo de `enviar()` con un paquete recibido sin leer.
+ */
+
+#include "Prueba.h"
+
+#include <UniversalRadioWSN.h>
+
+#include "Sx127xFalso.h"
+
+namespace {
+
+const uint8_t PIN_CS = 10;
+const uint8_t PIN_DIO0 = 2;
+
+LoRaConfig configuracion(uint8_t pinCs = PIN_CS, int pinDio0 = -1) {
+  LoRaConfig config;
+  config.frequency = 868E6;
+  config.spreadingFactor = 7;
+  config.signalBandwidth = 125E3;
+  config.codingRate = 5;
+  config.syncWord = 0x12;
+  config.txPower = 14;
+  config.csPin = pinCs;
+  config.resetPin = -1;
+  config.irqPin = pinDio0;
+  return config;
+}
+
+void rellenar(uint8_t* datos, size_t longitud, uint8_t semilla) {
+  for (size_t i = 0; i < longitud; ++i) datos[i] = (uint8_t)(semilla + i * 7);
+}
+
+} // namespace
+
+PRUEBA(sin_modulo_iniciar_falla) {
+  Sx127xNucleo radio(configuracion());
+  COMPROBAR(!radio.iniciar());
+}
+
+PRUEBA(iniciar_deja_el_modulo_en_recepcion_continua) {
+  Sx127xFalso modulo(PIN_CS);
+  Sx127xNucleo radio(configuracion());
+  COMPROBAR(radio.iniciar());
+  COMPROBAR_IGUAL(modulo.modo(), Sx127xFalso::MODO_RX_CONTINUO);
+  COMPROBAR_IGUAL(modulo.registro(Sx127xFalso::REG_SYNC_WORD), 0x12);
+  COMPROBAR_IGUAL(modulo.registro(Sx127xFalso::REG_MODEM_CONFIG_2) >> 4, 7);
+  COMPROBAR_IGUAL(modulo.registro(0x06), 0xD9); // FRF = 868 MHz
+}
+
+PRUEBA(enviar_escribe_la_fifo_en_una_rafaga) {
+  Sx127xFalso modulo(PIN_CS);
+  Sx127xNucleo radio(configuracion());
+  COMPROBAR(radio.iniciar());
+
+  uint8_t datos[200];
+  rellenar(datos, sizeof(datos), 3);
+  COMPROBAR(radio.enviar(datos, sizeof(datos)));
+  COMPROBAR_IGUAL(modulo.transaccionesFifo(), 1u);
+  COMPROBAR_IGUAL(modulo.tramasTransmitidas(), 1u);
+  COMPROBAR(modulo.ultimaTrama() == std::vector<uint8_t>(datos, datos + sizeof(datos)));
+  COMPROBAR_IGUAL(modulo.modo(), Sx127xFalso::MODO_RX_CONTINUO);
+}
+
+PRUEBA(enviar_por_segmentos_una_rafaga_por_segmento) {
+  Sx127xFalso modulo(PIN_CS);
+  Sx127xNucleo radio(configuracion());
+  COMPROBAR(radio.iniciar());
+
+  uint8_t cabecera[4] = {1, 2, 3, 4};
+  uint8_t cuerpo[60];
+  rellenar(cuerpo, sizeof(cuerpo), 9);
+  Segmento segmentos[2] = {{cabecera, sizeof(cabecera)}, {cuerpo, sizeof(cuerpo)}};
+  COMPROBAR(radio.enviar(segmentos, 2));
+  COMPROBAR_IGUAL(modulo.transaccionesFifo(), 2u);
+  std::vector<uint8_t> esperada(cabecera, cabecera + sizeof(cabecera));
+  esperada.insert(esperada.end(), cuerpo, cuerpo + sizeof(cuerpo));
+  COMPROBAR(modulo.ultimaTrama() == esperada);
+}
+
+PRUEBA(leer_vuelca_la_fifo_en_una_rafaga) {
+  Sx127xFalso modulo(PIN_CS);
+  Sx127xNucleo radio(configuracion());
+  COMPROBAR(radio.iniciar());
+
+  uint8_t datos[255];
+  rellenar(datos, sizeof(datos), 5);
+  COMPROBAR(modulo.recibir(datos, sizeof(datos), -80));
+  uint32_t transacciones = host::estadisticasSpi().transacciones;
+  uint8_t buffer[255];
+  COMPROBAR_IGUAL(radio.hayDatosDisponibles(), 255);
+  COMPROBAR_IGUAL(radio.leer(buffer, sizeof(buffer)), 255u);
+  COMPROBAR(memcmp(buffer, datos, sizeof(datos)) == 0);
+  // Estado en ráfaga, limpiar banderas, puntero de la FIFO y la FIFO
+  COMPROBAR_IGUAL(host::estadisticasSpi().transacciones - transacciones, 4u);
+  COMPROBAR_IGUAL(modulo.transaccionesFifo(), 1u);
+  COMPROBAR_IGUAL(radio.obtenerRSSI(), -80);
+  COMPROBAR_IGUAL(modulo.registro(Sx127xFalso::REG_IRQ_FLAGS), 0);
+}
+
+PRUEBA(paquete_con_crc_erroneo_se_descarta) {
+  Sx127xFalso modulo(PIN_CS);
+  Sx127xNucleo radio(configuracion());
+  COMPROBAR(radio.iniciar());
+
+  uint8_t datos[8] = {0};
+  modulo.recibir(datos, sizeof(datos), -60, true);
+  COMPROBAR_IGUAL(radio.hayDatosDisponibles(), 0);
+  COMPROBAR_IGUAL(radio.obtenerEstadisticas().tramasErroneas, 1u);
+}
+
+PRUEBA(con_dio0_el_sondeo_sin_paquete_no_usa_el_bus) {
+  Sx127xFalso modulo(PIN_CS, PIN_DIO0);
+  Sx127xNucleo radio(configuracion(PIN_CS, PIN_DIO0));
+  COMPROBAR(radio.iniciar());
+
+  uint32_t transacciones = host::estadisticasSpi().transacciones;
+  for (int i = 0; i < 10; ++i) COMPROBAR_IGUAL(radio.hayDatosDisponibles(), 0);
+  COMPROBAR_IGUAL(host::estadisticasSpi().transacciones, transacciones);
+
+  uint8_t datos[3] = {7, 8, 9};
+  modulo.recibir(datos, sizeof(datos));
+  COMPROBAR_IGUAL(radio.hayDatosDisponibles(), 3);
+}
+
+PRUEBA(enviar_con_paquete_sin_detectar_se_rechaza_sin_sobrescribirlo) {
+  Sx127xFalso modulo(PIN_CS);
+  Sx127xNucleo radio(configuracion());
+  COMPROBAR(radio.iniciar());
+
+  // Llega un paquete después del último sondeo: la TX lo sobrescribiría en la FIFO
+  uint8_t recibido[40];
+  rellenar(recibido, sizeof(recibido), 11);
+  COMPROBAR_IGUAL(radio.hayDatosDisponibles(), 0);
+  modulo.recibir(recibido, sizeof(recibido));
+
+  uint8_t saliente[40];
+  rellenar(saliente, sizeof(saliente), 99);
+  COMPROBAR(!radio.enviar(saliente, sizeof(saliente)));
+  COMPROBAR_IGUAL(radio.obtenerEstadisticas().rechazosOcupada, 1u);
+  COMPROBAR_IGUAL(modulo.tramasTransmitidas(), 0u);
+
+  uint8_t buffer[64];
+  COMPROBAR_IGUAL(radio.leer(buffer, sizeof(buffer)), sizeof(recibido));
+  COMPROBAR(memcmp(buffer, recibido, sizeof(recibido)) == 0);
+  COMPROBAR(radio.enviar(saliente, sizeof(saliente)));
+}
+
+PRUEBA(dormir_descarta_el_paquete_sin_leer) {
+  Sx127xFalso modulo(PIN_CS);
+  Sx127xNucleo radio(configuracion());
+  COMPROBAR(radio.iniciar());
+
+  uint8_t datos[4] = {1, 2, 3, 4};
+  modulo.recibir(datos, sizeof(datos));
+  COMPROBAR(radio.dormir());
+  COMPROBAR(radio.despertar());
+  COMPROBAR_IGUAL(radio.hayDatosDisponibles(), 0);
+  COMPROBAR(radio.enviar(datos, sizeof(datos)));
+}
+
+PRUEBA(dos_modulos_en_el_mismo_bus) {
+  Sx127xFalso moduloA(PIN_CS);
+  Sx127xFalso moduloB(11, 3);
+  moduloA.enlazar(moduloB);
+  Sx127xRadio a(configuracion());
+  Sx127xRadio b(configuracion(11, 3));
+  COMPROBAR(a.iniciar());
+  COMPROBAR(b.iniciar());
+
+  COMPROBAR(a.enviar(String("hola")));
+  uint8_t buffer[16];
+  COMPROBAR_IGUAL(b.hayDatosDisponibles(), 4);
+  COMPROBAR_IGUAL(b.leer(buffer, sizeof(buffer)), 4u);
+  COMPROBAR(memcmp(buffer, "hola", 4) == 0);
+
+  COMPROBAR(b.enviar(String("adios")));
+  COMPROBAR_IGUAL(a.hayDatosDisponibles(), 5);
+}
+
+int main() { return pruebas::ejecutar(); }
@@ -0,0 +1,332 @@
+/**
+ * @file prueba_xbee.cpp
+ * @brief `XBeeRadio` en modo API contra un UART en memoria: tramas TX16/TX64 con escapes,
+ * recepción RX16/RX64 con RSSI y origen, TX status y escrituras cortas; y la cola de
+ * transmisión asíncrona drenada a trozos según el espacio del UART.
+ * @details El otro extremo es la propia prueba, que inyecta las tramas del módulo con
+ * `PuertoSerieFalso::inyectar()` y decodifica lo escrito con `ParserTramaXBee`.
+ */
+
+#include "Prueba.h"
+#include "PuertoSerieFalso.h"
+
+#include <UniversalRadioWSN.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Codifica una trama API con `contenido` (tipo de API incluido) como la enviaría el módulo.
+ */
+std::vector<uint8_t> trama(const std::vector<uint8_t>& contenido, bool escapado = true) {
+  std::vector<uint8_t> salida(2 * contenido.size() + 8);
+  EscritorMemoria escritor(salida.data(), salida.size());
+  Segmento segmento = {contenido.data(), contenido.size()};
+  salida.resize(escribirTramaXBee(escritor, nullptr, 0, &segmento, 1, escapado));
+  return salida;
+}
+
+/**
+ * @brief Decodifica la única trama de `linea`; devuelve su contenido o un vector vacío.
+ */
+std::vector<uint8_t> decodificar(const std::vector<uint8_t>& linea, bool escapado = true) {
+  uint8_t buffer[128];
+  ParserTramaXBee parser(buffer, sizeof(buffer));
+  parser.fijarEscapado(escapado);
+  for (size_t i = 0; i < linea.size(); ++i) {
+    if (parser.procesar(linea[i])) {
+      if (i + 1 != linea.size()) return std::vector<uint8_t>();
+      return std::vector<uint8_t>(parser.trama(), parser.trama() + parser.longitud());
+    }
+  }
+  return std::vector<uint8_t>();
+}
+
+/// RX16 desde `origen` con el RSSI dado (en -dBm, como lo informa el módulo).
+std::vector<uint8_t> rx16(uint16_t origen, uint8_t rssi, const std::vector<uint8_t>& datos) {
+  std::vector<uint8_t> contenido;
+  contenido.push_back(XBEE_API_RX16);
+  contenido.push_back((uint8_t)(origen >> 8));
+  contenido.push_back((uint8_t)(origen & 0xFF));
+  contenido.push_back(rssi);
+  contenido.push_back(0); // Opciones
+  contenido.insert(contenido.end(), datos.begin(), datos.end());
+  return trama(contenido);
+}
+
+std::vector<uint8_t> estadoTx(uint8_t idTrama, uint8_t estado) {
+  std::vector<uint8_t> contenido;
+  contenido.push_back(XBEE_API_ESTADO_TX);
+  contenido.push_back(idTrama);
+  contenido.push_back(estado);
+  return trama(contenido);
+}
+
+void inyectar(PuertoSerieFalso& puerto, const std::vector<uint8_t>& bytes) { puerto.inyectar(bytes.data(), bytes.size()); }
+
+uint8_t ultimoId = 0;
+uint8_t ultimoEstado = 0;
+uint32_t avisosEstado = 0;
+
+void alEstadoTx(uint8_t idTrama, uint8_t estado) {
+  ultimoId = idTrama;
+  ultimoEstado = estado;
+  avisosEstado++;
+}
+
+} // namespace
+
+PRUEBA(trama_api_ida_y_vuelta_aleatoria) {
+  std::mt19937 azar(10);
+  const uint8_t especiales[4] = {XBEE_API_INICIO, XBEE_API_ESCAPE, XBEE_API_XON, XBEE_API_XOFF};
+  for (int repeticion = 0; repeticion < 200; ++repeticion) {
+    bool escapado = (repeticion % 2) == 0;
+    uint8_t cabecera[5];
+    for (size_t i = 0; i < sizeof(cabecera); ++i) cabecera[i] = especiales[azar() % 4];
+    std::vector<uint8_t> datos(1 + azar() % XBEE_API_MAX_PAYLOAD);
+    for (size_t i = 0; i < datos.size(); ++i) {
+      datos[i] = (azar() % 4 == 0) ? especiales[azar() % 4] : (uint8_t)azar();
+    }
+    Segmento segmentos[2] = {{datos.data(), datos.size() / 2}, {datos.data() + datos.size() / 2, datos.size() - datos.size() / 2}};
+
+    std::vector<uint8_t> linea(2 * (sizeof(cabecera) + datos.size()) + 8);
+    EscritorMemoria escritor(linea.data(), linea.size());
+    size_t escritos = escribirTramaXBee(escritor, cabecera, sizeof(cabecera), segmentos, 2, escapado);
+    COMPROBAR_IGUAL(escritos, escritor.longitud());
+    COMPROBAR_IGUAL(escritos, longitudTramaXBee(cabecera, sizeof(cabecera), segmentos, 2, escapado));
+    linea.resize(escritos);
+
+    std::vector<uint8_t> esperado(cabecera, cabecera + sizeof(cabecera));
+    esperado.insert(esperado.end(), datos.begin(), datos.end());
+    COMPROBAR(decodificar(linea, escapado) == esperado);
+  }
+}
+
+PRUEBA(enviar_escribe_tx16_con_id_y_escapes) {
+  PuertoSerieFalso puerto;
+  XBeeRadio radio(puerto, 9600, -1, -1);
+  radio.usarModoAPI();
+  COMPROBAR(radio.iniciar());
+  radio.fijarDestino16(0x7D13);
+
+  const uint8_t datos[4] = {XBEE_API_INICIO, 1, XBEE_API_XON, 2};
+  COMPROBAR(radio.enviar(datos, sizeof(datos)));
+  uint8_t id = radio.ultimoIdTrama();
+  COMPROBAR(id != 0);
+  COMPROBAR_IGUAL(radio.estadoTransmision(id), XBEE_TX_PENDIENTE);
+
+  const uint8_t esperado[9] = {XBEE_API_TX16, id, 0x7D, 0x13, 0, XBEE_API_INICIO, 1, XBEE_API_XON, 2};
+  COMPROBAR(decodificar(puerto.salida()) == std::vector<uint8_t>(esperado, esperado + sizeof(esperado)));
+}
+
+PRUEBA(enviar_escribe_tx64_sin_escapes) {
+  PuertoSerieFalso puerto;
+  XBeeRadio radio(puerto, 9600, -1, -1);
+  radio.usarModoAPI(false);
+  COMPROBAR(radio.iniciar());
+  radio.fijarDestino64(0x0013A20040A1B2C3ULL);
+
+  const uint8_t datos[2] = {XBEE_API_INICIO, XBEE_API_ESCAPE};
+  COMPROBAR(radio.enviar(datos, sizeof(datos)));
+  uint8_t id = radio.ultimoIdTrama();
+  const uint8_t esperado[13] = {XBEE_API_TX64, id, 0x00, 0x13, 0xA2, 0x00, 0x40, 0xA1, 0xB2, 0xC3, 0,
+                                XBEE_API_INICIO, XBEE_API_ESCAPE};
+  COMPROBAR_IGUAL(puerto.salida().size(), 3u + sizeof(esperado) + 1u);
+  COMPROBAR(decodificar(puerto.salida(), false) == std::vector<uint8_t>(esperado, esperado + sizeof(esperado)));
+}
+
+PRUEBA(recibe_rx16_con_rssi_y_origen) {
+  PuertoSerieFalso puerto;
+  XBeeRadio radio(puerto, 9600, -1, -1);
+  radio.usarModoAPI();
+  COMPROBAR(radio.iniciar());
+
+  const uint8_t datos[5] = {'h', XBEE_API_INICIO, 'o', XBEE_API_XOFF, 'a'};
+  inyectar(puerto, rx16(0x1311, 0x28, std::vector<uint8_t>(datos, datos + sizeof(datos))));
+
+  uint8_t buffer[32];
+  COMPROBAR_IGUAL(radio.hayDatosDisponibles(), 5);
+  COMPROBAR_IGUAL(radio.leer(buffer, sizeof(buffer)), 5u);
+  COMPROBAR(memcmp(buffer, datos, sizeof(datos)) == 0);
+  COMPROBAR_IGUAL(radio.obtenerRSSI(), -40);
+  COMPROBAR_IGUAL(radio.ultimoOrigen16(), 0x1311);
+  COMPROBAR(radio.ultimoOrigen64() == 0);
+  COMPROBAR_IGUAL(radio.hayDatosDisponibles(), 0);
+}
+
+PRUEBA(recibe_rx64_con_origen_de_64_bits) {
+  PuertoSerieFalso puerto;
+  XBeeRadio radio(puerto, 9600, -1, -1);
+  radio.usarModoAPI();
+  COMPROBAR(radio.iniciar());
+
+  const uint8_t contenido[14] = {XBEE_API_RX64, 0x00, 0x13, 0xA2, 0x00, 0x40, 0x7E, 0x7D, 0x11, 0x50, 0, 9, 8, 7};
+  inyectar(puerto, trama(std::vector<uint8_t>(contenido, contenido + sizeof(contenido))));
+
+  uint8_t buffer[8];
+  COMPROBAR_IGUAL(radio.leer(buffer, sizeof(buffer)), 3u);
+  COMPROBAR_IGUAL(buffer[0], 9);
+  COMPROBAR(radio.ultimoOrigen64() == 0x0013A200407E7D11ULL);
+  COMPROBAR_IGUAL(radio.ultimoOrigen16(), 0xFFFE);
+  COMPROBAR_IGUAL(radio.obtenerRSSI(), -0x50);
+}
+
+PRUEBA(tx_status_actualiza_el_estado_y_avisa) {
+  PuertoSerieFalso puerto;
+  XBeeRadio radio(puerto, 9600, -1, -1);
+  avisosEstado = 0;
+  radio.usarModoAPI(true, alEstadoTx);
+  COMPROBAR(radio.iniciar());
+
+  COMPROBAR(radio.enviar("uno"));
+  uint8_t primero = radio.ultimoIdTrama();
+  COMPROBAR(radio.enviar("dos"));
+  uint8_t segundo = radio.ultimoIdTrama();
+  COMPROBAR(primero != segundo);
+
+  // Los TX status llegan mezclados con un paquete recibido
+  inyectar(puerto, estadoTx(primero, XBEE_TX_EXITO));
+  inyectar(puerto, rx16(0x0002, 0x30, std::vector<uint8_t>(1, 0x55)));
+  inyectar(puerto, estadoTx(segundo, XBEE_TX_SIN_ACK));
+
+  COMPROBAR_IGUAL(radio.estadoTransmision(primero), XBEE_TX_EXITO);
+  COMPROBAR_IGUAL(avisosEstado, 1u);
+  COMPROBAR_IGUAL(ultimoId, primero);
+  // El paquete queda retenido hasta leerlo; el segundo TX status espera detrás
+  COMPROBAR_IGUAL(radio.estadoTransmision(segundo), XBEE_TX_PENDIENTE);
+  uint8_t buffer[4];
+  COMPROBAR_IGUAL(radio.leer(buffer, sizeof(buffer)), 1u);
+  COMPROBAR_IGUAL(radio.estadoTransmision(segundo), XBEE_TX_SIN_ACK);
+  COMPROBAR_IGUAL(avisosEstado, 2u);
+  COMPROBAR_IGUAL(ultimoEstado, XBEE_TX_SIN_ACK);
+  COMPROBAR_IGUAL(radio.obtenerEstadisticas().tramasNoEntregadas, 1u);
+  COMPROBAR_IGUAL(radio.estadoTransmision(0), XBEE_TX_DESCONOCIDA);
+}
+
+PRUEBA(checksum_erroneo_se_descarta_y_resincroniza) {
+  PuertoSerieFalso puerto;
+  XBeeRadio radio(puerto, 9600, -1, -1);
+  radio.usarModoAPI();
+  COMPROBAR(radio.iniciar());
+
+  std::vector<uint8_t> corrupta = rx16(0x0001, 0x20, std::vector<uint8_t>(3, 0x41));
+  corrupta.back() ^= 0x01;
+  inyectar(puerto, corrupta);
+  inyectar(puerto, rx16(0x0001, 0x20, std::vector<uint8_t>(2, 0x42)));
+
+  uint8_t buffer[8];
+  COMPROBAR_IGUAL(radio.leer(buffer, sizeof(buffer)), 2u);
+  COMPROBAR_IGUAL(buffer[0], 0x42);
+  COMPROBAR_IGUAL(radio.obtenerEstadisticas().tramasErroneas, 1u);
+}
+
+PRUEBA(escritura_corta_de_trama_api_falla_y_olvida_el_id) {
+  PuertoSerieFalso puerto;
+  XBeeRadio radio(puerto, 9600, -1, -1);
+  radio.usarModoAPI();
+  COMPROBAR(radio.iniciar());
+
+  // 0x7E en los datos: con escapes la trama ocupa 3 + 5 + 4 + 1 bytes (o uno más si se escapa el checksum)
+  const uint8_t datos[3] = {1, XBEE_API_INICIO, 3};
+  COMPROBAR(radio.enviar(datos, sizeof(datos)));
+  COMPROBAR(puerto.salida().size() >= 13u);
+
+  // El UART acepta la cabecera pero corta el payload
+  puerto.limitarEscritura(10);
+  COMPROBAR(!radio.enviar(datos, sizeof(datos)));
+  uint8_t id = radio.ultimoIdTrama();
+  COMPROBAR_IGUAL(radio.estadoTransmision(id), XBEE_TX_DESCONOCIDA);
+  EstadisticasRadio estadisticas = radio.obtenerEstadisticas();
+  COMPROBAR_IGUAL(estadisticas.enviosFallidos, 1u);
+  COMPROBAR_IGUAL(estadisticas.tramasEnviadas, 1u);
+
+  puerto.limitarEscritura(PuertoSerieFalso::SIN_LIMITE);
+  COMPROBAR(radio.enviar(datos, sizeof(datos)));
+  COMPROBAR_IGUAL(radio.estadoTransmision(radio.ultimoIdTrama()), XBEE_TX_PENDIENTE);
+}
+
+PRUEBA(trama_api_que_no_cabe_en_la_ranura_falla) {
+  PuertoSerieFalso puerto;
+  XBeeRadio radio(puerto, 9600, -1, -1);
+  AnilloPaquetesEstatico<3, 16> cola;
+  radio.usarModoAPI();
+  COMPROBAR(radio.iniciar());
+  radio.habilitarTransmisionAsincrona(cola);
+
+  // 9 bytes de cabecera y checksum + 8 de datos no caben en 16
+  uint8_t datos[8] = {0};
+  COMPROBAR(!radio.enviar(datos, sizeof(datos)));
+  COMPROBAR_IGUAL(radio.estadoTransmision(radio.ultimoIdTrama()), XBEE_TX_DESCONOCIDA);
+  COMPROBAR_IGUAL(radio.transmisionesPendientes(), 0);
+  COMPROBAR(radio.enviar(datos, 7));
+  COMPROBAR_IGUAL(radio.estadoTransmision(radio.ultimoIdTrama()), XBEE_TX_PENDIENTE);
+  COMPROBAR_IGUAL(decodificar(puerto.salida()).size(), 5u + 7u);
+}
+
+PRUEBA(cola_se_drena_a_trozos_segun_el_espacio_del_uart) {
+  PuertoSerieFalso puerto(16);
+  XBeeRadio radio(puerto, 9600, -1, -1);
+  AnilloPaquetesEstatico<4, 32> cola;
+  COMPROBAR(radio.iniciar());
+  radio.habilitarTransmisionAsincrona(cola);
+
+  // El buffer TX del UART solo tiene sitio para 5 bytes
+  puerto.limitarEscritura(5);
+  COMPROBAR(radio.enviar("primer mensaje"));
+  COMPROBAR(radio.enviar("segundo"));
+  COMPROBAR_IGUAL(puerto.salida().size(), 5u);
+  COMPROBAR_IGUAL(radio.transmisionesPendientes(), 2);
+  COMPROBAR(!radio.transmisionVaciada());
+
+  // Se libera sitio para 12 bytes más: termina el primero y empieza el segundo
+  puerto.limitarEscritura(12);
+  radio.procesarTransmision();
+  COMPROBAR_IGUAL(puerto.salida().size(), 17u);
+  COMPROBAR_IGUAL(radio.transmisionesPendientes(), 1);
+  COMPROBAR(!radio.transmisionVaciada());
+
+  puerto.limitarEscritura(PuertoSerieFalso::SIN_LIMITE);
+  COMPROBAR(radio.transmisionVaciada());
+  COMPROBAR_IGUAL(radio.transmisionesPendientes(), 0);
+  const char esperado[] = "primer mensajesegundo";
+  COMPROBAR(puerto.salida() == std::vector<uint8_t>(esperado, esperado + sizeof(esperado) - 1));
+}
+
+PRUEBA(cola_no_pierde_bytes_en_una_escritura_corta) {
+  // Sin availableForWrite() (ej. SoftwareSerial) se escribe la trama entera de una vez
+  PuertoSerieFalso puerto(0);
+  XBeeRadio radio(puerto, 9600, -1, -1);
+  AnilloPaquetesEstatico<4, 32> cola;
+  COMPROBAR(radio.iniciar());
+  radio.habilitarTransmisionAsincrona(cola);
+
+  puerto.limitarEscritura(4);
+  COMPROBAR(radio.enviar("abcdefgh"));
+  COMPROBAR_IGUAL(puerto.salida().size(), 4u);
+  COMPROBAR_IGUAL(radio.transmisionesPendientes(), 1);
+
+  puerto.limitarEscritura(PuertoSerieFalso::SIN_LIMITE);
+  radio.procesarTransmision();
+  COMPROBAR_IGUAL(radio.transmisionesPendientes(), 0);
+  const char esperado[] = "abcdefgh";
+  COMPROBAR(puerto.salida() == std::vector<uint8_t>(esperado, esperado + 8));
+}
+
+PRUEBA(cola_llena_rechaza_el_envio) {
+  PuertoSerieFalso puerto;
+  XBeeRadio radio(puerto, 9600, -1, -1);
+  AnilloPaquetesEstatico<3, 16> cola;
+  COMPROBAR(radio.iniciar());
+  radio.habilitarTransmisionAsincrona(cola);
+
+  puerto.limitarEscritura(0);
+  COMPROBAR(radio.enviar("uno"));
+  COMPROBAR(radio.enviar("dos"));
+  COMPROBAR(!radio.enviar("tres"));
+  COMPROBAR_IGUAL(radio.obtenerEstadisticas().rechazosOcupada, 1u);
+  COMPROBAR_IGUAL(radio.transmisionesPendientes(), 2);
+}
+
+int main() { return pruebas::ejecutar(); }
@@ -0,0 +1,451 @@
+/**
+ * @file Arduino.cpp
+ * @brief Implementación del entorno Arduino simulado en el host (ver Arduino.h).
+ */
+
+#include "Arduino.h"
+
+#include <ctype.h>
+#include <stdio.h>
+
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Interrupcion {
+  void (*rutina)(void);
+  int modo;
+  bool pendiente;
+};
+
+struct Entorno {
+  uint64_t ahoraUs;
+  uint64_t secuencia;
+  std::multimap<uint64_t, std::function<void()> > eventos;
+  int niveles[host::NUM_PINES];
+  Interrupcion interrupciones[host::NUM_PINES];
+  std::vector<std::function<void(int)> > observadores[host::NUM_PINES];
+  bool interrupcionesActivas;
+  bool enRutinaInterrupcion;
+  std::function<void()> alEsperar;
+  bool esperando;
+  uint32_t reservasString;
+  uint32_t bytesCopiadosString;
+  uint32_t lecturasReloj;
+  bool serialSilenciado;
+  std::mt19937 aleatorio;
+};
+
+Entorno& entorno() {
+  static Entorno e;
+  return e;
+}
+
+void ejecutarPendientes() {
+  Entorno& e = entorno();
+  if (!e.interrupcionesActivas || e.enRutinaInterrupcion) return;
+  for (uint8_t pin = 0; pin < host::NUM_PINES; ++pin) {
+    Interrupcion& irq = e.interrupciones[pin];
+    if (!irq.pendiente || !irq.rutina) continue;
+    irq.pendiente = false;
+    e.enRutinaInterrupcion = true;
+    irq.rutina();
+    e.enRutinaInterrupcion = false;
+    pin = 0xFF; // Una rutina puede haber dejado otras pendientes: volver a empezar.
+  }
+}
+
+void cambiarNivel(uint8_t pin, int nivel) {
+  Entorno& e = entorno();
+  if (pin >= host::NUM_PINES) return;
+  int anterior = e.niveles[pin];
+  nivel = nivel ? HIGH : LOW;
+  if (anterior == nivel) return;
+  e.niveles[pin] = nivel;
+
+  // Copia: un observador puede registrar otros mientras se recorre la lista.
+  std::vector<std::function<void(int)> > observadores = e.observadores[pin];
+  for (size_t i = 0; i < observadores.size(); ++i) observadores[i](nivel);
+
+  Interrupcion& irq = e.interrupciones[pin];
+  if (!irq.rutina) return;
+  bool disparo = irq.modo == CHANGE || (irq.modo == RISING && nivel == HIGH) ||
+                 (irq.modo == FALLING && nivel == LOW);
+  if (!disparo) return;
+  irq.pendiente = true;
+  ejecutarPendientes();
+}
+
+void llamarAlEsperar() {
+  Entorno& e = entorno();
+  if (!e.alEsperar || e.esperando) return;
+  e.esperando = true;
+  e.alEsperar();
+  e.esperando = false;
+}
+
+} // namespace
+
+// --- Tiempo ---
+
+unsigned long millis() {
+  entorno().lecturasReloj++;
+  return static_cast<unsigned long>(entorno().ahoraUs / 1000ULL);
+}
+
+unsigned long micros() {
+  entorno().lecturasReloj++;
+  return static_cast<unsigned long>(entorno().ahoraUs);
+}
+
+void delay(unsigned long milisegundos) {
+  for (unsigned long i = 0; i < milisegundos; ++i) {
+    host::avanzarMicros(1000);
+    llamarAlEsperar();
+  }
+  if (milisegundos == 0) llamarAlEsperar();
+}
+
+void delayMicroseconds(unsigned int microsegundos) {
+  host::avanzarMicros(microsegundos);
+}
+
+void yield() {
+  host::avanzarMicros(10);
+  llamarAlEsperar();
+}
+
+// --- Pines e interrupciones ---
+
+void pinMode(uint8_t, uint8_t) {}
+
+void digitalWrite(uint8_t pin, uint8_t nivel) { cambiarNivel(pin, nivel); }
+
+int digitalRead(uint8_t pin) { return pin < host::NUM_PINES ? entorno().niveles[pin] : LOW; }
+
+int digitalPinToInterrupt(uint8_t pin) { return pin < host::NUM_PINES ? pin : NOT_AN_INTERRUPT; }
+
+void attachInterrupt(uint8_t interrupcion, void (*rutina)(void), int modo) {
+  if (interrupcion >= host::NUM_PINES) return;
+  Interrupcion& irq = entorno().interrupciones[interrupcion];
+  irq.rutina = rutina;
+  irq.modo = modo;
+  irq.pendiente = false;
+}
+
+void detachInterrupt(uint8_t interrupcion) {
+  if (interrupcion >= host::NUM_PINES) return;
+  Interrupcion& irq = entorno().interrupciones[interrupcion];
+  irq.rutina = nullptr;
+  irq.pendiente = false;
+}
+
+void noInterrupts() { entorno().interrupcionesActivas = false; }
+
+void interrupts() {
+  entorno().interrupcionesActivas = true;
+  ejecutarPendientes();
+}
+
+// --- Números aleatorios ---
+
+long random(long maximo) {
+  if (maximo <= 0) return 0;
+  return static_cast<long>(entorno().aleatorio() % static_cast<unsigned long>(maximo));
+}
+
+long random(long minimo, long maximo) {
+  if (minimo >= maximo) return minimo;
+  return minimo + random(maximo - minimo);
+}
+
+void randomSeed(unsigned long semilla) {
+  if (semilla != 0) entorno().aleatorio.seed(static_cast<std::mt19937::result_type>(semilla));
+}
+
+// --- Control del entorno ---
+
+namespace host {
+
+void reiniciar() {
+  Entorno& e = entorno();
+  e.ahoraUs = 0;
+  e.secuencia = 0;
+  e.eventos.clear();
+  for (uint8_t pin = 0; pin < NUM_PINES; ++pin) {
+    e.niveles[pin] = LOW;
+    e.interrupciones[pin] = Interrupcion{nullptr, 0, false};
+    e.observadores[pin].clear();
+  }
+  e.interrupcionesActivas = true;
+  e.enRutinaInterrupcion = false;
+  e.alEsperar = nullptr;
+  e.esperando = false;
+  e.reservasString = 0;
+  e.bytesCopiadosString = 0;
+  e.lecturasReloj = 0;
+  e.aleatorio.seed(1);
+}
+
+uint64_t ahoraMicros() { return entorno().ahoraUs; }
+
+void avanzarMicros(uint64_t microsegundos) {
+  Entorno& e = entorno();
+  uint64_t destino = e.ahoraUs + microsegundos;
+  while (!e.eventos.empty() && e.eventos.begin()->first <= destino) {
+    std::multimap<uint64_t, std::function<void()> >::iterator siguiente = e.eventos.begin();
+    if (siguiente->first > e.ahoraUs) e.ahoraUs = siguiente->first;
+    std::function<void()> accion = siguiente->second;
+    e.eventos.erase(siguiente);
+    accion();
+  }
+  if (destino > e.ahoraUs) e.ahoraUs = destino;
+}
+
+bool avanzarHastaEvento() {
+  Entorno& e = entorno();
+  if (e.eventos.empty()) return false;
+  uint64_t instante = e.eventos.begin()->first;
+  avanzarMicros(instante > e.ahoraUs ? instante - e.ahoraUs : 0);
+  return true;
+}
+
+void programar(uint64_t instanteUs, std::function<void()> accion) {
+  entorno().eventos.insert(std::make_pair(instanteUs, accion));
+}
+
+void fijarPin(uint8_t pin, int nivel) { cambiarNivel(pin, nivel); }
+
+int nivelPin(uint8_t pin) { return digitalRead(pin); }
+
+void observarPin(uint8_t pin, std::function<void(int)> observador) {
+  if (pin < NUM_PINES) entorno().observadores[pin].push_back(observador);
+}
+
+void alEsperar(std::function<void()> funcion) { entorno().alEsperar = funcion; }
+
+bool interrupcionesActivas() { return entorno().interrupcionesActivas; }
+
+uint32_t reservasString() { return entorno().reservasString; }
+
+uint32_t bytesCopiadosString() { return entorno().bytesCopiadosString; }
+
+uint32_t lecturasReloj() { return entorno().lecturasReloj; }
+
+void silenciarSerial(bool silenciar) { entorno().serialSilenciado = silenciar; }
+
+} // namespace host
+
+namespace {
+
+struct InicializadorEntorno {
+  InicializadorEntorno() {
+    host::reiniciar();
+    entorno().serialSilenciado = false;
+  }
+} inicializadorEntorno;
+
+} // namespace
+
+// --- String ---
+
+String::String(const char* texto) : _buffer(nullptr), _capacidad(0), _longitud(0) {
+  if (texto) _copiar(texto, static_cast<unsigned int>(strlen(texto)));
+}
+
+String::String(const String& otra) : _buffer(nullptr), _capacidad(0), _longitud(0) {
+  _copiar(otra.c_str(), otra._longitud);
+}
+
+String::String(char caracter) : _buffer(nullptr), _capacidad(0), _longitud(0) {
+  _copiar(&caracter, 1);
+}
+
+String::String(int valor, unsigned char base) : String(static_cast<long>(valor), base) {}
+
+String::String(unsigned int valor, unsigned char base)
+    : String(static_cast<unsigned long>(valor), base) {}
+
+String::String(long valor, unsigned char base) : _buffer(nullptr), _capacidad(0), _longitud(0) {
+  char texto[34];
+  if (base == 16) snprintf(texto, sizeof(texto), "%lx", valor);
+  else snprintf(texto, sizeof(texto), "%ld", valor);
+  _copiar(texto, static_cast<unsigned int>(strlen(texto)));
+}
+
+String::String(unsigned long valor, unsigned char base)
+    : _buffer(nullptr), _capacidad(0), _longitud(0) {
+  char texto[34];
+  if (base == 16) snprintf(texto, sizeof(texto), "%lx", valor);
+  else snprintf(texto, sizeof(texto), "%lu", valor);
+  _copiar(texto, static_cast<unsigned int>(strlen(texto)));
+}
+
+String::~String() { free(_buffer); }
+
+String& String::operator=(const String& otra) {
+  if (this != &otra) _copiar(otra.c_str(), otra._longitud);
+  return *this;
+}
+
+String& String::operator=(const char* texto) {
+  _copiar(texto ? texto : "", texto ? static_cast<unsigned int>(strlen(texto)) : 0);
+  return *this;
+}
+
+unsigned char String::reserve(unsigned int tamano) {
+  if (_buffer && _capacidad >= tamano) return 1;
+  char* nuevo = static_cast<char*>(realloc(_buffer, tamano + 1));
+  if (!nuevo) return 0;
+  if (!_buffer) nuevo[0] = '\0';
+  _buffer = nuevo;
+  _capacidad = tamano;
+  entorno().reservasString++;
+  return 1;
+}
+
+void String::_copiar(const char* texto, unsigned int longitud) {
+  if (!reserve(longitud)) return;
+  memmove(_buffer, texto, longitud);
+  _buffer[longitud] = '\0';
+  _longitud = longitud;
+  entorno().bytesCopiadosString += longitud;
+}
+
+unsigned char String::concat(const char* texto, unsigned int longitud) {
+  if (!texto) return 0;
+  if (!reserve(_longitud + longitud)) return 0;
+  memmove(_buffer + _longitud, texto, longitud);
+  _longitud += longitud;
+  _buffer[_longitud] = '\0';
+  entorno().bytesCopiadosString += longitud;
+  return 1;
+}
+
+unsigned char String::concat(const String& otra) { return concat(otra.c_str(), otra._longitud); }
+
+unsigned char String::concat(const char* texto) {
+  return texto ? concat(texto, static_cast<unsigned int>(strlen(texto))) : 0;
+}
+
+unsigned char String::concat(char caracter) { return concat(&caracter, 1); }
+
+unsigned char String::equals(const String& otra) const {
+  return _longitud == otra._longitud && memcmp(c_str(), otra.c_str(), _longitud) == 0;
+}
+
+unsigned char String::equals(const char* texto) const {
+  return texto && strcmp(c_str(), texto) == 0;
+}
+
+char String::charAt(unsigned int indice) const { return indice < _longitud ? _buffer[indice] : 0; }
+
+int String::indexOf(char caracter) const {
+  const char* encontrado = strchr(c_str(), caracter);
+  return encontrado ? static_cast<int>(encontrado - c_str()) : -1;
+}
+
+int String::indexOf(const char* texto) const {
+  const char* encontrado = strstr(c_str(), texto);
+  return encontrado ? static_cast<int>(encontrado - c_str()) : -1;
+}
+
+String String::substring(unsigned int desde) const { return substring(desde, _longitud); }
+
+String String::substring(unsigned int desde, unsigned int hasta) const {
+  if (desde > hasta) { unsigned int t = desde; desde = hasta; hasta = t; }
+  if (hasta > _longitud) hasta = _longitud;
+  String resultado;
+  if (desde < hasta) resultado.concat(c_str() + desde, hasta - desde);
+  return resultado;
+}
+
+void String::trim() {
+  if (!_buffer || _longitud == 0) return;
+  unsigned int inicio = 0;
+  while (inicio < _longitud && isspace(static_cast<unsigned char>(_buffer[inicio]))) ++inicio;
+  unsigned int fin = _longitud;
+  while (fin > inicio && isspace(static_cast<unsigned char>(_buffer[fin - 1]))) --fin;
+  _longitud = fin - inicio;
+  if (inicio > 0) memmove(_buffer, _buffer + inicio, _longitud);
+  _buffer[_longitud] = '\0';
+}
+
+long String::toInt() const { return atol(c_str()); }
+
+String operator+(const String& a, const String& b) { String r(a); r.concat(b); return r; }
+String operator+(const String& a, const char* b) { String r(a); r.concat(b); return r; }
+String operator+(const char* a, const String& b) { String r(a); r.concat(b); return r; }
+String operator+(const String& a, char b) { String r(a); r.concat(b); return r; }
+
+// --- Print / Stream ---
+
+size_t Print::write(const uint8_t* buffer, size_t longitud) {
+  size_t escritos = 0;
+  while (escritos < longitud && write(buffer[escritos])) ++escritos;
+  return escritos;
+}
+
+size_t Print::print(const String& texto) {
+  return write(reinterpret_cast<const uint8_t*>(texto.c_str()), texto.length());
+}
+
+size_t Print::print(long valor, int base) {
+  char texto[34];
+  if (base == 16) snprintf(texto, sizeof(texto), "%lX", valor);
+  else snprintf(texto, sizeof(texto), "%ld", valor);
+  return write(texto);
+}
+
+size_t Print::print(unsigned long valor, int base) {
+  char texto[34];
+  if (base == 16) snprintf(texto, sizeof(texto), "%lX", valor);
+  else snprintf(texto, sizeof(texto), "%lu", valor);
+  return write(texto);
+}
+
+size_t Print::print(double valor, int decimales) {
+  char texto[48];
+  snprintf(texto, sizeof(texto), "%.*f", decimales, valor);
+  return write(texto);
+}
+
+int Stream::_leerConTiempoLimite() {
+  unsigned long inicio = millis();
+  do {
+    int c = read();
+    if (c >= 0) return c;
+    yield();
+  } while (millis() - inicio < _tiempoLimiteMs);
+  return -1;
+}
+
+size_t Stream::readBytes(uint8_t* buffer, size_t longitud) {
+  size_t leidos = 0;
+  while (leidos < longitud) {
+    int c = _leerConTiempoLimite();
+    if (c < 0) break;
+    buffer[leidos++] = static_cast<uint8_t>(c);
+  }
+  return leidos;
+}
+
+// --- Serial ---
+
+HardwareSerial Serial;
+
+size_t HardwareSerial::write(uint8_t byte) { return write(&byte, 1); }
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t longitud) {
+  if (!entorno().serialSilenciado) fwrite(buffer, 1, longitud, stdout);
+  return longitud;
+}
+
+void HardwareSerial::flush() { fflush(stdout); }
+
+void HardwareSerial::inyectar(const uint8_t* datos, size_t longitud) {
+  if (_inicio == _fin) _inicio = _fin = 0;
+  for (size_t i = 0; i < longitud && _fin < sizeof(_entrada); ++i) _entrada[_fin++] = datos[i];
+}
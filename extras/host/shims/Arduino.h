@@ -0,0 +1,176 @@
+/**
+ * @file Arduino.h
+ * @brief Cabecera de compatibilidad de Arduino para compilar la librería en el host (Linux).
+ * @details Implementa lo que usan `src/` y los ejemplos: tipos, `String`, `Print`/`Stream`,
+ * `Serial`, pines digitales con interrupciones y un reloj virtual. El tiempo no corre
+ * solo: avanza con `delay()`, `delayMicroseconds()`, `yield()` y `host::avanzarMicros()`,
+ * de modo que las pruebas son deterministas y los tiempos en el aire de los drivers
+ * falsos no cuestan tiempo real.
+ *
+ * El espacio de nombres `host` agrupa el control del entorno desde las pruebas (reloj,
+ * eventos programados, niveles de pin y contadores de memoria dinámica de `String`).
+ *
+ * @note Solo para el host; no forma parte de la librería para Arduino.
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <functional>
+
+typedef uint8_t byte;
+typedef bool boolean;
+typedef uint16_t word;
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define DEC 10
+#define HEX 16
+#define BIN 2
+
+#define NOT_AN_INTERRUPT -1
+
+#define PROGMEM
+#define pgm_read_byte(direccion) (*(const uint8_t*)(direccion))
+#define F(texto) (texto)
+
+#define constrain(valor, minimo, maximo) \
+  ((valor) < (minimo) ? (minimo) : ((valor) > (maximo) ? (maximo) : (valor)))
+
+// --- Tiempo (reloj virtual) ---
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long milisegundos);
+void delayMicroseconds(unsigned int microsegundos);
+void yield();
+
+// --- Pines e interrupciones ---
+
+void pinMode(uint8_t pin, uint8_t modo);
+void digitalWrite(uint8_t pin, uint8_t nivel);
+int digitalRead(uint8_t pin);
+int digitalPinToInterrupt(uint8_t pin);
+void attachInterrupt(uint8_t interrupcion, void (*rutina)(void), int modo);
+void detachInterrupt(uint8_t interrupcion);
+void noInterrupts();
+void interrupts();
+
+// --- Números aleatorios ---
+
+long random(long maximo);
+long random(long minimo, long maximo);
+void randomSeed(unsigned long semilla);
+
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
+#include "HardwareSerial.h"
+
+/**
+ * @namespace host
+ * @brief Control del entorno simulado desde pruebas, benchmarks y ejecutables de ejemplo.
+ */
+namespace host {
+
+/// Número de pines digitales simulados.
+const uint8_t NUM_PINES = 64;
+
+/**
+ * @brief Vuelve al estado inicial: reloj a 0, pines a LOW, sin interrupciones ni eventos.
+ */
+void reiniciar();
+
+/**
+ * @brief Tiempo virtual actual en microsegundos (64 bits, no da la vuelta).
+ */
+uint64_t ahoraMicros();
+
+/**
+ * @brief Avanza el reloj virtual, ejecutando en orden los eventos programados que venzan.
+ */
+void avanzarMicros(uint64_t microsegundos);
+
+/**
+ * @brief Avanza el reloj hasta el siguiente evento programado y lo ejecuta.
+ * @return false si no había ningún evento programado (el reloj no se mueve).
+ */
+bool avanzarHastaEvento();
+
+/**
+ * @brief Programa una acción (hardware simulado) para el instante absoluto `instanteUs`.
+ * @details Las acciones con el mismo instante se ejecutan en el orden en que se programaron.
+ */
+void programar(uint64_t instanteUs, std::function<void()> accion);
+
+/**
+ * @brief Fija el nivel de un pin desde "fuera" del MCU (ej. DIO0 de un módulo de radio).
+ * @details Si el pin tiene una interrupción y el flanco coincide, se ejecuta de inmediato,
+ * o al llamar a `interrupts()` si están desactivadas.
+ */
+void fijarPin(uint8_t pin, int nivel);
+
+/**
+ * @brief Nivel actual de un pin, lo haya fijado el MCU o el hardware simulado.
+ */
+int nivelPin(uint8_t pin);
+
+/**
+ * @brief Registra una función que se llama cada vez que cambia el nivel de un pin.
+ * @details La usan los dispositivos SPI simulados para detectar su chip select.
+ */
+void observarPin(uint8_t pin, std::function<void(int)> observador);
+
+/**
+ * @brief Función que se ejecuta en cada espera (`delay()`, `yield()`...).
+ * @details Permite ejecutar otro código (ej. el `loop()` de otro nodo) mientras el sketch
+ * espera. No se llama de forma anidada. `nullptr` la desactiva.
+ */
+void alEsperar(std::function<void()> funcion);
+
+/**
+ * @brief Indica si las interrupciones están activadas (fuera de `noInterrupts()`).
+ */
+bool interrupcionesActivas();
+
+/**
+ * @brief Reservas de memoria dinámica hechas por `String` desde el último `reiniciar()`.
+ */
+uint32_t reservasString();
+
+/**
+ * @brief Bytes copiados por `String` (construcción y concatenación) desde el último `reiniciar()`.
+ */
+uint32_t bytesCopiadosString();
+
+/**
+ * @brief Llamadas a `millis()` y `micros()` desde el último `reiniciar()`.
+ */
+uint32_t lecturasReloj();
+
+/**
+ * @brief Hace que `Serial` no imprima nada (útil en benchmarks).
+ */
+void silenciarSerial(bool silenciar);
+
+} // namespace host
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,104 @@
+/**
+ * @file EnlaceMemoria.h
+ * @brief `RadioInterface` en memoria para probar las capas decoradoras en el host.
+ * @details Dos enlaces conectados con `conectar()` se entregan los paquetes sin pérdidas y
+ * en orden. La prueba puede manipular los paquetes en tránsito con `entrada()` (reordenar,
+ * duplicar, corromper o descartar) y consultar lo enviado con `enviados()`. Los paquetes
+ * mayores que el MTU se rechazan, como en una radio real.
+ */
+
+#ifndef HOST_ENLACE_MEMORIA_H
+#define HOST_ENLACE_MEMORIA_H
+
+#include <RadioInterface.h>
+
+#include <deque>
+#include <vector>
+
+class EnlaceMemoria : public RadioInterface {
+public:
+  typedef std::vector<uint8_t> Paquete;
+
+  /**
+   * @param mtu Tamaño máximo de un paquete (lo que informa `obtenerMTU()`).
+   */
+  explicit EnlaceMemoria(size_t mtu = 255) : _par(nullptr), _mtu(mtu), _vistaTomada(false), _dormidas(0) {}
+
+  void conectar(EnlaceMemoria& par) {
+    _par = &par;
+    par._par = this;
+  }
+
+  /// Descarta los paquetes en tránsito hacia este extremo (ej. mientras el nodo está apagado).
+  void vaciar() { _entrada.clear(); }
+
+  /// Paquetes en tránsito hacia este extremo, el primero es el siguiente que se lee.
+  std::deque<Paquete>& entrada() { return _entrada; }
+
+  /// Paquetes aceptados por `enviar()` en este extremo.
+  const std::vector<Paquete>& enviados() const { return _enviados; }
+
+  /// Llamadas a `dormir()`.
+  uint32_t dormidas() const { return _dormidas; }
+
+  bool iniciar() override { return true; }
+
+  bool enviar(const uint8_t* buffer, size_t longitud) override {
+    if (longitud == 0 || longitud > _mtu) return false;
+    _enviados.push_back(Paquete(buffer, buffer + longitud));
+    if (_par) _par->_entrada.push_back(_enviados.back());
+    return true;
+  }
+
+  bool enviar(const Segmento* segmentos, size_t numSegmentos) override {
+    Paquete paquete;
+    for (size_t i = 0; i < numSegmentos; ++i) {
+      paquete.insert(paquete.end(), segmentos[i].datos, segmentos[i].datos + segmentos[i].longitud);
+    }
+    return enviar(paquete.data(), paquete.size());
+  }
+  using RadioInterface::enviar;
+
+  int hayDatosDisponibles() override { return _entrada.empty() ? 0 : (int)_entrada.front().size(); }
+
+  size_t leer(uint8_t* buffer, size_t maxLongitud) override {
+    if (_entrada.empty()) return 0;
+    size_t longitud = _entrada.front().size() < maxLongitud ? _entrada.front().size() : maxLongitud;
+    memcpy(buffer, _entrada.front().data(), longitud);
+    _entrada.pop_front();
+    _vistaTomada = false;
+    return longitud;
+  }
+
+  bool tomarPaquete(VistaPaquete& vista) override {
+    if (_entrada.empty()) return false;
+    vista.datos = _entrada.front().data();
+    vista.longitud = _entrada.front().size();
+    vista.rssi = 0;
+    _vistaTomada = true;
+    return true;
+  }
+
+  void liberarPaquete() override {
+    if (!_vistaTomada) return;
+    _entrada.pop_front();
+    _vistaTomada = false;
+  }
+
+  size_t obtenerMTU() override { return _mtu; }
+
+  bool dormir() override {
+    _dormidas++;
+    return true;
+  }
+
+private:
+  EnlaceMemoria* _par;
+  size_t _mtu;
+  bool _vistaTomada;
+  uint32_t _dormidas;
+  std::deque<Paquete> _entrada;
+  std::vector<Paquete> _enviados;
+};
+
+#endif // HOST_ENLACE_MEMORIA_H
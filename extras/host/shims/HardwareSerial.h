@@ -0,0 +1,42 @@
+/**
+ * @file HardwareSerial.h
+ * @brief `Serial` del host: escribe en la salida estándar y lee de un buffer que llenan las pruebas.
+ */
+
+#ifndef HOST_HARDWARE_SERIAL_H
+#define HOST_HARDWARE_SERIAL_H
+
+#include "Stream.h"
+
+class HardwareSerial : public Stream {
+public:
+  HardwareSerial() : _inicio(0), _fin(0) {}
+
+  void begin(unsigned long) {}
+  void end() {}
+  operator bool() const { return true; }
+
+  int available() override { return static_cast<int>(_fin - _inicio); }
+  int read() override { return _inicio < _fin ? _entrada[_inicio++] : -1; }
+  int peek() override { return _inicio < _fin ? _entrada[_inicio] : -1; }
+
+  size_t write(uint8_t byte) override;
+  size_t write(const uint8_t* buffer, size_t longitud) override;
+  using Print::write;
+  int availableForWrite() override { return 64; }
+  void flush() override;
+
+  /**
+   * @brief Añade bytes a la entrada, como si llegaran por el puerto.
+   */
+  void inyectar(const uint8_t* datos, size_t longitud);
+
+private:
+  uint8_t _entrada[256];
+  size_t _inicio;
+  size_t _fin;
+};
+
+extern HardwareSerial Serial;
+
+#endif // HOST_HARDWARE_SERIAL_H
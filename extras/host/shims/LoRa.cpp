@@ -0,0 +1,335 @@
+/**
+ * @file LoRa.cpp
+ * @brief Implementación del driver LoRa falso y de su éter (ver LoRa.h).
+ */
+
+#include "LoRa.h"
+
+#include <random>
+#include <vector>
+
+#include "TiempoEnAire.h"
+
+LoRaClass LoRa(true);
+
+namespace {
+
+std::vector<LoRaClass*>& instancias() {
+  static std::vector<LoRaClass*> lista;
+  return lista;
+}
+
+struct Canal {
+  double probabilidadPerdida;
+  std::mt19937 aleatorio;
+  Canal() : probabilidadPerdida(0.0), aleatorio(1) {}
+};
+
+Canal& canal() {
+  static Canal c;
+  return c;
+}
+
+bool perderPaquete() {
+  Canal& c = canal();
+  if (c.probabilidadPerdida <= 0.0) return false;
+  return std::uniform_real_distribution<double>(0.0, 1.0)(c.aleatorio) < c.probabilidadPerdida;
+}
+
+} // namespace
+
+namespace host {
+namespace lora {
+
+void fijarProbabilidadPerdida(double probabilidad, uint32_t semilla) {
+  canal().probabilidadPerdida = probabilidad;
+  canal().aleatorio.seed(semilla);
+}
+
+} // namespace lora
+} // namespace host
+
+LoRaClass::LoRaClass(bool conectadoAPines)
+    : _conectadoAPines(conectadoAPines),
+      _pinSs(LORA_DEFAULT_SS_PIN), _pinReset(LORA_DEFAULT_RESET_PIN), _pinDio0(LORA_DEFAULT_DIO0_PIN),
+      _frecuencia(0), _bw(125000), _preambulo(8),
+      _sf(7), _cr(5), _syncWord(0x12), _potencia(17),
+      _crc(false), _cabeceraImplicita(false),
+      _generacion(0) {
+  reiniciarModulo();
+  instancias().push_back(this);
+}
+
+LoRaClass::~LoRaClass() {
+  std::vector<LoRaClass*>& lista = instancias();
+  for (size_t i = 0; i < lista.size(); ++i) {
+    if (lista[i] == this) { lista.erase(lista.begin() + i); break; }
+  }
+  for (size_t i = 0; i < lista.size(); ++i) {
+    if (lista[i]->_recibiendoDe == this) lista[i]->_recibiendoDe = nullptr;
+  }
+}
+
+void LoRaClass::reiniciarModulo() {
+  _modo = MODO_SLEEP;
+  _banderasIrq = 0;
+  _dio0EnTxDone = false;
+  _longitudTx = 0;
+  _longitudRx = 0;
+  _punteroFifo = 0;
+  _packetIndex = 0;
+  _rssiRecepcion = -40;
+  _rssiUltimo = 0;
+  _recibidos = 0;
+  _sobrescritos = 0;
+  _finUltimaTxUs = 0;
+  _recibiendoDe = nullptr;
+  _colision = false;
+  _onReceive = nullptr;
+  _onTxDone = nullptr;
+  _generacion++;
+  reiniciarLlamadas();
+}
+
+void LoRaClass::setPins(int ss, int reset, int dio0) {
+  _pinSs = ss;
+  _pinReset = reset;
+  _pinDio0 = dio0;
+}
+
+int LoRaClass::begin(long frequency) {
+  _frecuencia = frequency;
+  _banderasIrq = 0;
+  _longitudTx = 0;
+  _longitudRx = 0;
+  _packetIndex = 0;
+  _modo = MODO_STDBY;
+  _llamadas.registros += 12;
+  return 1;
+}
+
+void LoRaClass::end() {
+  _modo = MODO_SLEEP;
+  _llamadas.registros++;
+}
+
+int LoRaClass::beginPacket(int implicitHeader) {
+  _llamadas.beginPacket++;
+  _llamadas.registros++;
+  if (_modo == MODO_TX) return 0;
+  if (_banderasIrq & IRQ_TX_DONE) {
+    _llamadas.registros++;
+    _limpiarBanderas(IRQ_TX_DONE);
+  }
+  _modo = MODO_STDBY;
+  _cabeceraImplicita = implicitHeader != 0;
+  _longitudTx = 0;
+  _punteroFifo = 0;
+  _llamadas.registros += 5;
+  return 1;
+}
+
+int LoRaClass::endPacket(bool async) {
+  _llamadas.endPacket++;
+  if (_onTxDone && async) {
+    _dio0EnTxDone = true;
+    _llamadas.registros++;
+  }
+  _modo = MODO_TX;
+  _llamadas.registros++;
+
+  uint32_t aire = tiempoEnAireLoRaUs(static_cast<uint8_t>(_sf), static_cast<uint32_t>(_bw),
+                                     static_cast<uint8_t>(_cr), _longitudTx,
+                                     static_cast<uint16_t>(_preambulo), _crc, _cabeceraImplicita);
+  std::vector<LoRaClass*>& lista = instancias();
+  for (size_t i = 0; i < lista.size(); ++i) {
+    if (lista[i] != this && lista[i]->_escucha(*this)) lista[i]->_empezarRecepcion(this);
+  }
+  uint32_t generacion = _generacion;
+  host::programar(host::ahoraMicros() + aire, [this, generacion]() {
+    if (_generacion == generacion) _terminarTx();
+  });
+
+  if (!async) {
+    while (!(_banderasIrq & IRQ_TX_DONE)) {
+      _llamadas.registros++;
+      if (!host::avanzarHastaEvento()) break;
+    }
+    _llamadas.registros++;
+    _limpiarBanderas(IRQ_TX_DONE);
+  }
+  return 1;
+}
+
+void LoRaClass::_terminarTx() {
+  _modo = MODO_STDBY;
+  _finUltimaTxUs = host::ahoraMicros();
+  std::vector<LoRaClass*> lista = instancias();
+  for (size_t i = 0; i < lista.size(); ++i) {
+    LoRaClass* receptor = lista[i];
+    if (receptor == this || receptor->_recibiendoDe != this) continue;
+    receptor->_recibiendoDe = nullptr;
+    if (receptor->_colision || !receptor->_escucha(*this) || perderPaquete()) continue;
+    receptor->_entregar(this, _fifo, _longitudTx);
+  }
+  _banderasIrq |= IRQ_TX_DONE;
+  _actualizarDio0();
+}
+
+bool LoRaClass::_escucha(const LoRaClass& emisor) const {
+  return (_modo == MODO_RX_CONTINUO || _modo == MODO_RX_SIMPLE) && _frecuencia == emisor._frecuencia &&
+         _sf == emisor._sf && _bw == emisor._bw && _syncWord == emisor._syncWord;
+}
+
+void LoRaClass::_empezarRecepcion(LoRaClass* emisor) {
+  if (_recibiendoDe) {
+    _colision = true;
+    return;
+  }
+  _recibiendoDe = emisor;
+  _colision = false;
+}
+
+void LoRaClass::_entregar(LoRaClass* emisor, const uint8_t* datos, uint8_t longitud) {
+  (void)emisor;
+  _recibidos++;
+  if (_banderasIrq & IRQ_RX_DONE) _sobrescritos++;
+  memcpy(_fifo, datos, longitud);
+  _longitudRx = longitud;
+  _rssiUltimo = _rssiRecepcion;
+  if (_modo == MODO_RX_SIMPLE) _modo = MODO_STDBY;
+  _banderasIrq |= IRQ_RX_DONE;
+  _actualizarDio0();
+}
+
+void LoRaClass::_actualizarDio0() {
+  if (!_conectadoAPines || _pinDio0 < 0) return;
+  uint8_t mapeada = _dio0EnTxDone ? IRQ_TX_DONE : IRQ_RX_DONE;
+  host::fijarPin(static_cast<uint8_t>(_pinDio0), (_banderasIrq & mapeada) ? HIGH : LOW);
+}
+
+void LoRaClass::_limpiarBanderas(uint8_t banderas) {
+  _banderasIrq &= static_cast<uint8_t>(~banderas);
+  _actualizarDio0();
+}
+
+int LoRaClass::parsePacket(int size) {
+  _llamadas.parsePacket++;
+  int longitud = 0;
+  uint8_t banderas = _banderasIrq;
+  _cabeceraImplicita = size > 0;
+  _llamadas.registros += 2;
+  _limpiarBanderas(banderas);
+
+  if (banderas & IRQ_RX_DONE) {
+    _packetIndex = 0;
+    longitud = _cabeceraImplicita ? size : _longitudRx;
+    _punteroFifo = 0;
+    _modo = MODO_STDBY;
+    _llamadas.registros += 4;
+  } else {
+    _llamadas.registros++;
+    if (_modo != MODO_RX_SIMPLE) {
+      _punteroFifo = 0;
+      _dio0EnTxDone = false;
+      _modo = MODO_RX_SIMPLE;
+      _llamadas.registros += 2;
+    }
+  }
+  return longitud;
+}
+
+int LoRaClass::packetRssi() {
+  _llamadas.registros++;
+  return _rssiUltimo;
+}
+
+float LoRaClass::packetSnr() {
+  _llamadas.registros++;
+  return 9.5f;
+}
+
+size_t LoRaClass::write(uint8_t byte) { return write(&byte, 1); }
+
+size_t LoRaClass::write(const uint8_t* buffer, size_t size) {
+  _llamadas.write++;
+  if (_longitudTx + size > 255) size = 255 - _longitudTx;
+  memcpy(_fifo + _longitudTx, buffer, size);
+  _longitudTx = static_cast<uint8_t>(_longitudTx + size);
+  _llamadas.registros += static_cast<uint32_t>(size) + 2;
+  _llamadas.bytes += static_cast<uint32_t>(size);
+  return size;
+}
+
+int LoRaClass::available() {
+  _llamadas.available++;
+  _llamadas.registros++;
+  return _longitudRx - _packetIndex;
+}
+
+int LoRaClass::read() {
+  _llamadas.read++;
+  _llamadas.registros++;
+  if (_longitudRx - _packetIndex <= 0) return -1;
+  _packetIndex++;
+  _llamadas.registros++;
+  _llamadas.bytes++;
+  return _fifo[_punteroFifo++];
+}
+
+int LoRaClass::peek() {
+  _llamadas.registros++;
+  if (_longitudRx - _packetIndex <= 0) return -1;
+  _llamadas.registros += 3;
+  return _fifo[_punteroFifo];
+}
+
+void LoRaClass::onReceive(void (*callback)(int)) {
+  _onReceive = callback;
+  if (!_conectadoAPines) return;
+  if (callback) attachInterrupt(digitalPinToInterrupt(static_cast<uint8_t>(_pinDio0)), _onDio0Rise, RISING);
+  else detachInterrupt(digitalPinToInterrupt(static_cast<uint8_t>(_pinDio0)));
+}
+
+void LoRaClass::onTxDone(void (*callback)()) {
+  _onTxDone = callback;
+  if (!_conectadoAPines) return;
+  if (callback) attachInterrupt(digitalPinToInterrupt(static_cast<uint8_t>(_pinDio0)), _onDio0Rise, RISING);
+  else detachInterrupt(digitalPinToInterrupt(static_cast<uint8_t>(_pinDio0)));
+}
+
+void LoRaClass::receive(int size) {
+  _cabeceraImplicita = size > 0;
+  _dio0EnTxDone = false;
+  _modo = MODO_RX_CONTINUO;
+  _llamadas.registros += 3;
+  _actualizarDio0();
+}
+
+void LoRaClass::idle() {
+  _modo = MODO_STDBY;
+  _llamadas.registros++;
+}
+
+void LoRaClass::sleep() {
+  _modo = MODO_SLEEP;
+  _recibiendoDe = nullptr;
+  _llamadas.registros++;
+}
+
+void LoRaClass::_onDio0Rise() { LoRa._handleDio0Rise(); }
+
+void LoRaClass::_handleDio0Rise() {
+  uint8_t banderas = _banderasIrq;
+  _llamadas.registros += 2;
+  _limpiarBanderas(banderas);
+  if (banderas & IRQ_RX_DONE) {
+    _packetIndex = 0;
+    int longitud = _longitudRx;
+    _punteroFifo = 0;
+    _llamadas.registros += 3;
+    if (_onReceive) _onReceive(longitud);
+  } else if (banderas & IRQ_TX_DONE) {
+    if (_onTxDone) _onTxDone();
+  }
+}
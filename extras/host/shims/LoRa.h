@@ -0,0 +1,177 @@
+/**
+ * @file LoRa.h
+ * @brief Versión falsa en memoria de la librería LoRa de Sandeep Mistry para el host.
+ * @details Reproduce la API y la semántica que usa `LoraNucleo`: `parsePacket()` limpia las
+ * banderas de IRQ y, si no había paquete, rearma RX_SINGLE; `onReceive()`/`onTxDone()`
+ * enganchan la interrupción en el pin DIO0 configurado *en el momento de la llamada*;
+ * `read()` cuesta una lectura de RX_NB_BYTES más una del FIFO.
+ *
+ * Todas las instancias comparten un "éter": lo que transmite una llega a las demás que
+ * estén escuchando en la misma frecuencia, SF, ancho de banda y sync word, al final de su
+ * tiempo en el aire (reloj virtual). Solo la instancia global `LoRa` maneja su pin DIO0;
+ * las demás hacen de nodo par en pruebas y se consultan por sondeo.
+ *
+ * Además de la API de la librería, cuenta las llamadas y los accesos a registro que haría
+ * la librería real (ver `LlamadasLoRa`), para los benchmarks.
+ */
+
+#ifndef HOST_LORA_H
+#define HOST_LORA_H
+
+#include <Arduino.h>
+#include <SPI.h>
+
+#define LORA_DEFAULT_SS_PIN 10
+#define LORA_DEFAULT_RESET_PIN 9
+#define LORA_DEFAULT_DIO0_PIN 2
+
+#define PA_OUTPUT_RFO_PIN 0
+#define PA_OUTPUT_PA_BOOST_PIN 1
+
+/**
+ * @brief Contadores de uso del driver falso.
+ * @details `registros` suma los accesos a registro SPI que haría la librería real para las
+ * mismas llamadas (ej. `read()` = 2, `write(buf, n)` = n + 2).
+ */
+struct LlamadasLoRa {
+  uint32_t parsePacket;
+  uint32_t available;
+  uint32_t read;
+  uint32_t write;
+  uint32_t beginPacket;
+  uint32_t endPacket;
+  uint32_t registros;
+  uint32_t bytes; ///< Bytes escritos en la FIFO con `write()` o leídos con `read()`.
+};
+
+class LoRaClass : public Stream {
+public:
+  /**
+   * @param conectadoAPines true solo para la instancia global `LoRa`: maneja el pin DIO0.
+   */
+  explicit LoRaClass(bool conectadoAPines = false);
+  ~LoRaClass();
+
+  int begin(long frequency);
+  void end();
+
+  int beginPacket(int implicitHeader = false);
+  int endPacket(bool async = false);
+
+  int parsePacket(int size = 0);
+  int packetRssi();
+  float packetSnr();
+
+  size_t write(uint8_t byte) override;
+  size_t write(const uint8_t* buffer, size_t size) override;
+  using Print::write;
+
+  int available() override;
+  int read() override;
+  int peek() override;
+  void flush() override {}
+
+  void onReceive(void (*callback)(int));
+  void onTxDone(void (*callback)());
+
+  void receive(int size = 0);
+  void idle();
+  void sleep();
+
+  void setTxPower(int level, int outputPin = PA_OUTPUT_PA_BOOST_PIN) { (void)outputPin; _potencia = level; }
+  void setFrequency(long frequency) { _frecuencia = frequency; }
+  void setSpreadingFactor(int sf) { _sf = sf < 6 ? 6 : (sf > 12 ? 12 : sf); }
+  void setSignalBandwidth(long sbw) { _bw = sbw; }
+  void setCodingRate4(int denominator) { _cr = denominator < 5 ? 5 : (denominator > 8 ? 8 : denominator); }
+  void setPreambleLength(long length) { _preambulo = length; }
+  void setSyncWord(int sw) { _syncWord = sw; }
+  void enableCrc() { _crc = true; }
+  void disableCrc() { _crc = false; }
+
+  void setPins(int ss = LORA_DEFAULT_SS_PIN, int reset = LORA_DEFAULT_RESET_PIN, int dio0 = LORA_DEFAULT_DIO0_PIN);
+  void setSPI(SPIClass&) {}
+  void setSPIFrequency(uint32_t) {}
+
+  // --- Extensiones del host ---
+
+  /// Contadores desde el último `reiniciarLlamadas()`.
+  const LlamadasLoRa& llamadas() const { return _llamadas; }
+  void reiniciarLlamadas() { memset(&_llamadas, 0, sizeof(_llamadas)); }
+
+  /// RSSI (dBm) con que este módulo recibe los paquetes.
+  void fijarRssiRecepcion(int rssi) { _rssiRecepcion = rssi; }
+
+  /// Paquetes que han llegado al módulo (leídos o no).
+  uint32_t paquetesRecibidos() const { return _recibidos; }
+
+  /// Paquetes recibidos que se perdieron por no haberse leído antes de que llegara otro.
+  uint32_t paquetesSobrescritos() const { return _sobrescritos; }
+
+  /// true mientras está transmitiendo.
+  bool transmitiendo() const { return _modo == MODO_TX; }
+
+  /// Instante (reloj virtual) en que terminó la última transmisión.
+  uint64_t finUltimaTxUs() const { return _finUltimaTxUs; }
+
+  /// Vuelve al estado de encendido, sin callbacks y con los contadores a cero.
+  void reiniciarModulo();
+
+private:
+  enum Modo { MODO_SLEEP, MODO_STDBY, MODO_TX, MODO_RX_CONTINUO, MODO_RX_SIMPLE };
+
+  static const uint8_t IRQ_TX_DONE = 0x08;
+  static const uint8_t IRQ_RX_DONE = 0x40;
+
+  bool _conectadoAPines;
+  int _pinSs, _pinReset, _pinDio0;
+  long _frecuencia, _bw, _preambulo;
+  int _sf, _cr, _syncWord, _potencia;
+  bool _crc, _cabeceraImplicita;
+
+  Modo _modo;
+  uint8_t _banderasIrq;
+  bool _dio0EnTxDone;
+  uint8_t _fifo[256];
+  uint8_t _longitudTx;
+  uint8_t _longitudRx;
+  uint8_t _punteroFifo;
+  int _packetIndex;
+  int _rssiRecepcion, _rssiUltimo;
+  uint32_t _recibidos;
+  uint32_t _sobrescritos;
+  uint64_t _finUltimaTxUs;
+  uint32_t _generacion;
+
+  LoRaClass* _recibiendoDe;
+  bool _colision;
+
+  void (*_onReceive)(int);
+  void (*_onTxDone)();
+
+  LlamadasLoRa _llamadas;
+
+  void _actualizarDio0();
+  void _limpiarBanderas(uint8_t banderas);
+  void _terminarTx();
+  void _empezarRecepcion(LoRaClass* emisor);
+  void _entregar(LoRaClass* emisor, const uint8_t* datos, uint8_t longitud);
+  bool _escucha(const LoRaClass& emisor) const;
+
+  static void _onDio0Rise();
+  void _handleDio0Rise();
+};
+
+extern LoRaClass LoRa;
+
+namespace host {
+namespace lora {
+
+/**
+ * @brief Probabilidad (0-1) de que un paquete se pierda en el éter. Determinista por semilla.
+ */
+void fijarProbabilidadPerdida(double probabilidad, uint32_t semilla = 1);
+
+} // namespace lora
+} // namespace host
+
+#endif // HOST_LORA_H
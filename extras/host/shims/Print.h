@@ -0,0 +1,43 @@
+/**
+ * @file Print.h
+ * @brief Clase `Print` de Arduino para el host.
+ */
+
+#ifndef HOST_PRINT_H
+#define HOST_PRINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+class String;
+
+class Print {
+public:
+  virtual ~Print() {}
+
+  virtual size_t write(uint8_t byte) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t longitud);
+  size_t write(const char* texto) { return texto ? write(reinterpret_cast<const uint8_t*>(texto), strlen(texto)) : 0; }
+  size_t write(const char* buffer, size_t longitud) { return write(reinterpret_cast<const uint8_t*>(buffer), longitud); }
+
+  virtual int availableForWrite() { return 0; }
+  virtual void flush() {}
+
+  size_t print(const char* texto) { return write(texto); }
+  size_t print(const String& texto);
+  size_t print(char caracter) { return write(static_cast<uint8_t>(caracter)); }
+  size_t print(int valor, int base = 10) { return print(static_cast<long>(valor), base); }
+  size_t print(unsigned int valor, int base = 10) { return print(static_cast<unsigned long>(valor), base); }
+  size_t print(long valor, int base = 10);
+  size_t print(unsigned long valor, int base = 10);
+  size_t print(double valor, int decimales = 2);
+
+  size_t println() { return write("\r\n"); }
+  template <typename T>
+  size_t println(const T& valor) { size_t n = print(valor); return n + println(); }
+  template <typename T>
+  size_t println(const T& valor, int formato) { size_t n = print(valor, formato); return n + println(); }
+};
+
+#endif // HOST_PRINT_H
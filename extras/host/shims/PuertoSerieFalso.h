@@ -0,0 +1,101 @@
+/**
+ * @file PuertoSerieFalso.h
+ * @brief `Stream` en memoria para el host: un UART cuyo otro extremo es otro puerto falso.
+ * @details Dos puertos conectados con `conectar()` forman un enlace en bucle (lo que uno
+ * escribe, el otro lo lee), que es lo que ven dos XBee en modo transparente. Sin conectar,
+ * lo escrito se acumula en `salida()`. `limitarEscritura()` provoca escrituras cortas
+ * para probar la gestión de errores del llamador.
+ */
+
+#ifndef HOST_PUERTO_SERIE_FALSO_H
+#define HOST_PUERTO_SERIE_FALSO_H
+
+#include <Arduino.h>
+
+#include <deque>
+#include <vector>
+
+class PuertoSerieFalso : public Stream {
+public:
+  static const size_t SIN_LIMITE = static_cast<size_t>(-1);
+
+  /**
+   * @param capacidadTx Lo que informa `availableForWrite()` (buffer TX del UART).
+   */
+  explicit PuertoSerieFalso(int capacidadTx = 63)
+      : _otro(nullptr), _capacidadTx(capacidadTx), _limite(SIN_LIMITE), _escrituras(0), _lecturas(0),
+        _consultas(0), _bytes(0) {}
+
+  /// Conecta los dos puertos entre sí (en ambos sentidos).
+  void conectar(PuertoSerieFalso& otro) {
+    _otro = &otro;
+    otro._otro = this;
+  }
+
+  int available() override {
+    _consultas++;
+    return static_cast<int>(_entrada.size());
+  }
+
+  int read() override {
+    _lecturas++;
+    if (_entrada.empty()) return -1;
+    _bytes++;
+    uint8_t byte = _entrada.front();
+    _entrada.pop_front();
+    return byte;
+  }
+
+  int peek() override { return _entrada.empty() ? -1 : _entrada.front(); }
+
+  size_t write(uint8_t byte) override { return write(&byte, 1); }
+
+  size_t write(const uint8_t* buffer, size_t longitud) override {
+    _escrituras++;
+    if (_limite != SIN_LIMITE) {
+      if (longitud > _limite) longitud = _limite;
+      _limite -= longitud;
+    }
+    _bytes += static_cast<uint32_t>(longitud);
+    if (_otro) _otro->_entrada.insert(_otro->_entrada.end(), buffer, buffer + longitud);
+    _salida.insert(_salida.end(), buffer, buffer + longitud);
+    return longitud;
+  }
+  using Print::write;
+
+  int availableForWrite() override {
+    if (_limite != SIN_LIMITE && _limite < static_cast<size_t>(_capacidadTx)) return static_cast<int>(_limite);
+    return _capacidadTx;
+  }
+
+  /// Añade bytes a la entrada, como si los hubiera enviado el otro extremo.
+  void inyectar(const uint8_t* datos, size_t longitud) { _entrada.insert(_entrada.end(), datos, datos + longitud); }
+
+  /// A partir de ahora acepta solo `bytes` bytes más; el resto de cada escritura se descarta.
+  void limitarEscritura(size_t bytes) { _limite = bytes; }
+
+  /// Todo lo escrito en el puerto.
+  const std::vector<uint8_t>& salida() const { return _salida; }
+  void borrarSalida() { _salida.clear(); }
+
+  /// Llamadas a `write()` / `read()` / `available()`.
+  uint32_t escrituras() const { return _escrituras; }
+  uint32_t lecturas() const { return _lecturas; }
+  uint32_t consultas() const { return _consultas; }
+  /// Bytes aceptados por `write()` más bytes entregados por `read()`.
+  uint32_t bytes() const { return _bytes; }
+  void reiniciarContadores() { _escrituras = _lecturas = _consultas = _bytes = 0; }
+
+private:
+  PuertoSerieFalso* _otro;
+  int _capacidadTx;
+  size_t _limite;
+  std::deque<uint8_t> _entrada;
+  std::vector<uint8_t> _salida;
+  uint32_t _escrituras;
+  uint32_t _lecturas;
+  uint32_t _consultas;
+  uint32_t _bytes;
+};
+
+#endif // HOST_PUERTO_SERIE_FALSO_H
@@ -0,0 +1,439 @@
+/**
+ * @file RF24.cpp
+ * @brief Implementación del driver RF24 falso y de su éter (ver RF24.h).
+ */
+
+#include "RF24.h"
+
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<RF24*>& instancias() {
+  static std::vector<RF24*> lista;
+  return lista;
+}
+
+struct Canal {
+  double probabilidadPerdida;
+  std::mt19937 aleatorio;
+  Canal() : probabilidadPerdida(0.0), aleatorio(1) {}
+};
+
+Canal& canal() {
+  static Canal c;
+  return c;
+}
+
+bool perderIntento() {
+  Canal& c = canal();
+  if (c.probabilidadPerdida <= 0.0) return false;
+  return std::uniform_real_distribution<double>(0.0, 1.0)(c.aleatorio) < c.probabilidadPerdida;
+}
+
+} // namespace
+
+namespace host {
+namespace nrf {
+
+void fijarProbabilidadPerdida(double probabilidad, uint32_t semilla) {
+  canal().probabilidadPerdida = probabilidad;
+  canal().aleatorio.seed(semilla);
+}
+
+} // namespace nrf
+} // namespace host
+
+RF24::RF24(uint16_t cePin, uint16_t csnPin)
+    : _pinCe(static_cast<uint8_t>(cePin)), _pinCsn(static_cast<uint8_t>(csnPin)), _conectadoSpi(false),
+      _canal(76), _tasa(RF24_1MBPS), _potencia(RF24_PA_MAX), _retardoReintento(5), _reintentos(15),
+      _autoAck(true), _payloadsDinamicos(false), _payloadsEnAck(false), _retardoTx(280),
+      _tubo0Lectura(false), _configCache(0x08), _configChip(0x08), _ce(false), _listoDesdeUs(0),
+      _banderaTxDs(false), _banderaMaxRt(false), _transmitiendo(false), _hayRespuesta(false), _intento(0),
+      _generacion(0), _vivo(new bool(true)), _comandoSpi(0), _bytesTransaccion(0),
+      _confirmados(0), _recibidos(0), _consumirAlRecibir(false), _rechazadosRx(0) {
+  memset(_direccionTx, 0xE7, sizeof(_direccionTx));
+  memset(_direccionTubo, 0xC2, sizeof(_direccionTubo));
+  memset(_direccionTubo[0], 0xE7, sizeof(_direccionTubo[0]));
+  memset(_direccionLecturaTubo0, 0, sizeof(_direccionLecturaTubo0));
+  for (uint8_t i = 0; i < 6; ++i) _tuboAbierto[i] = i < 2;
+  reiniciarLlamadas();
+  instancias().push_back(this);
+}
+
+RF24::~RF24() {
+  std::vector<RF24*>& lista = instancias();
+  for (size_t i = 0; i < lista.size(); ++i) {
+    if (lista[i] == this) { lista.erase(lista.begin() + i); break; }
+  }
+  if (_conectadoSpi) host::desconectarSpi(this);
+}
+
+bool RF24::begin() {
+  if (_conectadoSpi) host::desconectarSpi(this);
+  host::conectarSpi(_pinCsn, this);
+  _conectadoSpi = true;
+  // El sketch también puede mover CE directamente (ej. al dormir sin pasar por la librería)
+  std::weak_ptr<bool> vivo = _vivo;
+  host::observarPin(_pinCe, [this, vivo](int nivel) {
+    if (vivo.expired()) return;
+    _ce = nivel == HIGH;
+    _evaluarTx();
+  });
+
+  _fijarCe(false);
+  delay(5);
+  _generacion++;
+  _transmitiendo = false;
+  _fifoRx.clear();
+  _fifoTx.clear();
+  _banderaTxDs = _banderaMaxRt = false;
+  _payloadsDinamicos = _payloadsEnAck = false;
+  _tubo0Lectura = false;
+  _confirmados = _recibidos = _rechazadosRx = 0;
+  setRetries(5, 15);
+  setDataRate(RF24_1MBPS);
+  _configCache = 0x0C;
+  _escribirConfig(_configCache);
+  powerUp();
+  return true;
+}
+
+bool RF24::setDataRate(rf24_datarate_e speed) {
+  _tasa = speed;
+  _retardoTx = speed == RF24_250KBPS ? 505 : (speed == RF24_2MBPS ? 240 : 280);
+  return true;
+}
+
+void RF24::openWritingPipe(const uint8_t* address) {
+  memcpy(_direccionTx, address, 5);
+  memcpy(_direccionTubo[0], address, 5);
+}
+
+void RF24::openReadingPipe(uint8_t number, const uint8_t* address) {
+  if (number > 5) return;
+  if (number == 0) {
+    memcpy(_direccionLecturaTubo0, address, 5);
+    _tubo0Lectura = true;
+  }
+  memcpy(_direccionTubo[number], address, number < 2 ? 5 : 1);
+  _tuboAbierto[number] = true;
+}
+
+void RF24::startListening() {
+  _contar(&LlamadasRF24::startListening);
+  _configCache |= (1 << PRIM_RX);
+  _escribirConfig(_configCache);
+  _banderaTxDs = _banderaMaxRt = false;
+  _fijarCe(true);
+  if (_tubo0Lectura) memcpy(_direccionTubo[0], _direccionLecturaTubo0, 5);
+  else _tuboAbierto[0] = false;
+}
+
+void RF24::stopListening() {
+  _contar(&LlamadasRF24::stopListening);
+  _fijarCe(false);
+  delayMicroseconds(_retardoTx);
+  if (_payloadsEnAck) flush_tx();
+  _configCache &= static_cast<uint8_t>(~(1 << PRIM_RX));
+  _escribirConfig(_configCache);
+  _tuboAbierto[0] = true;
+}
+
+bool RF24::write(const void* buf, uint8_t len) {
+  _contar(&LlamadasRF24::write);
+  _contarBytes(len);
+  if (_fifoTx.size() < NIVELES_FIFO) {
+    Paquete paquete;
+    paquete.longitud = len > 32 ? 32 : len;
+    paquete.tubo = 0;
+    memcpy(paquete.datos, buf, paquete.longitud);
+    _fifoTx.push_back(paquete);
+  }
+  _fijarCe(true);
+  while (!_banderaTxDs && !_banderaMaxRt) {
+    if (!host::avanzarHastaEvento()) break;
+  }
+  _fijarCe(false);
+  bool fallo = _banderaMaxRt || !_banderaTxDs;
+  _banderaTxDs = _banderaMaxRt = false;
+  if (fallo) {
+    flush_tx();
+    return false;
+  }
+  return true;
+}
+
+bool RF24::writeFast(const void* buf, uint8_t len) {
+  _contar(&LlamadasRF24::writeFast);
+  _contarBytes(len);
+  while (_fifoTx.size() >= NIVELES_FIFO) {
+    if (_banderaMaxRt) return false;
+    if (!host::avanzarHastaEvento()) return false;
+  }
+  Paquete paquete;
+  paquete.longitud = len > 32 ? 32 : len;
+  paquete.tubo = 0;
+  memcpy(paquete.datos, buf, paquete.longitud);
+  _fifoTx.push_back(paquete);
+  _fijarCe(true);
+  return true;
+}
+
+bool RF24::txStandBy() {
+  _contar(&LlamadasRF24::txStandBy);
+  while (!_fifoTx.empty()) {
+    if (_banderaMaxRt) {
+      _banderaMaxRt = false;
+      _fijarCe(false);
+      flush_tx();
+      return false;
+    }
+    if (!host::avanzarHastaEvento()) break;
+  }
+  _fijarCe(false);
+  return true;
+}
+
+bool RF24::writeAckPayload(uint8_t pipe, const void* buf, uint8_t len) {
+  if (!_payloadsEnAck || _fifoTx.size() >= NIVELES_FIFO) return false;
+  Paquete paquete;
+  paquete.longitud = len > 32 ? 32 : len;
+  paquete.tubo = pipe & 0x07;
+  memcpy(paquete.datos, buf, paquete.longitud);
+  _fifoTx.push_back(paquete);
+  return true;
+}
+
+bool RF24::available() { return available(nullptr); }
+
+bool RF24::available(uint8_t* pipe_num) {
+  _contar(&LlamadasRF24::available);
+  if (_fifoRx.empty()) return false;
+  if (pipe_num) *pipe_num = _fifoRx.front().tubo;
+  return true;
+}
+
+uint8_t RF24::getDynamicPayloadSize() {
+  _contar(&LlamadasRF24::getDynamicPayloadSize);
+  return _fifoRx.empty() ? 0 : _fifoRx.front().longitud;
+}
+
+void RF24::read(void* buf, uint8_t len) {
+  _contar(&LlamadasRF24::read);
+  _contarBytes(len);
+  uint8_t* destino = static_cast<uint8_t*>(buf);
+  if (_fifoRx.empty()) {
+    memset(destino, 0, len);
+    return;
+  }
+  const Paquete& paquete = _fifoRx.front();
+  uint8_t copiar = len < paquete.longitud ? len : paquete.longitud;
+  memcpy(destino, paquete.datos, copiar);
+  if (copiar < len) memset(destino + copiar, 0, len - copiar);
+  _fifoRx.pop_front();
+}
+
+bool RF24::rxFifoFull() { return _fifoRx.size() >= NIVELES_FIFO; }
+
+uint8_t RF24::flush_tx() {
+  if (!_transmitiendo) _fifoTx.clear();
+  else if (!_fifoTx.empty()) _fifoTx.erase(_fifoTx.begin() + 1, _fifoTx.end());
+  return 0;
+}
+
+uint8_t RF24::flush_rx() {
+  _fifoRx.clear();
+  return 0;
+}
+
+void RF24::powerUp() {
+  _contar(&LlamadasRF24::powerUp);
+  if (_configCache & (1 << PWR_UP)) return;
+  _configCache |= (1 << PWR_UP);
+  _escribirConfig(_configCache);
+  delayMicroseconds(RF24_POWERUP_DELAY);
+}
+
+void RF24::powerDown() {
+  _fijarCe(false);
+  _configCache &= static_cast<uint8_t>(~(1 << PWR_UP));
+  _escribirConfig(_configCache);
+}
+
+uint8_t RF24::transferir(uint8_t dato) {
+  if (_bytesTransaccion++ == 0) {
+    _comandoSpi = dato;
+    uint8_t tuboRx = _fifoRx.empty() ? 0x07 : _fifoRx.front().tubo;
+    return static_cast<uint8_t>((_fifoRx.empty() ? 0 : (1 << RX_DR)) | (_banderaTxDs ? (1 << TX_DS) : 0) |
+                                (_banderaMaxRt ? (1 << MAX_RT) : 0) | (tuboRx << 1) |
+                                (_fifoTx.size() >= NIVELES_FIFO ? 0x01 : 0));
+  }
+  if (_comandoSpi == RF24_NOP) return 0;
+  uint8_t registro = _comandoSpi & REGISTER_MASK;
+  if ((_comandoSpi & 0xE0) == R_REGISTER) return registro == NRF_CONFIG ? _configChip : 0;
+  if ((_comandoSpi & 0xE0) == W_REGISTER && registro == NRF_CONFIG && _bytesTransaccion == 2) {
+    _escribirConfig(dato);
+  }
+  return 0;
+}
+
+void RF24::_escribirConfig(uint8_t valor) {
+  uint8_t anterior = _configChip;
+  _configChip = valor;
+  bool antes = (anterior & (1 << PWR_UP)) != 0;
+  bool ahora = (valor & (1 << PWR_UP)) != 0;
+  if (!antes && ahora) _listoDesdeUs = host::ahoraMicros() + ARRANQUE_US;
+  if (antes && !ahora) {
+    _generacion++;
+    _transmitiendo = false;
+  }
+  _evaluarTx();
+}
+
+void RF24::_fijarCe(bool nivel) {
+  _ce = nivel;
+  digitalWrite(_pinCe, nivel ? HIGH : LOW);
+  _evaluarTx();
+}
+
+bool RF24::_escuchando() const {
+  return encendido() && host::ahoraMicros() >= _listoDesdeUs && _ce && (_configChip & (1 << PRIM_RX));
+}
+
+bool RF24::_aceptaDireccion(const uint8_t* direccion, uint8_t& tubo) const {
+  for (uint8_t p = 0; p < 6; ++p) {
+    if (!_tuboAbierto[p]) continue;
+    bool coincide = p < 2 ? memcmp(direccion, _direccionTubo[p], 5) == 0
+                          : direccion[0] == _direccionTubo[p][0] &&
+                                memcmp(direccion + 1, _direccionTubo[1] + 1, 4) == 0;
+    if (coincide) {
+      tubo = p;
+      return true;
+    }
+  }
+  return false;
+}
+
+uint32_t RF24::_tiempoAireUs(uint8_t longitud) const {
+  // Preámbulo + dirección + campo de control (9 bits) + payload + CRC de 2 bytes.
+  uint32_t bits = 8u * (1u + 5u + longitud + 2u) + 9u;
+  if (_tasa == RF24_250KBPS) return bits * 4u;
+  if (_tasa == RF24_2MBPS) return (bits + 1u) / 2u;
+  return bits;
+}
+
+LlamadasRF24& RF24::llamadasTotales() {
+  static LlamadasRF24 totales = LlamadasRF24();
+  return totales;
+}
+
+void RF24::_contar(uint32_t LlamadasRF24::*campo) {
+  _llamadas.*campo += 1;
+  llamadasTotales().*campo += 1;
+}
+
+void RF24::_contarBytes(uint8_t longitud) {
+  _llamadas.bytes += longitud;
+  llamadasTotales().bytes += longitud;
+}
+
+void RF24::_programar(uint64_t instanteUs, void (RF24::*metodo)()) {
+  std::weak_ptr<bool> vivo = _vivo;
+  uint32_t generacion = _generacion;
+  RF24* radio = this;
+  host::programar(instanteUs, [vivo, generacion, radio, metodo]() {
+    if (vivo.expired() || radio->_generacion != generacion) return;
+    (radio->*metodo)();
+  });
+}
+
+void RF24::_evaluarTx() {
+  if (_transmitiendo || !encendido() || !_ce || (_configChip & (1 << PRIM_RX)) || _banderaMaxRt) return;
+  if (_fifoTx.empty()) return;
+  _transmitiendo = true;
+  _intento = 0;
+  uint64_t inicio = host::ahoraMicros();
+  if (inicio < _listoDesdeUs) inicio = _listoDesdeUs;
+  _programar(inicio + ASENTAMIENTO_US, &RF24::_intentarEnvio);
+}
+
+void RF24::_intentarEnvio() {
+  if (_fifoTx.empty()) {
+    _transmitiendo = false;
+    return;
+  }
+  _programar(host::ahoraMicros() + _tiempoAireUs(_fifoTx.front().longitud), &RF24::_finAire);
+}
+
+void RF24::_finAire() {
+  if (_fifoTx.empty()) {
+    _transmitiendo = false;
+    return;
+  }
+  const Paquete& paquete = _fifoTx.front();
+  RF24* receptor = nullptr;
+  uint8_t tubo = 0;
+  std::vector<RF24*>& lista = instancias();
+  for (size_t i = 0; i < lista.size() && !receptor; ++i) {
+    RF24* candidato = lista[i];
+    if (candidato == this || !candidato->_escuchando() || candidato->_canal != _canal ||
+        candidato->_tasa != _tasa) {
+      continue;
+    }
+    if (candidato->_aceptaDireccion(_direccionTx, tubo)) receptor = candidato;
+  }
+
+  bool entregado = false;
+  _hayRespuesta = false;
+  if (receptor && !perderIntento()) {
+    if (receptor->_fifoRx.size() >= NIVELES_FIFO) {
+      receptor->_rechazadosRx++;
+    } else {
+      Paquete recibido = paquete;
+      recibido.tubo = tubo;
+      receptor->_recibidos++;
+      if (!receptor->_consumirAlRecibir) receptor->_fifoRx.push_back(recibido);
+      entregado = true;
+      if (receptor->_payloadsEnAck) {
+        for (std::deque<Paquete>::iterator it = receptor->_fifoTx.begin(); it != receptor->_fifoTx.end(); ++it) {
+          if (it->tubo == tubo) {
+            _respuesta = *it;
+            _respuesta.tubo = 0;
+            _hayRespuesta = true;
+            receptor->_fifoTx.erase(it);
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  if (!_autoAck) {
+    _terminarEnvio();
+    return;
+  }
+  if (entregado) {
+    uint8_t longitudAck = _hayRespuesta ? _respuesta.longitud : 0;
+    _programar(host::ahoraMicros() + ASENTAMIENTO_US + _tiempoAireUs(longitudAck), &RF24::_terminarEnvio);
+    return;
+  }
+  if (_intento < _reintentos) {
+    _intento++;
+    _programar(host::ahoraMicros() + 250u * (_retardoReintento + 1u), &RF24::_intentarEnvio);
+    return;
+  }
+  _banderaMaxRt = true;
+  _transmitiendo = false;
+}
+
+void RF24::_terminarEnvio() {
+  if (!_fifoTx.empty()) _fifoTx.pop_front();
+  _banderaTxDs = true;
+  _confirmados++;
+  if (_hayRespuesta && _fifoRx.size() < NIVELES_FIFO) _fifoRx.push_back(_respuesta);
+  _hayRespuesta = false;
+  _transmitiendo = false;
+  _evaluarTx();
+}
@@ -0,0 +1,203 @@
+/**
+ * @file RF24.h
+ * @brief Versión falsa en memoria de la librería RF24 (nRF24L01+) para el host.
+ * @details Reproduce la API y la semántica de RF24 1.4.x que usa `NrfNucleo`: FIFOs de 3
+ * niveles, auto-ACK con reintentos (MAX_RT), payloads dinámicos, payloads en el ACK, seis
+ * pipes de lectura (los pipes 2-5 solo cambian el primer byte de la dirección del pipe 1) y
+ * `powerUp()` con la espera `RF24_POWERUP_DELAY` dentro de la llamada.
+ *
+ * Todas las instancias comparten un éter: un paquete llega a la instancia que escuche en el
+ * mismo canal y tasa con un pipe cuya dirección coincida, al final de su tiempo en el aire
+ * (reloj virtual). El módulo es además un dispositivo SPI en su pin CSN (desde `begin()`)
+ * que responde a lecturas y escrituras del registro CONFIG, igual que el chip, y sigue el
+ * nivel del pin CE aunque lo cambie el sketch con `digitalWrite()`.
+ *
+ * Además de la API de la librería, cuenta las llamadas (ver `LlamadasRF24`).
+ */
+
+#ifndef HOST_RF24_H
+#define HOST_RF24_H
+
+#include <Arduino.h>
+#include <SPI.h>
+
+#include <deque>
+#include <memory>
+
+#include "nRF24L01.h"
+
+/// Espera de `powerUp()` en RF24 1.4.x (microsegundos).
+#define RF24_POWERUP_DELAY 5000
+
+typedef enum { RF24_PA_MIN = 0, RF24_PA_LOW, RF24_PA_HIGH, RF24_PA_MAX, RF24_PA_ERROR } rf24_pa_dbm_e;
+typedef enum { RF24_1MBPS = 0, RF24_2MBPS, RF24_250KBPS } rf24_datarate_e;
+
+/**
+ * @brief Contadores de uso del driver falso.
+ */
+struct LlamadasRF24 {
+  uint32_t write;
+  uint32_t writeFast;
+  uint32_t txStandBy;
+  uint32_t available;
+  uint32_t getDynamicPayloadSize;
+  uint32_t read;
+  uint32_t startListening;
+  uint32_t stopListening;
+  uint32_t powerUp;
+  uint32_t bytes; ///< Bytes pasados a `write()`/`writeFast()` o pedidos a `read()`.
+};
+
+class RF24 : public host::DispositivoSpi {
+public:
+  RF24(uint16_t cePin, uint16_t csnPin);
+  ~RF24();
+
+  bool begin();
+  bool isChipConnected() { return true; }
+
+  void setChannel(uint8_t channel) { _canal = channel; }
+  uint8_t getChannel() const { return _canal; }
+  bool setDataRate(rf24_datarate_e speed);
+  void setPALevel(uint8_t level, bool lnaEnable = true) { (void)lnaEnable; _potencia = level; }
+  void setRetries(uint8_t delay, uint8_t count) { _retardoReintento = delay; _reintentos = count; }
+  void setAutoAck(bool enable) { _autoAck = enable; }
+  void enableDynamicPayloads() { _payloadsDinamicos = true; }
+  void enableAckPayload() { _payloadsEnAck = true; _payloadsDinamicos = true; }
+
+  void openWritingPipe(const uint8_t* address);
+  void openReadingPipe(uint8_t number, const uint8_t* address);
+  void closeReadingPipe(uint8_t pipe) { if (pipe < 6) _tuboAbierto[pipe] = false; }
+
+  void startListening();
+  void stopListening();
+
+  bool write(const void* buf, uint8_t len);
+  bool writeFast(const void* buf, uint8_t len);
+  bool txStandBy();
+  bool writeAckPayload(uint8_t pipe, const void* buf, uint8_t len);
+
+  bool available();
+  bool available(uint8_t* pipe_num);
+  uint8_t getDynamicPayloadSize();
+  void read(void* buf, uint8_t len);
+  bool rxFifoFull();
+  uint8_t flush_tx();
+  uint8_t flush_rx();
+
+  void powerUp();
+  void powerDown();
+
+  // --- Dispositivo SPI (registro CONFIG del chip) ---
+
+  uint8_t transferir(uint8_t dato) override;
+  void finTransaccion() override { _bytesTransaccion = 0; }
+
+  // --- Extensiones del host ---
+
+  const LlamadasRF24& llamadas() const { return _llamadas; }
+  void reiniciarLlamadas() { memset(&_llamadas, 0, sizeof(_llamadas)); }
+
+  /// Suma de las llamadas de todas las instancias (para radios que encapsulan su `RF24`).
+  static LlamadasRF24& llamadasTotales();
+
+  /// true si el bit PWR_UP del registro CONFIG del chip está activo.
+  bool encendido() const { return (_configChip & (1 << PWR_UP)) != 0; }
+
+  /// Paquetes entregados con ACK desde `begin()`.
+  uint32_t paquetesConfirmados() const { return _confirmados; }
+
+  /// Paquetes que han llegado al módulo desde `begin()` (leídos o no).
+  uint32_t paquetesRecibidos() const { return _recibidos; }
+
+  /**
+   * @brief Receptor ideal: cuenta los paquetes que llegan y los descarta sin ocupar la FIFO.
+   * @details Para benchmarks de transmisión, donde la aplicación receptora no importa.
+   */
+  void consumirAlRecibir(bool consumir) { _consumirAlRecibir = consumir; }
+
+  /// Paquetes descartados por el receptor con la FIFO de recepción llena.
+  uint32_t paquetesRechazadosRx() const { return _rechazadosRx; }
+
+private:
+  struct Paquete {
+    uint8_t datos[32];
+    uint8_t longitud;
+    uint8_t tubo;
+  };
+
+  static const uint8_t NIVELES_FIFO = 3;
+  static const uint32_t ARRANQUE_US = 1500; ///< Tpd2stby del oscilador.
+  static const uint32_t ASENTAMIENTO_US = 130;
+
+  uint8_t _pinCe;
+  uint8_t _pinCsn;
+  bool _conectadoSpi;
+
+  uint8_t _canal;
+  rf24_datarate_e _tasa;
+  uint8_t _potencia;
+  uint8_t _retardoReintento;
+  uint8_t _reintentos;
+  bool _autoAck;
+  bool _payloadsDinamicos;
+  bool _payloadsEnAck;
+  uint32_t _retardoTx;
+
+  uint8_t _direccionTx[5];
+  uint8_t _direccionTubo[6][5];
+  bool _tuboAbierto[6];
+  uint8_t _direccionLecturaTubo0[5];
+  bool _tubo0Lectura;
+
+  uint8_t _configCache; ///< Copia en la librería (`config_reg` en RF24 1.4.x).
+  uint8_t _configChip;  ///< Registro CONFIG del chip.
+  bool _ce;
+  uint64_t _listoDesdeUs;
+
+  std::deque<Paquete> _fifoRx;
+  std::deque<Paquete> _fifoTx;
+  bool _banderaTxDs;
+  bool _banderaMaxRt;
+  bool _transmitiendo;
+  bool _hayRespuesta;
+  Paquete _respuesta; ///< Payload del ACK en vuelo.
+  uint8_t _intento;
+  uint32_t _generacion;
+  std::shared_ptr<bool> _vivo; ///< Los eventos programados no se ejecutan si la instancia ya no existe.
+
+  uint8_t _comandoSpi;
+  uint8_t _bytesTransaccion;
+
+  uint32_t _confirmados;
+  uint32_t _recibidos;
+  bool _consumirAlRecibir;
+  uint32_t _rechazadosRx;
+  LlamadasRF24 _llamadas;
+
+  void _escribirConfig(uint8_t valor);
+  void _fijarCe(bool nivel);
+  bool _escuchando() const;
+  bool _aceptaDireccion(const uint8_t* direccion, uint8_t& tubo) const;
+  uint32_t _tiempoAireUs(uint8_t longitud) const;
+  void _evaluarTx();
+  void _intentarEnvio();
+  void _finAire();
+  void _terminarEnvio();
+  void _programar(uint64_t instanteUs, void (RF24::*metodo)());
+  void _contar(uint32_t LlamadasRF24::*campo);
+  void _contarBytes(uint8_t longitud);
+};
+
+namespace host {
+namespace nrf {
+
+/**
+ * @brief Probabilidad (0-1) de que se pierda cada intento de transmisión. Determinista por semilla.
+ */
+void fijarProbabilidadPerdida(double probabilidad, uint32_t semilla = 1);
+
+} // namespace nrf
+} // namespace host
+
+#endif // HOST_RF24_H
@@ -0,0 +1,76 @@
+/**
+ * @file SPI.cpp
+ * @brief Bus SPI simulado del host (ver SPI.h).
+ */
+
+#include "SPI.h"
+
+#include <vector>
+
+SPIClass SPI;
+
+namespace {
+
+struct Conexion {
+  uint8_t pinCs;
+  host::DispositivoSpi* dispositivo;
+};
+
+std::vector<Conexion>& conexiones() {
+  static std::vector<Conexion> lista;
+  return lista;
+}
+
+host::EstadisticasSpi estadisticas = {0, 0};
+
+} // namespace
+
+void SPIClass::beginTransaction(SPISettings) { estadisticas.transacciones++; }
+
+uint8_t SPIClass::transfer(uint8_t dato) {
+  estadisticas.bytes++;
+  std::vector<Conexion>& lista = conexiones();
+  for (size_t i = 0; i < lista.size(); ++i) {
+    if (digitalRead(lista[i].pinCs) == LOW) return lista[i].dispositivo->transferir(dato);
+  }
+  return 0xFF;
+}
+
+uint16_t SPIClass::transfer16(uint16_t dato) {
+  uint8_t alto = transfer(static_cast<uint8_t>(dato >> 8));
+  uint8_t bajo = transfer(static_cast<uint8_t>(dato));
+  return static_cast<uint16_t>((alto << 8) | bajo);
+}
+
+void SPIClass::transfer(void* buffer, size_t longitud) {
+  uint8_t* bytes = static_cast<uint8_t*>(buffer);
+  for (size_t i = 0; i < longitud; ++i) bytes[i] = transfer(bytes[i]);
+}
+
+namespace host {
+
+void conectarSpi(uint8_t pinCs, DispositivoSpi* dispositivo) {
+  Conexion conexion = {pinCs, dispositivo};
+  conexiones().push_back(conexion);
+  // El CS se deja en reposo (HIGH) sin disparar el fin de transacción.
+  fijarPin(pinCs, HIGH);
+  observarPin(pinCs, [dispositivo](int nivel) {
+    if (nivel == HIGH) dispositivo->finTransaccion();
+  });
+}
+
+void desconectarSpi(DispositivoSpi* dispositivo) {
+  std::vector<Conexion>& lista = conexiones();
+  for (size_t i = 0; i < lista.size(); ++i) {
+    if (lista[i].dispositivo == dispositivo) {
+      lista.erase(lista.begin() + i);
+      --i;
+    }
+  }
+}
+
+void desconectarSpi() { conexiones().clear(); }
+
+EstadisticasSpi& estadisticasSpi() { return estadisticas; }
+
+} // namespace host
@@ -0,0 +1,86 @@
+/**
+ * @file SPI.h
+ * @brief `SPIClass` de Arduino para el host, con dispositivos simulados seleccionados por chip select.
+ * @details Cada transferencia va al dispositivo conectado cuyo pin CS esté a LOW; al subir
+ * el CS se le avisa del fin de la transacción. Cuenta transacciones y bytes para los
+ * benchmarks (ver `host::estadisticasSpi()`).
+ */
+
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+#include <Arduino.h>
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0C
+
+class SPISettings {
+public:
+  SPISettings() : reloj(4000000), ordenBits(MSBFIRST), modo(SPI_MODE0) {}
+  SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode)
+      : reloj(clock), ordenBits(bitOrder), modo(dataMode) {}
+
+  uint32_t reloj;
+  uint8_t ordenBits;
+  uint8_t modo;
+};
+
+class SPIClass {
+public:
+  void begin() {}
+  void end() {}
+  void beginTransaction(SPISettings ajustes);
+  void endTransaction() {}
+  void usingInterrupt(int) {}
+
+  uint8_t transfer(uint8_t dato);
+  uint16_t transfer16(uint16_t dato);
+  void transfer(void* buffer, size_t longitud);
+};
+
+extern SPIClass SPI;
+
+namespace host {
+
+/**
+ * @brief Dispositivo SPI simulado.
+ */
+class DispositivoSpi {
+public:
+  virtual ~DispositivoSpi() {}
+
+  /// Intercambia un byte (full duplex). Solo se llama con el CS del dispositivo a LOW.
+  virtual uint8_t transferir(uint8_t dato) = 0;
+
+  /// El CS ha subido: termina la transacción en curso.
+  virtual void finTransaccion() {}
+};
+
+/**
+ * @brief Conecta un dispositivo al bus en el pin de chip select dado.
+ * @details Llamar después de `host::reiniciar()`, que borra los observadores de pin.
+ */
+void conectarSpi(uint8_t pinCs, DispositivoSpi* dispositivo);
+
+/**
+ * @brief Desconecta un dispositivo del bus.
+ */
+void desconectarSpi(DispositivoSpi* dispositivo);
+
+/**
+ * @brief Desconecta todos los dispositivos del bus.
+ */
+void desconectarSpi();
+
+struct EstadisticasSpi {
+  uint32_t transacciones; ///< Llamadas a `beginTransaction()`.
+  uint32_t bytes;         ///< Bytes intercambiados.
+};
+
+EstadisticasSpi& estadisticasSpi();
+
+} // namespace host
+
+#endif // HOST_SPI_H
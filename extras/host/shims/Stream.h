@@ -0,0 +1,33 @@
+/**
+ * @file Stream.h
+ * @brief Clase `Stream` de Arduino para el host.
+ * @details Las esperas con tiempo límite (`readBytes()`) llaman a `yield()`, que hace avanzar
+ * el reloj virtual, así que terminan aunque no lleguen datos.
+ */
+
+#ifndef HOST_STREAM_H
+#define HOST_STREAM_H
+
+#include "Print.h"
+
+class Stream : public Print {
+public:
+  Stream() : _tiempoLimiteMs(1000) {}
+
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+
+  void setTimeout(unsigned long milisegundos) { _tiempoLimiteMs = milisegundos; }
+  unsigned long getTimeout() const { return _tiempoLimiteMs; }
+
+  size_t readBytes(uint8_t* buffer, size_t longitud);
+  size_t readBytes(char* buffer, size_t longitud) { return readBytes(reinterpret_cast<uint8_t*>(buffer), longitud); }
+
+protected:
+  unsigned long _tiempoLimiteMs;
+
+  int _leerConTiempoLimite();
+};
+
+#endif // HOST_STREAM_H
@@ -0,0 +1,216 @@
+/**
+ * @file Sx127xFalso.h
+ * @brief Emulador a nivel de registros del SX127x (modo LoRa) para probar `Sx127xNucleo` en el host.
+ * @details Se conecta al bus SPI falso en su pin CS y responde a las mismas transacciones
+ * que el chip: el primer byte es la dirección (bit 7 = escritura) y los siguientes leen o
+ * escriben registros consecutivos, salvo en `REG_FIFO`, donde la dirección no avanza y cada
+ * byte mueve el puntero `REG_FIFO_ADDR_PTR`. Las banderas IRQ se limpian escribiendo un 1.
+ *
+ * Al pasar a TX, la trama (`REG_PAYLOAD_LENGTH` bytes desde `REG_FIFO_TX_BASE_ADDR`) sale
+ * al final de su tiempo en el aire, calculado con los registros de modulación; entonces se
+ * activa TxDone, el módulo vuelve a standby y la trama llega al módulo enlazado con
+ * `enlazar()` si está en recepción continua. `recibir()` entrega un paquete desde la prueba.
+ * Cada paquete recibido se escribe desde `REG_FIFO_RX_BASE_ADDR`, la misma zona que usa la
+ * transmisión, así que una TX sobrescribe un paquete sin leer, como en el chip.
+ */
+
+#ifndef HOST_SX127X_FALSO_H
+#define HOST_SX127X_FALSO_H
+
+#include <Arduino.h>
+#include <SPI.h>
+
+#include <vector>
+
+class Sx127xFalso : public host::DispositivoSpi {
+public:
+  static const uint8_t REG_FIFO = 0x00;
+  static const uint8_t REG_OP_MODE = 0x01;
+  static const uint8_t REG_FIFO_ADDR_PTR = 0x0D;
+  static const uint8_t REG_FIFO_TX_BASE_ADDR = 0x0E;
+  static const uint8_t REG_FIFO_RX_BASE_ADDR = 0x0F;
+  static const uint8_t REG_FIFO_RX_CURRENT_ADDR = 0x10;
+  static const uint8_t REG_IRQ_FLAGS = 0x12;
+  static const uint8_t REG_RX_NB_BYTES = 0x13;
+  static const uint8_t REG_PKT_RSSI_VALUE = 0x1A;
+  static const uint8_t REG_MODEM_CONFIG_1 = 0x1D;
+  static const uint8_t REG_MODEM_CONFIG_2 = 0x1E;
+  static const uint8_t REG_PAYLOAD_LENGTH = 0x22;
+  static const uint8_t REG_MODEM_CONFIG_3 = 0x26;
+  static const uint8_t REG_SYNC_WORD = 0x39;
+  static const uint8_t REG_DIO_MAPPING_1 = 0x40;
+  static const uint8_t REG_VERSION = 0x42;
+
+  static const uint8_t MODO_SLEEP = 0x00;
+  static const uint8_t MODO_STDBY = 0x01;
+  static const uint8_t MODO_TX = 0x03;
+  static const uint8_t MODO_RX_CONTINUO = 0x05;
+
+  static const uint8_t IRQ_TX_DONE = 0x08;
+  static const uint8_t IRQ_CRC_ERRONEO = 0x20;
+  static const uint8_t IRQ_RX_DONE = 0x40;
+
+  /**
+   * @param pinCs Pin de chip select en el bus SPI falso.
+   * @param pinDio0 Pin que refleja DIO0, o -1 si no está conectado.
+   */
+  explicit Sx127xFalso(uint8_t pinCs, int pinDio0 = -1)
+      : _pinDio0(pinDio0), _par(nullptr), _bytesTransaccion(0), _direccion(0), _escritura(false),
+        _transaccionesFifo(0), _generacion(0), _tramasTransmitidas(0) {
+    memset(_registros, 0, sizeof(_registros));
+    memset(_fifo, 0, sizeof(_fifo));
+    // Valores de reset que el driver lee y modifica
+    _registros[REG_OP_MODE] = MODO_STDBY;
+    _registros[0x0C] = 0x20; // REG_LNA
+    _registros[REG_MODEM_CONFIG_1] = 0x72;
+    _registros[REG_MODEM_CONFIG_2] = 0x70;
+    _registros[REG_PAYLOAD_LENGTH] = 0x01;
+    _registros[REG_SYNC_WORD] = 0x12;
+    _registros[REG_VERSION] = 0x12;
+    host::conectarSpi(pinCs, this);
+    _actualizarDio0();
+  }
+
+  ~Sx127xFalso() {
+    host::desconectarSpi(this);
+    if (_par) _par->_par = nullptr;
+  }
+
+  /// Enlaza dos módulos: lo que transmite uno lo recibe el otro.
+  void enlazar(Sx127xFalso& otro) {
+    _par = &otro;
+    otro._par = this;
+  }
+
+  /**
+   * @brief Entrega un paquete como si acabara de llegar por el aire.
+   * @details Solo se recibe en recepción continua (si no, el paquete se pierde).
+   * @return true si el módulo lo recibió.
+   */
+  bool recibir(const uint8_t* datos, uint8_t longitud, int rssi = -60, bool crcErroneo = false) {
+    if (_modo() != MODO_RX_CONTINUO) return false;
+    uint8_t base = _registros[REG_FIFO_RX_BASE_ADDR];
+    for (uint8_t i = 0; i < longitud; ++i) _fifo[(uint8_t)(base + i)] = datos[i];
+    _registros[REG_FIFO_RX_CURRENT_ADDR] = base;
+    _registros[REG_RX_NB_BYTES] = longitud;
+    _registros[REG_PKT_RSSI_VALUE] = (uint8_t)(rssi + 157);
+    _registros[REG_IRQ_FLAGS] |= IRQ_RX_DONE | (crcErroneo ? IRQ_CRC_ERRONEO : 0);
+    _actualizarDio0();
+    return true;
+  }
+
+  uint8_t registro(uint8_t direccion) const { return _registros[direccion & 0x7F]; }
+  uint8_t modo() const { return _modo(); }
+
+  /// Última trama transmitida.
+  const std::vector<uint8_t>& ultimaTrama() const { return _ultimaTrama; }
+  uint32_t tramasTransmitidas() const { return _tramasTransmitidas; }
+
+  /// Transacciones SPI que leyeron o escribieron la FIFO.
+  uint32_t transaccionesFifo() const { return _transaccionesFifo; }
+
+  /// Tiempo en el aire de una trama de `longitud` bytes con los registros actuales, en µs.
+  uint32_t tiempoEnAireUs(uint8_t longitud) const {
+    static const uint32_t ANCHOS[10] = {7800, 10400, 15600, 20800, 31250, 41700, 62500, 125000, 250000, 500000};
+    uint8_t indiceAncho = _registros[REG_MODEM_CONFIG_1] >> 4;
+    uint32_t ancho = ANCHOS[indiceAncho < 10 ? indiceAncho : 9];
+    int cr = ((_registros[REG_MODEM_CONFIG_1] >> 1) & 0x07) + 4;
+    bool cabeceraImplicita = _registros[REG_MODEM_CONFIG_1] & 0x01;
+    int sf = _registros[REG_MODEM_CONFIG_2] >> 4;
+    bool crc = _registros[REG_MODEM_CONFIG_2] & 0x04;
+    bool tasaBaja = _registros[REG_MODEM_CONFIG_3] & 0x08;
+    double simboloUs = (double)(1UL << sf) * 1e6 / ancho;
+    int numerador = 8 * longitud - 4 * sf + 28 + (crc ? 16 : 0) - (cabeceraImplicita ? 20 : 0);
+    int denominador = 4 * (sf - (tasaBaja ? 2 : 0));
+    int simbolosPayload = 8 + (numerador > 0 ? ((numerador + denominador - 1) / denominador) * cr : 0);
+    return (uint32_t)((8 + 4.25 + simbolosPayload) * simboloUs);
+  }
+
+  uint8_t transferir(uint8_t dato) override {
+    if (_bytesTransaccion++ == 0) {
+      _direccion = dato & 0x7F;
+      _escritura = (dato & 0x80) != 0;
+      if (_direccion == REG_FIFO) _transaccionesFifo++;
+      return 0;
+    }
+    uint8_t direccion = _direccion;
+    if (direccion != REG_FIFO) _direccion = (_direccion + 1) & 0x7F;
+    if (_escritura) {
+      _escribir(direccion, dato);
+      return 0;
+    }
+    if (direccion == REG_FIFO) return _fifo[_registros[REG_FIFO_ADDR_PTR]++];
+    return _registros[direccion];
+  }
+
+  void finTransaccion() override { _bytesTransaccion = 0; }
+
+private:
+  int _pinDio0;
+  Sx127xFalso* _par;
+  uint8_t _registros[128];
+  uint8_t _fifo[256];
+  uint32_t _bytesTransaccion;
+  uint8_t _direccion;
+  bool _escritura;
+  uint32_t _transaccionesFifo;
+  uint32_t _generacion;
+  uint32_t _tramasTransmitidas;
+  std::vector<uint8_t> _ultimaTrama;
+
+  uint8_t _modo() const { return _registros[REG_OP_MODE] & 0x07; }
+
+  void _escribir(uint8_t direccion, uint8_t dato) {
+    switch (direccion) {
+      case REG_FIFO:
+        _fifo[_registros[REG_FIFO_ADDR_PTR]++] = dato;
+        return;
+      case REG_IRQ_FLAGS:
+        _registros[REG_IRQ_FLAGS] &= (uint8_t)~dato;
+        _actualizarDio0();
+        return;
+      case REG_OP_MODE:
+        _cambiarModo(dato);
+        return;
+      case REG_VERSION:
+        return; // Solo lectura
+      default:
+        _registros[direccion] = dato;
+        if (direccion == REG_DIO_MAPPING_1) _actualizarDio0();
+    }
+  }
+
+  void _cambiarModo(uint8_t valor) {
+    uint8_t anterior = _modo();
+    _registros[REG_OP_MODE] = valor;
+    if (anterior == MODO_TX && _modo() != MODO_TX) _generacion++; // TX abortada
+    if (anterior == MODO_TX || _modo() != MODO_TX) return;
+
+    uint8_t longitud = _registros[REG_PAYLOAD_LENGTH];
+    uint8_t base = _registros[REG_FIFO_TX_BASE_ADDR];
+    std::vector<uint8_t> trama(longitud);
+    for (uint8_t i = 0; i < longitud; ++i) trama[i] = _fifo[(uint8_t)(base + i)];
+    uint32_t generacion = ++_generacion;
+    host::programar(host::ahoraMicros() + tiempoEnAireUs(longitud), [this, generacion, trama]() {
+      if (generacion != _generacion) return;
+      _ultimaTrama = trama;
+      _tramasTransmitidas++;
+      _registros[REG_OP_MODE] = (_registros[REG_OP_MODE] & 0xF8) | MODO_STDBY;
+      _registros[REG_IRQ_FLAGS] |= IRQ_TX_DONE;
+      _actualizarDio0();
+      if (_par && _par->_registros[REG_SYNC_WORD] == _registros[REG_SYNC_WORD]) {
+        _par->recibir(trama.data(), (uint8_t)trama.size());
+      }
+    });
+  }
+
+  /// DIO0 sigue a RxDone (mapeo 00) o a TxDone (mapeo 01).
+  void _actualizarDio0() {
+    if (_pinDio0 < 0) return;
+    uint8_t mapeo = _registros[REG_DIO_MAPPING_1] >> 6;
+    uint8_t bandera = mapeo == 0 ? IRQ_RX_DONE : (mapeo == 1 ? IRQ_TX_DONE : 0);
+    host::fijarPin((uint8_t)_pinDio0, (_registros[REG_IRQ_FLAGS] & bandera) ? HIGH : LOW);
+  }
+};
+
+#endif // HOST_SX127X_FALSO_H
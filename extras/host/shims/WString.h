@@ -0,0 +1,70 @@
+/**
+ * @file WString.h
+ * @brief `String` de Arduino para el host.
+ * @details Misma semántica que la del núcleo de Arduino (memoria dinámica propia, `trim()`,
+ * concatenación con `+`). Cuenta reservas y bytes copiados para poder medir en los
+ * benchmarks el coste de las rutas basadas en `String` (ver `host::reservasString()`).
+ */
+
+#ifndef HOST_WSTRING_H
+#define HOST_WSTRING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+class String {
+public:
+  String(const char* texto = "");
+  String(const String& otra);
+  explicit String(char caracter);
+  explicit String(int valor, unsigned char base = 10);
+  explicit String(unsigned int valor, unsigned char base = 10);
+  explicit String(long valor, unsigned char base = 10);
+  explicit String(unsigned long valor, unsigned char base = 10);
+  ~String();
+
+  String& operator=(const String& otra);
+  String& operator=(const char* texto);
+
+  unsigned char reserve(unsigned int tamano);
+  unsigned int length() const { return _longitud; }
+  const char* c_str() const { return _buffer ? _buffer : ""; }
+
+  unsigned char concat(const String& otra);
+  unsigned char concat(const char* texto);
+  unsigned char concat(const char* texto, unsigned int longitud);
+  unsigned char concat(char caracter);
+  String& operator+=(const String& otra) { concat(otra); return *this; }
+  String& operator+=(const char* texto) { concat(texto); return *this; }
+  String& operator+=(char caracter) { concat(caracter); return *this; }
+
+  unsigned char equals(const String& otra) const;
+  unsigned char equals(const char* texto) const;
+  bool operator==(const String& otra) const { return equals(otra); }
+  bool operator==(const char* texto) const { return equals(texto); }
+  bool operator!=(const String& otra) const { return !equals(otra); }
+  bool operator!=(const char* texto) const { return !equals(texto); }
+
+  char charAt(unsigned int indice) const;
+  char operator[](unsigned int indice) const { return charAt(indice); }
+  int indexOf(char caracter) const;
+  int indexOf(const char* texto) const;
+  String substring(unsigned int desde) const;
+  String substring(unsigned int desde, unsigned int hasta) const;
+  void trim();
+  long toInt() const;
+
+private:
+  char* _buffer;
+  unsigned int _capacidad;
+  unsigned int _longitud;
+
+  void _copiar(const char* texto, unsigned int longitud);
+};
+
+String operator+(const String& a, const String& b);
+String operator+(const String& a, const char* b);
+String operator+(const char* a, const String& b);
+String operator+(const String& a, char b);
+
+#endif // HOST_WSTRING_H
@@ -0,0 +1,27 @@
+/**
+ * @file nRF24L01.h
+ * @brief Mapa de registros del nRF24L01+ (subconjunto) para el host.
+ */
+
+#ifndef HOST_NRF24L01_H
+#define HOST_NRF24L01_H
+
+#define NRF_CONFIG 0x00
+#define EN_AA 0x01
+#define EN_RXADDR 0x02
+#define RF_CH 0x05
+#define NRF_STATUS 0x07
+#define FIFO_STATUS 0x17
+
+#define PRIM_RX 0
+#define PWR_UP 1
+#define RX_DR 6
+#define TX_DS 5
+#define MAX_RT 4
+
+#define R_REGISTER 0x00
+#define W_REGISTER 0x20
+#define REGISTER_MASK 0x1F
+#define RF24_NOP 0xFF
+
+#endif // HOST_NRF24L01_H
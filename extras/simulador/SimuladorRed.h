@@ -0,0 +1,697 @@
+/**
+ * @file SimuladorRed.h
+ * @brief Simulador de eventos discretos para redes de cientos o miles de nodos `RadioInterface`.
+ * @details Ejecuta el código de aplicación real contra radios simuladas (`NodoSimulado`),
+ * todo en tiempo virtual, para dimensionar despliegues antes de comprar hardware.
+ * Modela:
+ * - Tiempo en el aire a partir de `LoRaConfig` (SF, BW, CR) o `NrfConfig` (tasa de datos).
+ * - Pérdidas de propagación log-distancia con sombreado log-normal opcional, fijo para
+ *   cada enlace (se sortea la primera vez que se usa y es simétrico).
+ * - Colisiones entre transmisiones solapadas en el mismo canal (y mismo SF en LoRa),
+ *   con efecto captura cuando la señal supera por `umbralCaptura_dB` a la suma de
+ *   potencias de las interferentes.
+ * - Radios semidúplex: un nodo que transmite no recibe.
+ *
+ * Al terminar, `informe()` devuelve por nodo la tasa de entrega, la latencia (desde
+ * `enviar()` hasta la entrega en destino, incluida la espera en cola) y la utilización
+ * del canal.
+ *
+ * @note Solo para compilación en el host (usa la STL). No forma parte de la librería
+ * para Arduino: el IDE ignora la carpeta `extras`. Necesita en la ruta de inclusión `src/`
+ * y el `Arduino.h` del entorno de host (`extras/host/shims`); no depende de las librerías
+ * `LoRa` ni `RF24`. `simular_red.cpp` es un programa de ejemplo listo para ejecutar.
+ *
+ * Ejemplo: 500 nodos alrededor de un gateway, comparando SF7 y SF9.
+ * @code
+ * class Sensor : public AplicacionNodo {
+ * public:
+ *   uint64_t ejecutar(NodoSimulado& nodo, uint64_t ahoraUs) override {
+ *     uint8_t lectura[12] = {0};
+ *     nodo.enviar(lectura, sizeof(lectura));
+ *     return ahoraUs + 60000000ULL + nodo.simulador().aleatorio(0, 5000000);
+ *   }
+ * };
+ *
+ * SimuladorRed sim;
+ * LoRaConfig cfg = {868000000, 14, 7, 125000, 5, 0x12, 0, 0, 0};
+ * size_t gateway = sim.agregarNodo(ModeloAire::lora(cfg), 0, 0);
+ * for (int i = 0; i < 500; i++) {
+ *   size_t id = sim.agregarNodo(ModeloAire::lora(cfg), sim.aleatorio(-2000, 2000), sim.aleatorio(-2000, 2000));
+ *   sim.nodo(id).fijarDestino(gateway);
+ *   sim.asignarAplicacion(id, new Sensor());
+ * }
+ * sim.ejecutarHasta(3600ULL * 1000000ULL); // Una hora virtual
+ * sim.imprimirInforme(std::cout);
+ * @endcode
+ */
+
+#ifndef SIMULADOR_RED_H
+#define SIMULADOR_RED_H
+
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <ostream>
+#include <queue>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "RadioInterface.h"
+#include "LoRaConfig.h"
+#include "NrfConfig.h"
+#include "TiempoEnAire.h"
+
+class SimuladorRed;
+class NodoSimulado;
+
+/**
+ * @struct ModeloAire
+ * @brief Parámetros de capa física de un nodo simulado.
+ * @details Se construye a partir de la configuración real de la radio con
+ * `ModeloAire::lora()` o `ModeloAire::nrf()`.
+ */
+struct ModeloAire {
+  bool esLora;              ///< true para LoRa, false para NRF24L01.
+  uint32_t canal;           ///< Frecuencia (LoRa, Hz) o canal RF (NRF).
+  uint8_t spreadingFactor;  ///< SF (LoRa). 0 en NRF. Distintos SF no colisionan entre sí.
+  uint32_t anchoBanda;      ///< Ancho de banda en Hz (LoRa).
+  uint8_t codingRate;       ///< Denominador de la tasa de codificación, 5-8 (LoRa).
+  uint32_t tasaBits;        ///< Tasa de datos en bit/s (NRF).
+  double potenciaTx_dBm;    ///< Potencia de transmisión.
+  double sensibilidad_dBm;  ///< Nivel mínimo de señal para recibir un paquete.
+  size_t mtu;               ///< Tamaño máximo de paquete en bytes.
+
+  /**
+   * @brief Modelo a partir de la configuración de un `LoraRadio`.
+   * @details La sensibilidad sigue la tabla típica del SX1276 a 125 kHz, ajustada al ancho de banda.
+   */
+  static ModeloAire lora(const LoRaConfig& config) {
+    static const double sensibilidad125k[] = { -123.0, -126.0, -129.0, -132.0, -134.5, -137.0 }; // SF7..SF12
+    ModeloAire m;
+    m.esLora = true;
+    m.canal = (uint32_t)config.frequency;
+    m.spreadingFactor = (uint8_t)config.spreadingFactor;
+    m.anchoBanda = (uint32_t)config.signalBandwidth;
+    m.codingRate = (uint8_t)config.codingRate;
+    m.tasaBits = 0;
+    m.potenciaTx_dBm = config.txPower;
+    int indice = config.spreadingFactor - 7;
+    if (indice < 0) indice = 0;
+    if (indice > 5) indice = 5;
+    m.sensibilidad_dBm = sensibilidad125k[indice] + 10.0 * std::log10(m.anchoBanda / 125000.0);
+    m.mtu = 255;
+    return m;
+  }
+
+  /**
+   * @brief Modelo a partir de la configuración de un `NrfRadio`.
+   * @details Traduce `paLevel` (0-3) a -18/-12/-6/0 dBm y `dataRate` a la sensibilidad del datasheet.
+   */
+  static ModeloAire nrf(const NrfConfig& config) {
+    ModeloAire m;
+    m.esLora = false;
+    m.canal = config.channel;
+    m.spreadingFactor = 0;
+    m.anchoBanda = 0;
+    m.codingRate = 0;
+    m.potenciaTx_dBm = -18.0 + 6.0 * config.paLevel;
+    if (config.dataRate == 250) {
+      m.tasaBits = 250000;
+      m.sensibilidad_dBm = -94.0;
+    } else if (config.dataRate == 2) {
+      m.tasaBits = 2000000;
+      m.sensibilidad_dBm = -82.0;
+    } else {
+      m.tasaBits = 1000000;
+      m.sensibilidad_dBm = -85.0;
+    }
+    m.mtu = 32;
+    return m;
+  }
+
+  /**
+   * @brief Tiempo en el aire de un paquete, en microsegundos.
+   * @details LoRa: `tiempoEnAireLoRaUs()` con la configuración por defecto de `LoraRadio`
+   * (preámbulo de 8 símbolos, cabecera explícita, sin CRC).
+   * NRF: Enhanced ShockBurst (preámbulo, dirección de 5 bytes, PCF, CRC de 2 bytes)
+   * más 130 µs de asentamiento del PLL.
+   */
+  uint64_t tiempoEnAireUs(size_t longitud) const {
+    if (!esLora) {
+      uint64_t bits = 8ULL * (1 + 5 + longitud + 2) + 9;
+      return 130 + (bits * 1000000ULL) / tasaBits;
+    }
+    return tiempoEnAireLoRaUs(spreadingFactor, anchoBanda, codingRate, longitud);
+  }
+
+  /**
+   * @brief Indica si dos transmisiones con estos modelos pueden interferirse.
+   */
+  bool compartenCanal(const ModeloAire& otro) const {
+    return esLora == otro.esLora && canal == otro.canal && spreadingFactor == otro.spreadingFactor;
+  }
+};
+
+/**
+ * @struct ParametrosCanal
+ * @brief Modelo de propagación y de colisiones del simulador.
+ */
+struct ParametrosCanal {
+  double perdidaReferencia_dB; ///< Pérdida a 1 m de distancia.
+  double exponente;            ///< Exponente de pérdida log-distancia (2 = espacio libre).
+  double sombreado_dB;         ///< Desviación típica del sombreado log-normal por enlace (0 = determinista).
+  double umbralCaptura_dB;     ///< Margen sobre la suma de interferentes con el que una señal sobrevive a una colisión.
+
+  ParametrosCanal()
+    : perdidaReferencia_dB(40.0),
+      exponente(2.7),
+      sombreado_dB(0.0),
+      umbralCaptura_dB(6.0) {}
+};
+
+/**
+ * @class AplicacionNodo
+ * @brief Código de aplicación que se ejecuta sobre un nodo simulado.
+ * @details Equivale a `setup()`/`loop()` de un sketch, pero en tiempo virtual: en lugar de
+ * `delay()`, `ejecutar()` devuelve el instante en que quiere volver a ejecutarse. Cuando
+ * llega un paquete a su radio, el simulador llama a `alRecibir()`.
+ */
+class AplicacionNodo {
+public:
+  virtual ~AplicacionNodo() {}
+
+  /**
+   * @brief Se llama una vez, antes del primer `ejecutar()`.
+   * @param nodo Radio simulada del nodo, usable como `RadioInterface`.
+   */
+  virtual void iniciar(NodoSimulado& nodo) { (void)nodo; }
+
+  /**
+   * @brief Ejecuta la lógica de la aplicación.
+   * @param nodo Radio simulada del nodo.
+   * @param ahoraUs Tiempo virtual actual en microsegundos.
+   * @return Instante absoluto (µs) de la siguiente ejecución programada, o
+   * `SimuladorRed::NUNCA` si solo debe ejecutarse al recibir paquetes.
+   */
+  virtual uint64_t ejecutar(NodoSimulado& nodo, uint64_t ahoraUs) = 0;
+
+  /**
+   * @brief Se llama cada vez que la radio del nodo recibe un paquete.
+   * @details Por defecto no hace nada: los paquetes se acumulan en la cola de recepción
+   * y, cuando se llena, se cuentan como desbordes.
+   * @param nodo Radio simulada del nodo (el paquete se lee con `hayDatosDisponibles()`/`leer()`).
+   * @param ahoraUs Tiempo virtual actual en microsegundos.
+   */
+  virtual void alRecibir(NodoSimulado& nodo, uint64_t ahoraUs) { (void)nodo; (void)ahoraUs; }
+};
+
+/**
+ * @struct InformeNodo
+ * @brief Resultados de un nodo al final de la simulación.
+ */
+struct InformeNodo {
+  uint32_t enviados;        ///< Paquetes transmitidos.
+  uint32_t rechazados;      ///< Llamadas a `enviar()` rechazadas (cola llena, dormido, > MTU).
+  uint32_t entregados;      ///< Paquetes recibidos por el destino (o por algún nodo, en difusión).
+  uint32_t recibidos;       ///< Paquetes recibidos por este nodo.
+  uint32_t colisiones;      ///< Recepciones perdidas en este nodo por interferencia.
+  uint32_t desbordesRx;     ///< Recepciones descartadas por cola de recepción llena.
+  uint64_t latenciaTotalUs; ///< Suma de latencias de los paquetes entregados.
+  uint64_t latenciaMaxUs;   ///< Latencia máxima observada.
+  uint64_t tiempoTxUs;      ///< Tiempo total transmitiendo.
+
+  /**
+   * @brief Tasa de entrega (0-1).
+   */
+  double tasaEntrega() const { return enviados ? (double)entregados / enviados : 0.0; }
+
+  /**
+   * @brief Latencia media en microsegundos.
+   */
+  double latenciaMediaUs() const { return entregados ? (double)latenciaTotalUs / entregados : 0.0; }
+};
+
+/**
+ * @class NodoSimulado
+ * @brief Radio simulada que implementa `RadioInterface`.
+ * @details `enviar()` encola la trama (como la transmisión asíncrona de `LoraRadio`) y el
+ * simulador la pone en el aire cuando el transmisor queda libre. Los paquetes recibidos se
+ * guardan en una cola de capacidad limitada y se leen con la API habitual.
+ */
+class NodoSimulado : public RadioInterface {
+public:
+  static const size_t DIFUSION = (size_t)-1; ///< Destino "cualquier nodo".
+
+  // Hace visibles las sobrecargas de RadioInterface (ej. enviar(const String&)).
+  using RadioInterface::enviar;
+
+  NodoSimulado(SimuladorRed& simulador, size_t id, const ModeloAire& modelo, double x, double y)
+    : _simulador(simulador),
+      _id(id),
+      _modelo(modelo),
+      _x(x),
+      _y(y),
+      _destino(DIFUSION),
+      _capacidadTx(4),
+      _capacidadRx(4),
+      _dormido(false),
+      _despiertoDesdeUs(0),
+      _transmitiendo(false),
+      _rssiUltimo(0),
+      _aplicacion(nullptr),
+      _informe() {}
+
+  // --- RadioInterface ---
+
+  bool iniciar() override { return true; }
+  bool enviar(const uint8_t* buffer, size_t longitud) override;
+
+  int hayDatosDisponibles() override {
+    return _colaRx.empty() ? 0 : (int)_colaRx.front().datos.size();
+  }
+
+  size_t leer(uint8_t* buffer, size_t maxLongitud) override {
+    if (_colaRx.empty()) return 0;
+    const PaqueteRx& paquete = _colaRx.front();
+    size_t bytes = (paquete.datos.size() < maxLongitud) ? paquete.datos.size() : maxLongitud;
+    memcpy(buffer, paquete.datos.data(), bytes);
+    _rssiUltimo = paquete.rssi;
+    _colaRx.pop_front();
+    return bytes;
+  }
+
+  int obtenerRSSI() override { return _rssiUltimo; }
+
+  size_t obtenerMTU() override { return _modelo.mtu; }
+
+  bool dormir() override {
+    if (_transmitiendo) return false;
+    _dormido = true;
+    return true;
+  }
+
+  bool despertar() override;
+
+  // --- Configuración ---
+
+  /**
+   * @brief Nodo al que van dirigidos los paquetes, para calcular la tasa de entrega.
+   * @param destino Índice del nodo destino, o `DIFUSION` (entregado si lo recibe cualquiera).
+   */
+  void fijarDestino(size_t destino) { _destino = destino; }
+
+  /**
+   * @brief Capacidades de las colas de transmisión y recepción (en paquetes).
+   */
+  void fijarCapacidades(size_t capacidadTx, size_t capacidadRx) {
+    _capacidadTx = capacidadTx;
+    _capacidadRx = capacidadRx;
+  }
+
+  size_t id() const { return _id; }
+  const ModeloAire& modelo() const { return _modelo; }
+  const InformeNodo& informe() const { return _informe; }
+  SimuladorRed& simulador() { return _simulador; }
+
+private:
+  friend class SimuladorRed;
+
+  struct PaqueteTx {
+    std::vector<uint8_t> datos;
+    uint64_t encoladoUs;
+  };
+
+  struct PaqueteRx {
+    std::vector<uint8_t> datos;
+    int rssi;
+  };
+
+  SimuladorRed& _simulador;
+  size_t _id;
+  ModeloAire _modelo;
+  double _x;
+  double _y;
+  size_t _destino;
+  size_t _capacidadTx;
+  size_t _capacidadRx;
+  bool _dormido;
+  uint64_t _despiertoDesdeUs;
+  bool _transmitiendo;
+  int _rssiUltimo;
+  AplicacionNodo* _aplicacion;
+  InformeNodo _informe;
+  std::deque<PaqueteTx> _colaTx;
+  std::deque<PaqueteRx> _colaRx;
+};
+
+/**
+ * @class SimuladorRed
+ * @brief Motor de eventos discretos: reloj virtual, canal compartido y estadísticas.
+ */
+class SimuladorRed {
+public:
+  static const uint64_t NUNCA = std::numeric_limits<uint64_t>::max(); ///< Sin próxima ejecución.
+
+  /**
+   * @brief Constructor.
+   * @param canal Modelo de propagación y captura.
+   * @param semilla Semilla del generador aleatorio (la simulación es reproducible).
+   */
+  explicit SimuladorRed(const ParametrosCanal& canal = ParametrosCanal(), uint32_t semilla = 1)
+    : _canal(canal),
+      _azar(semilla),
+      _ahoraUs(0),
+      _secuencia(0),
+      _tiempoAireMaxUs(0),
+      _baseTransmisiones(0) {}
+
+  ~SimuladorRed() {
+    for (size_t i = 0; i < _nodos.size(); i++) {
+      delete _nodos[i]->_aplicacion;
+      delete _nodos[i];
+    }
+  }
+
+  /**
+   * @brief Crea un nodo en la posición (x, y), en metros.
+   * @return Índice del nodo.
+   */
+  size_t agregarNodo(const ModeloAire& modelo, double x, double y) {
+    size_t id = _nodos.size();
+    _nodos.push_back(new NodoSimulado(*this, id, modelo, x, y));
+    return id;
+  }
+
+  /**
+   * @brief Asigna la aplicación de un nodo. El simulador toma posesión del objeto.
+   * @details La aplicación se inicia y se ejecuta por primera vez en el instante actual.
+   */
+  void asignarAplicacion(size_t id, AplicacionNodo* aplicacion) {
+    NodoSimulado& n = *_nodos[id];
+    delete n._aplicacion;
+    n._aplicacion = aplicacion;
+    aplicacion->iniciar(n);
+    _programar(_ahoraUs, EVENTO_APLICACION, id);
+  }
+
+  NodoSimulado& nodo(size_t id) { return *_nodos[id]; }
+  size_t numNodos() const { return _nodos.size(); }
+
+  /**
+   * @brief Tiempo virtual actual en microsegundos.
+   */
+  uint64_t ahoraUs() const { return _ahoraUs; }
+
+  /**
+   * @brief Número aleatorio uniforme en [minimo, maximo], del generador reproducible del simulador.
+   */
+  double aleatorio(double minimo, double maximo) {
+    std::uniform_real_distribution<double> distribucion(minimo, maximo);
+    return distribucion(_azar);
+  }
+
+  /**
+   * @brief Procesa eventos hasta que el reloj virtual alcance `finUs` o no queden eventos.
+   */
+  void ejecutarHasta(uint64_t finUs) {
+    while (!_eventos.empty() && _eventos.top().instanteUs <= finUs) {
+      Evento evento = _eventos.top();
+      _eventos.pop();
+      _ahoraUs = evento.instanteUs;
+      if (evento.tipo == EVENTO_FIN_TX) {
+        _finalizarTransmision(evento.indice);
+      } else {
+        _ejecutarAplicacion(evento.indice);
+      }
+    }
+    _ahoraUs = finUs;
+  }
+
+  /**
+   * @brief Fracción del tiempo simulado en que hubo al menos una transmisión en el canal
+   * del nodo `id` (0-1).
+   */
+  double utilizacionCanal(size_t id) const {
+    if (_ahoraUs == 0) return 0.0;
+    const ModeloAire& m = _nodos[id]->_modelo;
+    for (size_t i = 0; i < _ocupacion.size(); i++) {
+      if (_ocupacion[i].modelo.compartenCanal(m)) {
+        return (double)_ocupacion[i].ocupadoUs / _ahoraUs;
+      }
+    }
+    return 0.0;
+  }
+
+  /**
+   * @brief Escribe una tabla con los resultados de cada nodo y un resumen global.
+   */
+  void imprimirInforme(std::ostream& salida) const {
+    salida << "nodo,enviados,rechazados,entregados,tasa_entrega,latencia_media_us,latencia_max_us,"
+              "recibidos,colisiones,desbordes_rx,utilizacion_canal\n";
+    uint64_t enviados = 0;
+    uint64_t entregados = 0;
+    for (size_t i = 0; i < _nodos.size(); i++) {
+      const InformeNodo& r = _nodos[i]->_informe;
+      salida << i << ',' << r.enviados << ',' << r.rechazados << ',' << r.entregados << ','
+             << r.tasaEntrega() << ',' << r.latenciaMediaUs() << ',' << r.latenciaMaxUs << ','
+             << r.recibidos << ',' << r.colisiones << ',' << r.desbordesRx << ','
+             << utilizacionCanal(i) << '\n';
+      enviados += r.enviados;
+      entregados += r.entregados;
+    }
+    salida << "# total: enviados=" << enviados << " entregados=" << entregados
+           << " tasa_entrega=" << (enviados ? (double)entregados / enviados : 0.0)
+           << " tiempo_virtual_s=" << _ahoraUs / 1e6 << '\n';
+  }
+
+private:
+  friend class NodoSimulado;
+
+  enum TipoEvento { EVENTO_APLICACION, EVENTO_FIN_TX };
+
+  struct Evento {
+    uint64_t instanteUs;
+    uint64_t secuencia; ///< Desempate FIFO entre eventos simultáneos.
+    TipoEvento tipo;
+    size_t indice;      ///< Nodo (aplicación) o transmisión (fin de TX).
+
+    bool operator>(const Evento& otro) const {
+      return instanteUs != otro.instanteUs ? instanteUs > otro.instanteUs : secuencia > otro.secuencia;
+    }
+  };
+
+  struct Transmision {
+    size_t emisor;
+    uint64_t inicioUs;
+    uint64_t finUs;
+    uint64_t encoladoUs;
+    std::vector<uint8_t> datos;
+    bool activa;
+  };
+
+  struct OcupacionCanal {
+    ModeloAire modelo;
+    uint64_t ocupadoHastaUs;
+    uint64_t ocupadoUs;
+  };
+
+  ParametrosCanal _canal;
+  std::mt19937 _azar;
+  uint64_t _ahoraUs;
+  uint64_t _secuencia;
+  uint64_t _tiempoAireMaxUs;
+  std::vector<NodoSimulado*> _nodos;
+  std::priority_queue<Evento, std::vector<Evento>, std::greater<Evento> > _eventos;
+  std::deque<Transmision> _transmisiones; ///< Transmisiones recientes (para detectar solapes).
+  size_t _baseTransmisiones;              ///< Índice absoluto de `_transmisiones.front()`.
+  std::vector<OcupacionCanal> _ocupacion;
+  std::unordered_map<uint64_t, double> _sombreadoEnlaces; ///< Sombreado de cada enlace ya sorteado (dB).
+
+  void _programar(uint64_t instanteUs, TipoEvento tipo, size_t indice) {
+    Evento evento = { instanteUs, _secuencia++, tipo, indice };
+    _eventos.push(evento);
+  }
+
+  void _ejecutarAplicacion(size_t id) {
+    NodoSimulado& n = *_nodos[id];
+    if (n._aplicacion == nullptr) return;
+    uint64_t siguiente = n._aplicacion->ejecutar(n, _ahoraUs);
+    if (siguiente != NUNCA) {
+      _programar(siguiente > _ahoraUs ? siguiente : _ahoraUs, EVENTO_APLICACION, id);
+    }
+  }
+
+  /**
+   * @brief Pone en el aire la siguiente trama de la cola del nodo, si está libre.
+   */
+  void _intentarTransmitir(NodoSimulado& n) {
+    if (n._transmitiendo || n._dormido || n._colaTx.empty()) return;
+
+    Transmision tx;
+    tx.emisor = n._id;
+    tx.inicioUs = _ahoraUs;
+    tx.finUs = _ahoraUs + n._modelo.tiempoEnAireUs(n._colaTx.front().datos.size());
+    tx.encoladoUs = n._colaTx.front().encoladoUs;
+    tx.datos.swap(n._colaTx.front().datos);
+    tx.activa = true;
+    n._colaTx.pop_front();
+    n._transmitiendo = true;
+
+    uint64_t duracion = tx.finUs - tx.inicioUs;
+    if (duracion > _tiempoAireMaxUs) _tiempoAireMaxUs = duracion;
+    n._informe.enviados++;
+    n._informe.tiempoTxUs += duracion;
+    _registrarOcupacion(n._modelo, tx.inicioUs, tx.finUs);
+
+    _transmisiones.push_back(tx);
+    _programar(tx.finUs, EVENTO_FIN_TX, _baseTransmisiones + _transmisiones.size() - 1);
+  }
+
+  void _registrarOcupacion(const ModeloAire& modelo, uint64_t inicioUs, uint64_t finUs) {
+    for (size_t i = 0; i < _ocupacion.size(); i++) {
+      OcupacionCanal& o = _ocupacion[i];
+      if (o.modelo.compartenCanal(modelo)) {
+        uint64_t desde = (inicioUs > o.ocupadoHastaUs) ? inicioUs : o.ocupadoHastaUs;
+        if (finUs > desde) o.ocupadoUs += finUs - desde;
+        if (finUs > o.ocupadoHastaUs) o.ocupadoHastaUs = finUs;
+        return;
+      }
+    }
+    OcupacionCanal o = { modelo, finUs, finUs - inicioUs };
+    _ocupacion.push_back(o);
+  }
+
+  /**
+   * @brief Sombreado del enlace entre dos nodos, en dB.
+   * @details Se sortea la primera vez que se usa el enlace y se conserva: los obstáculos
+   * entre dos nodos fijos no cambian de un paquete a otro. Es el mismo en ambos sentidos.
+   */
+  double _sombreado(size_t a, size_t b) {
+    uint64_t clave = (a < b) ? ((uint64_t)a << 32) | b : ((uint64_t)b << 32) | a;
+    std::unordered_map<uint64_t, double>::iterator it = _sombreadoEnlaces.find(clave);
+    if (it != _sombreadoEnlaces.end()) return it->second;
+    std::normal_distribution<double> sombreado(0.0, _canal.sombreado_dB);
+    double valor = sombreado(_azar);
+    _sombreadoEnlaces[clave] = valor;
+    return valor;
+  }
+
+  /**
+   * @brief Potencia recibida en `receptor` de una transmisión de `emisor`, en dBm.
+   */
+  double _rssi(const NodoSimulado& emisor, const NodoSimulado& receptor) {
+    double dx = emisor._x - receptor._x;
+    double dy = emisor._y - receptor._y;
+    double distancia = std::sqrt(dx * dx + dy * dy);
+    if (distancia < 1.0) distancia = 1.0;
+    double perdida = _canal.perdidaReferencia_dB + 10.0 * _canal.exponente * std::log10(distancia);
+    if (_canal.sombreado_dB > 0.0) perdida += _sombreado(emisor._id, receptor._id);
+    return emisor._modelo.potenciaTx_dBm - perdida;
+  }
+
+  /**
+   * @brief Resuelve la recepción de una transmisión que acaba de terminar en cada nodo.
+   */
+  void _finalizarTransmision(size_t indiceAbsoluto) {
+    Transmision& tx = _transmisiones[indiceAbsoluto - _baseTransmisiones];
+    NodoSimulado& emisor = *_nodos[tx.emisor];
+    bool entregado = false;
+
+    for (size_t r = 0; r < _nodos.size(); r++) {
+      if (r == tx.emisor) continue;
+      NodoSimulado& receptor = *_nodos[r];
+      if (!receptor._modelo.compartenCanal(emisor._modelo)) continue;
+      if (receptor._dormido || receptor._despiertoDesdeUs > tx.inicioUs) continue;
+
+      double rssi = _rssi(emisor, receptor);
+      if (rssi < receptor._modelo.sensibilidad_dBm) continue;
+
+      // Interferencias: transmisiones solapadas en el mismo canal, incluida la propia (semidúplex).
+      // Las potencias de las interferentes se suman en mW: varias señales débiles pueden
+      // impedir la captura aunque ninguna por separado lo haga.
+      bool perdido = false;
+      double interferencia_mW = 0.0;
+      for (size_t j = 0; j < _transmisiones.size() && !perdido; j++) {
+        const Transmision& otra = _transmisiones[j];
+        if (&otra == &tx || otra.finUs <= tx.inicioUs || otra.inicioUs >= tx.finUs) continue;
+        if (otra.emisor == r) {
+          perdido = true; // El receptor estaba transmitiendo
+          continue;
+        }
+        const NodoSimulado& interferente = *_nodos[otra.emisor];
+        if (!interferente._modelo.compartenCanal(emisor._modelo)) continue;
+        interferencia_mW += std::pow(10.0, _rssi(interferente, receptor) / 10.0);
+      }
+      if (!perdido && interferencia_mW > 0.0) {
+        perdido = rssi - 10.0 * std::log10(interferencia_mW) < _canal.umbralCaptura_dB;
+      }
+      if (perdido) {
+        receptor._informe.colisiones++;
+        continue;
+      }
+
+      if (receptor._colaRx.size() >= receptor._capacidadRx) {
+        receptor._informe.desbordesRx++;
+        continue;
+      }
+      NodoSimulado::PaqueteRx paquete;
+      paquete.datos = tx.datos;
+      paquete.rssi = (int)std::floor(rssi);
+      receptor._colaRx.push_back(paquete);
+      receptor._informe.recibidos++;
+      if (emisor._destino == NodoSimulado::DIFUSION || emisor._destino == r) entregado = true;
+      if (receptor._aplicacion) receptor._aplicacion->alRecibir(receptor, _ahoraUs);
+    }
+
+    if (entregado) {
+      uint64_t latencia = _ahoraUs - tx.encoladoUs;
+      emisor._informe.entregados++;
+      emisor._informe.latenciaTotalUs += latencia;
+      if (latencia > emisor._informe.latenciaMaxUs) emisor._informe.latenciaMaxUs = latencia;
+    }
+
+    tx.activa = false;
+    emisor._transmitiendo = false;
+    _podarTransmisiones();
+    _intentarTransmitir(emisor);
+  }
+
+  /**
+   * @brief Descarta del historial las transmisiones que ya no pueden solaparse con ninguna activa.
+   */
+  void _podarTransmisiones() {
+    while (!_transmisiones.empty()) {
+      const Transmision& primera = _transmisiones.front();
+      if (primera.activa || primera.finUs + _tiempoAireMaxUs > _ahoraUs) break;
+      _transmisiones.pop_front();
+      _baseTransmisiones++;
+    }
+  }
+};
+
+inline bool NodoSimulado::enviar(const uint8_t* buffer, size_t longitud) {
+  if (_dormido || longitud > _modelo.mtu || _colaTx.size() >= _capacidadTx) {
+    _informe.rechazados++;
+    return false;
+  }
+  PaqueteTx paquete;
+  paquete.datos.assign(buffer, buffer + longitud);
+  paquete.encoladoUs = _simulador.ahoraUs();
+  _colaTx.push_back(paquete);
+  _simulador._intentarTransmitir(*this);
+  return true;
+}
+
+inline bool NodoSimulado::despertar() {
+  if (_dormido) {
+    _dormido = false;
+    _despiertoDesdeUs = _simulador.ahoraUs();
+    _simulador._intentarTransmitir(*this);
+  }
+  return true;
+}
+
+#endif // SIMULADOR_RED_H
@@ -0,0 +1,113 @@
+/**
+ * @file simular_red.cpp
+ * @brief Programa de ejemplo de `SimuladorRed`: sensores LoRa alrededor de un gateway.
+ * @details Reparte `nodos` sensores al azar en un cuadrado de `lado` metros con el gateway
+ * en el centro. Cada sensor arranca en un instante aleatorio del primer periodo y envía
+ * 12 bytes al gateway cada `periodo` segundos (más hasta un 10% aleatorio) durante `horas`
+ * horas virtuales. Escribe el informe CSV por nodo en la salida estándar y un resumen en la
+ * salida de error.
+ *
+ * Compilación y uso (o el objetivo `simular_red` del CMakeLists.txt raíz):
+ * @code
+ * ./simular_red                      # 500 nodos, SF7, cada 60 s, 1 hora
+ * ./simular_red 500 9 60 1 > sf9.csv # nodos sf periodo_s horas [lado_m] [sombreado_dB]
+ * @endcode
+ *
+ * @note Solo para compilación en el host. El IDE de Arduino ignora la carpeta `extras`.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+#include "SimuladorRed.h"
+
+namespace {
+
+const size_t TAM_LECTURA = 12;
+
+/**
+ * @brief Sensor periódico: una lectura cada `periodoUs`, con un desfase aleatorio.
+ */
+class Sensor : public AplicacionNodo {
+public:
+  explicit Sensor(uint64_t periodoUs) : _periodoUs(periodoUs), _secuencia(0), _arrancado(false) {}
+
+  uint64_t ejecutar(NodoSimulado& nodo, uint64_t ahoraUs) override {
+    if (!_arrancado) { // Los nodos no se encienden todos a la vez
+      _arrancado = true;
+      return ahoraUs + (uint64_t)nodo.simulador().aleatorio(0, (double)_periodoUs);
+    }
+    uint8_t lectura[TAM_LECTURA] = {0};
+    lectura[0] = (uint8_t)nodo.id();
+    lectura[1] = _secuencia++;
+    nodo.enviar(lectura, sizeof(lectura));
+    return ahoraUs + _periodoUs + (uint64_t)nodo.simulador().aleatorio(0, _periodoUs / 10.0);
+  }
+
+private:
+  uint64_t _periodoUs;
+  uint8_t _secuencia;
+  bool _arrancado;
+};
+
+/**
+ * @brief Gateway: vacía su cola de recepción en cada paquete.
+ */
+class Gateway : public AplicacionNodo {
+public:
+  uint64_t ejecutar(NodoSimulado& nodo, uint64_t ahoraUs) override {
+    (void)nodo;
+    (void)ahoraUs;
+    return SimuladorRed::NUNCA;
+  }
+
+  void alRecibir(NodoSimulado& nodo, uint64_t ahoraUs) override {
+    (void)ahoraUs;
+    uint8_t buffer[255];
+    while (nodo.hayDatosDisponibles() > 0) nodo.leer(buffer, sizeof(buffer));
+  }
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  int nodos = argc > 1 ? atoi(argv[1]) : 500;
+  int sf = argc > 2 ? atoi(argv[2]) : 7;
+  double periodoS = argc > 3 ? atof(argv[3]) : 60.0;
+  double horas = argc > 4 ? atof(argv[4]) : 1.0;
+  double lado = argc > 5 ? atof(argv[5]) : 4000.0;
+  double sombreado = argc > 6 ? atof(argv[6]) : 0.0;
+  if (nodos < 1 || sf < 7 || sf > 12 || periodoS <= 0.0 || horas <= 0.0 || lado <= 0.0) {
+    fprintf(stderr, "uso: %s [nodos] [sf 7-12] [periodo_s] [horas] [lado_m] [sombreado_dB]\n", argv[0]);
+    return 2;
+  }
+
+  LoRaConfig config = {868000000, 14, sf, 125000, 5, 0x12, 0, 0, 0};
+  ParametrosCanal canal;
+  canal.sombreado_dB = sombreado;
+  SimuladorRed sim(canal);
+
+  size_t gateway = sim.agregarNodo(ModeloAire::lora(config), 0, 0);
+  sim.nodo(gateway).fijarCapacidades(4, 16);
+  sim.asignarAplicacion(gateway, new Gateway());
+  for (int i = 0; i < nodos; i++) {
+    size_t id = sim.agregarNodo(ModeloAire::lora(config), sim.aleatorio(-lado / 2, lado / 2),
+                                sim.aleatorio(-lado / 2, lado / 2));
+    sim.nodo(id).fijarDestino(gateway);
+    sim.asignarAplicacion(id, new Sensor((uint64_t)(periodoS * 1e6)));
+  }
+  sim.ejecutarHasta((uint64_t)(horas * 3600.0 * 1e6));
+  sim.imprimirInforme(std::cout);
+
+  uint64_t enviados = 0;
+  uint64_t entregados = 0;
+  for (size_t i = 1; i < sim.numNodos(); i++) {
+    enviados += sim.nodo(i).informe().enviados;
+    entregados += sim.nodo(i).informe().entregados;
+  }
+  fprintf(stderr, "SF%d, %d nodos, cada %.0f s: entregados %llu de %llu (%.1f%%), canal ocupado %.1f%%\n", sf,
+          nodos, periodoS, (unsigned long long)entregados, (unsigned long long)enviados,
+          enviados ? 100.0 * entregados / enviados : 0.0, 100.0 * sim.utilizacionCanal(gateway));
+  return entregados > 0 ? 0 : 1;
+}
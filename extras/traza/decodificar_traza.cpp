@@ -0,0 +1,143 @@
+/**
+ * @file decodificar_traza.cpp
+ * @brief Decodificador (host) de los volcados de `TrazaRadio::volcar()`.
+ * @details Lee uno o varios volcados binarios (por ejemplo, la salida del puerto serie
+ * guardada en un archivo), empareja los eventos de inicio y fin de cada operación y
+ * muestra, por operación, el número de llamadas, los percentiles de latencia y un
+ * histograma en potencias de dos de microsegundos. Los bytes que no forman parte de un
+ * volcado (texto del sketch, por ejemplo) se ignoran.
+ *
+ * Compilación y uso:
+ * @code
+ * g++ -std=c++11 -O2 -o decodificar_traza decodificar_traza.cpp
+ * ./decodificar_traza captura.bin      # o: cat /dev/ttyUSB0 | ./decodificar_traza
+ * @endcode
+ *
+ * @note Solo para compilación en el host (usa la STL). El IDE de Arduino ignora la carpeta `extras`.
+ */
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+const uint8_t TRAZA_FIN = 0x80;
+const size_t TAM_CABECERA = 12;
+const size_t TAM_EVENTO = 5;
+const size_t NUM_OPERACIONES = 7;
+const size_t NUM_CUBETAS = 24; // Hasta 2^23 µs (~8 s)
+const char* const NOMBRES[NUM_OPERACIONES] = {
+  "iniciar", "enviar", "hayDatosDisponibles", "leer", "tomarPaquete", "dormir", "despertar"
+};
+
+uint32_t leer16(const uint8_t* p) { return (uint32_t)p[0] | ((uint32_t)p[1] << 8); }
+uint32_t leer32(const uint8_t* p) { return leer16(p) | (leer16(p + 2) << 16); }
+
+struct Operacion {
+  std::vector<uint32_t> inicios;  // Pila de inicios sin cerrar (admite anidamiento)
+  std::vector<double> latenciasUs;
+};
+
+/**
+ * @brief Procesa los eventos de un volcado. Cada volcado empareja sus propios eventos.
+ */
+void procesarVolcado(const uint8_t* eventos, size_t numEventos, double ticsPorUs,
+                     std::vector<Operacion>& operaciones, size_t& sinPareja) {
+  for (size_t i = 0; i < NUM_OPERACIONES; i++) operaciones[i].inicios.clear();
+  for (size_t i = 0; i < numEventos; i++) {
+    const uint8_t* evento = eventos + i * TAM_EVENTO;
+    uint32_t tics = leer32(evento);
+    uint8_t codigo = evento[4];
+    uint8_t operacion = codigo & ~TRAZA_FIN;
+    if (operacion >= NUM_OPERACIONES) {
+      sinPareja++;
+      continue;
+    }
+    Operacion& op = operaciones[operacion];
+    if (!(codigo & TRAZA_FIN)) {
+      op.inicios.push_back(tics);
+    } else if (op.inicios.empty()) {
+      sinPareja++; // Su inicio se sobrescribió en el anillo
+    } else {
+      uint32_t duracion = tics - op.inicios.back(); // Aritmética modular: admite el desbordamiento del reloj
+      op.inicios.pop_back();
+      op.latenciasUs.push_back(duracion / ticsPorUs);
+    }
+  }
+  for (size_t i = 0; i < NUM_OPERACIONES; i++) sinPareja += operaciones[i].inicios.size();
+}
+
+double percentil(const std::vector<double>& ordenadas, double p) {
+  size_t indice = (size_t)(p * (ordenadas.size() - 1) + 0.5);
+  return ordenadas[indice];
+}
+
+void imprimirOperacion(const char* nombre, std::vector<double> latencias) {
+  std::sort(latencias.begin(), latencias.end());
+  std::printf("\n%s: %zu llamadas, min %.0f us, p50 %.0f us, p90 %.0f us, p99 %.0f us, max %.0f us\n",
+              nombre, latencias.size(), latencias.front(), percentil(latencias, 0.5),
+              percentil(latencias, 0.9), percentil(latencias, 0.99), latencias.back());
+
+  size_t cubetas[NUM_CUBETAS] = {0};
+  for (size_t i = 0; i < latencias.size(); i++) {
+    size_t cubeta = 0;
+    while (cubeta + 1 < NUM_CUBETAS && latencias[i] >= (double)(1UL << cubeta)) cubeta++;
+    cubetas[cubeta]++;
+  }
+  size_t maximo = *std::max_element(cubetas, cubetas + NUM_CUBETAS);
+  for (size_t c = 0; c < NUM_CUBETAS; c++) {
+    if (cubetas[c] == 0) continue;
+    unsigned long desde = (c == 0) ? 0 : (1UL << (c - 1));
+    std::printf("  %8lu-%-8lu us %7zu %s\n", desde, 1UL << c, cubetas[c],
+                std::string((cubetas[c] * 50 + maximo - 1) / maximo, '#').c_str());
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  std::vector<uint8_t> datos;
+  if (argc > 1) {
+    std::ifstream archivo(argv[1], std::ios::binary);
+    if (!archivo) {
+      std::fprintf(stderr, "No se puede abrir %s\n", argv[1]);
+      return 1;
+    }
+    datos.assign(std::istreambuf_iterator<char>(archivo), std::istreambuf_iterator<char>());
+  } else {
+    std::cin >> std::noskipws;
+    datos.assign(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+  }
+
+  std::vector<Operacion> operaciones(NUM_OPERACIONES);
+  size_t volcados = 0, sinPareja = 0;
+  unsigned long sobrescritos = 0;
+  for (size_t i = 0; i + TAM_CABECERA <= datos.size(); i++) {
+    const uint8_t* cabecera = &datos[i];
+    if (cabecera[0] != 'U' || cabecera[1] != 'R' || cabecera[2] != 'T' || cabecera[3] != 1) continue;
+    uint32_t ticsPorUs = leer16(cabecera + 4);
+    size_t numEventos = leer16(cabecera + 6);
+    if (ticsPorUs == 0 || i + TAM_CABECERA + numEventos * TAM_EVENTO > datos.size()) continue;
+    procesarVolcado(cabecera + TAM_CABECERA, numEventos, ticsPorUs, operaciones, sinPareja);
+    sobrescritos += leer32(cabecera + 8);
+    volcados++;
+    i += TAM_CABECERA + numEventos * TAM_EVENTO - 1;
+  }
+
+  if (volcados == 0) {
+    std::fprintf(stderr, "No se encontró ningún volcado de traza\n");
+    return 1;
+  }
+  std::printf("%zu volcados, %lu eventos sobrescritos en el anillo, %zu eventos sin pareja\n",
+              volcados, sobrescritos, sinPareja);
+  for (size_t i = 0; i < NUM_OPERACIONES; i++) {
+    if (!operaciones[i].latenciasUs.empty()) imprimirOperacion(NOMBRES[i], operaciones[i].latenciasUs);
+  }
+  return 0;
+}
@@ -0,0 +1,182 @@
+/**
+ * @file AnilloPaquetes.h
+ * @brief Define un anillo de paquetes de ranura fija, de un productor y un consumidor (SPSC).
+ * @details Pensado para pasar paquetes completos desde una rutina de interrupción
+ * (productor) al `loop()` principal (consumidor) sin bloqueos ni memoria dinámica.
+ * Cada ranura guarda la longitud, el RSSI y los datos de un paquete.
+ */
+
+#ifndef ANILLO_PAQUETES_H
+#define ANILLO_PAQUETES_H
+
+#include <Arduino.h>
+
+/**
+ * @class AnilloPaquetes
+ * @brief Anillo SPSC sin bloqueos que opera sobre memoria proporcionada por el llamador.
+ * @details El productor llama a `reservarEscritura()`, copia el paquete en la ranura
+ * devuelta y lo publica con `confirmarEscritura()`. El consumidor lee la ranura del
+ * frente con `frente()`/`longitudFrente()` y la libera con `liberarFrente()`.
+ * @note Los índices son de 8 bits, por lo que su lectura/escritura es atómica incluso
+ * en AVR. Antes de publicar un índice se emite una barrera de compilador para que la
+ * copia de la ranura no se reordene después de él. Una ranura queda siempre libre para
+ * distinguir "lleno" de "vacío", así que la capacidad útil es `numRanuras - 1`.
+ */
+class AnilloPaquetes {
+public:
+  /// Bytes de cabecera por ranura: longitud (2) + RSSI (2).
+  static const uint16_t TAM_CABECERA = 4;
+
+  /**
+   * @brief Constructor.
+   * @param memoria Bloque de `numRanuras * (tamRanura + TAM_CABECERA)` bytes.
+   * @param numRanuras Número de ranuras (2-255).
+   * @param tamRanura Tamaño máximo de un paquete en bytes.
+   */
+  AnilloPaquetes(uint8_t* memoria, uint8_t numRanuras, uint16_t tamRanura)
+    : _memoria(memoria),
+      _numRanuras(numRanuras),
+      _tamRanura(tamRanura),
+      _cabeza(0),
+      _cola(0),
+      _descartados(0) {}
+
+  /**
+   * @brief Tamaño máximo de un paquete que cabe en una ranura.
+   */
+  uint16_t tamRanura() const { return _tamRanura; }
+
+  /**
+   * @brief Indica si no hay paquetes pendientes de consumir.
+   */
+  bool vacio() const { return _cabeza == _cola; }
+
+  /**
+   * @brief Indica si no queda ninguna ranura libre para el productor.
+   */
+  bool lleno() const { return _siguiente(_cabeza) == _cola; }
+
+  /**
+   * @brief Número de paquetes pendientes de consumir.
+   */
+  uint8_t pendientes() const {
+    uint8_t cabeza = _cabeza;
+    uint8_t cola = _cola;
+    return (cabeza >= cola) ? (cabeza - cola) : (uint8_t)(_numRanuras - cola + cabeza);
+  }
+
+  /**
+   * @brief Número de paquetes descartados porque el anillo estaba lleno.
+   */
+  uint32_t descartados() const { return _descartados; }
+
+  // --- Lado del productor ---
+
+  /**
+   * @brief Obtiene la zona de datos de la siguiente ranura libre.
+   * @return Puntero a `tamRanura()` bytes escribibles, o `nullptr` si el anillo está lleno
+   * (en ese caso se contabiliza un paquete descartado).
+   */
+  uint8_t* reservarEscritura() {
+    if (lleno()) {
+      _descartados++;
+      return nullptr;
+    }
+    return _datos(_cabeza);
+  }
+
+  /**
+   * @brief Publica la ranura reservada para que el consumidor pueda leerla.
+   * @param longitud Bytes escritos en la ranura (se recorta a `tamRanura()`).
+   * @param rssi RSSI asociado al paquete, en dBm.
+   */
+  void confirmarEscritura(uint16_t longitud, int16_t rssi) {
+    uint8_t* ranura = _ranura(_cabeza);
+    if (longitud > _tamRanura) longitud = _tamRanura;
+    ranura[0] = (uint8_t)(longitud & 0xFF);
+    ranura[1] = (uint8_t)(longitud >> 8);
+    ranura[2] = (uint8_t)((uint16_t)rssi & 0xFF);
+    ranura[3] = (uint8_t)((uint16_t)rssi >> 8);
+    _barrera();
+    _cabeza = _siguiente(_cabeza); // Publicar al final, cuando la ranura ya está completa
+  }
+
+  // --- Lado del consumidor ---
+
+  /**
+   * @brief Puntero a los datos del paquete más antiguo. Solo válido si `!vacio()`.
+   */
+  const uint8_t* frente() const { return _datos(_cola); }
+
+  /**
+   * @brief Longitud del paquete más antiguo, o 0 si el anillo está vacío.
+   */
+  uint16_t longitudFrente() const {
+    if (vacio()) return 0;
+    const uint8_t* ranura = _ranura(_cola);
+    return (uint16_t)(ranura[0] | (ranura[1] << 8));
+  }
+
+  /**
+   * @brief RSSI del paquete más antiguo, o 0 si el anillo está vacío.
+   */
+  int16_t rssiFrente() const {
+    if (vacio()) return 0;
+    const uint8_t* ranura = _ranura(_cola);
+    return (int16_t)(ranura[2] | (ranura[3] << 8));
+  }
+
+  /**
+   * @brief Libera la ranura del frente para que el productor la reutilice.
+   */
+  void liberarFrente() {
+    if (!vacio()) {
+      _barrera(); // La lectura de la ranura termina antes de cederla al productor
+      _cola = _siguiente(_cola);
+    }
+  }
+
+private:
+  uint8_t* _memoria;          ///< Bloque de ranuras (cabecera + datos).
+  uint8_t _numRanuras;        ///< Número total de ranuras.
+  uint16_t _tamRanura;        ///< Bytes de datos por ranura.
+  volatile uint8_t _cabeza;   ///< Próxima ranura a escribir (solo la modifica el productor).
+  volatile uint8_t _cola;     ///< Próxima ranura a leer (solo la modifica el consumidor).
+  volatile uint32_t _descartados; ///< Paquetes perdidos por anillo lleno.
+
+  /**
+   * @brief Barrera de compilador: los accesos a memoria anteriores no se mueven después de ella.
+   * @details Basta en núcleos de un solo hilo (AVR, Cortex-M0/M3/M4 y ESP32 con ISR en el mismo
+   * núcleo), donde el productor es una interrupción del mismo procesador.
+   */
+  static inline void _barrera() { asm volatile("" ::: "memory"); }
+
+  uint8_t _siguiente(uint8_t indice) const {
+    return (uint8_t)((indice + 1 >= _numRanuras) ? 0 : indice + 1);
+  }
+
+  uint8_t* _ranura(uint8_t indice) const {
+    return _memoria + (size_t)indice * (_tamRanura + TAM_CABECERA);
+  }
+
+  uint8_t* _datos(uint8_t indice) const {
+    return _ranura(indice) + TAM_CABECERA;
+  }
+};
+
+/**
+ * @class AnilloPaquetesEstatico
+ * @brief `AnilloPaquetes` que reserva su propia memoria de forma estática.
+ * @tparam RANURAS Número de ranuras (capacidad útil `RANURAS - 1`).
+ * @tparam TAM_RANURA Tamaño máximo de un paquete en bytes.
+ */
+template <uint8_t RANURAS, uint16_t TAM_RANURA>
+class AnilloPaquetesEstatico : public AnilloPaquetes {
+public:
+  AnilloPaquetesEstatico() : AnilloPaquetes(_almacen, RANURAS, TAM_RANURA) {}
+
+private:
+  uint8_t _almacen[(size_t)RANURAS * (TAM_RANURA + AnilloPaquetes::TAM_CABECERA)]; ///< Memoria de las ranuras.
+};
+
+#endif // ANILLO_PAQUETES_H
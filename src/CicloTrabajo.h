@@ -0,0 +1,103 @@
+/**
+ * @file CicloTrabajo.h
+ * @brief Define ContadorCicloTrabajo, un control del ciclo de trabajo (duty cycle) de transmisión.
+ * @details Lleva la cuenta del tiempo en el aire consumido frente a un presupuesto regulatorio
+ * (ej. 1% en la banda EU868) y permite rechazar envíos que lo excederían, o saber cuánto
+ * esperar antes de poder transmitir.
+ */
+
+#ifndef CICLO_TRABAJO_H
+#define CICLO_TRABAJO_H
+
+#include <Arduino.h>
+
+/**
+ * @class ContadorCicloTrabajo
+ * @brief Cubo de fichas (token bucket) de tiempo en el aire.
+ * @details El presupuesto se recarga de forma continua a razón de `cicloPorMil` µs por
+ * cada milisegundo transcurrido, hasta un máximo equivalente a una `ventanaMs` completa
+ * (ej. 36 s por hora al 1%). Empieza lleno.
+ */
+class ContadorCicloTrabajo {
+private:
+  uint16_t _cicloPorMil;      ///< Ciclo de trabajo permitido, en tanto por mil (10 = 1%).
+  uint32_t _maximoUs;         ///< Presupuesto máximo acumulable, en µs.
+  uint32_t _disponibleUs;     ///< Presupuesto disponible en el último instante actualizado.
+  uint32_t _ultimaRecargaMs;  ///< Instante (millis) de la última recarga.
+
+  /**
+   * @brief Suma al presupuesto la parte correspondiente al tiempo transcurrido.
+   */
+  void _recargar() {
+    uint32_t ahora = millis();
+    uint32_t transcurridoMs = ahora - _ultimaRecargaMs;
+    if (transcurridoMs == 0) return;
+    _ultimaRecargaMs = ahora;
+
+    uint32_t faltaUs = _maximoUs - _disponibleUs;
+    // Evita desbordar la multiplicación tras largos periodos sin transmitir
+    if (transcurridoMs >= faltaUs / _cicloPorMil + 1) {
+      _disponibleUs = _maximoUs;
+    } else {
+      _disponibleUs += transcurridoMs * _cicloPorMil;
+    }
+  }
+
+public:
+  /**
+   * @brief Constructor.
+   * @param cicloPorMil Ciclo de trabajo en tanto por mil (ej. 10 para 1%, 1 para 0.1%). Mínimo 1.
+   * @param ventanaMs Ventana de observación en ms (por defecto, una hora).
+   */
+  ContadorCicloTrabajo(uint16_t cicloPorMil, uint32_t ventanaMs = 3600000UL)
+    : _cicloPorMil(cicloPorMil ? cicloPorMil : 1),
+      _maximoUs(ventanaMs * (cicloPorMil ? cicloPorMil : 1)),
+      _disponibleUs(_maximoUs),
+      _ultimaRecargaMs(millis()) {}
+
+  /**
+   * @brief Descuenta el tiempo en el aire de una transmisión, si cabe en el presupuesto.
+   * @param tiempoEnAireUs Duración de la transmisión (ver `tiempoEnAireLoRaUs()`).
+   * @return true si había presupuesto y se descontó; false si la transmisión debe rechazarse.
+   */
+  bool consumir(uint32_t tiempoEnAireUs) {
+    _recargar();
+    if (tiempoEnAireUs > _disponibleUs) return false;
+    _disponibleUs -= tiempoEnAireUs;
+    return true;
+  }
+
+  /**
+   * @brief Devuelve al presupuesto el tiempo de una transmisión que se descontó pero no llegó al aire.
+   * @details Lo usan los drivers cuando el módulo rechaza la trama después de `consumir()`
+   * (ej. radio ocupada, o una trama encolada que se descarta). El presupuesto no supera
+   * el máximo.
+   * @param tiempoEnAireUs El mismo valor que se pasó a `consumir()`.
+   */
+  void devolver(uint32_t tiempoEnAireUs) {
+    _disponibleUs = (tiempoEnAireUs > _maximoUs - _disponibleUs) ? _maximoUs : _disponibleUs + tiempoEnAireUs;
+  }
+
+  /**
+   * @brief Presupuesto de tiempo en el aire disponible ahora mismo, en µs.
+   */
+  uint32_t presupuestoRestanteUs() {
+    _recargar();
+    return _disponibleUs;
+  }
+
+  /**
+   * @brief Milisegundos que hay que esperar para poder transmitir `tiempoEnAireUs`.
+   * @return 0 si ya se puede transmitir. Si la transmisión excede el presupuesto máximo,
+   * nunca podrá hacerse y se devuelve 0xFFFFFFFF.
+   */
+  uint32_t esperaNecesariaMs(uint32_t tiempoEnAireUs) {
+    _recargar();
+    if (tiempoEnAireUs > _maximoUs) return 0xFFFFFFFFUL;
+    if (tiempoEnAireUs <= _disponibleUs) return 0;
+    uint32_t faltaUs = tiempoEnAireUs - _disponibleUs;
+    return (faltaUs + _cicloPorMil - 1) / _cicloPorMil;
+  }
+};
+
+#endif // CICLO_TRABAJO_H
@@ -0,0 +1,252 @@
+/**
+ * @file CodificadorDelta.h
+ * @brief Codificación compacta de series de lecturas enteras o de punto fijo.
+ * @details Cada muestra se guarda como la diferencia con la anterior, transformada en zig-zag
+ * (0, -1, 1, -2... pasan a 0, 1, 2, 3...) para que las diferencias pequeñas, positivas o
+ * negativas, ocupen pocos bits. Hay dos formatos:
+ * - Varint (por defecto): 7 bits por byte, con el bit alto indicando que sigue otro byte.
+ *   Una diferencia entre -64 y 63 ocupa un byte.
+ * - Empaquetado de bits: cada diferencia ocupa exactamente `bits` bits; las que no caben se
+ *   escapan con el código de todo unos seguido de 32 bits. Útil cuando las diferencias
+ *   tienen un rango acotado y conocido (ej. 4 bits para una temperatura en décimas).
+ *
+ * La primera muestra se codifica como diferencia con 0, así que cada buffer se decodifica
+ * por sí solo. Las muestras se añaden de una en una sobre memoria del llamador, de modo que
+ * un nodo puede ir llenando el payload de un paquete a medida que mide.
+ */
+
+#ifndef CODIFICADOR_DELTA_H
+#define CODIFICADOR_DELTA_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Transforma un entero con signo en uno sin signo con los valores pequeños primero.
+ */
+inline uint32_t zigzagCodificar(int32_t valor) {
+  return ((uint32_t)valor << 1) ^ (uint32_t)(valor >> 31);
+}
+
+/**
+ * @brief Inversa de `zigzagCodificar()`.
+ */
+inline int32_t zigzagDecodificar(uint32_t valor) {
+  return (int32_t)((valor >> 1) ^ (0 - (valor & 1)));
+}
+
+/**
+ * @brief Convierte una lectura a punto fijo redondeando (ej. 21.37 con escala 100 -> 2137).
+ */
+inline int32_t aPuntoFijo(float valor, int32_t escala) {
+  float escalado = valor * (float)escala;
+  return (int32_t)(escalado >= 0 ? escalado + 0.5f : escalado - 0.5f);
+}
+
+/**
+ * @class CodificadorDelta
+ * @brief Codificador incremental de una serie de muestras en un buffer del llamador.
+ */
+class CodificadorDelta {
+public:
+  static const uint8_t BITS_VARINT = 0; ///< Valor de `bits` para el formato varint.
+
+  /**
+   * @brief Constructor.
+   * @param buffer Memoria donde se escriben las muestras codificadas (ej. el payload de un paquete).
+   * @param capacidad Tamaño de `buffer` en bytes.
+   * @param bits `BITS_VARINT` (por defecto) o bits por diferencia en el empaquetado de bits (1-31).
+   */
+  CodificadorDelta(uint8_t* buffer, size_t capacidad, uint8_t bits = BITS_VARINT)
+    : _buffer(buffer),
+      _capacidadBits(capacidad * 8),
+      _bits(bits > 31 ? 31 : bits) {
+    reiniciar();
+  }
+
+  /**
+   * @brief Vacía el buffer. La siguiente muestra vuelve a codificarse respecto a 0.
+   */
+  void reiniciar() {
+    _posicionBits = 0;
+    _anterior = 0;
+    _muestras = 0;
+  }
+
+  /**
+   * @brief Añade una muestra.
+   * @return false si no cabe; en ese caso el buffer no se modifica y se puede enviar tal cual.
+   */
+  bool agregar(int32_t valor) {
+    uint32_t codigo = zigzagCodificar((int32_t)((uint32_t)valor - (uint32_t)_anterior));
+    if (_bits == BITS_VARINT) {
+      if (!_escribirVarint(codigo)) return false;
+    } else {
+      uint32_t escape = (1UL << _bits) - 1;
+      size_t necesarios = (codigo < escape) ? _bits : _bits + 32;
+      if (_posicionBits + necesarios > _capacidadBits) return false;
+      if (codigo < escape) {
+        _escribirBits(codigo, _bits);
+      } else {
+        _escribirBits(escape, _bits);
+        _escribirBits(codigo, 32);
+      }
+    }
+    _anterior = valor;
+    _muestras++;
+    return true;
+  }
+
+  /**
+   * @brief Añade una lectura en punto fijo (ver `aPuntoFijo()`).
+   */
+  bool agregar(float valor, int32_t escala) { return agregar(aPuntoFijo(valor, escala)); }
+
+  /**
+   * @brief Bytes ocupados en el buffer (lo que hay que enviar).
+   */
+  size_t longitud() const { return (_posicionBits + 7) / 8; }
+
+  /**
+   * @brief Muestras codificadas desde el último `reiniciar()`.
+   */
+  uint16_t muestras() const { return _muestras; }
+
+  /**
+   * @brief Buffer con las muestras codificadas.
+   */
+  const uint8_t* datos() const { return _buffer; }
+
+private:
+  uint8_t* _buffer;
+  size_t _capacidadBits;
+  uint8_t _bits;
+  size_t _posicionBits;
+  int32_t _anterior;
+  uint16_t _muestras;
+
+  bool _escribirVarint(uint32_t codigo) {
+    size_t posicion = _posicionBits / 8;
+    size_t necesarios = 1;
+    for (uint32_t resto = codigo >> 7; resto; resto >>= 7) necesarios++;
+    if (posicion + necesarios > _capacidadBits / 8) return false; // Sin tocar los bytes libres
+    do {
+      uint8_t byte = codigo & 0x7F;
+      codigo >>= 7;
+      _buffer[posicion++] = codigo ? (byte | 0x80) : byte;
+    } while (codigo);
+    _posicionBits = posicion * 8;
+    return true;
+  }
+
+  /**
+   * @brief Escribe los `n` bits bajos de `valor`, empezando por el menos significativo.
+   * @details Los bits sin usar del último byte quedan a 1, que el decodificador interpreta
+   * como un escape incompleto (fin de los datos).
+   */
+  void _escribirBits(uint32_t valor, uint8_t n) {
+    while (n > 0) {
+      uint8_t desplazamiento = _posicionBits & 7;
+      uint8_t* byte = _buffer + _posicionBits / 8;
+      if (desplazamiento == 0) *byte = 0xFF;
+      uint8_t trozo = 8 - desplazamiento;
+      if (trozo > n) trozo = n;
+      uint8_t mascara = (uint8_t)(((1U << trozo) - 1) << desplazamiento);
+      *byte = (*byte & ~mascara) | ((uint8_t)(valor << desplazamiento) & mascara);
+      valor >>= trozo;
+      n -= trozo;
+      _posicionBits += trozo;
+    }
+  }
+};
+
+/**
+ * @class DecodificadorDelta
+ * @brief Decodificador incremental de un buffer escrito por `CodificadorDelta`.
+ * @details Debe usar el mismo valor de `bits` que el codificador.
+ */
+class DecodificadorDelta {
+public:
+  /**
+   * @brief Constructor.
+   * @param datos Muestras codificadas (ej. el payload de un paquete recibido).
+   * @param longitud Bytes de `datos`.
+   * @param bits El mismo valor de `bits` que usó el codificador.
+   */
+  DecodificadorDelta(const uint8_t* datos, size_t longitud, uint8_t bits = CodificadorDelta::BITS_VARINT)
+    : _datos(datos),
+      _longitudBits(longitud * 8),
+      _bits(bits > 31 ? 31 : bits),
+      _posicionBits(0),
+      _anterior(0) {}
+
+  /**
+   * @brief Obtiene la siguiente muestra.
+   * @return false al llegar al final de los datos (o si están truncados).
+   */
+  bool siguiente(int32_t& valor) {
+    uint32_t codigo;
+    if (_bits == CodificadorDelta::BITS_VARINT) {
+      if (!_leerVarint(codigo)) return false;
+    } else {
+      if (_posicionBits + _bits > _longitudBits) return false;
+      codigo = _leerBits(_bits);
+      if (codigo == (1UL << _bits) - 1) {
+        if (_posicionBits + 32 > _longitudBits) return false; // Relleno del último byte
+        codigo = _leerBits(32);
+      }
+    }
+    _anterior = (int32_t)((uint32_t)_anterior + (uint32_t)zigzagDecodificar(codigo));
+    valor = _anterior;
+    return true;
+  }
+
+  /**
+   * @brief Obtiene la siguiente muestra como lectura en punto fijo (`valor / escala`).
+   */
+  bool siguiente(float& valor, int32_t escala) {
+    int32_t entero;
+    if (!siguiente(entero)) return false;
+    valor = (float)entero / (float)escala;
+    return true;
+  }
+
+private:
+  const uint8_t* _datos;
+  size_t _longitudBits;
+  uint8_t _bits;
+  size_t _posicionBits;
+  int32_t _anterior;
+
+  bool _leerVarint(uint32_t& codigo) {
+    size_t posicion = _posicionBits / 8;
+    size_t longitud = _longitudBits / 8;
+    codigo = 0;
+    for (uint8_t desplazamiento = 0; desplazamiento < 35; desplazamiento += 7) {
+      if (posicion >= longitud) return false;
+      uint8_t byte = _datos[posicion++];
+      codigo |= (uint32_t)(byte & 0x7F) << desplazamiento;
+      if (!(byte & 0x80)) {
+        _posicionBits = posicion * 8;
+        return true;
+      }
+    }
+    return false; // Más de 5 bytes: datos corruptos
+  }
+
+  uint32_t _leerBits(uint8_t n) {
+    uint32_t valor = 0;
+    uint8_t leidos = 0;
+    while (leidos < n) {
+      uint8_t desplazamiento = _posicionBits & 7;
+      uint8_t trozo = 8 - desplazamiento;
+      if (trozo > n - leidos) trozo = n - leidos;
+      uint32_t bits = (_datos[_posicionBits / 8] >> desplazamiento) & ((1U << trozo) - 1);
+      valor |= bits << leidos;
+      leidos += trozo;
+      _posicionBits += trozo;
+    }
+    return valor;
+  }
+};
+
+#endif // CODIFICADOR_DELTA_H
@@ -0,0 +1,42 @@
+/**
+ * @file LoRaConfig.h
+ * @brief Configuración común a los drivers LoRa (`LoraRadio` y `Sx127xRadio`).
+ * @details Está separada de `LoraRadio.h` para que `Sx127xRadio.h` no dependa de la
+ * librería `LoRa`.
+ */
+
+#ifndef LORA_CONFIG_H
+#define LORA_CONFIG_H
+
+#include <Arduino.h>
+#include "TiempoEnAire.h"
+
+/**
+ * @struct LoRaConfig
+ * @brief Almacena todos los parámetros de configuración para un módulo LoRa.
+ * @note Esta estructura se pasa al constructor de LoraRadio para una inicialización sencilla.
+ * Facilita la configuración de la radio con múltiples parámetros de una sola vez.
+ */
+struct LoRaConfig {
+  long frequency;       ///< Frecuencia de operación de LoRa en Hz (ej. 915E6, 868E6, 433E6).
+  int txPower;          ///< Potencia de transmisión en dB (ej. 17, 20).
+  int spreadingFactor;  ///< Factor de dispersión (ej. 7-12). Un valor más alto es más lento pero más robusto.
+  long signalBandwidth; ///< Ancho de banda de la señal en Hz (ej. 125E3, 250E3).
+  int codingRate;       ///< Tasa de codificación (ej. 5-8, para 4/5 a 4/8).
+  int syncWord;         ///< Palabra de sincronización (0x00-0xFF). Debe coincidir entre tx y rx.
+  int csPin;            ///< Pin (GPIO) para Chip Select (SS).
+  int resetPin;         ///< Pin (GPIO) para Reset (RST).
+  int irqPin;           ///< Pin (GPIO) para Interrupción (IRQ/DIO0).
+};
+
+/**
+ * @brief Tiempo en el aire de un paquete de `longitud` bytes con la configuración dada, en µs.
+ * @details Versión de `tiempoEnAireLoRaUs()` para una `LoRaConfig`; con una configuración
+ * `constexpr` se evalúa en tiempo de compilación.
+ */
+constexpr uint32_t tiempoEnAireLoRaUs(const LoRaConfig& config, size_t longitud) {
+  return tiempoEnAireLoRaUs((uint8_t)config.spreadingFactor, (uint32_t)config.signalBandwidth,
+                            (uint8_t)config.codingRate, longitud);
+}
+
+#endif // LORA_CONFIG_H
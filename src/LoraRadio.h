@@ -1,9 +1,11 @@
 /**
  * @file LoraRadio.h
- * @brief Define la clase LoraRadio, una implementación de RadioInterface para módulos LoRa.
+ * @brief Define las clases LoraNucleo y LoraRadio para módulos LoRa.
  * @details Esta clase utiliza la librería sandeepmistry/LoRa (https://github.com/sandeepmistry/arduino-LoRa)
  * para abstraer la configuración, envío, recepción y gestión de energía
  * de un módulo LoRa (como el SX1276/7/8).
+ * `LoraNucleo` es la implementación con despacho estático (`RadioBase`) y
+ * `LoraRadio` la expone como `RadioInterface`.
  */
 
 #ifndef LORA_RADIO_H
@@ -11,41 +13,309 @@
 
 #include <LoRa.h>
 #include "RadioInterface.h" 
+#include "AnilloPaquetes.h"
+#include "LoRaConfig.h"
+#include "CicloTrabajo.h"
 
-/**
- * @struct LoRaConfig
- * @brief Almacena todos los parámetros de configuración para un módulo LoRa.
- * @note Esta estructura se pasa al constructor de LoraRadio para una inicialización sencilla.
- * Facilita la configuración de la radio con múltiples parámetros de una sola vez.
- */
-struct LoRaConfig {
-  long frequency;       ///< Frecuencia de operación de LoRa en Hz (ej. 915E6, 868E6, 433E6).
-  int txPower;          ///< Potencia de transmisión en dB (ej. 17, 20).
-  int spreadingFactor;  ///< Factor de dispersión (ej. 7-12). Un valor más alto es más lento pero más robusto.
-  long signalBandwidth; ///< Ancho de banda de la señal en Hz (ej. 125E3, 250E3).
-  int codingRate;       ///< Tasa de codificación (ej. 5-8, para 4/5 a 4/8).
-  int syncWord;         ///< Palabra de sincronización (0x00-0xFF). Debe coincidir entre tx y rx.
-  int csPin;            ///< Pin (GPIO) para Chip Select (SS).
-  int resetPin;         ///< Pin (GPIO) para Reset (RST).
-  int irqPin;           ///< Pin (GPIO) para Interrupción (IRQ/DIO0).
-};
+#ifndef LORA_RADIO_TAM_BUFFER_RX
+/// Tamaño del buffer propio usado por `LoraNucleo::tomarPaquete()` en modo sondeo.
+#define LORA_RADIO_TAM_BUFFER_RX 255
+#endif
 
 /**
- * @class LoraRadio
- * @brief Implementación de la interfaz RadioInterface para módulos LoRa.
+ * @class LoraNucleo
+ * @brief Implementación con despacho estático (`RadioBase`) para módulos LoRa.
  * @details Esta clase envuelve la librería `sandeepmistry/LoRa` para proveer una
- * interfaz coherente y estandarizada definida por `RadioInterface`.
+ * interfaz coherente y estandarizada definida por `RadioBase`/`RadioInterface`.
+ *
+ * Por defecto la recepción funciona por sondeo (`LoRa.parsePacket()` desde
+ * `hayDatosDisponibles()`, una vez por paquete). Opcionalmente, con `habilitarRecepcionPorInterrupcion()`,
+ * la interrupción DIO0 (`LoRaConfig::irqPin`) vacía la FIFO del módulo en un
+ * `AnilloPaquetes` y la lectura se hace desde RAM, sin acceder al bus SPI.
+ *
+ * Del mismo modo, `habilitarTransmisionAsincrona()` convierte `enviar()` en una operación
+ * no bloqueante: la trama se encola y la interrupción de fin de transmisión (TX done)
+ * lanza la siguiente.
  */
-class LoraRadio : public RadioInterface {
+class LoraNucleo : public RadioBase<LoraNucleo> {
 private:
-  LoRaConfig _config; ///< Almacena la configuración proporcionada en el constructor.
+  LoRaConfig _config;          ///< Almacena la configuración proporcionada en el constructor.
+  AnilloPaquetes* _anilloRx;   ///< Anillo de recepción por interrupción. nullptr en modo sondeo.
+  int _rssiUltimo;             ///< RSSI del último paquete leído (del anillo o, en sondeo, del módulo).
+  bool _iniciada;              ///< true tras un `iniciar()` exitoso.
+
+  uint8_t _bufferRx[LORA_RADIO_TAM_BUFFER_RX]; ///< Buffer de `tomarPaquete()` en modo sondeo.
+  size_t _longitudVista;       ///< Longitud del paquete en `_bufferRx`. 0 si no hay vista tomada.
+  int _longitudPendiente;      ///< En sondeo, longitud del paquete detectado por `parsePacket()` y aún no leído. 0 si no hay.
+
+  AnilloPaquetes* _colaTx;                     ///< Cola de transmisión asíncrona. nullptr en modo bloqueante.
+  void (*_alCompletarTx)(uint16_t, bool);      ///< Callback opcional por trama transmitida.
+  volatile bool _txEnCurso;                    ///< true mientras hay una trama en el aire.
+  uint16_t _tramasEncoladas;                   ///< Número de secuencia de la última trama encolada.
+  volatile uint16_t _tramasCompletadas;        ///< Número de secuencia de la última trama terminada.
+
+  ContadorCicloTrabajo* _cicloTrabajo;         ///< Control de duty cycle opcional. nullptr si no se usa.
+
+  EstadisticasRadio _estadisticas;             ///< Contadores de actividad (también los actualizan las interrupciones).
+
+  /**
+   * @brief Instancia que atiende las interrupciones de la librería LoRa.
+   * @details La librería `LoRa` es un singleton y sus callbacks son funciones libres,
+   * por lo que solo puede haber una instancia activa en modo interrupción.
+   */
+  static LoraNucleo*& _instanciaIrq() {
+    static LoraNucleo* instancia = nullptr;
+    return instancia;
+  }
+
+  /**
+   * @brief Callback de recepción completa (DIO0), ejecutado en contexto de interrupción.
+   * @details Copia el paquete de la FIFO del módulo a la siguiente ranura libre del anillo.
+   * Si el anillo está lleno, el paquete se descarta y se contabiliza en `AnilloPaquetes::descartados()`.
+   * @param tamPaquete Tamaño del paquete recibido en bytes.
+   */
+  static void _alRecibirPaquete(int tamPaquete) {
+    LoraNucleo* radio = _instanciaIrq();
+    if (radio == nullptr || radio->_anilloRx == nullptr) return;
+
+    AnilloPaquetes& anillo = *radio->_anilloRx;
+    uint8_t* destino = anillo.reservarEscritura();
+    if (destino == nullptr) { // Anillo lleno
+      radio->_estadisticas.desbordamientosRx++;
+      return;
+    }
+
+    uint16_t bytesLeidos = 0;
+    while (bytesLeidos < (uint16_t)tamPaquete && bytesLeidos < anillo.tamRanura()) {
+      destino[bytesLeidos] = (uint8_t)LoRa.read();
+      bytesLeidos++;
+    }
+    int rssi = LoRa.packetRssi();
+    anillo.confirmarEscritura(bytesLeidos, (int16_t)rssi);
+
+    radio->_estadisticas.registrarRecepcion(bytesLeidos);
+    radio->_estadisticas.registrarRSSI(rssi);
+    if (bytesLeidos < (uint16_t)tamPaquete) radio->_estadisticas.lecturasTruncadas++;
+  }
+
+  /**
+   * @brief Callback de transmisión completa (TX done), ejecutado en contexto de interrupción.
+   * @details Libera la trama que estaba en el aire, notifica al callback del usuario
+   * y arranca la siguiente trama de la cola, si la hay.
+   */
+  static void _alTerminarTransmision() {
+    LoraNucleo* radio = _instanciaIrq();
+    if (radio == nullptr || radio->_colaTx == nullptr) return;
+
+    radio->_colaTx->liberarFrente();
+    radio->_notificarTx(true);
+    radio->_iniciarSiguienteTx();
+  }
+
+  /**
+   * @brief Avanza el contador de tramas completadas e invoca el callback del usuario.
+   * @param exito true si la trama se transmitió, false si se descartó.
+   */
+  void _notificarTx(bool exito) {
+    _tramasCompletadas++;
+    if (_alCompletarTx) _alCompletarTx(_tramasCompletadas, exito);
+  }
+
+  /**
+   * @brief Carga en el módulo la trama del frente de la cola y la transmite sin bloquear.
+   * @details Si la cola queda vacía, marca el transmisor como libre y, en modo
+   * interrupción, vuelve a dejar el módulo en recepción continua.
+   */
+  void _iniciarSiguienteTx() {
+    while (!_colaTx->vacio()) {
+      if (LoRa.beginPacket()) {
+        LoRa.write(_colaTx->frente(), _colaTx->longitudFrente());
+        LoRa.endPacket(true); // Asíncrono: el fin se notifica por TX done
+        return;
+      }
+      // La radio rechazó el paquete: se descarta (no llegó al aire) y se prueba con el siguiente
+      _estadisticas.tramasNoEntregadas++;
+      if (_cicloTrabajo) _cicloTrabajo->devolver(tiempoEnAireUs(_colaTx->longitudFrente()));
+      _colaTx->liberarFrente();
+      _notificarTx(false);
+    }
+    _txEnCurso = false;
+    if (_anilloRx) LoRa.receive();
+  }
+
+  /**
+   * @brief Registra el callback de fin de transmisión (TX done).
+   * @details `LoRa.onTxDone()` engancha la interrupción en el pin DIO0 configurado en ese
+   * momento, así que solo se llama con los pines ya fijados por `iniciar()`.
+   */
+  void _armarTransmision() {
+    _instanciaIrq() = this;
+    LoRa.onTxDone(_alTerminarTransmision);
+  }
+
+  /**
+   * @brief Registra el callback de recepción y deja el módulo en recepción continua.
+   */
+  void _armarRecepcion() {
+    _instanciaIrq() = this;
+    LoRa.onReceive(_alRecibirPaquete);
+    LoRa.receive();
+  }
+
+  /**
+   * @brief Descuenta del presupuesto de ciclo de trabajo el tiempo en el aire de una trama.
+   * @details Con las interrupciones desactivadas: TX done puede devolver presupuesto
+   * (`_iniciarSiguienteTx()`) en medio de la operación.
+   * @return true si no hay límite o la trama cabe en el presupuesto.
+   */
+  bool _cobrarCicloTrabajo(size_t longitud) {
+    if (_cicloTrabajo == nullptr) return true;
+    uint32_t aire = tiempoEnAireUs(longitud);
+    noInterrupts();
+    bool cabe = _cicloTrabajo->consumir(aire);
+    interrupts();
+    return cabe;
+  }
+
+  /**
+   * @brief Devuelve al presupuesto una trama cobrada que no llegó a transmitirse.
+   */
+  void _devolverCicloTrabajo(size_t longitud) {
+    if (_cicloTrabajo == nullptr) return;
+    uint32_t aire = tiempoEnAireUs(longitud);
+    noInterrupts();
+    _cicloTrabajo->devolver(aire);
+    interrupts();
+  }
+
+  /**
+   * @brief Contabiliza un `enviar()` rechazado.
+   * @param ocupada true si el motivo es la radio ocupada o la cola llena.
+   * @return false, para usarlo directamente en el `return` de `enviar()`.
+   */
+  bool _rechazarEnvio(bool ocupada) {
+    _estadisticas.enviosFallidos++;
+    if (ocupada) _estadisticas.rechazosOcupada++;
+    return false;
+  }
 
 public:
   /**
-   * @brief Constructor de la clase LoraRadio.
+   * @brief Constructor de la clase LoraNucleo.
    * @param config Estructura `LoRaConfig` con todos los parámetros de inicialización necesarios.
    */
-  LoraRadio(const LoRaConfig& config) : _config(config) {}
+  LoraNucleo(const LoRaConfig& config)
+    : _config(config),
+      _anilloRx(nullptr),
+      _rssiUltimo(0),
+      _iniciada(false),
+      _longitudVista(0),
+      _longitudPendiente(0),
+      _colaTx(nullptr),
+      _alCompletarTx(nullptr),
+      _txEnCurso(false),
+      _tramasEncoladas(0),
+      _tramasCompletadas(0),
+      _cicloTrabajo(nullptr) {
+    memset(&_estadisticas, 0, sizeof(_estadisticas));
+  }
+
+  /**
+   * @brief Destructor. Desregistra el callback si esta instancia lo tenía asignado.
+   */
+  ~LoraNucleo() {
+    if (_instanciaIrq() == this) {
+      LoRa.onReceive(nullptr);
+      LoRa.onTxDone(nullptr);
+      _instanciaIrq() = nullptr;
+    }
+  }
+
+  /**
+   * @brief Activa la recepción por interrupción (opcional).
+   * @details A partir de esta llamada, cada paquete recibido se copia desde la interrupción
+   * DIO0 al `anillo`, y `hayDatosDisponibles()`/`leer()` trabajan solo sobre RAM.
+   * Puede llamarse antes o después de `iniciar()`.
+   * @param anillo Anillo donde se depositan los paquetes (ej. `AnilloPaquetesEstatico<4, 255>`).
+   * Debe existir mientras la radio esté en uso.
+   * @note `LoRaConfig::irqPin` debe estar conectado a DIO0 y admitir interrupciones externas.
+   */
+  void habilitarRecepcionPorInterrupcion(AnilloPaquetes& anillo) {
+    _anilloRx = &anillo;
+    if (_iniciada) {
+      _armarRecepcion();
+    }
+  }
+
+  /**
+   * @brief Activa la transmisión asíncrona (opcional).
+   * @details A partir de esta llamada, `enviar()` copia la trama en `colaTx` y retorna
+   * de inmediato. La interrupción TX done (DIO0) marca el fin de cada trama y arranca
+   * la siguiente, de modo que el MCU puede seguir trabajando o dormir mientras la trama
+   * está en el aire.
+   * @param colaTx Cola de tramas pendientes (ej. `AnilloPaquetesEstatico<4, 255>`).
+   * Debe existir mientras la radio esté en uso.
+   * @param alCompletar Callback opcional, invocado desde la interrupción por cada trama
+   * con su número de secuencia (ver `ultimaTramaEncolada()`) y si llegó a transmitirse.
+   * @note Puede llamarse antes o después de `iniciar()`; la interrupción se registra una
+   * vez fijado `LoRaConfig::irqPin`.
+   */
+  void habilitarTransmisionAsincrona(AnilloPaquetes& colaTx, void (*alCompletar)(uint16_t numTrama, bool exito) = nullptr) {
+    _colaTx = &colaTx;
+    _alCompletarTx = alCompletar;
+    if (_iniciada) {
+      _armarTransmision();
+    }
+  }
+
+  /**
+   * @brief Número de secuencia asignado a la última trama aceptada por `enviar()` en modo asíncrono.
+   */
+  uint16_t ultimaTramaEncolada() const { return _tramasEncoladas; }
+
+  /**
+   * @brief Número de secuencia de la última trama que terminó de transmitirse (o se descartó).
+   * @details Permite sondear el progreso sin callback: la trama `n` está terminada cuando
+   * `(uint16_t)(tramasCompletadas() - n) < 0x8000`.
+   */
+  uint16_t tramasCompletadas() const { return _tramasCompletadas; }
+
+  /**
+   * @brief Número de tramas en la cola de transmisión, incluida la que está en el aire.
+   */
+  uint8_t transmisionesPendientes() const {
+    return _colaTx ? _colaTx->pendientes() : 0;
+  }
+
+  /**
+   * @brief Limita las transmisiones a un presupuesto de ciclo de trabajo (opcional).
+   * @details A partir de esta llamada, `enviar()` calcula el tiempo en el aire de cada
+   * trama y la rechaza (devuelve false sin transmitir) si excede el presupuesto restante.
+   * Solo se cobran las tramas que llegan al aire: si el módulo rechaza la trama, o una
+   * trama encolada en modo asíncrono se descarta, su tiempo se devuelve al presupuesto.
+   * La aplicación puede consultar `contador.presupuestoRestanteUs()` o
+   * `contador.esperaNecesariaMs()` para adaptar su frecuencia de envío.
+   * @param contador Contador de ciclo de trabajo (ej. `ContadorCicloTrabajo(10)` para 1%).
+   * Debe existir mientras la radio esté en uso.
+   */
+  void limitarCicloTrabajo(ContadorCicloTrabajo& contador) {
+    _cicloTrabajo = &contador;
+  }
+
+  /**
+   * @brief Tiempo en el aire de una trama de `longitud` bytes con la configuración actual, en µs.
+   */
+  uint32_t tiempoEnAireUs(size_t longitud) const {
+    return tiempoEnAireLoRaUs(_config, longitud);
+  }
+
+  /**
+   * @brief Número de paquetes perdidos por tener el anillo de recepción lleno.
+   * @return El contador del anillo, o 0 en modo sondeo.
+   */
+  uint32_t paquetesDescartados() const {
+    return _anilloRx ? _anilloRx->descartados() : 0;
+  }
 
   /**
    * @brief Inicializa el hardware LoRa con los parámetros de la configuración.
@@ -53,7 +323,8 @@ public:
    * especificada. Luego, aplica el resto de los parámetros (potencia, SF, BW, etc.).
    * @return true si `LoRa.begin()` fue exitoso, false en caso contrario.
    */
-  bool iniciar() override {
+  bool iniciar() {
+    URWSN_TRAZAR(TRAZA_INICIAR);
     // Configura los pines específicos para la placa
     LoRa.setPins(_config.csPin, _config.resetPin, _config.irqPin);
     
@@ -69,70 +340,247 @@ public:
     LoRa.setCodingRate4(_config.codingRate);
     LoRa.setSyncWord(_config.syncWord);
     
+    _iniciada = true;
+    if (_colaTx) {
+      _armarTransmision();
+    }
+    if (_anilloRx) {
+      _armarRecepcion();
+    }
     return true; // Inicialización exitosa
   }
 
+  // Hace visibles las sobrecargas de RadioBase (ej. enviar(const String&)).
+  using RadioBase<LoraNucleo>::enviar;
+
   /**
    * @brief Envuelve los datos en un paquete LoRa y los transmite.
-   * @details Inicia un paquete LoRa, escribe el buffer de datos y cierra el paquete
-   * para comenzar la transmisión.
+   * @details Equivale a `enviar()` con un único `Segmento`.
    * @param buffer Puntero al buffer de datos que se van a enviar.
    * @param longitud Número de bytes a enviar desde el buffer.
    * @return true si se pudo *iniciar* el paquete (`LoRa.beginPacket()`), false si no.
+   * En modo asíncrono, true si la trama se encoló.
+   */
+  bool enviar(const uint8_t* buffer, size_t longitud) {
+    Segmento segmento = { buffer, longitud };
+    return enviar(&segmento, 1);
+  }
+
+  /**
+   * @brief Transmite la concatenación de varios segmentos como un único paquete LoRa.
+   * @details Inicia un paquete LoRa, escribe cada segmento directamente con `LoRa.write()`
+   * y cierra el paquete para comenzar la transmisión. En modo interrupción, vuelve a
+   * dejar el módulo en recepción continua al terminar.
+   * En modo asíncrono, copia los segmentos en la ranura de la cola de transmisión y
+   * retorna sin esperar.
+   * @param segmentos Array de segmentos, en orden de transmisión.
+   * @param numSegmentos Número de elementos de `segmentos`.
+   * @return true si se pudo *iniciar* el paquete (`LoRa.beginPacket()`), false si no.
+   * En modo asíncrono, true si la trama se encoló; false si la cola está llena o la trama
+   * no cabe en una ranura.
+   * @return false también si hay un `ContadorCicloTrabajo` y la trama excede el presupuesto,
+   * o (modo bloqueante) si hay un paquete recibido sin leer: TX y RX comparten la FIFO.
    */
-  bool enviar(const uint8_t* buffer, size_t longitud) override {
+  bool enviar(const Segmento* segmentos, size_t numSegmentos) {
+    URWSN_TRAZAR(TRAZA_ENVIAR);
+    size_t longitud = 0;
+    for (size_t i = 0; i < numSegmentos; i++) longitud += segmentos[i].longitud;
+
+    if (_colaTx && longitud > _colaTx->tamRanura()) return _rechazarEnvio(false);
+    if (_colaTx && _colaTx->lleno()) return _rechazarEnvio(true);
+    if (!_colaTx && _longitudPendiente > 0) return _rechazarEnvio(true); // TX y RX comparten la FIFO
+    if (!_cobrarCicloTrabajo(longitud)) {
+      return _rechazarEnvio(false); // Excede el presupuesto de ciclo de trabajo
+    }
+
+    if (_colaTx) {
+      // La trama encolada ya tiene su tiempo en el aire cobrado; si se descarta, se devuelve
+      uint8_t* destino = _colaTx->reservarEscritura();
+      if (destino == nullptr) {
+        _devolverCicloTrabajo(longitud);
+        return _rechazarEnvio(true); // Cola llena
+      }
+      for (size_t i = 0; i < numSegmentos; i++) {
+        memcpy(destino, segmentos[i].datos, segmentos[i].longitud);
+        destino += segmentos[i].longitud;
+      }
+      _colaTx->confirmarEscritura(longitud, 0);
+      _tramasEncoladas++;
+      _estadisticas.registrarEnvio(true, longitud);
+
+      // Arrancar el transmisor solo si estaba libre; si no, lo hará TX done
+      noInterrupts();
+      bool arrancar = !_txEnCurso;
+      _txEnCurso = true;
+      interrupts();
+      if (arrancar) _iniciarSiguienteTx();
+      return true;
+    }
+
     if (LoRa.beginPacket()) {
-      LoRa.write(buffer, longitud);
+      for (size_t i = 0; i < numSegmentos; i++) {
+        LoRa.write(segmentos[i].datos, segmentos[i].longitud);
+      }
       LoRa.endPacket(); // Inicia la transmisión
+      if (_anilloRx) LoRa.receive(); // endPacket() deja el módulo en standby
+      _estadisticas.registrarEnvio(true, longitud);
       return true;
     }
-    return false; // La radio estaba ocupada (ej. transmitiendo)
+    _devolverCicloTrabajo(longitud); // La trama no llegó al aire
+    return _rechazarEnvio(true); // La radio estaba ocupada (ej. transmitiendo)
   }
 
   /**
    * @brief Comprueba si se ha recibido un paquete LoRa completo.
    * @details Llama a `LoRa.parsePacket()`, que comprueba la interrupción IRQ
-   * y prepara la librería para la lectura del paquete.
+   * y prepara la librería para la lectura del paquete. La longitud queda pendiente hasta
+   * que el paquete se lee: mientras tanto no se vuelve a llamar a `parsePacket()`, que
+   * limpiaría las banderas y rearmaría la recepción, perdiendo el paquete.
+   * En modo interrupción solo consulta el anillo de recepción, sin acceder al bus SPI.
    * @return El tamaño del paquete recibido en bytes, o 0 si no hay paquete disponible.
    */
-  int hayDatosDisponibles() override {
-    return LoRa.parsePacket();
+  int hayDatosDisponibles() {
+    URWSN_TRAZAR(TRAZA_HAY_DATOS);
+    if (_anilloRx) {
+      return _anilloRx->longitudFrente();
+    }
+    if (_longitudPendiente == 0) {
+      _longitudPendiente = LoRa.parsePacket();
+    }
+    return _longitudPendiente;
   }
 
   /**
    * @brief Lee los datos del paquete LoRa recibido previamente.
-   * @details Esta función debe llamarse *después* de que `hayDatosDisponibles()`
-   * devuelva un valor mayor que cero. Lee bytes del búfer FIFO de LoRa
-   * hasta que se agoten o se alcance `maxLongitud`.
+   * @details Si `hayDatosDisponibles()` no se llamó antes, lo llama. Lee bytes del búfer
+   * FIFO de LoRa hasta completar el paquete o alcanzar `maxLongitud`. En modo interrupción copia el
+   * paquete más antiguo del anillo y libera su ranura (los bytes que no caben se descartan).
    * @param buffer Puntero a un buffer donde se almacenarán los datos leídos.
    * @param maxLongitud El tamaño máximo del `buffer` de destino.
    * @return El número de bytes realmente leídos del paquete.
    */
-  size_t leer(uint8_t* buffer, size_t maxLongitud) override {
-    size_t bytesLeidos = 0;
-    while (LoRa.available() && bytesLeidos < maxLongitud) {
-      buffer[bytesLeidos] = (uint8_t)LoRa.read();
-      bytesLeidos++;
+  size_t leer(uint8_t* buffer, size_t maxLongitud) {
+    URWSN_TRAZAR(TRAZA_LEER);
+    if (_anilloRx) {
+      if (_anilloRx->vacio()) return 0;
+      size_t longitud = _anilloRx->longitudFrente();
+      size_t bytesACopiar = (longitud < maxLongitud) ? longitud : maxLongitud;
+      if (bytesACopiar < longitud) {
+        // La ISR de recepción incrementa el mismo contador
+        noInterrupts();
+        _estadisticas.lecturasTruncadas++;
+        interrupts();
+      }
+      memcpy(buffer, _anilloRx->frente(), bytesACopiar);
+      _rssiUltimo = _anilloRx->rssiFrente();
+      _anilloRx->liberarFrente();
+      return bytesACopiar;
+    }
+
+    if (hayDatosDisponibles() <= 0) return 0;
+    size_t longitud = (size_t)_longitudPendiente;
+    size_t bytesLeidos = (longitud < maxLongitud) ? longitud : maxLongitud;
+    for (size_t i = 0; i < bytesLeidos; i++) {
+      buffer[i] = (uint8_t)LoRa.read();
     }
+    _longitudPendiente = 0;
+    _rssiUltimo = LoRa.packetRssi();
+    _estadisticas.registrarRecepcion(bytesLeidos);
+    _estadisticas.registrarRSSI(_rssiUltimo);
+    if (bytesLeidos < longitud) _estadisticas.lecturasTruncadas++; // El resto del paquete se pierde
     return bytesLeidos;
   }
 
+  /**
+   * @brief Obtiene una vista del siguiente paquete sin copias intermedias.
+   * @details En modo interrupción la vista apunta directamente a la ranura del anillo
+   * (sin ninguna copia adicional). En modo sondeo, el paquete se lee una sola vez de la
+   * FIFO del módulo al buffer interno de `LORA_RADIO_TAM_BUFFER_RX` bytes.
+   * @param vista Estructura que se rellena con los datos del paquete.
+   * @return true si había un paquete disponible.
+   */
+  bool tomarPaquete(VistaPaquete& vista) {
+    URWSN_TRAZAR(TRAZA_TOMAR_PAQUETE);
+    if (_anilloRx) {
+      if (_anilloRx->vacio()) return false;
+      vista.datos = _anilloRx->frente();
+      vista.longitud = _anilloRx->longitudFrente();
+      vista.rssi = _anilloRx->rssiFrente();
+      _rssiUltimo = vista.rssi;
+      return true;
+    }
+
+    if (_longitudVista == 0) {
+      if (hayDatosDisponibles() <= 0) return false;
+      _longitudVista = leer(_bufferRx, sizeof(_bufferRx));
+      if (_longitudVista == 0) return false;
+    }
+    vista.datos = _bufferRx;
+    vista.longitud = _longitudVista;
+    vista.rssi = _rssiUltimo; // Capturado por `leer()`, sin otro acceso SPI
+    return true;
+  }
+
+  /**
+   * @brief Libera el paquete obtenido con `tomarPaquete()`.
+   */
+  void liberarPaquete() {
+    if (_anilloRx) {
+      _anilloRx->liberarFrente();
+    }
+    _longitudVista = 0;
+  }
+
   /**
    * @brief Obtiene el RSSI (Indicador de Fuerza de Señal Recibida) del último paquete LoRa recibido.
+   * @details En modo interrupción devuelve el RSSI capturado junto al último paquete leído.
    * @return El valor del RSSI en dBm (normalmente un valor negativo).
    */
-  int obtenerRSSI() override {
+  int obtenerRSSI() {
+    if (_anilloRx) return _rssiUltimo;
     return LoRa.packetRssi();
   }
 
+  /**
+   * @brief Copia de los contadores de actividad.
+   * @details Se copian con las interrupciones desactivadas para obtener una instantánea coherente.
+   */
+  EstadisticasRadio obtenerEstadisticas() {
+    noInterrupts();
+    EstadisticasRadio copia = _estadisticas;
+    interrupts();
+    return copia;
+  }
+
+  /**
+   * @brief Pone a cero los contadores de actividad.
+   */
+  void reiniciarEstadisticas() {
+    noInterrupts();
+    memset(&_estadisticas, 0, sizeof(_estadisticas));
+    interrupts();
+  }
+
+  /**
+   * @brief Tamaño máximo de un paquete LoRa (FIFO del SX127x): 255 bytes.
+   */
+  size_t obtenerMTU() {
+    return 255;
+  }
+
   /**
    * @brief Pone el módulo LoRa en modo de bajo consumo (Sleep).
    * @details Esto apaga la radio para ahorrar energía. Se necesita `despertar()`
    * para volver a recibir o transmitir.
-   * @return true siempre (basado en la implementación actual de la librería LoRa).
+   * @return true si el módulo pasó a Sleep.
+   * @return false en modo asíncrono si aún hay tramas en la cola de transmisión
+   * (dormir abortaría la trama en el aire).
    */
-  bool dormir() override {
+  bool dormir() {
+    URWSN_TRAZAR(TRAZA_DORMIR);
+    if (_txEnCurso) return false;
     LoRa.sleep();
+    _longitudPendiente = 0; // En Sleep el módulo no conserva la FIFO
     return true;
   }
 
@@ -140,12 +588,30 @@ public:
    * @brief Pone el módulo LoRa en modo de espera (Standby/Idle).
    * @details Este es el modo por defecto para recibir (si se llama a `receive()`)
    * o estar listo para transmitir. Se usa para salir del modo `dormir()`.
+   * En modo interrupción vuelve directamente a recepción continua.
    * @return true siempre (basado en la implementación actual de la librería LoRa).
    */
-  bool despertar() override {
+  bool despertar() {
+    URWSN_TRAZAR(TRAZA_DESPERTAR);
     LoRa.idle(); // El modo Idle (Standby) es el estado "despierto" por defecto
+    if (_anilloRx) LoRa.receive();
     return true;
   }
 };
 
+/**
+ * @class LoraRadio
+ * @brief Implementación de la interfaz RadioInterface para módulos LoRa.
+ * @details Adaptador polimórfico sobre `LoraNucleo`. Para firmware con una sola radio,
+ * usar `LoraNucleo` directamente evita la vtable y el despacho indirecto.
+ */
+class LoraRadio : public RadioAdaptador<LoraNucleo> {
+public:
+  /**
+   * @brief Constructor de la clase LoraRadio.
+   * @param config Estructura `LoRaConfig` con todos los parámetros de inicialización necesarios.
+   */
+  LoraRadio(const LoRaConfig& config) : RadioAdaptador<LoraNucleo>(config) {}
+};
+
 #endif // LORA_RADIO_H
@@ -0,0 +1,28 @@
+/**
+ * @file NrfConfig.h
+ * @brief Configuración del driver NRF24L01 (`NrfRadio`).
+ * @details Está separada de `NrfRadio.h` para que el código que solo necesita los
+ * parámetros de la radio (ej. el simulador de red) no dependa de la librería `RF24`.
+ */
+
+#ifndef NRF_CONFIG_H
+#define NRF_CONFIG_H
+
+#include <Arduino.h>
+
+/**
+ * @struct NrfConfig
+ * @brief Almacena los parámetros de configuración para el módulo NRF24L01.
+ * @note Usa tipos genéricos para no exponer los enums de la librería RF24 al sketch principal.
+ */
+struct NrfConfig {
+  uint8_t cePin;            ///< Pin (GPIO) para Chip Enable (CE).
+  uint8_t csnPin;           ///< Pin (GPIO) para Chip Select Not (CSN).
+  const byte* writeAddress; ///< Dirección del "pipe" de escritura (generalmente 5 bytes).
+  const byte* readAddress;  ///< Dirección del "pipe" 1 de lectura (generalmente 5 bytes). Sin uso en modo concentrador.
+  uint8_t channel;          ///< Canal de RF (0-125). Debe coincidir entre tx y rx.
+  uint16_t dataRate;        ///< Tasa de datos genérica: 250 (250KBPS), 1 (1MBPS), 2 (2MBPS).
+  int8_t paLevel;           ///< Nivel de potencia genérico: 0 (MIN), 1 (LOW), 2 (HIGH), 3 (MAX).
+};
+
+#endif // NRF_CONFIG_H
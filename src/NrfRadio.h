@@ -1,57 +1,298 @@
 /**
  * @file NrfRadio.h
- * @brief Define la clase NrfRadio, una implementación de RadioInterface para módulos NRF24L01.
+ * @brief Define las clases NrfNucleo y NrfRadio para módulos NRF24L01.
  * @details Esta clase utiliza la librería RF24 (https://github.com/nRF24/RF24)
  * para abstraer la configuración, envío y recepción de un módulo NRF24L01+.
+ * `NrfNucleo` es la implementación con despacho estático (`RadioBase`) y
+ * `NrfRadio` la expone como `RadioInterface`.
  */
 
 #ifndef NRF_RADIO_H
 #define NRF_RADIO_H
 
 #include "RadioInterface.h"
+#include "NrfConfig.h"
 #include <SPI.h>
 #include <nRF24L01.h>
 #include <RF24.h>
 
-/**
- * @struct NrfConfig
- * @brief Almacena los parámetros de configuración para el módulo NRF24L01.
- * @note Usa tipos genéricos para no exponer los enums de la librería RF24 al sketch principal.
- */
-struct NrfConfig {
-  uint8_t cePin;            ///< Pin (GPIO) para Chip Enable (CE).
-  uint8_t csnPin;           ///< Pin (GPIO) para Chip Select Not (CSN).
-  const byte* writeAddress; ///< Dirección del "pipe" de escritura (generalmente 5 bytes).
-  const byte* readAddress;  ///< Dirección del "pipe" 1 de lectura (generalmente 5 bytes).
-  uint8_t channel;          ///< Canal de RF (0-125). Debe coincidir entre tx y rx.
-  uint16_t dataRate;        ///< Tasa de datos genérica: 250 (250KBPS), 1 (1MBPS), 2 (2MBPS).
-  int8_t paLevel;           ///< Nivel de potencia genérico: 0 (MIN), 1 (LOW), 2 (HIGH), 3 (MAX).
-};
+#ifndef NRF_RADIO_ARRANQUE_US
+/// Tiempo de estabilización del oscilador al salir de Power Down (Tpd2stby), en µs.
+#define NRF_RADIO_ARRANQUE_US 5000
+#endif
+
+// `despertar()` y `dormir()` acceden al registro CONFIG por el bus `SPI` por defecto, que es
+// el que usa RF24 salvo con su SPI por software o por UART.
+#if defined(SOFTSPI) || defined(SPI_UART)
+#error "NrfRadio requiere que RF24 use el bus SPI por defecto (sin SOFTSPI ni SPI_UART)"
+#endif
+
+#ifndef NRF_RADIO_FRECUENCIA_SPI
+/// Frecuencia del reloj SPI de los accesos directos al registro CONFIG (máximo 10 MHz).
+#define NRF_RADIO_FRECUENCIA_SPI 10000000
+#endif
 
 /**
- * @class NrfRadio
- * @brief Implementación de RadioInterface para módulos NRF24L01 usando la librería RF24.
+ * @class NrfNucleo
+ * @brief Implementación con despacho estático (`RadioBase`) para módulos NRF24L01 usando la librería RF24.
  * @details Esta clase envuelve la librería `RF24` para proveer una
- * interfaz coherente y estandarizada definida por `RadioInterface`.
+ * interfaz coherente y estandarizada definida por `RadioBase`/`RadioInterface`.
+ *
+ * Además de `enviar()`, ofrece un modo ráfaga (`iniciarRafaga()`, `agregarARafaga()`,
+ * `terminarRafaga()`) que mantiene la radio en TX y llena la FIFO de 3 niveles del
+ * módulo con `writeFast()`, sin cambiar de modo ni esperar el ACK de cada paquete.
+ *
+ * Con `habilitarConcentrador()` la radio escucha en los seis pipes del módulo a la vez
+ * (topología en estrella) y `ultimoTubo()` indica por cuál llegó cada paquete.
+ * Con `habilitarPayloadsEnAck()`, el concentrador precarga respuestas por pipe
+ * (`precargarRespuesta()`) que viajan dentro del ACK del siguiente envío del nodo.
  */
-class NrfRadio : public RadioInterface {
+class NrfNucleo : public RadioBase<NrfNucleo> {
+public:
+  static const uint8_t TAM_MAX_PAYLOAD = 32; ///< Tamaño máximo de un payload del NRF24L01.
+  static const uint8_t NIVELES_FIFO_TX = 3;  ///< Profundidad de la FIFO de transmisión del módulo.
+  static const uint8_t NUM_TUBOS = 6;        ///< Pipes de recepción del módulo.
+  static const uint8_t TAM_DIRECCION = 5;    ///< Bytes de una dirección (ancho por defecto de RF24).
+
+  // --- Registro CONFIG, escrito directamente por `dormir()` y `despertar()` ---
+  static const uint8_t REG_CONFIG = 0x00;
+  static const uint8_t CONFIG_PWR_UP = 0x02;
+  static const uint8_t CMD_R_REGISTER = 0x00;
+  static const uint8_t CMD_W_REGISTER = 0x20;
+
 private:
   RF24 _radio;      ///< Instancia del objeto RF24 de la librería.
   NrfConfig _config; ///< Almacena la configuración proporcionada en el constructor.
+  SPISettings _ajustesSpi; ///< Reloj, orden de bits y modo SPI del NRF24L01.
+
+  bool _enRafaga;            ///< true entre `iniciarRafaga()` y `terminarRafaga()`.
+  size_t _rafagaEscritos;    ///< Paquetes aceptados por la FIFO en la ráfaga actual.
+  size_t _rafagaPerdidos;    ///< Paquetes descartados por MAX_RT en la ráfaga actual.
+  uint8_t _rafagaEnFifo;     ///< Cota superior de paquetes aún en la FIFO sin confirmar.
+
+  uint8_t _bufferRx[TAM_MAX_PAYLOAD]; ///< Buffer de `tomarPaquete()`.
+  uint8_t _longitudVista;             ///< Longitud del paquete en `_bufferRx`. 0 si no hay vista tomada.
+
+  const byte* _direccionConcentrador; ///< Dirección base de los seis pipes. nullptr fuera del modo concentrador.
+  bool _iniciada;                     ///< true tras un `iniciar()` exitoso.
+  bool _payloadsEnAck;                ///< true si los ACK pueden llevar payload.
+  uint8_t _tuboPendiente;             ///< Pipe del paquete detectado por `hayDatosDisponibles()`.
+  uint8_t _ultimoTubo;                ///< Pipe del último paquete leído.
+
+  bool _arrancando;                   ///< true desde `despertar()` hasta que el oscilador está estable.
+  uint32_t _inicioArranqueUs;         ///< `micros()` al llamar a `despertar()`.
+
+  EstadisticasRadio _estadisticas;    ///< Contadores de actividad.
+
+  /**
+   * @brief Lee de la FIFO de recepción un payload de `payloadSize` bytes, guardando hasta `maxLongitud`.
+   * @details Si la FIFO estaba llena, los paquetes que llegaron mientras tanto pueden haberse
+   * perdido: se cuenta como desbordamiento.
+   * @return Bytes guardados en `buffer`.
+   */
+  size_t _leerPayload(uint8_t* buffer, size_t maxLongitud, size_t payloadSize) {
+    if (_radio.rxFifoFull()) _estadisticas.desbordamientosRx++;
+    size_t bytesALeer = (payloadSize < maxLongitud) ? payloadSize : maxLongitud;
+    if (bytesALeer < payloadSize) _estadisticas.lecturasTruncadas++;
+    _radio.read(buffer, bytesALeer);
+    _estadisticas.registrarRecepcion(bytesALeer);
+    return bytesALeer;
+  }
+
+  /**
+   * @brief Activa o desactiva PWR_UP en el registro CONFIG con acceso SPI directo.
+   * @details Lee y reescribe CONFIG sin pasar por RF24: su `powerUp()` espera al oscilador
+   * dentro de la llamada, y su `powerDown()` borraría PWR_UP de la copia de CONFIG que la
+   * librería reescribe en `startListening()`. Así esa copia conserva PWR_UP y las demás
+   * operaciones de RF24 no apagan el módulo.
+   * @warning Depende de dos detalles internos de RF24, comprobados con la serie 1.4.x
+   * (>= 1.4.0, < 1.5.0): la copia `config_reg` de CONFIG que reescriben `startListening()` y
+   * `stopListening()`, y que la librería use el bus `SPI` global (`iniciar()` llama a
+   * `begin()` sin bus y comprueba que el módulo responde en `SPI`). Con otra versión,
+   * revisar ambos antes de actualizar.
+   * @return true si PWR_UP ya estaba activo.
+   */
+  bool _fijarPwrUp(bool encendido) {
+    SPI.beginTransaction(_ajustesSpi);
+    digitalWrite(_config.csnPin, LOW);
+    SPI.transfer(CMD_R_REGISTER | REG_CONFIG);
+    uint8_t config = SPI.transfer(0xFF);
+    digitalWrite(_config.csnPin, HIGH);
+    bool anterior = (config & CONFIG_PWR_UP) != 0;
+    config = encendido ? (uint8_t)(config | CONFIG_PWR_UP) : (uint8_t)(config & ~CONFIG_PWR_UP);
+    digitalWrite(_config.csnPin, LOW);
+    SPI.transfer(CMD_W_REGISTER | REG_CONFIG);
+    SPI.transfer(config);
+    digitalWrite(_config.csnPin, HIGH);
+    SPI.endTransaction();
+    return anterior;
+  }
+
+  /**
+   * @brief Lee el registro CONFIG por el bus `SPI` por defecto.
+   */
+  uint8_t _leerConfig() {
+    SPI.beginTransaction(_ajustesSpi);
+    digitalWrite(_config.csnPin, LOW);
+    SPI.transfer(CMD_R_REGISTER | REG_CONFIG);
+    uint8_t config = SPI.transfer(0xFF);
+    digitalWrite(_config.csnPin, HIGH);
+    SPI.endTransaction();
+    return config;
+  }
+
+  /**
+   * @brief Espera lo que quede del arranque iniciado por `despertar()`.
+   */
+  void _esperarArranque() {
+    while (!listo()) {
+      yield();
+    }
+  }
+
+  /**
+   * @brief Abre los seis pipes de lectura con las direcciones derivadas de `_direccionConcentrador`.
+   */
+  void _abrirTubosConcentrador() {
+    byte direccion[TAM_DIRECCION];
+    for (uint8_t tubo = 0; tubo < NUM_TUBOS; tubo++) {
+      direccionTubo(_direccionConcentrador, tubo, direccion);
+      _radio.openReadingPipe(tubo, direccion); // En los pipes 2-5, RF24 solo escribe el primer byte
+    }
+  }
 
 public:
   /**
    * @brief Constructor que configura el objeto RF24 con sus pines CE y CSN.
    * @param config Estructura `NrfConfig` con todos los parámetros de inicialización.
    */
-  NrfRadio(const NrfConfig& config)
+  NrfNucleo(const NrfConfig& config)
     : _radio(config.cePin, config.csnPin),
-      _config(config) {}
+      _config(config),
+      _ajustesSpi(NRF_RADIO_FRECUENCIA_SPI, MSBFIRST, SPI_MODE0),
+      _enRafaga(false),
+      _rafagaEscritos(0),
+      _rafagaPerdidos(0),
+      _rafagaEnFifo(0),
+      _longitudVista(0),
+      _direccionConcentrador(nullptr),
+      _iniciada(false),
+      _payloadsEnAck(false),
+      _tuboPendiente(0),
+      _ultimoTubo(0),
+      _arrancando(false),
+      _inicioArranqueUs(0) {
+    memset(&_estadisticas, 0, sizeof(_estadisticas));
+  }
+
+  /**
+   * @brief Dirección del pipe `tubo` de un concentrador con dirección base `base`.
+   * @details Es `base` con el primer byte (el menos significativo en RF24) incrementado en
+   * `tubo`. Los nodos sensores la usan como `writeAddress` para hablar con su pipe.
+   * @note El incremento es módulo 256: con `base[0]` mayor que `0xFF - 5` los pipes altos
+   * dan la vuelta a 0x00. `habilitarConcentrador()` rechaza esas bases (ver
+   * `direccionBaseValida()`).
+   * @param base Dirección base de `TAM_DIRECCION` bytes.
+   * @param tubo Pipe (0-5).
+   * @param destino Buffer de `TAM_DIRECCION` bytes donde se escribe la dirección.
+   */
+  static void direccionTubo(const byte* base, uint8_t tubo, byte* destino) {
+    memcpy(destino, base, TAM_DIRECCION);
+    destino[0] = (byte)(base[0] + tubo);
+  }
+
+  /**
+   * @brief Indica si `base` sirve como dirección de un concentrador.
+   * @details El primer byte del pipe 0 (`base[0]`) no puede ser 0x00: las versiones de RF24
+   * que deciden si restaurar la dirección de lectura del pipe 0 en `startListening()` con
+   * `pipe0_reading_address[0] > 0` lo darían por cerrado, así que tras el primer `enviar()`
+   * el pipe 0 quedaría con la dirección de escritura. Tampoco puede pasar de `0xFF - (NUM_TUBOS - 1)`, o `direccionTubo()` daría
+   * la vuelta en los pipes altos.
+   * @param base Dirección base de `TAM_DIRECCION` bytes.
+   * @return true si `base[0]` está entre 0x01 y 0xFA.
+   */
+  static bool direccionBaseValida(const byte* base) {
+    return base[0] != 0 && base[0] <= 0xFF - (NUM_TUBOS - 1);
+  }
+
+  /**
+   * @brief Activa el modo concentrador: recepción en los seis pipes (opcional).
+   * @details En lugar de `NrfConfig::readAddress` en el pipe 1, abre los pipes 0-5 con las
+   * direcciones `direccionTubo(direccionBase, 0..5)`, que comparten los 4 bytes altos
+   * como exige el módulo. El filtrado por dirección (y el ACK automático) lo hace el
+   * hardware, y `ultimoTubo()` identifica al emisor de cada paquete.
+   * Puede llamarse antes o después de `iniciar()`.
+   * @param direccionBase Dirección de `TAM_DIRECCION` bytes. Debe existir mientras la
+   * radio esté en uso, igual que las direcciones de `NrfConfig`.
+   * @note `enviar()` usa el pipe 0 para recibir el ACK; RF24 restaura su dirección de
+   * lectura al volver a escuchar.
+   * @return false (sin cambiar de modo) si `direccionBaseValida(direccionBase)` es false.
+   */
+  bool habilitarConcentrador(const byte* direccionBase) {
+    if (!direccionBaseValida(direccionBase)) return false;
+    _direccionConcentrador = direccionBase;
+    if (_iniciada) {
+      _radio.stopListening();
+      _abrirTubosConcentrador();
+      _radio.startListening();
+    }
+    return true;
+  }
 
   /**
-   * @brief Destructor virtual.
+   * @brief Pipe (0-5) por el que llegó el último paquete leído con `leer()` o `tomarPaquete()`.
+   * @details En el modo concentrador identifica al nodo emisor. Con `leer()`, es válido
+   * cuando se llama después de `hayDatosDisponibles()`, como indica su documentación.
    */
-  virtual ~NrfRadio() {}
+  uint8_t ultimoTubo() const { return _ultimoTubo; }
+
+  /**
+   * @brief Indica si el módulo ya puede transmitir o recibir tras `despertar()`.
+   * @details Permite aprovechar el arranque del oscilador (ej. para leer sensores) en lugar
+   * de esperar. Si no, `enviar()`, `hayDatosDisponibles()`, `leer()`, `tomarPaquete()` e
+   * `iniciarRafaga()` esperan solo el tiempo que falte. Al terminar el arranque, la radio
+   * vuelve al modo de escucha.
+   * @return true si no hay un arranque en curso o si ya pasaron `NRF_RADIO_ARRANQUE_US`.
+   */
+  bool listo() {
+    if (_arrancando && (uint32_t)(micros() - _inicioArranqueUs) >= NRF_RADIO_ARRANQUE_US) {
+      _arrancando = false;
+      _radio.startListening(); // Sube CE, que `dormir()` bajó
+    }
+    return !_arrancando;
+  }
+
+  /**
+   * @brief Permite que los ACK lleven payload (opcional; ambos extremos deben activarlo).
+   * @details Abre un canal de bajada sin tiempo en el aire adicional ni ventana de escucha:
+   * - En el concentrador, `precargarRespuesta()` deja un payload para un pipe y el módulo
+   *   lo envía dentro del ACK del siguiente paquete que llegue por ese pipe.
+   * - En el nodo, la respuesta llega dentro del ACK de su propio `enviar()` y queda en la
+   *   FIFO de recepción: `hayDatosDisponibles()`/`leer()` la entregan como un paquete
+   *   recibido normal, con `ultimoTubo()` igual a 0.
+   * Puede llamarse antes o después de `iniciar()`.
+   */
+  void habilitarPayloadsEnAck() {
+    _payloadsEnAck = true;
+    if (_iniciada) _radio.enableAckPayload();
+  }
+
+  /**
+   * @brief Precarga la respuesta que se enviará en el ACK del próximo paquete recibido por `tubo`.
+   * @details La FIFO de transmisión del módulo admite `NIVELES_FIFO_TX` respuestas en total,
+   * compartidas entre todos los pipes; cada una se consume con el siguiente paquete de su pipe.
+   * @note `enviar()` y las ráfagas vacían la FIFO de transmisión (RF24 lo hace al dejar de
+   * escuchar con los payloads en ACK activos), así que las respuestas precargadas se pierden.
+   * @param tubo Pipe del nodo destinatario (0-5; ver `habilitarConcentrador()`).
+   * @param datos Payload de la respuesta.
+   * @param longitud Bytes de la respuesta (máximo `TAM_MAX_PAYLOAD`).
+   * @return false si no se llamó a `habilitarPayloadsEnAck()`, si la respuesta es demasiado
+   * grande o si la FIFO de transmisión está llena.
+   */
+  bool precargarRespuesta(uint8_t tubo, const uint8_t* datos, size_t longitud) {
+    if (!_payloadsEnAck || !_iniciada || tubo >= NUM_TUBOS || longitud > TAM_MAX_PAYLOAD) return false;
+    return _radio.writeAckPayload(tubo, datos, (uint8_t)longitud);
+  }
 
   /**
    * @brief Inicializa el hardware NRF24L01 con la configuración proporcionada.
@@ -62,12 +303,20 @@ public:
    * 4. Configura los pipes de escritura y lectura.
    * 5. Pone la radio en modo de escucha (`startListening`).
    * @note Traduce los valores genéricos de NrfConfig a los enums de la librería RF24.
-   * @return true si `_radio.begin()` fue exitoso, false en caso contrario.
+   * @return true si `_radio.begin()` fue exitoso y el módulo responde en el bus `SPI` por
+   * defecto (ver `_fijarPwrUp()`), false en caso contrario.
    */
-  bool iniciar() override {
+  bool iniciar() {
+    URWSN_TRAZAR(TRAZA_INICIAR);
     if (!_radio.begin()) {
       return false; // Fallo al inicializar
     }
+    // `begin()` deja PWR_UP activo: si no se lee así por `SPI`, el módulo está en otro bus
+    // y `despertar()`/`dormir()` no lo alcanzarían
+    uint8_t config = _leerConfig();
+    if (config == 0xFF || (config & CONFIG_PWR_UP) == 0) {
+      return false;
+    }
 
     _radio.setChannel(_config.channel);
 
@@ -86,41 +335,168 @@ public:
     
     // Habilitar payloads dinámicos para poder saber el tamaño del paquete recibido
     _radio.enableDynamicPayloads();
+    if (_payloadsEnAck) _radio.enableAckPayload();
 
     // Configurar pipes para comunicación
     _radio.openWritingPipe(_config.writeAddress);
-    _radio.openReadingPipe(1, _config.readAddress); // Usamos el pipe 1 para lectura
+    if (_direccionConcentrador) {
+      _abrirTubosConcentrador();
+    } else {
+      _radio.openReadingPipe(1, _config.readAddress); // Usamos el pipe 1 para lectura
+    }
 
     // Por defecto, nos ponemos en modo escucha
     _radio.startListening();
+    _iniciada = true;
     return true;
   }
 
+  // Hace visibles las sobrecargas de RadioBase (ej. enviar(const String&)).
+  using RadioBase<NrfNucleo>::enviar;
+
   /**
    * @brief Envía un bloque de datos.
    * @details Para enviar, la radio debe dejar de escuchar (`stopListening`),
    * transmitir el paquete (`write`), y luego volver a escuchar (`startListening`).
+   * Con `habilitarPayloadsEnAck()`, la respuesta que traiga el ACK queda lista para
+   * `hayDatosDisponibles()`/`leer()` (conviene leerla antes de `dormir()`).
    * @param buffer Puntero al buffer de datos que se van a enviar.
    * @param longitud Número de bytes a enviar desde el buffer.
    * @return true si el envío fue exitoso (ACK recibido), false en caso contrario (timeout).
    */
-  bool enviar(const uint8_t* buffer, size_t longitud) override {
+  bool enviar(const uint8_t* buffer, size_t longitud) {
+    URWSN_TRAZAR(TRAZA_ENVIAR);
+    _esperarArranque();
     _radio.stopListening(); // Salir del modo receptor
     
     bool ok = _radio.write(buffer, longitud);
     
     _radio.startListening(); // Volver al modo receptor
+    _estadisticas.registrarEnvio(ok, longitud);
     return ok;
   }
 
+  /**
+   * @brief Envía la concatenación de varios segmentos como un único payload.
+   * @details `RF24::write()` necesita el payload contiguo, así que los segmentos se
+   * reúnen en un buffer de `TAM_MAX_PAYLOAD` bytes en el stack (nunca en el heap).
+   * @param segmentos Array de segmentos, en orden de transmisión.
+   * @param numSegmentos Número de elementos de `segmentos`.
+   * @return true si el envío fue exitoso (ACK recibido), false si falló o si el total
+   * excede `TAM_MAX_PAYLOAD`.
+   */
+  bool enviar(const Segmento* segmentos, size_t numSegmentos) {
+    uint8_t payload[TAM_MAX_PAYLOAD];
+    size_t longitud = 0;
+    for (size_t i = 0; i < numSegmentos; i++) {
+      if (longitud + segmentos[i].longitud > TAM_MAX_PAYLOAD) {
+        _estadisticas.enviosFallidos++;
+        return false;
+      }
+      memcpy(payload + longitud, segmentos[i].datos, segmentos[i].longitud);
+      longitud += segmentos[i].longitud;
+    }
+    return enviar(payload, longitud);
+  }
+
+  /**
+   * @brief Comienza una ráfaga de transmisión.
+   * @details Sale del modo receptor una sola vez para toda la ráfaga. Los paquetes se
+   * agregan con `agregarARafaga()` y la ráfaga se cierra con `terminarRafaga()`.
+   */
+  void iniciarRafaga() {
+    _esperarArranque();
+    _radio.stopListening();
+    _enRafaga = true;
+    _rafagaEscritos = 0;
+    _rafagaPerdidos = 0;
+    _rafagaEnFifo = 0;
+  }
+
+  /**
+   * @brief Agrega un paquete a la ráfaga en curso.
+   * @details Usa `writeFast()`, que solo espera si la FIFO de 3 niveles está llena.
+   * Si el módulo agota los reintentos (MAX_RT) de un paquete anterior, la FIFO se
+   * vacía con `txStandBy()` y los paquetes que contenía se cuentan como perdidos.
+   * @param buffer Puntero a los datos del paquete.
+   * @param longitud Número de bytes (máximo `TAM_MAX_PAYLOAD`).
+   * @return true si el paquete quedó en la FIFO, false si no se pudo encolar
+   * (sin ráfaga iniciada, paquete demasiado grande o fallo MAX_RT).
+   */
+  bool agregarARafaga(const uint8_t* buffer, size_t longitud) {
+    if (!_enRafaga || longitud > TAM_MAX_PAYLOAD) {
+      _estadisticas.enviosFallidos++;
+      return false;
+    }
+
+    if (_radio.writeFast(buffer, (uint8_t)longitud)) {
+      _rafagaEscritos++;
+      if (_rafagaEnFifo < NIVELES_FIFO_TX) _rafagaEnFifo++;
+      _estadisticas.registrarEnvio(true, longitud);
+      return true;
+    }
+
+    // MAX_RT: txStandBy() limpia el flag y vacía la FIFO
+    _radio.txStandBy();
+    _rafagaPerdidos += _rafagaEnFifo;
+    _estadisticas.tramasNoEntregadas += _rafagaEnFifo;
+    _estadisticas.enviosFallidos++;
+    _rafagaEnFifo = 0;
+    return false;
+  }
+
+  /**
+   * @brief Envía un bloque de datos como ráfaga de paquetes de `TAM_MAX_PAYLOAD` bytes.
+   * @details Atajo para `iniciarRafaga()` + `agregarARafaga()` por trozo + `terminarRafaga()`.
+   * Los trozos rechazados no se reintentan.
+   * @param datos Puntero al bloque de datos.
+   * @param longitud Número total de bytes.
+   * @return Número de paquetes entregados (ver `terminarRafaga()`).
+   */
+  size_t enviarRafaga(const uint8_t* datos, size_t longitud) {
+    iniciarRafaga();
+    while (longitud > 0) {
+      size_t trozo = (longitud < TAM_MAX_PAYLOAD) ? longitud : TAM_MAX_PAYLOAD;
+      agregarARafaga(datos, trozo);
+      datos += trozo;
+      longitud -= trozo;
+    }
+    return terminarRafaga();
+  }
+
+  /**
+   * @brief Cierra la ráfaga: espera a que la FIFO se vacíe y vuelve al modo receptor.
+   * @details Llama a `txStandBy()` una única vez. Si el último tramo falla por MAX_RT,
+   * los paquetes que quedaban en la FIFO se cuentan como perdidos.
+   * @note El resultado es una cota inferior: ante un fallo se asume que la FIFO
+   * estaba llena, ya que el módulo no informa de cuántos paquetes contenía.
+   * @return Número de paquetes de la ráfaga entregados con ACK.
+   */
+  size_t terminarRafaga() {
+    if (!_enRafaga) return 0;
+
+    if (!_radio.txStandBy()) {
+      _rafagaPerdidos += _rafagaEnFifo;
+      _estadisticas.tramasNoEntregadas += _rafagaEnFifo;
+    }
+    _rafagaEnFifo = 0;
+    _enRafaga = false;
+    _radio.startListening();
+
+    return (_rafagaPerdidos < _rafagaEscritos) ? (_rafagaEscritos - _rafagaPerdidos) : 0;
+  }
+
   /**
    * @brief Comprueba si hay un paquete disponible y devuelve su tamaño.
-   * @details Llama a `_radio.available()` y, si es verdadero, obtiene el tamaño
-   * del payload dinámico que acaba de llegar usando `_radio.getDynamicPayloadSize()`.
+   * @details Llama a `_radio.available()` (que también informa del pipe, ver `ultimoTubo()`)
+   * y, si es verdadero, obtiene el tamaño del payload dinámico que acaba de llegar usando
+   * `_radio.getDynamicPayloadSize()`.
    * @return El tamaño del payload dinámico recibido en bytes, o 0 si no hay nada.
    */
-  int hayDatosDisponibles() override {
-    if (_radio.available()) {
+  int hayDatosDisponibles() {
+    URWSN_TRAZAR(TRAZA_HAY_DATOS);
+    _esperarArranque();
+    if (_radio.available(&_tuboPendiente)) {
       return _radio.getDynamicPayloadSize();
     }
     return 0;
@@ -134,46 +510,113 @@ public:
    * @param maxLongitud El tamaño máximo del `buffer` de destino.
    * @return El número de bytes realmente leídos (limitado por `maxLongitud`).
    */
-  size_t leer(uint8_t* buffer, size_t maxLongitud) override {
+  size_t leer(uint8_t* buffer, size_t maxLongitud) {
+    URWSN_TRAZAR(TRAZA_LEER);
+    _esperarArranque();
     // Obtenemos el tamaño del payload. Es importante en caso de que
     // hayDatosDisponibles() no se haya llamado, aunque sea redundante si sí se llamó.
     size_t payloadSize = _radio.getDynamicPayloadSize();
     if (payloadSize == 0) return 0;
 
-    // Leemos solo la cantidad de bytes que caben en el buffer
-    size_t bytesALeer = min(payloadSize, maxLongitud);
-    _radio.read(buffer, bytesALeer);
-    
+    // Leemos solo la cantidad de bytes que caben en el buffer.
     // Si payloadSize > maxLongitud, los bytes restantes se descartan.
-    
-    return bytesALeer;
+    _ultimoTubo = _tuboPendiente;
+    return _leerPayload(buffer, maxLongitud, payloadSize);
+  }
+
+  /**
+   * @brief Obtiene una vista del siguiente paquete.
+   * @details El payload se lee una sola vez de la FIFO del módulo al buffer interno
+   * de `TAM_MAX_PAYLOAD` bytes.
+   * @param vista Estructura que se rellena con los datos del paquete (RSSI siempre 0).
+   * @return true si había un paquete disponible.
+   */
+  bool tomarPaquete(VistaPaquete& vista) {
+    URWSN_TRAZAR(TRAZA_TOMAR_PAQUETE);
+    _esperarArranque();
+    if (_longitudVista == 0) {
+      if (!_radio.available(&_tuboPendiente)) return false;
+      uint8_t payloadSize = _radio.getDynamicPayloadSize();
+      if (payloadSize == 0) return false;
+      _ultimoTubo = _tuboPendiente;
+      _longitudVista = (uint8_t)_leerPayload(_bufferRx, TAM_MAX_PAYLOAD, payloadSize);
+    }
+    vista.datos = _bufferRx;
+    vista.longitud = _longitudVista;
+    vista.rssi = 0;
+    return true;
+  }
+
+  /**
+   * @brief Libera el paquete obtenido con `tomarPaquete()`.
+   */
+  void liberarPaquete() {
+    _longitudVista = 0;
+  }
+
+  /**
+   * @brief Copia de los contadores de actividad (el NRF24L01 no mide RSSI: histograma a 0).
+   */
+  EstadisticasRadio obtenerEstadisticas() { return _estadisticas; }
+
+  /**
+   * @brief Pone a cero los contadores de actividad.
+   */
+  void reiniciarEstadisticas() { memset(&_estadisticas, 0, sizeof(_estadisticas)); }
+
+  /**
+   * @brief Tamaño máximo de un payload del NRF24L01: `TAM_MAX_PAYLOAD` (32 bytes).
+   */
+  size_t obtenerMTU() {
+    return TAM_MAX_PAYLOAD;
   }
 
   /**
    * @brief Pone el módulo NRF24L01 en modo de bajo consumo (Power Down).
-   * @details Llama a `_radio.powerDown()`.
+   * @details Baja CE y borra PWR_UP escribiendo CONFIG directamente (ver `despertar()`).
    * @return true siempre.
    */
-  bool dormir() override {
-    _radio.powerDown();
+  bool dormir() {
+    URWSN_TRAZAR(TRAZA_DORMIR);
+    _arrancando = false;
+    if (!_iniciada) return true;
+    digitalWrite(_config.cePin, LOW);
+    _fijarPwrUp(false);
     return true;
   }
 
   /**
-   * @brief Saca al módulo NRF24L01 del modo de bajo consumo.
-   * @details Llama a `_radio.powerUp()`.
-   * @note Incluye un pequeño `delay(5)` para permitir que el oscilador
-   * de la radio se estabilice antes de continuar.
+   * @brief Saca al módulo NRF24L01 del modo de bajo consumo sin esperar al oscilador.
+   * @details Activa PWR_UP escribiendo CONFIG directamente por SPI, sin `_radio.powerUp()`,
+   * que en RF24 1.4.x bloquea `RF24_POWERUP_DELAY` (5 ms) dentro de la llamada. Anota el
+   * instante: el módulo estará listo `NRF_RADIO_ARRANQUE_US` después (ver `listo()`), y las
+   * operaciones de radio esperan solo lo que falte. Si el módulo no estaba dormido, no
+   * hay arranque que esperar.
    * @return true siempre.
    */
-  bool despertar() override {
-    _radio.powerUp();
-    
-    // El datasheet recomienda esperar un corto tiempo para que el
-    // oscilador se estabilice al salir de powerDown.
-    delay(5); 
+  bool despertar() {
+    URWSN_TRAZAR(TRAZA_DESPERTAR);
+    if (!_iniciada) return true;
+    if (_fijarPwrUp(true)) return true;
+    _inicioArranqueUs = micros();
+    _arrancando = true;
     return true;
   }
 };
 
+/**
+ * @class NrfRadio
+ * @brief Implementación de RadioInterface para módulos NRF24L01 usando la librería RF24.
+ * @details Adaptador polimórfico sobre `NrfNucleo`. Para firmware con una sola radio,
+ * usar `NrfNucleo` directamente evita la vtable y el despacho indirecto.
+ */
+class NrfRadio : public RadioAdaptador<NrfNucleo> {
+public:
+  /**
+   * @brief Constructor que configura el objeto RF24 con sus pines CE y CSN.
+   * @param config Estructura `NrfConfig` con todos los parámetros de inicialización.
+   */
+  NrfRadio(const NrfConfig& config) : RadioAdaptador<NrfNucleo>(config) {}
+};
+
 #endif // NRF_RADIO_H
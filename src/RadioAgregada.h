@@ -0,0 +1,303 @@
+/**
+ * @file RadioAgregada.h
+ * @brief Agregación de mensajes pequeños en tramas de hasta el MTU de cualquier `RadioInterface`.
+ * @details `RadioAgregada` acumula los mensajes que se le entregan y los transmite juntos en
+ * una sola trama, de modo que el preámbulo y la cabecera de LoRa, o el ACK de NRF24L01, se
+ * pagan una vez por trama en lugar de una vez por mensaje. En recepción separa cada trama
+ * en los mensajes originales.
+ */
+
+#ifndef RADIO_AGREGADA_H
+#define RADIO_AGREGADA_H
+
+#include "RadioInterface.h"
+
+// Tamaño de los buffers de trama (uno de envío y otro de recepción). Se puede redefinir antes de incluir la librería.
+#ifndef RADIO_AGREGADA_TAM_BUFFER
+#define RADIO_AGREGADA_TAM_BUFFER 255
+#endif
+
+/**
+ * @struct EstadisticasAgregacion
+ * @brief Contadores de `RadioAgregada`.
+ * @details `mensajesEnviados / tramasEnviadas` es el número medio de mensajes por trama, que
+ * es aproximadamente el factor en que se reduce la sobrecarga por paquete de la radio.
+ */
+struct EstadisticasAgregacion {
+  uint32_t mensajesEnviados;   ///< Mensajes transmitidos dentro de una trama.
+  uint32_t tramasEnviadas;     ///< Tramas entregadas a la radio.
+  uint32_t bytesMensajes;      ///< Bytes de los mensajes enviados.
+  uint32_t bytesTramas;        ///< Bytes de las tramas enviadas (mensajes + prefijos de longitud).
+  uint32_t vaciadosPorLlenado; ///< Tramas enviadas porque el siguiente mensaje no cabía.
+  uint32_t vaciadosPorPlazo;   ///< Tramas enviadas al vencer el plazo.
+  uint32_t mensajesRecibidos;  ///< Mensajes extraídos de las tramas recibidas.
+  uint32_t tramasRecibidas;    ///< Tramas leídas de la radio.
+  uint32_t tramasInvalidas;    ///< Tramas recibidas con un prefijo de longitud incoherente.
+};
+
+/**
+ * @class RadioAgregada
+ * @brief Decorador de `RadioInterface` que agrupa varios mensajes en cada trama.
+ * @details Cada mensaje va precedido de un byte con su longitud (1-254). `enviar()` solo
+ * encola el mensaje en la trama en curso; la trama se transmite cuando el siguiente mensaje
+ * ya no cabe en el MTU de la radio, cuando vence el plazo contado desde el primer mensaje
+ * encolado (`fijarPlazo()`, 100 ms por defecto) o al llamar a `vaciar()`.
+ *
+ * El plazo se comprueba en `procesar()`, `enviar()` y `hayDatosDisponibles()`, así que hay
+ * que llamar a `procesar()` en cada iteración de `loop()`. En recepción, los mensajes se
+ * entregan de uno en uno desde un buffer propio, sin copias adicionales con `tomarPaquete()`.
+ * @note Un mensaje que necesite confirmación inmediata debe ir seguido de `vaciar()`.
+ * Ambos extremos deben usar `RadioAgregada`.
+ */
+class RadioAgregada : public RadioInterface {
+public:
+  static const uint8_t TAM_PREFIJO = 1; ///< Bytes de longitud antes de cada mensaje.
+
+  // Hace visibles las sobrecargas de RadioInterface (ej. enviar(const String&)).
+  using RadioInterface::enviar;
+
+  /**
+   * @brief Constructor.
+   * @param radio Radio sobre la que se envían las tramas. Debe existir mientras se use este objeto.
+   */
+  explicit RadioAgregada(RadioInterface& radio)
+    : _radio(radio),
+      _plazoMs(100),
+      _ocupadosTx(0),
+      _mensajesTx(0),
+      _inicioTramaMs(0),
+      _longitudRx(0),
+      _posicionRx(0),
+      _vistaTomada(false),
+      _rssi(0) {
+    memset(&_estadisticas, 0, sizeof(_estadisticas));
+  }
+
+  /**
+   * @brief Tiempo máximo que un mensaje espera en la trama en curso (100 ms por defecto).
+   * @details 0 envía cada trama en la siguiente llamada a `procesar()`.
+   */
+  void fijarPlazo(uint32_t milisegundos) { _plazoMs = milisegundos; }
+
+  /**
+   * @brief Transmite la trama en curso, si tiene algún mensaje.
+   * @return true si no había nada que enviar o la radio aceptó la trama. Si la rechaza, la
+   * trama se conserva y se reintenta en el siguiente vaciado.
+   */
+  bool vaciar() {
+    if (_mensajesTx == 0) return true;
+    if (!_radio.enviar(_tramaTx, _ocupadosTx)) return false;
+    _estadisticas.mensajesEnviados += _mensajesTx;
+    _estadisticas.tramasEnviadas++;
+    _estadisticas.bytesMensajes += _ocupadosTx - (size_t)_mensajesTx * TAM_PREFIJO;
+    _estadisticas.bytesTramas += _ocupadosTx;
+    _ocupadosTx = 0;
+    _mensajesTx = 0;
+    return true;
+  }
+
+  /**
+   * @brief Envía la trama en curso si ha vencido su plazo. Llamar en cada iteración de `loop()`.
+   */
+  void procesar() {
+    if (_mensajesTx > 0 && millis() - _inicioTramaMs >= _plazoMs && vaciar()) {
+      _estadisticas.vaciadosPorPlazo++;
+    }
+  }
+
+  /**
+   * @brief Mensajes encolados en la trama en curso.
+   */
+  uint8_t mensajesPendientes() const { return _mensajesTx; }
+
+  /**
+   * @brief Contadores de mensajes y tramas enviados y recibidos.
+   */
+  const EstadisticasAgregacion& estadisticas() const { return _estadisticas; }
+
+  /**
+   * @brief Mensajes por trama enviada, multiplicado por 100 (ej. 420 = 4.2 mensajes por trama).
+   */
+  uint16_t mensajesPorTramaX100() const {
+    if (_estadisticas.tramasEnviadas == 0) return 0;
+    return (uint16_t)(_estadisticas.mensajesEnviados * 100UL / _estadisticas.tramasEnviadas);
+  }
+
+  /**
+   * @brief Fracción de los bytes de trama que son datos de mensaje, en tanto por mil.
+   * @details El resto son los prefijos de longitud, la sobrecarga propia de la agregación.
+   */
+  uint16_t eficienciaPorMil() const {
+    if (_estadisticas.bytesTramas == 0) return 0;
+    return (uint16_t)((uint64_t)_estadisticas.bytesMensajes * 1000 / _estadisticas.bytesTramas);
+  }
+
+  // --- RadioInterface ---
+
+  bool iniciar() override { return _radio.iniciar(); }
+
+  bool enviar(const uint8_t* buffer, size_t longitud) override {
+    Segmento segmento = {buffer, longitud};
+    return enviar(&segmento, 1);
+  }
+
+  /**
+   * @brief Encola la concatenación de los segmentos como un mensaje de la trama en curso.
+   * @details Si el mensaje no cabe en la trama, antes se transmite la trama en curso.
+   * @return false si el mensaje está vacío, excede `obtenerMTU()`, o no cabe y la radio
+   * rechazó la trama en curso.
+   */
+  bool enviar(const Segmento* segmentos, size_t numSegmentos) override {
+    procesar();
+    size_t total = 0;
+    for (size_t i = 0; i < numSegmentos; i++) total += segmentos[i].longitud;
+    if (total == 0 || total > obtenerMTU()) return false;
+
+    if (_ocupadosTx + TAM_PREFIJO + total > _capacidadTrama()) {
+      if (!vaciar()) return false;
+      _estadisticas.vaciadosPorLlenado++;
+    }
+    if (_mensajesTx == 0) _inicioTramaMs = millis();
+    _tramaTx[_ocupadosTx++] = (uint8_t)total;
+    for (size_t i = 0; i < numSegmentos; i++) {
+      memcpy(_tramaTx + _ocupadosTx, segmentos[i].datos, segmentos[i].longitud);
+      _ocupadosTx += segmentos[i].longitud;
+    }
+    _mensajesTx++;
+    return true;
+  }
+
+  /**
+   * @brief Longitud del siguiente mensaje recibido, o 0 si no hay ninguno.
+   */
+  int hayDatosDisponibles() override {
+    procesar();
+    _atenderRecepcion();
+    return (_posicionRx < _longitudRx) ? _tramaRx[_posicionRx] : 0;
+  }
+
+  /**
+   * @brief Copia el siguiente mensaje recibido. Lo que no quepa en `buffer` se descarta.
+   */
+  size_t leer(uint8_t* buffer, size_t maxLongitud) override {
+    _atenderRecepcion();
+    if (_posicionRx >= _longitudRx || maxLongitud == 0) return 0;
+    size_t longitud = _tramaRx[_posicionRx];
+    if (longitud > maxLongitud) longitud = maxLongitud;
+    memcpy(buffer, _tramaRx + _posicionRx + TAM_PREFIJO, longitud);
+    _avanzarRx();
+    return longitud;
+  }
+
+  /**
+   * @brief Vista del siguiente mensaje recibido, dentro de la trama que lo contiene.
+   */
+  bool tomarPaquete(VistaPaquete& vista) override {
+    if (!_vistaTomada) {
+      _atenderRecepcion();
+      if (_posicionRx >= _longitudRx) return false;
+      _vistaTomada = true;
+    }
+    vista.datos = _tramaRx + _posicionRx + TAM_PREFIJO;
+    vista.longitud = _tramaRx[_posicionRx];
+    vista.rssi = _rssi;
+    return true;
+  }
+
+  void liberarPaquete() override {
+    if (!_vistaTomada) return;
+    _vistaTomada = false;
+    _avanzarRx();
+  }
+
+  int obtenerRSSI() override { return _rssi; }
+
+  /**
+   * @brief Envía la trama en curso antes de dormir la radio.
+   */
+  bool dormir() override {
+    vaciar();
+    return _radio.dormir();
+  }
+
+  bool despertar() override { return _radio.despertar(); }
+  EstadisticasRadio obtenerEstadisticas() override { return _radio.obtenerEstadisticas(); }
+  void reiniciarEstadisticas() override { _radio.reiniciarEstadisticas(); }
+
+  /**
+   * @brief Tamaño máximo de un mensaje: una trama con un solo mensaje.
+   */
+  size_t obtenerMTU() override {
+    size_t capacidad = _capacidadTrama();
+    return (capacidad > TAM_PREFIJO) ? capacidad - TAM_PREFIJO : 0;
+  }
+
+private:
+  RadioInterface& _radio;
+  uint32_t _plazoMs;
+  uint8_t _tramaTx[RADIO_AGREGADA_TAM_BUFFER]; ///< Trama en curso.
+  size_t _ocupadosTx;                          ///< Bytes ocupados de `_tramaTx`.
+  uint8_t _mensajesTx;                         ///< Mensajes en `_tramaTx`.
+  uint32_t _inicioTramaMs;                     ///< `millis()` al encolar el primer mensaje de la trama.
+  uint8_t _tramaRx[RADIO_AGREGADA_TAM_BUFFER]; ///< Última trama recibida.
+  size_t _longitudRx;                          ///< Bytes válidos de `_tramaRx`.
+  size_t _posicionRx;                          ///< Prefijo del siguiente mensaje por entregar.
+  bool _vistaTomada;
+  int _rssi;                                   ///< RSSI de la trama recibida.
+  EstadisticasAgregacion _estadisticas;
+
+  size_t _capacidadTrama() {
+    size_t mtu = _radio.obtenerMTU();
+    return (mtu < sizeof(_tramaTx)) ? mtu : sizeof(_tramaTx);
+  }
+
+  void _avanzarRx() {
+    _posicionRx += TAM_PREFIJO + _tramaRx[_posicionRx];
+  }
+
+  /**
+   * @brief Si ya se entregaron todos los mensajes de la trama actual, lee la siguiente de la radio.
+   */
+  void _atenderRecepcion() {
+    if (_posicionRx < _longitudRx || _vistaTomada) return;
+    while (_radio.hayDatosDisponibles() > 0) {
+      size_t longitud;
+      VistaPaquete vista;
+      if (_radio.tomarPaquete(vista)) {
+        longitud = (vista.longitud < sizeof(_tramaRx)) ? vista.longitud : sizeof(_tramaRx);
+        memcpy(_tramaRx, vista.datos, longitud);
+        _rssi = vista.rssi;
+        _radio.liberarPaquete();
+      } else {
+        longitud = _radio.leer(_tramaRx, sizeof(_tramaRx));
+        if (longitud == 0) break;
+        _rssi = _radio.obtenerRSSI();
+      }
+      _estadisticas.tramasRecibidas++;
+      _posicionRx = 0;
+      _longitudRx = _validarTrama(longitud);
+      if (_longitudRx > 0) return;
+    }
+  }
+
+  /**
+   * @brief Recorre los prefijos de la trama y cuenta sus mensajes.
+   * @return Bytes de la trama que contienen mensajes completos. Si un prefijo es 0 o se sale
+   * de la trama, se descarta desde ese mensaje y la trama cuenta como inválida.
+   */
+  size_t _validarTrama(size_t longitud) {
+    size_t posicion = 0;
+    while (posicion < longitud) {
+      uint8_t tamMensaje = _tramaRx[posicion];
+      if (tamMensaje == 0 || posicion + TAM_PREFIJO + tamMensaje > longitud) {
+        _estadisticas.tramasInvalidas++;
+        break;
+      }
+      posicion += TAM_PREFIJO + tamMensaje;
+      _estadisticas.mensajesRecibidos++;
+    }
+    return posicion;
+  }
+};
+
+#endif // RADIO_AGREGADA_H
@@ -0,0 +1,247 @@
+/**
+ * @file RadioBase.h
+ * @brief Define la base estática (CRTP) común a todos los módulos de radio.
+ * @details `RadioBase<Derivada>` ofrece la misma API que `RadioInterface`, pero resuelta
+ * en tiempo de compilación: sin vtable, sin llamadas indirectas y con las funciones del
+ * camino de envío/recepción disponibles para que el compilador las inline.
+ * Es la opción recomendada para firmware con un único tipo de radio.
+ */
+
+#ifndef RADIO_BASE_H
+#define RADIO_BASE_H
+
+#include <Arduino.h>
+#include <string.h> // memcpy
+#include "TrazaRadio.h"
+
+/**
+ * @struct VistaPaquete
+ * @brief Vista de solo lectura de un paquete recibido, alojado en memoria del radio.
+ * @details La obtiene `tomarPaquete()`. Los datos pertenecen al radio
+ * y son válidos hasta la llamada a `liberarPaquete()`.
+ */
+struct VistaPaquete {
+  const uint8_t* datos; ///< Puntero a los bytes del paquete (no se deben modificar).
+  size_t longitud;      ///< Número de bytes del paquete.
+  int rssi;             ///< RSSI del paquete en dBm, o 0 si el módulo no lo soporta.
+};
+
+/**
+ * @struct Segmento
+ * @brief Fragmento de memoria (puntero + longitud) para envíos por partes (scatter-gather).
+ * @details Permite enviar, por ejemplo, cabecera + datos + CRC como un solo paquete
+ * sin concatenarlos antes en un buffer intermedio.
+ */
+struct Segmento {
+  const uint8_t* datos; ///< Puntero al inicio del fragmento.
+  size_t longitud;      ///< Número de bytes del fragmento.
+};
+
+#ifndef RADIO_CUBETAS_RSSI
+/// Número de cubetas del histograma de RSSI de `EstadisticasRadio`.
+#define RADIO_CUBETAS_RSSI 8
+#endif
+
+/**
+ * @struct EstadisticasRadio
+ * @brief Contadores de actividad de una radio, actualizados con incrementos simples en los
+ * caminos de envío y recepción.
+ * @details Se obtiene una copia con `obtenerEstadisticas()` y se ponen a cero con
+ * `reiniciarEstadisticas()`. Los contadores que un módulo no puede medir quedan a 0
+ * (ej. el RSSI en NRF24L01). Los contadores de 16 bits del histograma dan la vuelta
+ * tras 65535 paquetes, así que conviene leerlos y reiniciarlos periódicamente.
+ */
+struct EstadisticasRadio {
+  static const int RSSI_MINIMO = -120;     ///< Límite superior (excluido) de la primera cubeta, en dBm.
+  static const int ANCHO_CUBETA_RSSI = 10; ///< Ancho de las cubetas intermedias, en dB.
+
+  uint32_t tramasEnviadas;      ///< Tramas aceptadas por `enviar()` (transmitidas o encoladas).
+  uint32_t bytesEnviados;       ///< Bytes de payload de esas tramas.
+  uint32_t enviosFallidos;      ///< Llamadas a `enviar()` que devolvieron false, por cualquier motivo.
+  uint32_t rechazosOcupada;     ///< De ellas, porque la radio estaba ocupada o la cola de transmisión llena.
+  uint32_t tramasNoEntregadas;  ///< Tramas aceptadas que el módulo dio después por perdidas (sin ACK, descartadas).
+  uint32_t tramasRecibidas;     ///< Paquetes recibidos (o lecturas, en flujos sin límites de paquete).
+  uint32_t bytesRecibidos;      ///< Bytes de esos paquetes.
+  uint32_t desbordamientosRx;   ///< Paquetes perdidos, o en riesgo de perderse, por recepción llena.
+  uint32_t lecturasTruncadas;   ///< Paquetes que no cabían en el buffer de destino y se recortaron.
+  uint32_t tramasErroneas;      ///< Tramas recibidas descartadas por checksum o formato.
+  /// Paquetes recibidos por RSSI: [0] por debajo de `RSSI_MINIMO`, luego cubetas de
+  /// `ANCHO_CUBETA_RSSI` dB y la última, todo lo que esté por encima (con 8: >= -60 dBm).
+  uint16_t histogramaRSSI[RADIO_CUBETAS_RSSI];
+
+  /**
+   * @brief Suma un paquete recibido con el RSSI dado (dBm) al histograma.
+   */
+  void registrarRSSI(int rssi) {
+    int cubeta = (rssi < RSSI_MINIMO) ? 0 : (rssi - RSSI_MINIMO) / ANCHO_CUBETA_RSSI + 1;
+    if (cubeta >= RADIO_CUBETAS_RSSI) cubeta = RADIO_CUBETAS_RSSI - 1;
+    histogramaRSSI[cubeta]++;
+  }
+
+  /**
+   * @brief Suma un paquete recibido de `longitud` bytes.
+   */
+  void registrarRecepcion(size_t longitud) {
+    tramasRecibidas++;
+    bytesRecibidos += longitud;
+  }
+
+  /**
+   * @brief Suma el resultado de una llamada a `enviar()`.
+   */
+  void registrarEnvio(bool exito, size_t longitud) {
+    if (exito) {
+      tramasEnviadas++;
+      bytesEnviados += longitud;
+    } else {
+      enviosFallidos++;
+    }
+  }
+};
+
+/**
+ * @brief Implementación genérica de `enviar(segmentos)` para radios sin envío por partes nativo.
+ * @details Copia los segmentos en un buffer de 255 bytes en el stack y llama a
+ * `radio.enviar(buffer, longitud)`. La usan tanto `RadioBase` como `RadioInterface`.
+ * @return false si el total excede 255 bytes o si el envío falla.
+ */
+template <class Radio>
+bool radioEnviarSegmentos(Radio& radio, const Segmento* segmentos, size_t numSegmentos) {
+  uint8_t buffer[255];
+  size_t total = 0;
+  for (size_t i = 0; i < numSegmentos; i++) {
+    if (total + segmentos[i].longitud > sizeof(buffer)) return false;
+    memcpy(buffer + total, segmentos[i].datos, segmentos[i].longitud);
+    total += segmentos[i].longitud;
+  }
+  return radio.enviar(buffer, total);
+}
+
+/**
+ * @brief Implementación genérica de `leerComoString()`.
+ * @details Lee hasta 255 bytes con `radio.leer()` en un buffer del stack y los
+ * convierte a un String de Arduino. La usan tanto `RadioBase` como `RadioInterface`.
+ */
+template <class Radio>
+String radioLeerComoString(Radio& radio) {
+  uint8_t buffer[256]; // Buffer local en el stack
+
+  // Se reserva 1 byte para el terminador nulo '\0'.
+  size_t longitud = radio.leer(buffer, 255);
+
+  buffer[longitud] = '\0'; // Asegura terminación nula para el constructor del String
+
+  // Convierte el buffer C a un String de Arduino
+  return String(reinterpret_cast<char*>(buffer));
+}
+
+/**
+ * @class RadioBase
+ * @brief Base CRTP para módulos de radio con despacho estático.
+ * @details Cada radio concreta (ej. `LoraNucleo`) hereda de `RadioBase<SuPropiaClase>` e
+ * implementa, como funciones normales (no virtuales), `iniciar()`, `enviar(buffer, longitud)`,
+ * `hayDatosDisponibles()` y `leer()`. Las funciones opcionales de esta base (RSSI, energía,
+ * vistas) son valores por defecto que la clase derivada oculta si las soporta, y las
+ * sobrecargas de conveniencia llaman a la clase derivada con `static_cast`, sin vtable.
+ *
+ * Para código genérico que acepte cualquier radio sin coste de despacho:
+ * @code
+ * template <class R>
+ * void reportar(RadioBase<R>& radio) { radio.enviar(datos, longitud); }
+ * @endcode
+ * Para polimorfismo en tiempo de ejecución, `RadioAdaptador` expone cualquier
+ * `RadioBase` como `RadioInterface`.
+ * @tparam Derivada La clase concreta que hereda de esta base.
+ */
+template <class Derivada>
+class RadioBase {
+public:
+  // --- Funciones Fundamentales (las implementa Derivada) ---
+
+  bool iniciar() { return _derivada().iniciar(); }
+  bool enviar(const uint8_t* buffer, size_t longitud) { return _derivada().enviar(buffer, longitud); }
+  int hayDatosDisponibles() { return _derivada().hayDatosDisponibles(); }
+  size_t leer(uint8_t* buffer, size_t maxLongitud) { return _derivada().leer(buffer, maxLongitud); }
+
+  // --- Funciones de Conveniencia y Estado (valores por defecto) ---
+
+  /**
+   * @brief RSSI del último paquete. 0 por defecto, si el módulo no lo soporta.
+   */
+  int obtenerRSSI() { return 0; }
+
+  /**
+   * @brief Tamaño máximo de un paquete en bytes. 255 por defecto.
+   */
+  size_t obtenerMTU() { return 255; }
+
+  /**
+   * @brief Modo de bajo consumo. true por defecto (no necesario o sin soporte).
+   */
+  bool dormir() { return true; }
+
+  /**
+   * @brief Salida del modo de bajo consumo. true por defecto.
+   */
+  bool despertar() { return true; }
+
+  /**
+   * @brief Vista sin copias del siguiente paquete. false por defecto (sin soporte).
+   */
+  bool tomarPaquete(VistaPaquete& vista) { (void)vista; return false; }
+
+  /**
+   * @brief Libera el paquete obtenido con `tomarPaquete()`.
+   */
+  void liberarPaquete() {}
+
+  /**
+   * @brief Copia de los contadores de actividad. Todo a 0 por defecto (sin soporte).
+   */
+  EstadisticasRadio obtenerEstadisticas() {
+    EstadisticasRadio estadisticas;
+    memset(&estadisticas, 0, sizeof(estadisticas));
+    return estadisticas;
+  }
+
+  /**
+   * @brief Pone a cero los contadores de actividad.
+   */
+  void reiniciarEstadisticas() {}
+
+  // --- Sobrecargas de Conveniencia ---
+
+  /**
+   * @brief Envía un objeto String a través del radio.
+   */
+  bool enviar(const String& data) {
+    return _derivada().enviar(reinterpret_cast<const uint8_t*>(data.c_str()), data.length());
+  }
+
+  /**
+   * @brief Envía varios segmentos como un único paquete (por defecto, reuniéndolos en el stack).
+   */
+  bool enviar(const Segmento* segmentos, size_t numSegmentos) {
+    return radioEnviarSegmentos(_derivada(), segmentos, numSegmentos);
+  }
+
+  /**
+   * @brief Lee el paquete disponible como un String de Arduino (máximo 255 bytes).
+   */
+  String leerComoString() {
+    return radioLeerComoString(_derivada());
+  }
+
+protected:
+  /**
+   * @brief Destructor protegido y no virtual: una radio no se destruye a través de `RadioBase`.
+   */
+  ~RadioBase() {}
+
+  /**
+   * @brief Acceso a la clase derivada (resuelto en tiempo de compilación).
+   */
+  Derivada& _derivada() { return *static_cast<Derivada*>(this); }
+};
+
+#endif // RADIO_BASE_H
@@ -0,0 +1,250 @@
+/**
+ * @file RadioFEC.h
+ * @brief Corrección de errores hacia delante (FEC) Reed-Solomon sobre cualquier `RadioInterface`.
+ * @details `RadioFEC` añade a cada paquete bytes de paridad Reed-Solomon, de modo que el
+ * receptor puede reparar bytes dañados en lugar de perder el paquete entero. Con
+ * entrelazado, el paquete se reparte en varias palabras código y una ráfaga de errores
+ * consecutivos se divide entre todas ellas.
+ */
+
+#ifndef RADIO_FEC_H
+#define RADIO_FEC_H
+
+#include "RadioInterface.h"
+#include "ReedSolomon.h"
+
+// Tamaño del buffer de recepción (mensaje + paridad). Se puede redefinir antes de incluir la librería.
+#ifndef RADIO_FEC_TAM_BUFFER
+#define RADIO_FEC_TAM_BUFFER 255
+#endif
+
+/**
+ * @struct EstadisticasFEC
+ * @brief Contadores de `RadioFEC`.
+ * @details `paquetesCorregidos / paquetesRecibidos` indica cuántos paquetes se habrían
+ * perdido sin FEC; si `paquetesIrrecuperables` crece, conviene más paridad o entrelazado.
+ */
+struct EstadisticasFEC {
+  uint32_t paquetesEnviados;       ///< Paquetes codificados y entregados a la radio.
+  uint32_t paquetesRecibidos;      ///< Paquetes leídos de la radio.
+  uint32_t paquetesCorregidos;     ///< Paquetes con al menos un byte corregido.
+  uint32_t bytesCorregidos;        ///< Total de bytes corregidos.
+  uint32_t paquetesIrrecuperables; ///< Paquetes descartados por exceso de errores o longitud inválida.
+};
+
+/**
+ * @class RadioFEC
+ * @brief Decorador de `RadioInterface` que codifica y corrige los paquetes con Reed-Solomon.
+ * @details Un paquete de `m` bytes de mensaje se transmite como el mensaje tal cual,
+ * seguido de `profundidad * paridad` bytes de paridad. Con profundidad `D`, el byte en la
+ * posición `i` del paquete (mensaje o paridad) pertenece a la palabra código `i % D`, y
+ * cada palabra corrige hasta `paridad / 2` bytes erróneos, así que una ráfaga de hasta
+ * `D * paridad / 2` bytes consecutivos es recuperable esté donde esté.
+ *
+ * El mensaje se envía con `enviar(segmentos)` de la radio (segmentos del llamador + bloque
+ * de paridad), sin copiarlo. En recepción, el paquete se copia a un buffer propio de
+ * `RADIO_FEC_TAM_BUFFER` bytes, se corrige en su sitio y se entrega desde ahí.
+ * @note Para que la FEC sirva de algo, la radio debe entregar los paquetes dañados: en
+ * LoRa hay que dejar el CRC desactivado (valor por defecto de `LoRaConfig`). Con un CRC
+ * por hardware activo (NRF24L01, XBee) solo se aprovecha la detección adicional.
+ */
+class RadioFEC : public RadioInterface {
+public:
+  static const uint8_t MAX_SEGMENTOS = 6; ///< Segmentos del llamador por paquete en `enviar(segmentos)`.
+
+  // Hace visibles las sobrecargas de RadioInterface (ej. enviar(const String&)).
+  using RadioInterface::enviar;
+
+  /**
+   * @brief Constructor.
+   * @param radio Radio sobre la que se envían los paquetes. Debe existir mientras se use este objeto.
+   * @param paridad Bytes de paridad por palabra código (2-32, 16 por defecto: corrige 8 bytes).
+   * @param profundidad Palabras código entrelazadas por paquete (1 = sin entrelazado).
+   */
+  explicit RadioFEC(RadioInterface& radio, uint8_t paridad = 16, uint8_t profundidad = 1)
+    : _radio(radio),
+      _rs(paridad),
+      _profundidad(profundidad == 0 ? 1 : profundidad),
+      _longitud(0),
+      _rssi(0),
+      _vistaTomada(false) {
+    memset(&_estadisticas, 0, sizeof(_estadisticas));
+  }
+
+  /**
+   * @brief Bytes añadidos a cada paquete (`profundidad * paridad`).
+   */
+  size_t sobrecarga() const { return (size_t)_profundidad * _rs.paridad(); }
+
+  /**
+   * @brief Contadores de paquetes enviados, recibidos y corregidos.
+   */
+  const EstadisticasFEC& estadisticas() const { return _estadisticas; }
+
+  // --- RadioInterface ---
+
+  bool iniciar() override { return _radio.iniciar(); }
+
+  bool enviar(const uint8_t* buffer, size_t longitud) override {
+    Segmento segmento = {buffer, longitud};
+    return enviar(&segmento, 1);
+  }
+
+  /**
+   * @brief Calcula la paridad de la concatenación de los segmentos y la envía tras ellos.
+   * @return false si el mensaje está vacío, excede `obtenerMTU()`, hay más de
+   * `MAX_SEGMENTOS` segmentos, o la radio rechaza el paquete.
+   */
+  bool enviar(const Segmento* segmentos, size_t numSegmentos) override {
+    size_t total = 0;
+    for (size_t i = 0; i < numSegmentos; i++) total += segmentos[i].longitud;
+    if (total == 0 || total > obtenerMTU() || numSegmentos > MAX_SEGMENTOS) return false;
+
+    uint8_t paridad[255];
+    memset(paridad, 0, sobrecarga());
+    uint8_t registro = _inicioParidad(0, total); // Paridad de la palabra del primer byte
+    for (size_t s = 0; s < numSegmentos; s++) {
+      for (size_t i = 0; i < segmentos[s].longitud; i++) {
+        _rs.codificarByte(paridad + registro, _profundidad, segmentos[s].datos[i]);
+        if (++registro == _profundidad) registro = 0;
+      }
+    }
+
+    Segmento partes[MAX_SEGMENTOS + 1];
+    for (size_t s = 0; s < numSegmentos; s++) partes[s] = segmentos[s];
+    partes[numSegmentos].datos = paridad;
+    partes[numSegmentos].longitud = sobrecarga();
+    if (!_radio.enviar(partes, numSegmentos + 1)) return false;
+    _estadisticas.paquetesEnviados++;
+    return true;
+  }
+
+  /**
+   * @brief Longitud del siguiente mensaje ya corregido, o 0 si no hay ninguno.
+   */
+  int hayDatosDisponibles() override {
+    _atenderRecepcion();
+    return (int)_longitud;
+  }
+
+  /**
+   * @brief Copia el siguiente mensaje corregido. Lo que no quepa en `buffer` se descarta.
+   */
+  size_t leer(uint8_t* buffer, size_t maxLongitud) override {
+    _atenderRecepcion();
+    if (_longitud == 0 || maxLongitud == 0) return 0;
+    size_t longitud = (_longitud < maxLongitud) ? _longitud : maxLongitud;
+    memcpy(buffer, _buffer, longitud);
+    _longitud = 0;
+    return longitud;
+  }
+
+  /**
+   * @brief Vista del siguiente mensaje corregido, en el buffer de recepción de `RadioFEC`.
+   */
+  bool tomarPaquete(VistaPaquete& vista) override {
+    if (!_vistaTomada) {
+      _atenderRecepcion();
+      if (_longitud == 0) return false;
+      _vistaTomada = true;
+    }
+    vista.datos = _buffer;
+    vista.longitud = _longitud;
+    vista.rssi = _rssi;
+    return true;
+  }
+
+  void liberarPaquete() override {
+    if (!_vistaTomada) return;
+    _vistaTomada = false;
+    _longitud = 0;
+  }
+
+  int obtenerRSSI() override { return _rssi; }
+  bool dormir() override { return _radio.dormir(); }
+  bool despertar() override { return _radio.despertar(); }
+  EstadisticasRadio obtenerEstadisticas() override { return _radio.obtenerEstadisticas(); }
+  void reiniciarEstadisticas() override { _radio.reiniciarEstadisticas(); }
+
+  /**
+   * @brief Tamaño máximo de un mensaje: MTU de la radio menos la paridad, limitado para
+   * que ninguna palabra código supere 255 bytes.
+   */
+  size_t obtenerMTU() override {
+    size_t mtu = _radio.obtenerMTU();
+    if (mtu > RADIO_FEC_TAM_BUFFER) mtu = RADIO_FEC_TAM_BUFFER;
+    if (mtu <= sobrecarga()) return 0;
+    size_t maximo = (size_t)_profundidad * (255 - _rs.paridad());
+    mtu -= sobrecarga();
+    return (mtu < maximo) ? mtu : maximo;
+  }
+
+private:
+  RadioInterface& _radio;
+  ReedSolomon _rs;
+  uint8_t _profundidad;
+  uint8_t _buffer[RADIO_FEC_TAM_BUFFER]; ///< Paquete recibido; tras corregirlo, el mensaje ocupa el principio.
+  size_t _longitud;                      ///< Longitud del mensaje pendiente de leer, 0 si ninguno.
+  int _rssi;                             ///< RSSI del paquete pendiente.
+  bool _vistaTomada;
+  EstadisticasFEC _estadisticas;
+
+  /**
+   * @brief Posición, dentro del bloque de paridad, del primer byte de paridad de la palabra `palabra`.
+   * @details El bloque empieza en la posición `mensaje` del paquete, que pertenece a la palabra `mensaje % D`.
+   */
+  uint8_t _inicioParidad(uint8_t palabra, size_t mensaje) const {
+    return (uint8_t)((palabra + _profundidad - mensaje % _profundidad) % _profundidad);
+  }
+
+  /**
+   * @brief Lee paquetes de la radio hasta obtener uno corregible (o vaciarla).
+   */
+  void _atenderRecepcion() {
+    if (_longitud > 0) return;
+    while (_radio.hayDatosDisponibles() > 0) {
+      size_t longitud;
+      VistaPaquete vista;
+      if (_radio.tomarPaquete(vista)) {
+        longitud = (vista.longitud < sizeof(_buffer)) ? vista.longitud : sizeof(_buffer);
+        memcpy(_buffer, vista.datos, longitud);
+        _rssi = vista.rssi;
+        _radio.liberarPaquete();
+      } else {
+        longitud = _radio.leer(_buffer, sizeof(_buffer));
+        if (longitud == 0) break;
+        _rssi = _radio.obtenerRSSI();
+      }
+      _estadisticas.paquetesRecibidos++;
+      if (_corregir(longitud)) return;
+      _estadisticas.paquetesIrrecuperables++;
+    }
+  }
+
+  /**
+   * @brief Corrige en su sitio cada palabra código del paquete que hay en `_buffer`.
+   * @return true si todas las palabras son válidas; `_longitud` queda con la longitud del mensaje.
+   */
+  bool _corregir(size_t longitudPaquete) {
+    if (longitudPaquete <= sobrecarga()) return false;
+    size_t mensaje = longitudPaquete - sobrecarga();
+    if (mensaje > (size_t)_profundidad * (255 - _rs.paridad())) return false;
+
+    size_t corregidos = 0;
+    for (uint8_t c = 0; c < _profundidad && c < mensaje; c++) {
+      uint8_t longitudPalabra = (uint8_t)((mensaje - c + _profundidad - 1) / _profundidad);
+      int resultado = _rs.corregir(_buffer + c, longitudPalabra, _buffer + mensaje + _inicioParidad(c, mensaje),
+                                   _profundidad);
+      if (resultado < 0) return false;
+      corregidos += resultado;
+    }
+    if (corregidos > 0) {
+      _estadisticas.paquetesCorregidos++;
+      _estadisticas.bytesCorregidos += corregidos;
+    }
+    _longitud = mensaje;
+    return true;
+  }
+};
+
+#endif // RADIO_FEC_H
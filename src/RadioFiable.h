@@ -0,0 +1,552 @@
+/**
+ * @file RadioFiable.h
+ * @brief Transporte fiable (ARQ de repetición selectiva) sobre cualquier `RadioInterface`.
+ * @details `RadioFiable` numera los mensajes, mantiene varios en vuelo a la vez (ventana
+ * deslizante), los confirma con ACKs acumulativos más un mapa de bits selectivo y
+ * retransmite solo los que faltan, con un timeout que se adapta al RTT medido.
+ * En enlaces lentos (LoRa) la ventana mantiene el canal ocupado mientras llegan los ACKs,
+ * en lugar de esperar uno por mensaje como en parada y espera.
+ */
+
+#ifndef RADIO_FIABLE_H
+#define RADIO_FIABLE_H
+
+#include "RadioInterface.h"
+
+/**
+ * @struct RanuraFiable
+ * @brief Estado de un mensaje en la ventana de envío o de recepción.
+ * @details Los datos van en la memoria de `RadioFiable`.
+ */
+struct RanuraFiable {
+  uint32_t enviadoMs; ///< (Envío) `millis()` de la última transmisión.
+  uint16_t longitud;  ///< Bytes del mensaje.
+  uint8_t secuencia;  ///< Número de secuencia.
+  uint8_t intentos;   ///< (Envío) Transmisiones realizadas.
+  bool ocupada;       ///< Envío: pendiente de ACK. Recepción: recibido y pendiente de leer.
+};
+
+/**
+ * @struct EstadisticasFiabilidad
+ * @brief Contadores de `RadioFiable`.
+ */
+struct EstadisticasFiabilidad {
+  uint32_t mensajesEnviados;    ///< Mensajes aceptados por `enviar()`.
+  uint32_t mensajesConfirmados; ///< Mensajes con ACK.
+  uint32_t mensajesFallidos;    ///< Mensajes abandonados tras agotar los reintentos.
+  uint32_t retransmisiones;     ///< Transmisiones repetidas por timeout.
+  uint32_t mensajesRecibidos;   ///< Mensajes nuevos aceptados en la ventana de recepción.
+  uint32_t duplicados;          ///< Mensajes recibidos más de una vez (ACK perdido).
+  uint32_t mensajesSaltados;    ///< Huecos que el emisor abandonó y el receptor dejó de esperar.
+  uint32_t acksEnviados;        ///< ACKs transmitidos.
+  uint32_t acksRecibidos;       ///< ACKs procesados.
+};
+
+/**
+ * @class RadioFiable
+ * @brief Decorador de `RadioInterface` con entrega fiable y ordenada entre dos nodos.
+ * @details Cabeceras:
+ * - Datos (4 bytes): [tipo] [sesión] [secuencia] [base], donde `base` es el mensaje más
+ *   antiguo que el emisor aún no ha confirmado ni abandonado.
+ * - ACK (5 bytes): [tipo] [sesión] [esperado] [mapa de bits (16, little endian)]. `esperado`
+ *   es el primer mensaje no recibido (confirma todos los anteriores) y el bit i confirma
+ *   `esperado + 1 + i`. La sesión es la de los datos que se confirman.
+ *
+ * La sesión identifica cada arranque del emisor (ver `fijarSesion()`). Cuando el receptor
+ * ve una sesión distinta de la anterior, descarta su ventana de recepción y adopta la
+ * numeración nueva; el emisor ignora los ACKs de otra sesión, que confirmarían números de
+ * secuencia del arranque anterior.
+ *
+ * `enviar()` copia el mensaje en la ventana de envío, lo transmite y retorna; si la
+ * ventana está llena devuelve false (no bloquea). `procesar()` lee los paquetes de la
+ * radio, responde con ACKs y retransmite los mensajes cuyo RTO ha vencido. El RTO sigue
+ * el algoritmo de Jacobson/Karels (RTO = SRTT + 4·RTTVAR, con RTTVAR >= SRTT/8), con backoff
+ * exponencial cada vez que vence el mensaje más antiguo (se deshace con el siguiente ACK de
+ * datos nuevos) y sin medir el RTT de mensajes retransmitidos (algoritmo de Karn).
+ *
+ * La recepción entrega los mensajes en orden con la API habitual (`hayDatosDisponibles()`,
+ * `leer()`, `tomarPaquete()`), que también llaman a `procesar()`.
+ * @note Pensado para enlaces punto a punto: en un canal compartido, todos los nodos con
+ * `RadioFiable` que escuchen el mensaje responderán con un ACK.
+ */
+class RadioFiable : public RadioInterface {
+public:
+  static const uint8_t TAM_CABECERA = 4;  ///< Bytes de cabecera de un mensaje de datos.
+  static const uint8_t TAM_ACK = 5;       ///< Bytes de un ACK.
+  static const uint8_t MAX_VENTANA = 16;  ///< Ventana máxima (bits del mapa selectivo).
+
+  // Hace visibles las sobrecargas de RadioInterface (ej. enviar(const String&)).
+  using RadioInterface::enviar;
+
+  /**
+   * @brief Constructor.
+   * @param radio Radio sobre la que se transmite. Debe existir mientras se use este objeto.
+   * @param ranurasTx Array de `ventana` ranuras para la ventana de envío.
+   * @param memoriaTx Bloque de `ventana * tamMensaje` bytes para los mensajes sin confirmar.
+   * @param ranurasRx Array de `ventana` ranuras para la ventana de recepción.
+   * @param memoriaRx Bloque de `ventana * tamMensaje` bytes para los mensajes recibidos sin leer.
+   * @param ventana Mensajes en vuelo (y fuera de orden en recepción) como máximo: 1, 2, 4, 8 o 16
+   * (potencia de 2, para que el índice de ranura siga a la secuencia de 8 bits al dar la vuelta).
+   * @param tamMensaje Tamaño máximo de un mensaje en bytes (como mucho el MTU de `radio` menos `TAM_CABECERA`).
+   */
+  RadioFiable(RadioInterface& radio, RanuraFiable* ranurasTx, uint8_t* memoriaTx,
+              RanuraFiable* ranurasRx, uint8_t* memoriaRx, uint8_t ventana, uint16_t tamMensaje)
+    : _radio(radio),
+      _ranurasTx(ranurasTx),
+      _memoriaTx(memoriaTx),
+      _ranurasRx(ranurasRx),
+      _memoriaRx(memoriaRx),
+      _capacidad(_potenciaDeDos(ventana)),
+      _ventana(_capacidad),
+      _tamMensaje(tamMensaje),
+      _maxIntentos(8),
+      _rtoMinMs(50),
+      _rtoMaxMs(60000),
+      _rtoMs(1000),
+      _srttMs(0),
+      _rttvarMs(0),
+      _baseTx(0),
+      _siguienteTx(0),
+      _sesion(0),
+      _sesionElegida(false),
+      _baseRx(0),
+      _baseEmisor(0),
+      _sesionEmisor(0),
+      _sincronizadoRx(false),
+      _vistaTomada(false) {
+    memset(&_estadisticas, 0, sizeof(_estadisticas));
+    for (uint8_t i = 0; i < _capacidad; i++) {
+      _ranurasTx[i].ocupada = false;
+      _ranurasRx[i].ocupada = false;
+    }
+  }
+
+  /**
+   * @brief Limita los mensajes en vuelo (1 equivale a parada y espera). No puede superar la del constructor.
+   */
+  void fijarVentana(uint8_t ventana) {
+    _ventana = (ventana == 0) ? 1 : (ventana > _capacidad ? _capacidad : ventana);
+  }
+
+  /**
+   * @brief Fija el identificador de sesión de este arranque, que viaja en cada mensaje.
+   * @details Debe cambiar en cada arranque para que el receptor detecte el reinicio. Si no se
+   * llama antes de `iniciar()` o del primer `enviar()`, se elige con `random()` mezclado con
+   * `micros()`; como `random()` repite la misma serie en cada arranque, conviene llamar antes
+   * a `randomSeed()` con una fuente de ruido (ej. `analogRead()` de un pin al aire) o pasar
+   * aquí un contador de arranques guardado en EEPROM.
+   */
+  void fijarSesion(uint8_t sesion) {
+    _sesion = sesion;
+    _sesionElegida = true;
+  }
+
+  /**
+   * @brief Identificador de sesión de este arranque.
+   */
+  uint8_t sesion() const { return _sesion; }
+
+  /**
+   * @brief Transmisiones de un mensaje antes de abandonarlo (8 por defecto).
+   */
+  void fijarReintentos(uint8_t maxIntentos) { _maxIntentos = maxIntentos; }
+
+  /**
+   * @brief RTO inicial, usado hasta la primera medida de RTT (1000 ms por defecto).
+   * @details Conviene que supere el tiempo en el aire del mensaje más su ACK (ej. ~3 s en LoRa SF12).
+   */
+  void fijarRTOInicial(uint32_t milisegundos) { _rtoMs = _limitarRTO(milisegundos); }
+
+  /**
+   * @brief Límites del RTO adaptativo (50 ms y 60 s por defecto).
+   */
+  void fijarLimitesRTO(uint32_t minimoMs, uint32_t maximoMs) {
+    _rtoMinMs = minimoMs;
+    _rtoMaxMs = maximoMs;
+    _rtoMs = _limitarRTO(_rtoMs);
+  }
+
+  /**
+   * @brief Timeout de retransmisión actual, en milisegundos.
+   */
+  uint32_t rtoMs() const { return _rtoMs; }
+
+  /**
+   * @brief RTT suavizado (SRTT), en milisegundos. 0 si aún no hay medidas.
+   */
+  uint32_t rttMs() const { return _srttMs; }
+
+  /**
+   * @brief Mensajes enviados que aún esperan su ACK.
+   */
+  uint8_t pendientesConfirmacion() const { return (uint8_t)(_siguienteTx - _baseTx); }
+
+  /**
+   * @brief Contadores de envío, retransmisión y recepción.
+   */
+  const EstadisticasFiabilidad& estadisticas() const { return _estadisticas; }
+
+  /**
+   * @brief Atiende el enlace: procesa datos y ACKs recibidos y retransmite los mensajes vencidos.
+   * @details Llamar periódicamente desde `loop()` mientras haya mensajes sin confirmar.
+   */
+  void procesar() {
+    while (_radio.hayDatosDisponibles() > 0) {
+      VistaPaquete vista;
+      if (_radio.tomarPaquete(vista)) {
+        _procesarPaquete(vista.datos, vista.longitud);
+        _radio.liberarPaquete();
+      } else {
+        uint8_t paquete[255]; // Radios sin vistas: copia intermedia en el stack
+        size_t longitud = _radio.leer(paquete, sizeof(paquete));
+        if (longitud == 0) break;
+        _procesarPaquete(paquete, longitud);
+      }
+    }
+    _retransmitirVencidos();
+  }
+
+  // --- RadioInterface ---
+
+  bool iniciar() override {
+    _elegirSesion();
+    return _radio.iniciar();
+  }
+
+  bool enviar(const uint8_t* buffer, size_t longitud) override {
+    Segmento segmento = {buffer, longitud};
+    return enviar(&segmento, 1);
+  }
+
+  /**
+   * @brief Copia el mensaje en la ventana de envío y lo transmite.
+   * @return true si el mensaje quedó en la ventana (su entrega se confirma después).
+   * @return false si la ventana está llena o el mensaje excede `obtenerMTU()`.
+   */
+  bool enviar(const Segmento* segmentos, size_t numSegmentos) override {
+    procesar();
+    if (pendientesConfirmacion() >= _ventana) return false;
+
+    size_t total = 0;
+    for (size_t i = 0; i < numSegmentos; i++) total += segmentos[i].longitud;
+    if (total > obtenerMTU()) return false;
+
+    _elegirSesion(); // Por si la radio se inició por separado
+    uint8_t secuencia = _siguienteTx++;
+    RanuraFiable& ranura = _ranurasTx[secuencia % _capacidad];
+    uint8_t* datos = _datosTx(secuencia);
+    size_t posicion = 0;
+    for (size_t i = 0; i < numSegmentos; i++) {
+      memcpy(datos + posicion, segmentos[i].datos, segmentos[i].longitud);
+      posicion += segmentos[i].longitud;
+    }
+    ranura.secuencia = secuencia;
+    ranura.longitud = total;
+    ranura.intentos = 0;
+    ranura.ocupada = true;
+    _estadisticas.mensajesEnviados++;
+    _transmitir(ranura);
+    return true;
+  }
+
+  /**
+   * @brief Longitud del siguiente mensaje en orden, o 0 si aún no ha llegado.
+   */
+  int hayDatosDisponibles() override {
+    procesar();
+    RanuraFiable* ranura = _siguienteRx();
+    return ranura ? (int)ranura->longitud : 0;
+  }
+
+  size_t leer(uint8_t* buffer, size_t maxLongitud) override {
+    procesar();
+    RanuraFiable* ranura = _siguienteRx();
+    if (!ranura || maxLongitud == 0) return 0;
+    size_t longitud = (ranura->longitud < maxLongitud) ? ranura->longitud : maxLongitud;
+    memcpy(buffer, _datosRx(ranura->secuencia), longitud);
+    _avanzarRx();
+    return longitud;
+  }
+
+  bool tomarPaquete(VistaPaquete& vista) override {
+    if (!_vistaTomada) procesar();
+    RanuraFiable* ranura = _siguienteRx();
+    if (!ranura) return false;
+    vista.datos = _datosRx(ranura->secuencia);
+    vista.longitud = ranura->longitud;
+    vista.rssi = _radio.obtenerRSSI();
+    _vistaTomada = true;
+    return true;
+  }
+
+  void liberarPaquete() override {
+    if (!_vistaTomada) return;
+    _vistaTomada = false;
+    _avanzarRx();
+  }
+
+  int obtenerRSSI() override { return _radio.obtenerRSSI(); }
+  bool dormir() override { return _radio.dormir(); }
+  bool despertar() override { return _radio.despertar(); }
+  EstadisticasRadio obtenerEstadisticas() override { return _radio.obtenerEstadisticas(); }
+  void reiniciarEstadisticas() override { _radio.reiniciarEstadisticas(); }
+
+  /**
+   * @brief Tamaño máximo de un mensaje: `tamMensaje`, limitado por el MTU de la radio.
+   */
+  size_t obtenerMTU() override {
+    size_t mtu = _radio.obtenerMTU();
+    size_t carga = (mtu > TAM_CABECERA) ? mtu - TAM_CABECERA : 0;
+    return (_tamMensaje < carga) ? _tamMensaje : carga;
+  }
+
+private:
+  static const uint8_t TIPO_DATOS = 0x01;
+  static const uint8_t TIPO_ACK = 0x02;
+  static const uint8_t MASCARA_TIPO = 0x0F;
+
+  RadioInterface& _radio;
+  RanuraFiable* _ranurasTx;
+  uint8_t* _memoriaTx;
+  RanuraFiable* _ranurasRx;
+  uint8_t* _memoriaRx;
+  uint8_t _capacidad;
+  uint8_t _ventana;
+  uint16_t _tamMensaje;
+  uint8_t _maxIntentos;
+  uint32_t _rtoMinMs;
+  uint32_t _rtoMaxMs;
+  uint32_t _rtoMs;
+  uint32_t _srttMs;
+  uint32_t _rttvarMs;
+  uint8_t _baseTx;       ///< Mensaje más antiguo sin confirmar.
+  uint8_t _siguienteTx;  ///< Próximo número de secuencia.
+  uint8_t _sesion;       ///< Sesión de este arranque, enviada en cada mensaje.
+  bool _sesionElegida;   ///< true tras `fijarSesion()` o el primer `iniciar()`.
+  uint8_t _baseRx;       ///< Próximo mensaje a entregar a la aplicación.
+  uint8_t _baseEmisor;   ///< Última `base` anunciada por el emisor.
+  uint8_t _sesionEmisor; ///< Sesión del emisor a la que pertenece la ventana de recepción.
+  bool _sincronizadoRx;  ///< true tras el primer mensaje de datos.
+  bool _vistaTomada;
+  EstadisticasFiabilidad _estadisticas;
+
+  /// Mayor potencia de 2 que no supera `ventana`, entre 1 y `MAX_VENTANA`.
+  static uint8_t _potenciaDeDos(uint8_t ventana) {
+    uint8_t potencia = 1;
+    while (potencia < MAX_VENTANA && (uint8_t)(potencia * 2) <= ventana) potencia *= 2;
+    return potencia;
+  }
+
+  /// true si `a` es anterior a `b` en el espacio de secuencia circular de 8 bits.
+  static bool _anterior(uint8_t a, uint8_t b) { return (uint8_t)(b - a - 1) < 128; }
+
+  uint8_t* _datosTx(uint8_t secuencia) const { return _memoriaTx + (size_t)(secuencia % _capacidad) * _tamMensaje; }
+  uint8_t* _datosRx(uint8_t secuencia) const { return _memoriaRx + (size_t)(secuencia % _capacidad) * _tamMensaje; }
+
+  void _elegirSesion() {
+    if (!_sesionElegida) fijarSesion((uint8_t)(random(256) ^ micros()));
+  }
+
+  uint32_t _limitarRTO(uint32_t rto) const {
+    return (rto < _rtoMinMs) ? _rtoMinMs : (rto > _rtoMaxMs ? _rtoMaxMs : rto);
+  }
+
+  void _transmitir(RanuraFiable& ranura) {
+    uint8_t cabecera[TAM_CABECERA] = {TIPO_DATOS, _sesion, ranura.secuencia, _baseTx};
+    Segmento partes[2] = {{cabecera, TAM_CABECERA}, {_datosTx(ranura.secuencia), ranura.longitud}};
+    _radio.enviar(partes, 2); // Si la radio lo rechaza, se reintentará al vencer el RTO
+    ranura.enviadoMs = millis();
+    ranura.intentos++;
+  }
+
+  void _retransmitirVencidos() {
+    uint32_t ahora = millis();
+    uint32_t rto = _rtoMs;
+    bool masAntiguo = true;
+    for (uint8_t secuencia = _baseTx; secuencia != _siguienteTx; secuencia++) {
+      RanuraFiable& ranura = _ranurasTx[secuencia % _capacidad];
+      if (!ranura.ocupada) continue;
+      bool esMasAntiguo = masAntiguo;
+      masAntiguo = false;
+      if (ahora - ranura.enviadoMs < rto) continue;
+      if (ranura.intentos >= _maxIntentos) {
+        ranura.ocupada = false;
+        _estadisticas.mensajesFallidos++;
+        continue;
+      }
+      // Backoff exponencial solo al vencer el mensaje más antiguo: cada mensaje tiene su
+      // temporizador y, con la ventana llena, doblar en cada vencimiento llevaría el RTO al máximo.
+      if (esMasAntiguo) _rtoMs = _limitarRTO(rto * 2);
+      _estadisticas.retransmisiones++;
+      _transmitir(ranura);
+    }
+    _avanzarBaseTx();
+  }
+
+  void _avanzarBaseTx() {
+    while (_baseTx != _siguienteTx && !_ranurasTx[_baseTx % _capacidad].ocupada) _baseTx++;
+  }
+
+  void _procesarPaquete(const uint8_t* datos, size_t longitud) {
+    if (longitud == 0) return;
+    uint8_t tipo = datos[0] & MASCARA_TIPO;
+    if (tipo == TIPO_ACK && longitud >= TAM_ACK) {
+      if (datos[1] != _sesion) return; // Confirma mensajes de un arranque anterior
+      _procesarAck(datos[2], (uint16_t)datos[3] | ((uint16_t)datos[4] << 8));
+    } else if (tipo == TIPO_DATOS && longitud >= TAM_CABECERA) {
+      _procesarDatos(datos, longitud);
+    }
+  }
+
+  void _procesarAck(uint8_t esperado, uint16_t mapa) {
+    _estadisticas.acksRecibidos++;
+    uint32_t ahora = millis();
+    bool hayConfirmados = false;
+    for (uint8_t secuencia = _baseTx; secuencia != _siguienteTx; secuencia++) {
+      RanuraFiable& ranura = _ranurasTx[secuencia % _capacidad];
+      if (!ranura.ocupada) continue;
+      uint8_t bit = (uint8_t)(secuencia - esperado - 1);
+      bool confirmado = _anterior(secuencia, esperado) || (bit < 16 && (mapa & (1U << bit)));
+      if (!confirmado) continue;
+      ranura.ocupada = false;
+      hayConfirmados = true;
+      _estadisticas.mensajesConfirmados++;
+      if (ranura.intentos == 1) _medirRTT(ahora - ranura.enviadoMs);
+    }
+    // El enlace vuelve a responder: se deshace el backoff acumulado.
+    if (hayConfirmados && _srttMs > 0) _rtoMs = _rtoCalculado();
+    _avanzarBaseTx();
+  }
+
+  /**
+   * @brief Actualiza SRTT/RTTVAR y el RTO con una medida de RTT (Jacobson/Karels, RFC 6298).
+   */
+  void _medirRTT(uint32_t rtt) {
+    if (_srttMs == 0) {
+      _srttMs = rtt ? rtt : 1;
+      _rttvarMs = rtt / 2;
+    } else {
+      uint32_t diferencia = (rtt > _srttMs) ? rtt - _srttMs : _srttMs - rtt;
+      _rttvarMs = (3 * _rttvarMs + diferencia) / 4;
+      _srttMs = (7 * _srttMs + rtt) / 8;
+      if (_srttMs == 0) _srttMs = 1;
+    }
+    _rtoMs = _rtoCalculado();
+  }
+
+  /**
+   * @brief SRTT + 4·RTTVAR, con RTTVAR de al menos SRTT/8 (RTO >= 1.5·SRTT).
+   * @details Con un RTT muy estable RTTVAR tiende a 0 y el RTO quedaría pegado al SRTT:
+   * cualquier espera en la cola de la radio provocaría retransmisiones espurias.
+   */
+  uint32_t _rtoCalculado() const {
+    uint32_t variacion = (_rttvarMs > _srttMs / 8) ? _rttvarMs : _srttMs / 8;
+    return _limitarRTO(_srttMs + 4 * variacion);
+  }
+
+  void _procesarDatos(const uint8_t* datos, size_t longitud) {
+    uint8_t sesion = datos[1];
+    uint8_t secuencia = datos[2];
+    uint8_t baseEmisor = datos[3];
+    uint8_t distancia = (uint8_t)(secuencia - _baseRx);
+
+    // Primer contacto, o el emisor se ha reiniciado: adoptar su numeración.
+    if (!_sincronizadoRx || sesion != _sesionEmisor) {
+      if (_sincronizadoRx) _descartarRx();
+      _baseRx = baseEmisor;
+      _baseEmisor = baseEmisor;
+      _sesionEmisor = sesion;
+      _sincronizadoRx = true;
+      distancia = (uint8_t)(secuencia - _baseRx);
+    }
+    if (_anterior(_baseEmisor, baseEmisor)) _baseEmisor = baseEmisor;
+
+    size_t carga = longitud - TAM_CABECERA;
+    if (distancia < _capacidad && carga <= _tamMensaje) {
+      RanuraFiable& ranura = _ranurasRx[secuencia % _capacidad];
+      if (ranura.ocupada) {
+        _estadisticas.duplicados++;
+      } else {
+        memcpy(_datosRx(secuencia), datos + TAM_CABECERA, carga);
+        ranura.secuencia = secuencia;
+        ranura.longitud = carga;
+        ranura.ocupada = true;
+        _estadisticas.mensajesRecibidos++;
+      }
+    } else if (_anterior(secuencia, _baseRx)) {
+      _estadisticas.duplicados++; // Ya entregado: solo hay que repetir el ACK
+    } else {
+      return; // Fuera de la ventana: el emisor lo repetirá cuando haya sitio
+    }
+    _saltarAbandonados();
+    _enviarAck();
+  }
+
+  void _enviarAck() {
+    uint8_t esperado = _baseRx;
+    while ((uint8_t)(esperado - _baseRx) < _capacidad && _ranurasRx[esperado % _capacidad].ocupada &&
+           _ranurasRx[esperado % _capacidad].secuencia == esperado) {
+      esperado++;
+    }
+    uint16_t mapa = 0;
+    for (uint8_t i = 0; i < 16; i++) {
+      uint8_t secuencia = esperado + 1 + i;
+      if ((uint8_t)(secuencia - _baseRx) >= _capacidad) break;
+      const RanuraFiable& ranura = _ranurasRx[secuencia % _capacidad];
+      if (ranura.ocupada && ranura.secuencia == secuencia) mapa |= (uint16_t)(1U << i);
+    }
+    uint8_t ack[TAM_ACK] = {TIPO_ACK, _sesionEmisor, esperado, (uint8_t)(mapa & 0xFF), (uint8_t)(mapa >> 8)};
+    _radio.enviar(ack, TAM_ACK);
+    _estadisticas.acksEnviados++;
+  }
+
+  /**
+   * @brief Deja de esperar los mensajes que el emisor ya ha abandonado (anteriores a su `base`).
+   */
+  void _saltarAbandonados() {
+    while (_anterior(_baseRx, _baseEmisor) && !_ranurasRx[_baseRx % _capacidad].ocupada) {
+      _baseRx++;
+      _estadisticas.mensajesSaltados++;
+    }
+  }
+
+  RanuraFiable* _siguienteRx() {
+    RanuraFiable& ranura = _ranurasRx[_baseRx % _capacidad];
+    return (ranura.ocupada && ranura.secuencia == _baseRx) ? &ranura : nullptr;
+  }
+
+  void _avanzarRx() {
+    _ranurasRx[_baseRx % _capacidad].ocupada = false;
+    _baseRx++;
+    _saltarAbandonados();
+  }
+
+  void _descartarRx() {
+    for (uint8_t i = 0; i < _capacidad; i++) _ranurasRx[i].ocupada = false;
+  }
+};
+
+/**
+ * @class RadioFiableEstatica
+ * @brief `RadioFiable` que reserva sus ventanas de envío y recepción de forma estática.
+ * @tparam VENTANA Mensajes en vuelo como máximo (1, 2, 4, 8 o 16).
+ * @tparam TAM_MENSAJE Tamaño máximo de un mensaje en bytes.
+ */
+template <uint8_t VENTANA, uint16_t TAM_MENSAJE>
+class RadioFiableEstatica : public RadioFiable {
+public:
+  explicit RadioFiableEstatica(RadioInterface& radio)
+    : RadioFiable(radio, _ranurasTxAlmacen, _datosTxAlmacen, _ranurasRxAlmacen, _datosRxAlmacen,
+                  VENTANA, TAM_MENSAJE) {}
+
+private:
+  static_assert(VENTANA == 1 || VENTANA == 2 || VENTANA == 4 || VENTANA == 8 || VENTANA == 16,
+                "VENTANA debe ser 1, 2, 4, 8 o 16");
+
+  RanuraFiable _ranurasTxAlmacen[VENTANA];               ///< Ventana de envío.
+  RanuraFiable _ranurasRxAlmacen[VENTANA];               ///< Ventana de recepción.
+  uint8_t _datosTxAlmacen[(size_t)VENTANA * TAM_MENSAJE]; ///< Mensajes sin confirmar.
+  uint8_t _datosRxAlmacen[(size_t)VENTANA * TAM_MENSAJE]; ///< Mensajes recibidos sin leer.
+};
+
+#endif // RADIO_FIABLE_H
@@ -0,0 +1,412 @@
+/**
+ * @file RadioFragmentada.h
+ * @brief Capa de fragmentación y reensamblado sobre cualquier `RadioInterface`.
+ * @details `RadioFragmentada` envía mensajes mayores que el MTU de la radio (32 bytes
+ * en NRF24L01, 255 en LoRa) dividiéndolos en fragmentos con una cabecera de 2 bytes, y
+ * los reensambla en recepción sobre un conjunto fijo de ranuras, sin memoria dinámica.
+ */
+
+#ifndef RADIO_FRAGMENTADA_H
+#define RADIO_FRAGMENTADA_H
+
+#include "RadioInterface.h"
+
+/**
+ * @struct RanuraReensamblado
+ * @brief Estado de un mensaje en reensamblado. Los datos van en la memoria de `RadioFragmentada`.
+ */
+struct RanuraReensamblado {
+  uint32_t recibidos; ///< Mapa de bits de los fragmentos recibidos (bit i = fragmento i).
+  uint32_t inicioMs;  ///< `millis()` al recibir el primer fragmento.
+  uint16_t longitud;  ///< Longitud del mensaje (conocida al llegar el último fragmento).
+  uint16_t bytes;     ///< Bytes de datos recibidos hasta ahora.
+  uint8_t id;         ///< ID de mensaje del emisor.
+  uint8_t total;      ///< Número de fragmentos (0 hasta recibir el último).
+  uint8_t estado;     ///< `RadioFragmentada::RANURA_LIBRE`, `RANURA_EN_CURSO` o `RANURA_COMPLETA`.
+};
+
+/**
+ * @struct EstadisticasFragmentacion
+ * @brief Contadores de `RadioFragmentada`.
+ * @details `fragmentosEnviados / mensajesEnviados` da los fragmentos por mensaje; los
+ * máximos indican cuánta memoria de reensamblado se ha llegado a usar.
+ */
+struct EstadisticasFragmentacion {
+  uint32_t mensajesEnviados;      ///< Mensajes enviados por completo.
+  uint32_t fragmentosEnviados;    ///< Fragmentos entregados a la radio.
+  uint32_t mensajesRecibidos;     ///< Mensajes reensamblados por completo.
+  uint32_t fragmentosRecibidos;   ///< Fragmentos leídos de la radio.
+  uint32_t mensajesCaducados;     ///< Mensajes incompletos expulsados por tiempo o por falta de ranuras.
+  uint32_t fragmentosDescartados; ///< Fragmentos inválidos, duplicados o sin ranura libre.
+  uint8_t ranurasOcupadasMax;     ///< Máximo de ranuras ocupadas a la vez.
+  uint32_t bytesReensambladoMax;  ///< Máximo de bytes de datos en reensamblado a la vez.
+};
+
+/**
+ * @class RadioFragmentada
+ * @brief Decorador de `RadioInterface` que fragmenta y reensambla mensajes.
+ * @details Cada fragmento lleva una cabecera de 2 bytes: ID de mensaje y
+ * [último:1 | reservado:2 | índice:5]. Todos los fragmentos salvo el último ocupan el
+ * MTU completo de la radio, así que el receptor calcula la posición de cada uno a partir
+ * de su índice, y un mensaje admite hasta `MAX_FRAGMENTOS` fragmentos (ej. 960 bytes con
+ * NRF24L01). Ambos extremos deben usar el mismo tipo de radio.
+ *
+ * Los fragmentos se envían con `enviar(segmentos)` de la radio (cabecera + trozo del
+ * mensaje, sin copiarlo) y en recepción se copian directamente desde la vista de
+ * `tomarPaquete()` a la ranura de su mensaje. Un mensaje incompleto se descarta pasado
+ * `fijarTiempoMaximoReensamblado()` o cuando su ranura hace falta para otro mensaje.
+ * @note Las ranuras se asocian por ID de mensaje: con varios emisores simultáneos, dos
+ * mensajes con el mismo ID pueden mezclarse. Mientras un mensaje completo no se lee, los
+ * fragmentos con su ID se descartan como duplicados. El reensamblado avanza en las llamadas a
+ * `hayDatosDisponibles()`, `leer()` y `tomarPaquete()`.
+ */
+class RadioFragmentada : public RadioInterface {
+public:
+  static const uint8_t TAM_CABECERA = 2;     ///< Bytes de cabecera por fragmento.
+  static const uint8_t MAX_FRAGMENTOS = 32;  ///< Fragmentos por mensaje (bits del mapa de recibidos).
+  static const uint8_t RANURA_LIBRE = 0;     ///< Ranura sin uso.
+  static const uint8_t RANURA_EN_CURSO = 1;  ///< Mensaje a medio reensamblar.
+  static const uint8_t RANURA_COMPLETA = 2;  ///< Mensaje completo, pendiente de leer.
+
+  // Hace visibles las sobrecargas de RadioInterface (ej. enviar(const String&)).
+  using RadioInterface::enviar;
+
+  /**
+   * @brief Constructor.
+   * @param radio Radio sobre la que se envían los fragmentos. Debe existir mientras se use este objeto.
+   * @param ranuras Array de `numRanuras` ranuras de reensamblado.
+   * @param memoria Bloque de `numRanuras * tamMensaje` bytes para los datos de los mensajes.
+   * @param numRanuras Mensajes que se pueden reensamblar a la vez (1-255).
+   * @param tamMensaje Tamaño máximo de un mensaje en bytes.
+   */
+  RadioFragmentada(RadioInterface& radio, RanuraReensamblado* ranuras, uint8_t* memoria,
+                   uint8_t numRanuras, uint16_t tamMensaje)
+    : _radio(radio),
+      _ranuras(ranuras),
+      _memoria(memoria),
+      _numRanuras(numRanuras),
+      _tamMensaje(tamMensaje),
+      _tiempoMaximoMs(3000),
+      _siguienteId(0),
+      _ranuraVista(-1),
+      _bytesOcupados(0) {
+    memset(&_estadisticas, 0, sizeof(_estadisticas));
+    for (uint8_t i = 0; i < _numRanuras; i++) {
+      _ranuras[i].estado = RANURA_LIBRE;
+      _ranuras[i].bytes = 0;
+    }
+  }
+
+  /**
+   * @brief Tiempo máximo para completar un mensaje desde su primer fragmento (3000 ms por defecto).
+   */
+  void fijarTiempoMaximoReensamblado(uint32_t milisegundos) { _tiempoMaximoMs = milisegundos; }
+
+  /**
+   * @brief Contadores de envío, recepción y uso de memoria de reensamblado.
+   */
+  const EstadisticasFragmentacion& estadisticas() const { return _estadisticas; }
+
+  // --- RadioInterface ---
+
+  bool iniciar() override { return _radio.iniciar(); }
+
+  bool enviar(const uint8_t* buffer, size_t longitud) override {
+    Segmento segmento = {buffer, longitud};
+    return enviar(&segmento, 1);
+  }
+
+  /**
+   * @brief Envía la concatenación de los segmentos como un mensaje fragmentado.
+   * @details Cada fragmento se entrega a la radio como cabecera + hasta `MAX_TROZOS`
+   * trozos de los segmentos originales, sin copiarlos.
+   * @return false si el mensaje está vacío, excede `obtenerMTU()`, o la radio rechaza un fragmento.
+   */
+  bool enviar(const Segmento* segmentos, size_t numSegmentos) override {
+    size_t carga = _cargaPorFragmento();
+    size_t total = 0;
+    for (size_t i = 0; i < numSegmentos; i++) total += segmentos[i].longitud;
+    if (carga == 0 || total == 0 || total > obtenerMTU()) return false;
+
+    uint8_t numFragmentos = (uint8_t)((total + carga - 1) / carga);
+    uint8_t id = _siguienteId++;
+    size_t segmento = 0;
+    size_t desplazamiento = 0;
+
+    for (uint8_t indice = 0; indice < numFragmentos; indice++) {
+      uint8_t cabecera[TAM_CABECERA] = {id, (uint8_t)(indice | (indice + 1 == numFragmentos ? BIT_ULTIMO : 0))};
+      Segmento partes[1 + MAX_TROZOS];
+      partes[0].datos = cabecera;
+      partes[0].longitud = TAM_CABECERA;
+      size_t numPartes = 1;
+
+      size_t restante = total - (size_t)indice * carga;
+      if (restante > carga) restante = carga;
+      while (restante > 0) {
+        size_t disponible = segmentos[segmento].longitud - desplazamiento;
+        if (disponible == 0) {
+          segmento++;
+          desplazamiento = 0;
+          continue;
+        }
+        if (numPartes == 1 + MAX_TROZOS) return false; // Demasiados segmentos pequeños en un fragmento
+        size_t trozo = (disponible < restante) ? disponible : restante;
+        partes[numPartes].datos = segmentos[segmento].datos + desplazamiento;
+        partes[numPartes].longitud = trozo;
+        numPartes++;
+        desplazamiento += trozo;
+        restante -= trozo;
+      }
+
+      if (!_radio.enviar(partes, numPartes)) return false;
+      _estadisticas.fragmentosEnviados++;
+    }
+    _estadisticas.mensajesEnviados++;
+    return true;
+  }
+
+  /**
+   * @brief Longitud del siguiente mensaje completo, o 0 si no hay ninguno.
+   */
+  int hayDatosDisponibles() override {
+    _atenderRecepcion();
+    int ranura = _ranuraCompleta();
+    return (ranura < 0) ? 0 : (int)_ranuras[ranura].longitud;
+  }
+
+  /**
+   * @brief Copia el siguiente mensaje completo. Lo que no quepa en `buffer` se descarta.
+   */
+  size_t leer(uint8_t* buffer, size_t maxLongitud) override {
+    _atenderRecepcion();
+    int ranura = _ranuraCompleta();
+    if (ranura < 0 || maxLongitud == 0) return 0;
+    size_t longitud = _ranuras[ranura].longitud;
+    if (longitud > maxLongitud) longitud = maxLongitud;
+    memcpy(buffer, _datosRanura(ranura), longitud);
+    _liberarRanura(ranura);
+    return longitud;
+  }
+
+  /**
+   * @brief Lee el siguiente mensaje completo como String, sin el límite de 255 bytes.
+   */
+  String leerComoString() override {
+    String texto;
+    _atenderRecepcion();
+    int ranura = _ranuraCompleta();
+    if (ranura < 0) return texto;
+    const uint8_t* datos = _datosRanura(ranura);
+    texto.reserve(_ranuras[ranura].longitud);
+    for (uint16_t i = 0; i < _ranuras[ranura].longitud; i++) texto += (char)datos[i];
+    _liberarRanura(ranura);
+    return texto;
+  }
+
+  /**
+   * @brief Vista del siguiente mensaje completo, directamente en su ranura de reensamblado.
+   */
+  bool tomarPaquete(VistaPaquete& vista) override {
+    if (_ranuraVista < 0) {
+      _atenderRecepcion();
+      _ranuraVista = _ranuraCompleta();
+      if (_ranuraVista < 0) return false;
+    }
+    vista.datos = _datosRanura(_ranuraVista);
+    vista.longitud = _ranuras[_ranuraVista].longitud;
+    vista.rssi = _radio.obtenerRSSI();
+    return true;
+  }
+
+  void liberarPaquete() override {
+    if (_ranuraVista < 0) return;
+    _liberarRanura(_ranuraVista);
+    _ranuraVista = -1;
+  }
+
+  int obtenerRSSI() override { return _radio.obtenerRSSI(); }
+  bool dormir() override { return _radio.dormir(); }
+  bool despertar() override { return _radio.despertar(); }
+  EstadisticasRadio obtenerEstadisticas() override { return _radio.obtenerEstadisticas(); }
+  void reiniciarEstadisticas() override { _radio.reiniciarEstadisticas(); }
+
+  /**
+   * @brief Tamaño máximo de un mensaje: `tamMensaje`, limitado a `MAX_FRAGMENTOS` fragmentos.
+   */
+  size_t obtenerMTU() override {
+    size_t maximo = (size_t)MAX_FRAGMENTOS * _cargaPorFragmento();
+    return (_tamMensaje < maximo) ? _tamMensaje : maximo;
+  }
+
+private:
+  static const uint8_t BIT_ULTIMO = 0x80;     ///< Marca del último fragmento en el segundo byte.
+  static const uint8_t MASCARA_INDICE = 0x1F; ///< Índice del fragmento en el segundo byte.
+  static const uint8_t MAX_TROZOS = 4;        ///< Trozos de segmentos por fragmento en `enviar(segmentos)`.
+
+  RadioInterface& _radio;
+  RanuraReensamblado* _ranuras;
+  uint8_t* _memoria;
+  uint8_t _numRanuras;
+  uint16_t _tamMensaje;
+  uint32_t _tiempoMaximoMs;
+  uint8_t _siguienteId;
+  int _ranuraVista;        ///< Ranura entregada con `tomarPaquete()`, -1 si ninguna.
+  uint32_t _bytesOcupados; ///< Bytes de datos en ranuras ocupadas (hasta `numRanuras * tamMensaje`).
+  EstadisticasFragmentacion _estadisticas;
+
+  size_t _cargaPorFragmento() {
+    size_t mtu = _radio.obtenerMTU();
+    return (mtu > TAM_CABECERA) ? mtu - TAM_CABECERA : 0;
+  }
+
+  uint8_t* _datosRanura(int ranura) const { return _memoria + (size_t)ranura * _tamMensaje; }
+
+  static uint32_t _mascaraCompleta(uint8_t total) {
+    return (total >= 32) ? 0xFFFFFFFFUL : ((1UL << total) - 1);
+  }
+
+  /**
+   * @brief Expulsa los mensajes caducados y procesa los fragmentos que haya en la radio.
+   */
+  void _atenderRecepcion() {
+    uint32_t ahora = millis();
+    for (uint8_t i = 0; i < _numRanuras; i++) {
+      if (_ranuras[i].estado == RANURA_EN_CURSO && ahora - _ranuras[i].inicioMs > _tiempoMaximoMs) {
+        _liberarRanura(i);
+        _estadisticas.mensajesCaducados++;
+      }
+    }
+
+    while (_radio.hayDatosDisponibles() > 0) {
+      VistaPaquete vista;
+      if (_radio.tomarPaquete(vista)) {
+        _procesarFragmento(vista.datos, vista.longitud);
+        _radio.liberarPaquete();
+      } else {
+        uint8_t fragmento[255]; // Radios sin vistas: copia intermedia en el stack
+        size_t longitud = _radio.leer(fragmento, sizeof(fragmento));
+        if (longitud == 0) break;
+        _procesarFragmento(fragmento, longitud);
+      }
+    }
+  }
+
+  void _procesarFragmento(const uint8_t* datos, size_t longitud) {
+    _estadisticas.fragmentosRecibidos++;
+    size_t cargaMaxima = _cargaPorFragmento();
+    if (longitud < TAM_CABECERA) {
+      _estadisticas.fragmentosDescartados++;
+      return;
+    }
+    uint8_t id = datos[0];
+    uint8_t indice = datos[1] & MASCARA_INDICE;
+    bool ultimo = (datos[1] & BIT_ULTIMO) != 0;
+    size_t carga = longitud - TAM_CABECERA;
+    size_t desplazamiento = (size_t)indice * cargaMaxima;
+
+    bool valido = desplazamiento + carga <= _tamMensaje && carga > 0 && (ultimo || carga == cargaMaxima);
+    int ranura = valido ? _buscarRanura(id) : -1;
+    if (valido && ranura < 0) ranura = _asignarRanura(id);
+    if (ranura < 0 || _ranuras[ranura].estado == RANURA_COMPLETA || (_ranuras[ranura].recibidos & (1UL << indice))) {
+      _estadisticas.fragmentosDescartados++; // Inválido, sin ranura o duplicado
+      return;
+    }
+
+    RanuraReensamblado& r = _ranuras[ranura];
+    memcpy(_datosRanura(ranura) + desplazamiento, datos + TAM_CABECERA, carga);
+    r.recibidos |= 1UL << indice;
+    r.bytes += carga;
+    _bytesOcupados += carga;
+    if (_bytesOcupados > _estadisticas.bytesReensambladoMax) _estadisticas.bytesReensambladoMax = _bytesOcupados;
+    if (ultimo) {
+      r.total = indice + 1;
+      r.longitud = desplazamiento + carga;
+    }
+    if (r.total > 0 && r.recibidos == _mascaraCompleta(r.total)) {
+      r.estado = RANURA_COMPLETA;
+      _estadisticas.mensajesRecibidos++;
+    }
+  }
+
+  /**
+   * @brief Ranura del mensaje con ese ID, en curso o completo sin leer.
+   * @details Un fragmento repetido de un mensaje completo cae así en su ranura y se descarta
+   * como duplicado, en lugar de empezar otra copia del mensaje.
+   */
+  int _buscarRanura(uint8_t id) const {
+    for (uint8_t i = 0; i < _numRanuras; i++) {
+      if (_ranuras[i].estado != RANURA_LIBRE && _ranuras[i].id == id) return i;
+    }
+    return -1;
+  }
+
+  /**
+   * @brief Ocupa una ranura libre o, si no hay, expulsa el mensaje en curso más antiguo.
+   * @return Índice de la ranura, o -1 si todas guardan mensajes completos sin leer.
+   */
+  int _asignarRanura(uint8_t id) {
+    int elegida = -1;
+    uint8_t ocupadas = 0;
+    for (uint8_t i = 0; i < _numRanuras; i++) {
+      if (_ranuras[i].estado != RANURA_LIBRE) {
+        ocupadas++;
+      } else if (elegida < 0) {
+        elegida = i;
+      }
+    }
+    if (elegida < 0) {
+      for (uint8_t i = 0; i < _numRanuras; i++) {
+        if (_ranuras[i].estado != RANURA_EN_CURSO) continue;
+        if (elegida < 0 || _ranuras[i].inicioMs - _ranuras[elegida].inicioMs > 0x80000000UL) elegida = i;
+      }
+      if (elegida < 0) return -1;
+      _liberarRanura(elegida);
+      _estadisticas.mensajesCaducados++;
+      ocupadas--;
+    }
+
+    RanuraReensamblado& r = _ranuras[elegida];
+    r.recibidos = 0;
+    r.inicioMs = millis();
+    r.longitud = 0;
+    r.bytes = 0;
+    r.id = id;
+    r.total = 0;
+    r.estado = RANURA_EN_CURSO;
+    ocupadas++;
+    if (ocupadas > _estadisticas.ranurasOcupadasMax) _estadisticas.ranurasOcupadasMax = ocupadas;
+    return elegida;
+  }
+
+  int _ranuraCompleta() const {
+    for (uint8_t i = 0; i < _numRanuras; i++) {
+      if (_ranuras[i].estado == RANURA_COMPLETA) return i;
+    }
+    return -1;
+  }
+
+  void _liberarRanura(int ranura) {
+    _bytesOcupados -= _ranuras[ranura].bytes;
+    _ranuras[ranura].bytes = 0;
+    _ranuras[ranura].estado = RANURA_LIBRE;
+  }
+};
+
+/**
+ * @class RadioFragmentadaEstatica
+ * @brief `RadioFragmentada` que reserva su propia memoria de reensamblado de forma estática.
+ * @tparam RANURAS Mensajes que se pueden reensamblar a la vez.
+ * @tparam TAM_MENSAJE Tamaño máximo de un mensaje en bytes.
+ */
+template <uint8_t RANURAS, uint16_t TAM_MENSAJE>
+class RadioFragmentadaEstatica : public RadioFragmentada {
+public:
+  explicit RadioFragmentadaEstatica(RadioInterface& radio)
+    : RadioFragmentada(radio, _ranurasAlmacen, _datosAlmacen, RANURAS, TAM_MENSAJE) {}
+
+private:
+  RanuraReensamblado _ranurasAlmacen[RANURAS];           ///< Estado de las ranuras.
+  uint8_t _datosAlmacen[(size_t)RANURAS * TAM_MENSAJE]; ///< Datos de los mensajes.
+};
+
+#endif // RADIO_FRAGMENTADA_H
@@ -11,6 +11,7 @@
 #define RADIO_INTERFACE_H
 
 #include <Arduino.h>
+#include "RadioBase.h"
 
 /**
  * @class RadioInterface
@@ -18,6 +19,9 @@
  * @details Define los métodos puros virtuales que toda clase de radio concreta debe implementar.
  * También proporciona implementaciones por defecto (virtuales) para funciones opcionales
  * y sobrecargas de conveniencia (ej. para Strings).
+ *
+ * Las radios de la librería se implementan como `RadioBase` (despacho estático) y se
+ * exponen como `RadioInterface` mediante `RadioAdaptador`.
  */
 class RadioInterface {
 public:
@@ -79,6 +83,14 @@ public:
    */
   virtual int obtenerRSSI() { return 0; }
 
+  /**
+   * @brief Obtiene el tamaño máximo de paquete (MTU) que admite `enviar()`.
+   * @details Implementación virtual (opcional). La usan capas superiores, como
+   * `RadioFragmentada`, para decidir cómo dividir un mensaje.
+   * @return El número máximo de bytes por paquete (255 por defecto).
+   */
+  virtual size_t obtenerMTU() { return 255; }
+
   /**
    * @brief Pone el módulo de radio en modo de bajo consumo (dormir).
    * @details Implementación virtual (opcional). Las clases derivadas deben sobreescribir
@@ -94,6 +106,43 @@ public:
    */
   virtual bool despertar() { return true; }
 
+  /**
+   * @brief Obtiene una vista del siguiente paquete recibido, sin copiarlo a un buffer del llamador.
+   * @details Implementación virtual (opcional). El radio deposita el paquete una sola vez
+   * en memoria propia y devuelve un puntero a ella. Mientras no se llame a `liberarPaquete()`,
+   * sucesivas llamadas devuelven el mismo paquete.
+   * @note No se debe mezclar con `leer()`/`leerComoString()` mientras haya una vista tomada.
+   * @param vista Estructura que se rellena con puntero, longitud y metadatos del paquete.
+   * @return true si había un paquete disponible y `vista` es válida.
+   * @return false si no hay paquete o el módulo no soporta vistas (por defecto).
+   */
+  virtual bool tomarPaquete(VistaPaquete& vista) { (void)vista; return false; }
+
+  /**
+   * @brief Libera el paquete obtenido con `tomarPaquete()`.
+   * @details Tras esta llamada, la memoria apuntada por la vista puede ser reutilizada por el radio.
+   */
+  virtual void liberarPaquete() {}
+
+  /**
+   * @brief Obtiene una copia (instantánea) de los contadores de actividad del radio.
+   * @details Implementación virtual (opcional). Permite detectar nodos que se degradan
+   * (envíos rechazados, desbordamientos, RSSI a la baja) sin depurador. Los decoradores
+   * (ej. `RadioFragmentada`) devuelven los de la radio que envuelven.
+   * @return Los contadores; todo a 0 por defecto, si el módulo no los lleva.
+   */
+  virtual EstadisticasRadio obtenerEstadisticas() {
+    EstadisticasRadio estadisticas;
+    memset(&estadisticas, 0, sizeof(estadisticas));
+    return estadisticas;
+  }
+
+  /**
+   * @brief Pone a cero los contadores de actividad del radio.
+   * @details Implementación virtual (opcional).
+   */
+  virtual void reiniciarEstadisticas() {}
+
   // --- Sobrecargas de Conveniencia (Usan los métodos puros) ---
 
   /**
@@ -109,6 +158,20 @@ public:
     return enviar(reinterpret_cast<const uint8_t*>(data.c_str()), data.length());
   }
 
+  /**
+   * @brief Envía como un único paquete la concatenación de varios segmentos.
+   * @details Implementación virtual con un comportamiento por defecto: copia los segmentos
+   * en un buffer de 255 bytes en el stack y llama a `enviar(buffer, longitud)`. Las clases
+   * derivadas la sobreescriben para volcar cada segmento directamente en el hardware.
+   * @param segmentos Array de segmentos, en el orden en que deben transmitirse.
+   * @param numSegmentos Número de elementos de `segmentos`.
+   * @return true si el envío fue exitoso.
+   * @return false en caso contrario (o si el total excede 255 bytes en la implementación por defecto).
+   */
+  virtual bool enviar(const Segmento* segmentos, size_t numSegmentos) {
+    return radioEnviarSegmentos(*this, segmentos, numSegmentos);
+  }
+
   /**
    * @brief Lee los datos disponibles del radio y los devuelve como un objeto String.
    * @details Esta es una función de conveniencia. Llama a `leer(buffer, max)` y
@@ -116,21 +179,46 @@ public:
    * @note Esta implementación usa un buffer estático de tamaño fijo (256 bytes) en el stack.
    * Se reserva 1 byte para el terminador nulo `\0`.
    * Para paquetes más grandes (> 255 bytes), se debe usar `leer()` directamente.
+   * @note Cada llamada copia el paquete y reserva memoria dinámica para el String.
+   * En recepción continua es preferible `tomarPaquete()`/`liberarPaquete()`.
    * @return Un objeto String con los datos leídos.
    * @return Un String vacío si no había datos.
    */
   virtual String leerComoString() {
-    uint8_t buffer[256]; // Buffer local en el stack
-    
-    // Se reserva 1 byte para el terminador nulo '\0'.
-    size_t longitud = leer(buffer, 255); 
-    
-    buffer[longitud] = '\0'; // Asegura terminación nula para el constructor del String
-    
-    // Convierte el buffer C a un String de Arduino
-    return String(reinterpret_cast<char*>(buffer));
+    return radioLeerComoString(*this);
   }
 
 };
 
+/**
+ * @class RadioAdaptador
+ * @brief Expone una radio de despacho estático (`RadioBase`) como `RadioInterface`.
+ * @details Cada función virtual se limita a reenviar la llamada a la implementación
+ * de `Nucleo`, que el compilador puede inlinear dentro del adaptador. Las funciones
+ * propias de cada radio (ej. `LoraNucleo::habilitarRecepcionPorInterrupcion()`) siguen
+ * accesibles a través del adaptador.
+ * @tparam Nucleo Clase concreta derivada de `RadioBase<Nucleo>`.
+ */
+template <class Nucleo>
+class RadioAdaptador : public RadioInterface, public Nucleo {
+public:
+  using Nucleo::Nucleo; // Hereda los constructores de la radio concreta
+
+  bool iniciar() override { return Nucleo::iniciar(); }
+  bool enviar(const uint8_t* buffer, size_t longitud) override { return Nucleo::enviar(buffer, longitud); }
+  bool enviar(const Segmento* segmentos, size_t numSegmentos) override { return Nucleo::enviar(segmentos, numSegmentos); }
+  bool enviar(const String& data) override { return Nucleo::enviar(data); }
+  int hayDatosDisponibles() override { return Nucleo::hayDatosDisponibles(); }
+  size_t leer(uint8_t* buffer, size_t maxLongitud) override { return Nucleo::leer(buffer, maxLongitud); }
+  String leerComoString() override { return Nucleo::leerComoString(); }
+  int obtenerRSSI() override { return Nucleo::obtenerRSSI(); }
+  size_t obtenerMTU() override { return Nucleo::obtenerMTU(); }
+  bool dormir() override { return Nucleo::dormir(); }
+  bool despertar() override { return Nucleo::despertar(); }
+  bool tomarPaquete(VistaPaquete& vista) override { return Nucleo::tomarPaquete(vista); }
+  void liberarPaquete() override { Nucleo::liberarPaquete(); }
+  EstadisticasRadio obtenerEstadisticas() override { return Nucleo::obtenerEstadisticas(); }
+  void reiniciarEstadisticas() override { Nucleo::reiniciarEstadisticas(); }
+};
+
 #endif // RADIO_INTERFACE_H
@@ -0,0 +1,297 @@
+/**
+ * @file ReedSolomon.h
+ * @brief Código Reed-Solomon sobre GF(256) con tablas generadas en tiempo de compilación.
+ * @details Las tablas de exponentes y logaritmos de GF(256) (polinomio 0x11D, generador 2)
+ * se calculan con funciones `constexpr` y se expanden con una secuencia de índices
+ * variádica, así que no hay código de inicialización: en AVR viven en flash (`PROGMEM`)
+ * y se leen con `pgm_read_byte()`. El codificador y el decodificador trabajan con
+ * "paso" (stride), lo que permite entrelazar varias palabras código en un mismo paquete
+ * sin copiarlas.
+ */
+
+#ifndef REED_SOLOMON_H
+#define REED_SOLOMON_H
+
+#include <Arduino.h>
+#include <string.h> // memcpy
+
+// --- Cálculo de las tablas en tiempo de compilación ---
+
+/**
+ * @brief Multiplica por x (por 2) en GF(256) con el polinomio primitivo 0x11D.
+ */
+constexpr uint8_t gfPorDos(uint8_t a) {
+  return (a & 0x80) ? (uint8_t)((a << 1) ^ 0x1D) : (uint8_t)(a << 1);
+}
+
+/**
+ * @brief 2^i en GF(256), para 0 <= i < 255.
+ */
+constexpr uint8_t gfExpCalculado(uint16_t i) {
+  return (i == 0) ? 1 : gfPorDos(gfExpCalculado(i - 1));
+}
+
+/**
+ * @brief Busca i tal que 2^i == v, partiendo de 2^i == x.
+ */
+constexpr uint8_t gfLogBuscar(uint8_t v, uint8_t i, uint8_t x) {
+  return (x == v || i == 254) ? i : gfLogBuscar(v, i + 1, gfPorDos(x));
+}
+
+/**
+ * @brief log2(v) en GF(256). El logaritmo de 0 no existe; se devuelve 0.
+ */
+constexpr uint8_t gfLogCalculado(uint16_t v) {
+  return (v == 0) ? 0 : gfLogBuscar((uint8_t)v, 0, 1);
+}
+
+static_assert(gfExpCalculado(8) == 0x1D, "GF(256): 2^8 debe reducirse con 0x11D");
+static_assert(gfLogCalculado(0x1D) == 8, "GF(256): log(0x1D) debe ser 8");
+
+/// Secuencia de índices 0..N-1 (equivalente a `std::integer_sequence`, no disponible en AVR).
+template <uint16_t... I>
+struct IndicesGF {};
+
+template <class A, class B>
+struct UnirIndicesGF;
+
+template <uint16_t... A, uint16_t... B>
+struct UnirIndicesGF<IndicesGF<A...>, IndicesGF<B...> > {
+  typedef IndicesGF<A..., (uint16_t)(sizeof...(A) + B)...> tipo;
+};
+
+/// Genera `IndicesGF<0, 1, ..., N-1>` con profundidad de plantilla logarítmica.
+template <uint16_t N>
+struct GenerarIndicesGF {
+  typedef typename UnirIndicesGF<typename GenerarIndicesGF<N / 2>::tipo,
+                                 typename GenerarIndicesGF<N - N / 2>::tipo>::tipo tipo;
+};
+
+template <>
+struct GenerarIndicesGF<0> {
+  typedef IndicesGF<> tipo;
+};
+
+template <>
+struct GenerarIndicesGF<1> {
+  typedef IndicesGF<0> tipo;
+};
+
+/// Tabla de exponentes: `valores[i] = 2^(i mod 255)`. Con 512 entradas, el producto no necesita `% 255`.
+template <class Indices>
+struct TablaExpGF;
+
+template <uint16_t... I>
+struct TablaExpGF<IndicesGF<I...> > {
+  static const uint8_t valores[sizeof...(I)];
+};
+
+template <uint16_t... I>
+const uint8_t TablaExpGF<IndicesGF<I...> >::valores[sizeof...(I)] PROGMEM = {gfExpCalculado(I % 255)...};
+
+/// Tabla de logaritmos: `valores[v] = log2(v)` (`valores[0]` no se usa).
+template <class Indices>
+struct TablaLogGF;
+
+template <uint16_t... I>
+struct TablaLogGF<IndicesGF<I...> > {
+  static const uint8_t valores[sizeof...(I)];
+};
+
+template <uint16_t... I>
+const uint8_t TablaLogGF<IndicesGF<I...> >::valores[sizeof...(I)] PROGMEM = {gfLogCalculado(I)...};
+
+typedef TablaExpGF<GenerarIndicesGF<512>::tipo> TablaExpGF256;
+typedef TablaLogGF<GenerarIndicesGF<256>::tipo> TablaLogGF256;
+
+// --- Aritmética en GF(256) ---
+
+inline uint8_t gfExp(uint16_t i) { return pgm_read_byte(&TablaExpGF256::valores[i]); }
+inline uint8_t gfLog(uint8_t v) { return pgm_read_byte(&TablaLogGF256::valores[v]); }
+
+inline uint8_t gfMul(uint8_t a, uint8_t b) {
+  return (a == 0 || b == 0) ? 0 : gfExp((uint16_t)gfLog(a) + gfLog(b));
+}
+
+inline uint8_t gfDiv(uint8_t a, uint8_t b) {
+  return (a == 0) ? 0 : gfExp((uint16_t)gfLog(a) + 255 - gfLog(b));
+}
+
+/**
+ * @class ReedSolomon
+ * @brief Codificador/decodificador Reed-Solomon sistemático RS(n, n - paridad) sobre GF(256).
+ * @details Corrige hasta `paridad / 2` bytes erróneos por palabra código (n <= 255 bytes).
+ * Una palabra código son `k` bytes de datos seguidos de `paridad` bytes de paridad, y cada
+ * parte se recorre con un paso (`paso`) dado, de modo que la palabra puede estar
+ * intercalada con otras en el mismo buffer.
+ */
+class ReedSolomon {
+public:
+  static const uint8_t MAX_PARIDAD = 32; ///< Bytes de paridad máximos por palabra código.
+
+  /**
+   * @brief Constructor. Calcula el polinomio generador g(x) = (x - 2^0)(x - 2^1)...(x - 2^(paridad-1)).
+   * @param paridad Bytes de paridad por palabra código (2-`MAX_PARIDAD`; fuera de rango se recorta).
+   */
+  explicit ReedSolomon(uint8_t paridad)
+    : _paridad(paridad < 2 ? 2 : (paridad > MAX_PARIDAD ? MAX_PARIDAD : paridad)) {
+    memset(_generador, 0, sizeof(_generador));
+    _generador[0] = 1;
+    for (uint8_t j = 0; j < _paridad; j++) {
+      // g(x) *= (x + 2^j); coeficientes de menor a mayor grado
+      uint8_t raiz = gfExp(j);
+      for (uint8_t i = j + 1; i > 0; i--) {
+        _generador[i] = _generador[i - 1] ^ gfMul(_generador[i], raiz);
+      }
+      _generador[0] = gfMul(_generador[0], raiz);
+    }
+  }
+
+  /**
+   * @brief Bytes de paridad por palabra código.
+   */
+  uint8_t paridad() const { return _paridad; }
+
+  /**
+   * @brief Añade un byte de datos a la paridad de una palabra código (registro LFSR).
+   * @details El registro debe empezar a cero. Tras el último byte de datos contiene la
+   * paridad a transmitir, en orden.
+   * @param registro Primer byte de paridad de la palabra código.
+   * @param paso Distancia entre bytes de paridad consecutivos de esta palabra.
+   * @param byte Byte de datos.
+   */
+  void codificarByte(uint8_t* registro, uint8_t paso, uint8_t byte) const {
+    uint8_t realimentacion = byte ^ registro[0];
+    if (realimentacion == 0) {
+      for (uint8_t j = 0; j + 1 < _paridad; j++) registro[j * paso] = registro[(j + 1) * paso];
+      registro[(_paridad - 1) * paso] = 0;
+      return;
+    }
+    uint16_t logRealimentacion = gfLog(realimentacion);
+    for (uint8_t j = 0; j + 1 < _paridad; j++) {
+      uint8_t coeficiente = _generador[_paridad - 1 - j];
+      registro[j * paso] = registro[(j + 1) * paso] ^
+                           (coeficiente ? gfExp(logRealimentacion + gfLog(coeficiente)) : 0);
+    }
+    registro[(_paridad - 1) * paso] = _generador[0] ? gfExp(logRealimentacion + gfLog(_generador[0])) : 0;
+  }
+
+  /**
+   * @brief Detecta y corrige los errores de una palabra código, en su sitio.
+   * @details Si la paridad recalculada coincide con la recibida no hace nada más; si no,
+   * síndromes, Berlekamp-Massey, búsqueda de Chien y algoritmo de Forney.
+   * @param datos Primer byte de datos de la palabra.
+   * @param longitudDatos Bytes de datos (k). `k + paridad()` no debe superar 255.
+   * @param paridad Primer byte de paridad de la palabra.
+   * @param paso Distancia entre bytes consecutivos de la palabra, en ambas partes.
+   * @return Número de bytes corregidos (0 si no había errores), o -1 si hay más errores de los corregibles.
+   */
+  int corregir(uint8_t* datos, uint8_t longitudDatos, uint8_t* paridad, uint8_t paso) const {
+    uint8_t n = longitudDatos + _paridad;
+
+    // 0. Vía rápida: si la paridad recalculada coincide con la recibida, no hay errores.
+    //    Cuesta como codificar, varias veces menos que los síndromes.
+    uint8_t recalculada[MAX_PARIDAD];
+    memset(recalculada, 0, _paridad);
+    for (uint8_t i = 0; i < longitudDatos; i++) codificarByte(recalculada, 1, datos[(size_t)i * paso]);
+    bool coincide = true;
+    for (uint8_t j = 0; j < _paridad && coincide; j++) coincide = (recalculada[j] == paridad[(size_t)j * paso]);
+    if (coincide) return 0;
+
+    // 1. Síndromes S_j = r(2^j)
+    uint8_t sindromes[MAX_PARIDAD];
+    bool hayErrores = false;
+    for (uint8_t j = 0; j < _paridad; j++) {
+      uint8_t s = 0;
+      for (uint8_t i = 0; i < n; i++) {
+        s = (s ? gfExp((uint16_t)gfLog(s) + j) : 0) ^ *_byte(datos, longitudDatos, paridad, paso, i);
+      }
+      sindromes[j] = s;
+      hayErrores |= (s != 0);
+    }
+    if (!hayErrores) return 0;
+
+    // 2. Polinomio localizador de errores Λ(x) (Berlekamp-Massey), de menor a mayor grado
+    uint8_t lambda[MAX_PARIDAD + 1];
+    uint8_t previo[MAX_PARIDAD + 1];
+    uint8_t copia[MAX_PARIDAD + 1];
+    memset(lambda, 0, sizeof(lambda));
+    memset(previo, 0, sizeof(previo));
+    lambda[0] = previo[0] = 1;
+    uint8_t grado = 0, desplazamiento = 1, discrepanciaPrevia = 1;
+    for (uint8_t r = 0; r < _paridad; r++) {
+      uint8_t discrepancia = sindromes[r];
+      for (uint8_t i = 1; i <= grado; i++) discrepancia ^= gfMul(lambda[i], sindromes[r - i]);
+      if (discrepancia == 0) {
+        desplazamiento++;
+        continue;
+      }
+      uint8_t factor = gfDiv(discrepancia, discrepanciaPrevia);
+      bool crece = 2 * grado <= r;
+      if (crece) memcpy(copia, lambda, _paridad + 1);
+      for (uint8_t i = 0; i + desplazamiento <= _paridad; i++) {
+        lambda[i + desplazamiento] ^= gfMul(factor, previo[i]);
+      }
+      if (crece) {
+        grado = r + 1 - grado;
+        memcpy(previo, copia, _paridad + 1);
+        discrepanciaPrevia = discrepancia;
+        desplazamiento = 1;
+      } else {
+        desplazamiento++;
+      }
+    }
+    if (2 * grado > _paridad) return -1;
+
+    // 3. Búsqueda de Chien: el error de grado e (byte n-1-e) es raíz de Λ(2^-e)
+    uint8_t posiciones[MAX_PARIDAD / 2];
+    uint8_t encontrados = 0;
+    for (uint8_t e = 0; e < n; e++) {
+      uint16_t logInverso = (255 - e) % 255;
+      uint8_t valor = 0;
+      for (int8_t i = grado; i >= 0; i--) {
+        valor = (valor ? gfExp((uint16_t)gfLog(valor) + logInverso) : 0) ^ lambda[i];
+      }
+      if (valor != 0) continue;
+      if (encontrados == grado) return -1;
+      posiciones[encontrados++] = e;
+    }
+    if (encontrados != grado) return -1;
+
+    // 4. Forney: e_k = X_k·Ω(X_k^-1) / Λ'(X_k^-1), con Ω(x) = S(x)·Λ(x) mod x^paridad
+    uint8_t omega[MAX_PARIDAD];
+    for (uint8_t i = 0; i < _paridad; i++) {
+      uint8_t suma = 0;
+      for (uint8_t j = 0; j <= i && j <= grado; j++) suma ^= gfMul(lambda[j], sindromes[i - j]);
+      omega[i] = suma;
+    }
+    for (uint8_t k = 0; k < encontrados; k++) {
+      uint8_t e = posiciones[k];
+      uint8_t inverso = gfExp((255 - e) % 255);
+      uint8_t inversoCuadrado = gfMul(inverso, inverso);
+
+      uint8_t numerador = 0;
+      for (int8_t i = _paridad - 1; i >= 0; i--) numerador = gfMul(numerador, inverso) ^ omega[i];
+      uint8_t denominador = 0;
+      uint8_t potencia = 1;
+      for (uint8_t i = 1; i <= grado; i += 2) {
+        denominador ^= gfMul(lambda[i], potencia);
+        potencia = gfMul(potencia, inversoCuadrado);
+      }
+      if (denominador == 0) return -1;
+
+      *_byte(datos, longitudDatos, paridad, paso, n - 1 - e) ^= gfMul(gfExp(e), gfDiv(numerador, denominador));
+    }
+    return encontrados;
+  }
+
+private:
+  uint8_t _paridad;
+  uint8_t _generador[MAX_PARIDAD + 1]; ///< g(x), de menor a mayor grado (mónico).
+
+  static uint8_t* _byte(uint8_t* datos, uint8_t longitudDatos, uint8_t* paridad, uint8_t paso, uint8_t i) {
+    return (i < longitudDatos) ? datos + (size_t)i * paso : paridad + (size_t)(i - longitudDatos) * paso;
+  }
+};
+
+#endif // REED_SOLOMON_H
@@ -0,0 +1,520 @@
+/**
+ * @file Sx127xRadio.h
+ * @brief Define las clases Sx127xNucleo y Sx127xRadio: driver LoRa nativo para SX1276/7/8.
+ * @details Alternativa a `LoraRadio` que accede directamente a los registros del SX127x
+ * por SPI, sin la librería `LoRa`:
+ * - La FIFO se lee y se escribe en ráfaga (una sola transacción SPI por paquete) en lugar
+ *   de byte a byte.
+ * - Cada instancia tiene sus propios pines CS, RST y DIO0 y su propio bus `SPIClass`, de
+ *   modo que un gateway puede manejar varios módulos desde el mismo MCU.
+ * - La recepción es por sondeo: si `LoRaConfig::irqPin` (DIO0) está conectado, basta leer
+ *   el pin para saber que no hay paquete, sin acceder al bus.
+ *
+ * Usa la misma `LoRaConfig` y los mismos ajustes por defecto que la librería `LoRa`
+ * (cabecera explícita, preámbulo de 8 símbolos, PA_BOOST), así que se comunica con nodos
+ * que usan `LoraRadio`. La recepción por interrupción y la transmisión asíncrona siguen
+ * siendo exclusivas de `LoraNucleo`.
+ */
+
+#ifndef SX127X_RADIO_H
+#define SX127X_RADIO_H
+
+#include <SPI.h>
+#include "RadioInterface.h"
+#include "LoRaConfig.h"
+#include "CicloTrabajo.h"
+
+#ifndef SX127X_RADIO_TAM_BUFFER_RX
+/// Tamaño del buffer propio usado por `Sx127xNucleo::tomarPaquete()`.
+#define SX127X_RADIO_TAM_BUFFER_RX 255
+#endif
+
+#ifndef SX127X_RADIO_FRECUENCIA_SPI
+/// Frecuencia del reloj SPI hacia el SX127x (máximo 10 MHz según la hoja de datos).
+#define SX127X_RADIO_FRECUENCIA_SPI 8000000
+#endif
+
+/**
+ * @class Sx127xNucleo
+ * @brief Implementación con despacho estático (`RadioBase`) sobre los registros del SX127x.
+ * @details El módulo queda en recepción continua tras `iniciar()`, tras cada `enviar()` y
+ * tras `despertar()`. `hayDatosDisponibles()` lee en una sola ráfaga los registros de
+ * dirección, banderas IRQ, longitud, SNR y RSSI del paquete; `leer()` vuelca la FIFO
+ * directamente en el buffer del llamador.
+ */
+class Sx127xNucleo : public RadioBase<Sx127xNucleo> {
+public:
+  // --- Registros y valores del SX127x usados por el driver (modo LoRa) ---
+  static const uint8_t REG_FIFO = 0x00;
+  static const uint8_t REG_OP_MODE = 0x01;
+  static const uint8_t REG_FRF_MSB = 0x06;
+  static const uint8_t REG_PA_CONFIG = 0x09;
+  static const uint8_t REG_OCP = 0x0B;
+  static const uint8_t REG_LNA = 0x0C;
+  static const uint8_t REG_FIFO_ADDR_PTR = 0x0D;
+  static const uint8_t REG_FIFO_TX_BASE_ADDR = 0x0E;
+  static const uint8_t REG_FIFO_RX_BASE_ADDR = 0x0F;
+  static const uint8_t REG_FIFO_RX_CURRENT_ADDR = 0x10;
+  static const uint8_t REG_IRQ_FLAGS = 0x12;
+  static const uint8_t REG_PKT_RSSI_VALUE = 0x1A;
+  static const uint8_t REG_MODEM_CONFIG_1 = 0x1D;
+  static const uint8_t REG_MODEM_CONFIG_2 = 0x1E;
+  static const uint8_t REG_PAYLOAD_LENGTH = 0x22;
+  static const uint8_t REG_MODEM_CONFIG_3 = 0x26;
+  static const uint8_t REG_DETECTION_OPTIMIZE = 0x31;
+  static const uint8_t REG_DETECTION_THRESHOLD = 0x37;
+  static const uint8_t REG_SYNC_WORD = 0x39;
+  static const uint8_t REG_DIO_MAPPING_1 = 0x40;
+  static const uint8_t REG_VERSION = 0x42;
+  static const uint8_t REG_PA_DAC = 0x4D;
+
+  static const uint8_t MODO_LORA = 0x80;
+  static const uint8_t MODO_SLEEP = 0x00;
+  static const uint8_t MODO_STDBY = 0x01;
+  static const uint8_t MODO_TX = 0x03;
+  static const uint8_t MODO_RX_CONTINUO = 0x05;
+
+  static const uint8_t IRQ_TX_DONE = 0x08;
+  static const uint8_t IRQ_CRC_ERRONEO = 0x20;
+  static const uint8_t IRQ_RX_DONE = 0x40;
+
+  static const uint8_t VERSION_SX127X = 0x12;
+
+private:
+  LoRaConfig _config;          ///< Almacena la configuración proporcionada en el constructor.
+  SPIClass& _spi;              ///< Bus SPI del módulo.
+  SPISettings _ajustesSpi;     ///< Reloj, orden de bits y modo SPI del SX127x.
+  bool _iniciada;              ///< true tras un `iniciar()` exitoso.
+  bool _durmiendo;             ///< true entre `dormir()` y `despertar()`.
+
+  uint8_t _longitudPendiente;  ///< Longitud del paquete detectado y aún no leído. 0 si no hay.
+  uint8_t _direccionPendiente; ///< Dirección en la FIFO del paquete pendiente.
+  int _rssiUltimo;             ///< RSSI del último paquete detectado, en dBm.
+
+  uint8_t _bufferRx[SX127X_RADIO_TAM_BUFFER_RX]; ///< Buffer de `tomarPaquete()`.
+  size_t _longitudVista;       ///< Longitud del paquete en `_bufferRx`. 0 si no hay vista tomada.
+
+  ContadorCicloTrabajo* _cicloTrabajo;         ///< Control de duty cycle opcional. nullptr si no se usa.
+
+  EstadisticasRadio _estadisticas;             ///< Contadores de actividad.
+
+  // --- Acceso a registros ---
+
+  uint8_t _leerRegistro(uint8_t registro) {
+    uint8_t valor;
+    _leerRegistros(registro, &valor, 1);
+    return valor;
+  }
+
+  void _escribirRegistro(uint8_t registro, uint8_t valor) {
+    _escribirRegistros(registro, &valor, 1);
+  }
+
+  /**
+   * @brief Lee `n` registros consecutivos (o `n` bytes de la FIFO) en una sola transacción.
+   */
+  void _leerRegistros(uint8_t registro, uint8_t* destino, size_t n) {
+    _spi.beginTransaction(_ajustesSpi);
+    digitalWrite(_config.csPin, LOW);
+    _spi.transfer(registro & 0x7F);
+    _spi.transfer(destino, n); // Los bytes enviados se ignoran; se sobrescriben con los leídos
+    digitalWrite(_config.csPin, HIGH);
+    _spi.endTransaction();
+  }
+
+  /**
+   * @brief Escribe `n` registros consecutivos (o `n` bytes en la FIFO) en una sola transacción.
+   */
+  void _escribirRegistros(uint8_t registro, const uint8_t* origen, size_t n) {
+    _spi.beginTransaction(_ajustesSpi);
+    digitalWrite(_config.csPin, LOW);
+    _spi.transfer(registro | 0x80);
+    for (size_t i = 0; i < n; i++) {
+      _spi.transfer(origen[i]);
+    }
+    digitalWrite(_config.csPin, HIGH);
+    _spi.endTransaction();
+  }
+
+  // --- Configuración (mismos valores que la librería `LoRa`) ---
+
+  void _fijarModo(uint8_t modo) {
+    _escribirRegistro(REG_OP_MODE, MODO_LORA | modo);
+  }
+
+  void _fijarFrecuencia(long frecuencia) {
+    uint64_t frf = ((uint64_t)frecuencia << 19) / 32000000;
+    uint8_t registros[3] = {(uint8_t)(frf >> 16), (uint8_t)(frf >> 8), (uint8_t)frf};
+    _escribirRegistros(REG_FRF_MSB, registros, sizeof(registros));
+  }
+
+  /**
+   * @brief Potencia en la salida PA_BOOST (2-20 dBm), con el límite de corriente correspondiente.
+   */
+  void _fijarPotencia(int nivel) {
+    uint8_t limiteMa;
+    if (nivel > 17) {
+      if (nivel > 20) nivel = 20;
+      nivel -= 3; // Modo de alta potencia: +3 dB por el DAC del PA
+      _escribirRegistro(REG_PA_DAC, 0x87);
+      limiteMa = 140;
+    } else {
+      if (nivel < 2) nivel = 2;
+      _escribirRegistro(REG_PA_DAC, 0x84);
+      limiteMa = 100;
+    }
+    uint8_t ajuste = (limiteMa <= 120) ? (limiteMa - 45) / 5 : (limiteMa + 30) / 10;
+    _escribirRegistro(REG_OCP, 0x20 | (ajuste & 0x1F));
+    _escribirRegistro(REG_PA_CONFIG, 0x80 | (uint8_t)(nivel - 2));
+  }
+
+  void _fijarModulacion() {
+    int sf = constrain(_config.spreadingFactor, 6, 12);
+    _escribirRegistro(REG_DETECTION_OPTIMIZE, sf == 6 ? 0xC5 : 0xC3);
+    _escribirRegistro(REG_DETECTION_THRESHOLD, sf == 6 ? 0x0C : 0x0A);
+    _escribirRegistro(REG_MODEM_CONFIG_2, (_leerRegistro(REG_MODEM_CONFIG_2) & 0x0F) | (uint8_t)(sf << 4));
+
+    static const long ANCHOS[9] = {7800, 10400, 15600, 20800, 31250, 41700, 62500, 125000, 250000};
+    uint8_t ancho = 9; // 500 kHz
+    for (uint8_t i = 0; i < 9; i++) {
+      if (_config.signalBandwidth <= ANCHOS[i]) {
+        ancho = i;
+        break;
+      }
+    }
+    int cr = constrain(_config.codingRate, 5, 8);
+    _escribirRegistro(REG_MODEM_CONFIG_1,
+                      (_leerRegistro(REG_MODEM_CONFIG_1) & 0x01) | (uint8_t)(ancho << 4) | (uint8_t)((cr - 4) << 1));
+
+    // Optimización para tasas bajas con símbolos de más de 16 ms, redondeando como la
+    // librería `LoRa` (ambos extremos deben coincidir)
+    long anchoHz = (ancho < 9) ? ANCHOS[ancho] : 500000;
+    bool tasaBaja = (1000L / (anchoHz / (1L << sf))) > 16;
+    uint8_t config3 = _leerRegistro(REG_MODEM_CONFIG_3);
+    _escribirRegistro(REG_MODEM_CONFIG_3, tasaBaja ? (config3 | 0x08) : (config3 & ~0x08));
+  }
+
+  /**
+   * @brief Deja el módulo en recepción continua con DIO0 señalando RxDone.
+   */
+  void _armarRecepcion() {
+    _escribirRegistro(REG_DIO_MAPPING_1, 0x00); // DIO0 = RxDone
+    _fijarModo(MODO_RX_CONTINUO);
+  }
+
+  /**
+   * @brief Comprueba si ha llegado un paquete desde el último `hayDatosDisponibles()`.
+   * @details Lee REG_IRQ_FLAGS. Un paquete con CRC erróneo se descarta aquí, para que no
+   * bloquee las transmisiones de un nodo que no lee.
+   * @return true si hay un paquete válido en la FIFO.
+   */
+  bool _paqueteSinDetectar() {
+    uint8_t banderas = _leerRegistro(REG_IRQ_FLAGS);
+    if (!(banderas & IRQ_RX_DONE)) return false;
+    if (!(banderas & IRQ_CRC_ERRONEO)) return true;
+    _escribirRegistro(REG_IRQ_FLAGS, banderas);
+    _estadisticas.tramasErroneas++;
+    return false;
+  }
+
+  /**
+   * @brief Contabiliza un `enviar()` rechazado.
+   * @param ocupada true si el motivo es la radio ocupada.
+   * @return false, para usarlo directamente en el `return` de `enviar()`.
+   */
+  bool _rechazarEnvio(bool ocupada) {
+    _estadisticas.enviosFallidos++;
+    if (ocupada) _estadisticas.rechazosOcupada++;
+    return false;
+  }
+
+public:
+  /**
+   * @brief Constructor de la clase Sx127xNucleo.
+   * @param config Estructura `LoRaConfig` con todos los parámetros de inicialización.
+   * `resetPin` e `irqPin` pueden ser -1 si no están conectados.
+   * @param spi Bus SPI del módulo (por defecto `SPI`).
+   */
+  Sx127xNucleo(const LoRaConfig& config, SPIClass& spi = SPI)
+    : _config(config),
+      _spi(spi),
+      _ajustesSpi(SX127X_RADIO_FRECUENCIA_SPI, MSBFIRST, SPI_MODE0),
+      _iniciada(false),
+      _durmiendo(false),
+      _longitudPendiente(0),
+      _direccionPendiente(0),
+      _rssiUltimo(0),
+      _longitudVista(0),
+      _cicloTrabajo(nullptr) {
+    memset(&_estadisticas, 0, sizeof(_estadisticas));
+  }
+
+  /**
+   * @brief Limita las transmisiones a un presupuesto de ciclo de trabajo (opcional).
+   * @details Igual que `LoraNucleo::limitarCicloTrabajo()`.
+   * @param contador Contador de ciclo de trabajo. Debe existir mientras la radio esté en uso.
+   */
+  void limitarCicloTrabajo(ContadorCicloTrabajo& contador) {
+    _cicloTrabajo = &contador;
+  }
+
+  /**
+   * @brief Tiempo en el aire de una trama de `longitud` bytes con la configuración actual, en µs.
+   */
+  uint32_t tiempoEnAireUs(size_t longitud) const {
+    return tiempoEnAireLoRaUs(_config, longitud);
+  }
+
+  /**
+   * @brief Inicializa el módulo: reset, comprobación de versión y configuración completa.
+   * @return true si el módulo respondió como SX127x, false en caso contrario.
+   */
+  bool iniciar() {
+    URWSN_TRAZAR(TRAZA_INICIAR);
+    pinMode(_config.csPin, OUTPUT);
+    digitalWrite(_config.csPin, HIGH);
+    if (_config.irqPin >= 0) pinMode(_config.irqPin, INPUT);
+    if (_config.resetPin >= 0) {
+      pinMode(_config.resetPin, OUTPUT);
+      digitalWrite(_config.resetPin, LOW);
+      delay(10);
+      digitalWrite(_config.resetPin, HIGH);
+      delay(10);
+    }
+    _spi.begin();
+
+    if (_leerRegistro(REG_VERSION) != VERSION_SX127X) return false;
+
+    _fijarModo(MODO_SLEEP); // El modo LoRa solo se puede activar en Sleep
+    _fijarFrecuencia(_config.frequency);
+    uint8_t basesFifo[2] = {0, 0}; // TX y RX usan toda la FIFO de 256 bytes
+    _escribirRegistros(REG_FIFO_TX_BASE_ADDR, basesFifo, sizeof(basesFifo));
+    _escribirRegistro(REG_LNA, _leerRegistro(REG_LNA) | 0x03); // LNA boost
+    _escribirRegistro(REG_MODEM_CONFIG_3, 0x04);               // AGC automático
+    _fijarPotencia(_config.txPower);
+    _fijarModulacion();
+    _escribirRegistro(REG_SYNC_WORD, (uint8_t)_config.syncWord);
+
+    _iniciada = true;
+    _durmiendo = false;
+    _longitudPendiente = 0;
+    _armarRecepcion();
+    return true;
+  }
+
+  // Hace visibles las sobrecargas de RadioBase (ej. enviar(const String&)).
+  using RadioBase<Sx127xNucleo>::enviar;
+
+  /**
+   * @brief Transmite los datos como un paquete LoRa.
+   * @details Equivale a `enviar()` con un único `Segmento`.
+   */
+  bool enviar(const uint8_t* buffer, size_t longitud) {
+    Segmento segmento = { buffer, longitud };
+    return enviar(&segmento, 1);
+  }
+
+  /**
+   * @brief Transmite la concatenación de varios segmentos como un único paquete LoRa.
+   * @details Escribe cada segmento en la FIFO con una ráfaga SPI, lanza la transmisión y
+   * espera a TxDone (con un margen del doble del tiempo en el aire). Al terminar, el
+   * módulo vuelve a recepción continua.
+   * @return true si la trama se transmitió.
+   * @return false si hay un paquete recibido sin leer, aunque aún no se haya detectado con
+   * `hayDatosDisponibles()` (la transmisión lo sobrescribiría en la FIFO; se cuenta como
+   * radio ocupada y el paquete sigue disponible para `leer()`), si la trama excede
+   * 255 bytes o el presupuesto de ciclo de trabajo, o si TxDone no llega a tiempo.
+   */
+  bool enviar(const Segmento* segmentos, size_t numSegmentos) {
+    URWSN_TRAZAR(TRAZA_ENVIAR);
+    size_t longitud = 0;
+    for (size_t i = 0; i < numSegmentos; i++) longitud += segmentos[i].longitud;
+
+    if (!_iniciada || longitud > 255) return _rechazarEnvio(false);
+    if (_longitudPendiente > 0 || _paqueteSinDetectar()) return _rechazarEnvio(true); // TX y RX comparten la FIFO
+    if (_cicloTrabajo && !_cicloTrabajo->consumir(tiempoEnAireUs(longitud))) {
+      return _rechazarEnvio(false); // Excede el presupuesto de ciclo de trabajo
+    }
+
+    _fijarModo(MODO_STDBY);
+    _escribirRegistro(REG_FIFO_ADDR_PTR, 0);
+    for (size_t i = 0; i < numSegmentos; i++) {
+      _escribirRegistros(REG_FIFO, segmentos[i].datos, segmentos[i].longitud);
+    }
+    _escribirRegistro(REG_PAYLOAD_LENGTH, (uint8_t)longitud);
+    _escribirRegistro(REG_DIO_MAPPING_1, 0x40); // DIO0 = TxDone
+    _fijarModo(MODO_TX);
+
+    unsigned long limiteMs = 2 * tiempoEnAireUs(longitud) / 1000 + 100;
+    unsigned long inicio = millis();
+    bool terminada = false;
+    while (millis() - inicio < limiteMs) {
+      if ((_config.irqPin < 0 || digitalRead(_config.irqPin) == HIGH) &&
+          (_leerRegistro(REG_IRQ_FLAGS) & IRQ_TX_DONE)) {
+        terminada = true;
+        break;
+      }
+      yield();
+    }
+    _escribirRegistro(REG_IRQ_FLAGS, 0xFF); // Limpia todas las banderas
+    _armarRecepcion();
+
+    if (!terminada) {
+      // El módulo estuvo en TX: la trama pudo salir al aire, así que su tiempo no se devuelve
+      _estadisticas.tramasNoEntregadas++;
+      return _rechazarEnvio(false);
+    }
+    _durmiendo = false;
+    _estadisticas.registrarEnvio(true, longitud);
+    return true;
+  }
+
+  /**
+   * @brief Comprueba si se ha recibido un paquete completo.
+   * @details Si DIO0 está conectado y en nivel bajo, retorna 0 sin acceder al bus. Si no,
+   * lee en una sola ráfaga los registros 0x10-0x1A (dirección, banderas, longitud, SNR y
+   * RSSI del paquete). Los paquetes con CRC erróneo se descartan.
+   * @return El tamaño del paquete recibido en bytes, o 0 si no hay paquete disponible.
+   */
+  int hayDatosDisponibles() {
+    URWSN_TRAZAR(TRAZA_HAY_DATOS);
+    if (_longitudPendiente > 0) return _longitudPendiente;
+    if (!_iniciada || _durmiendo) return 0;
+    if (_config.irqPin >= 0 && digitalRead(_config.irqPin) == LOW) return 0;
+
+    // [0] RX current addr, [2] IRQ flags, [3] RX nb bytes, [10] packet RSSI
+    uint8_t estado[REG_PKT_RSSI_VALUE - REG_FIFO_RX_CURRENT_ADDR + 1];
+    _leerRegistros(REG_FIFO_RX_CURRENT_ADDR, estado, sizeof(estado));
+    uint8_t banderas = estado[REG_IRQ_FLAGS - REG_FIFO_RX_CURRENT_ADDR];
+    if (!(banderas & IRQ_RX_DONE)) return 0;
+    _escribirRegistro(REG_IRQ_FLAGS, banderas);
+
+    if (banderas & IRQ_CRC_ERRONEO) {
+      _estadisticas.tramasErroneas++;
+      return 0;
+    }
+    _direccionPendiente = estado[0];
+    _longitudPendiente = estado[3];
+    int desplazamiento = (_config.frequency < 525E6) ? 164 : 157; // Puerto LF o HF
+    _rssiUltimo = (int)estado[REG_PKT_RSSI_VALUE - REG_FIFO_RX_CURRENT_ADDR] - desplazamiento;
+    return _longitudPendiente;
+  }
+
+  /**
+   * @brief Lee el paquete recibido con una única ráfaga SPI sobre la FIFO.
+   * @details Si `hayDatosDisponibles()` no se llamó antes, lo llama. Los bytes que no
+   * caben en `buffer` se descartan.
+   * @return El número de bytes copiados en `buffer`, o 0 si no había paquete.
+   */
+  size_t leer(uint8_t* buffer, size_t maxLongitud) {
+    URWSN_TRAZAR(TRAZA_LEER);
+    if (hayDatosDisponibles() <= 0) return 0;
+    size_t bytesLeidos = (_longitudPendiente < maxLongitud) ? _longitudPendiente : maxLongitud;
+    _escribirRegistro(REG_FIFO_ADDR_PTR, _direccionPendiente);
+    _leerRegistros(REG_FIFO, buffer, bytesLeidos);
+
+    _estadisticas.registrarRecepcion(bytesLeidos);
+    _estadisticas.registrarRSSI(_rssiUltimo);
+    if (bytesLeidos < _longitudPendiente) _estadisticas.lecturasTruncadas++;
+    _longitudPendiente = 0;
+    return bytesLeidos;
+  }
+
+  /**
+   * @brief Obtiene una vista del siguiente paquete.
+   * @details El paquete se lee una sola vez de la FIFO al buffer interno de
+   * `SX127X_RADIO_TAM_BUFFER_RX` bytes.
+   * @return true si había un paquete disponible.
+   */
+  bool tomarPaquete(VistaPaquete& vista) {
+    URWSN_TRAZAR(TRAZA_TOMAR_PAQUETE);
+    if (_longitudVista == 0) {
+      _longitudVista = leer(_bufferRx, sizeof(_bufferRx));
+      if (_longitudVista == 0) return false;
+    }
+    vista.datos = _bufferRx;
+    vista.longitud = _longitudVista;
+    vista.rssi = _rssiUltimo;
+    return true;
+  }
+
+  /**
+   * @brief Libera el paquete obtenido con `tomarPaquete()`.
+   */
+  void liberarPaquete() {
+    _longitudVista = 0;
+  }
+
+  /**
+   * @brief RSSI del último paquete recibido, en dBm.
+   */
+  int obtenerRSSI() {
+    return _rssiUltimo;
+  }
+
+  /**
+   * @brief Copia de los contadores de actividad.
+   */
+  EstadisticasRadio obtenerEstadisticas() {
+    return _estadisticas;
+  }
+
+  /**
+   * @brief Pone a cero los contadores de actividad.
+   */
+  void reiniciarEstadisticas() {
+    memset(&_estadisticas, 0, sizeof(_estadisticas));
+  }
+
+  /**
+   * @brief Tamaño máximo de un paquete LoRa (FIFO del SX127x): 255 bytes.
+   */
+  size_t obtenerMTU() {
+    return 255;
+  }
+
+  /**
+   * @brief Pone el módulo en modo Sleep. Un paquete recibido y no leído se pierde.
+   * @return true siempre.
+   */
+  bool dormir() {
+    URWSN_TRAZAR(TRAZA_DORMIR);
+    if (!_iniciada) return true;
+    _fijarModo(MODO_SLEEP);
+    _escribirRegistro(REG_IRQ_FLAGS, 0xFF); // Un RxDone pendiente bloquearía el próximo enviar()
+    _durmiendo = true;
+    _longitudPendiente = 0;
+    return true;
+  }
+
+  /**
+   * @brief Sale del modo Sleep y vuelve a recepción continua.
+   * @return true siempre.
+   */
+  bool despertar() {
+    URWSN_TRAZAR(TRAZA_DESPERTAR);
+    if (!_iniciada) return true;
+    _fijarModo(MODO_STDBY);
+    _armarRecepcion();
+    _durmiendo = false;
+    return true;
+  }
+};
+
+/**
+ * @class Sx127xRadio
+ * @brief Implementación de RadioInterface sobre el driver nativo del SX127x.
+ * @details Adaptador polimórfico sobre `Sx127xNucleo`. Se pueden crear varias instancias,
+ * una por módulo, con distintos pines CS/RST/DIO0 o distintos buses SPI.
+ */
+class Sx127xRadio : public RadioAdaptador<Sx127xNucleo> {
+public:
+  /**
+   * @brief Constructor de la clase Sx127xRadio.
+   * @param config Estructura `LoRaConfig` con todos los parámetros de inicialización.
+   * @param spi Bus SPI del módulo (por defecto `SPI`).
+   */
+  Sx127xRadio(const LoRaConfig& config, SPIClass& spi = SPI) : RadioAdaptador<Sx127xNucleo>(config, spi) {}
+};
+
+#endif // SX127X_RADIO_H
@@ -0,0 +1,77 @@
+/**
+ * @file TiempoEnAire.h
+ * @brief Cálculo en tiempo de compilación del tiempo en el aire (time-on-air) de un paquete LoRa.
+ * @details Implementa la fórmula del datasheet del SX127x (sección 4.1.1.7) como funciones
+ * `constexpr`: con parámetros constantes, el resultado se calcula al compilar y no
+ * ocupa flash ni ciclos; con parámetros variables funciona como una función normal.
+ */
+
+#ifndef TIEMPO_EN_AIRE_H
+#define TIEMPO_EN_AIRE_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Indica si el módulo activa "Low Data Rate Optimize" para este SF y ancho de banda.
+ * @details Reproduce la comprobación entera de la librería LoRa (`setLdoFlag()`): duración
+ * del símbolo en ms, truncada, mayor que 16. Con SF11 a 125 kHz el símbolo dura 16.38 ms,
+ * que se trunca a 16: la librería no activa LDRO y el tiempo en el aire debe calcularse sin él.
+ */
+constexpr bool loraOptimizacionBajaTasa(uint8_t spreadingFactor, uint32_t anchoBanda) {
+  return 1000UL / (anchoBanda / (1UL << spreadingFactor)) > 16;
+}
+
+static_assert(!loraOptimizacionBajaTasa(11, 125000), "SF11/125 kHz: la librería LoRa no activa LDRO");
+static_assert(loraOptimizacionBajaTasa(12, 125000), "SF12/125 kHz: LDRO activo");
+
+/**
+ * @brief División entera redondeando hacia arriba, 0 si el numerador no es positivo.
+ */
+constexpr int32_t loraDivisionTecho(int32_t numerador, int32_t denominador) {
+  return (numerador <= 0) ? 0 : (numerador + denominador - 1) / denominador;
+}
+
+/**
+ * @brief Número de símbolos del payload (incluida la cabecera), según el datasheet.
+ * @param longitud Bytes de payload.
+ * @param spreadingFactor SF (6-12).
+ * @param codingRate Denominador de la tasa de codificación (5-8, para 4/5 a 4/8).
+ * @param crc true si el CRC del payload está activado.
+ * @param cabeceraImplicita true en modo de cabecera implícita.
+ * @param bajaTasa true si "Low Data Rate Optimize" está activo.
+ */
+constexpr uint32_t loraSimbolosPayload(size_t longitud, uint8_t spreadingFactor, uint8_t codingRate,
+                                       bool crc, bool cabeceraImplicita, bool bajaTasa) {
+  return 8 + (uint32_t)loraDivisionTecho(
+                 8 * (int32_t)longitud - 4 * spreadingFactor + 28 + (crc ? 16 : 0) - (cabeceraImplicita ? 20 : 0),
+                 4 * (spreadingFactor - (bajaTasa ? 2 : 0))) * codingRate;
+}
+
+/**
+ * @brief Tiempo en el aire de un paquete LoRa, en microsegundos.
+ * @details Los valores por defecto de los parámetros opcionales coinciden con la
+ * configuración que usa `LoraRadio` (librería LoRa): preámbulo de 8 símbolos,
+ * cabecera explícita y CRC desactivado.
+ * @code
+ * static_assert(tiempoEnAireLoRaUs(7, 125000, 5, 12) == 41216, "SF7, 12 bytes");
+ * @endcode
+ * @param spreadingFactor SF (6-12).
+ * @param anchoBanda Ancho de banda en Hz (ej. 125000).
+ * @param codingRate Denominador de la tasa de codificación (5-8).
+ * @param longitud Bytes de payload.
+ * @param preambulo Longitud del preámbulo en símbolos.
+ * @param crc true si el CRC del payload está activado.
+ * @param cabeceraImplicita true en modo de cabecera implícita.
+ * @return Duración de la transmisión en microsegundos.
+ */
+constexpr uint32_t tiempoEnAireLoRaUs(uint8_t spreadingFactor, uint32_t anchoBanda, uint8_t codingRate,
+                                      size_t longitud, uint16_t preambulo = 8,
+                                      bool crc = false, bool cabeceraImplicita = false) {
+  // Se trabaja en cuartos de símbolo para representar exactamente los 4.25 símbolos de sincronía.
+  return (uint32_t)(((4ULL * preambulo + 17ULL +
+                      4ULL * loraSimbolosPayload(longitud, spreadingFactor, codingRate, crc, cabeceraImplicita,
+                                                 loraOptimizacionBajaTasa(spreadingFactor, anchoBanda))) *
+                     (1ULL << spreadingFactor) * 1000000ULL) / (4ULL * anchoBanda));
+}
+
+#endif // TIEMPO_EN_AIRE_H
@@ -0,0 +1,180 @@
+/**
+ * @file TramaSlip.h
+ * @brief Delimitación de tramas SLIP (RFC 1055) para enlaces serie sin límites de paquete.
+ * @details `escribirTramaSlip()` codifica una trama a medida que la escribe en un `Print`,
+ * y `DecodificadorSlip` la reconstruye byte a byte con coste constante, sin memoria
+ * dinámica. Cada trama va entre dos bytes END (0xC0); los bytes END y ESC (0xDB) del
+ * contenido se sustituyen por ESC+0xDC y ESC+0xDD.
+ */
+
+#ifndef TRAMA_SLIP_H
+#define TRAMA_SLIP_H
+
+#include <Arduino.h>
+#include "RadioBase.h"
+
+static const uint8_t SLIP_END = 0xC0;     ///< Delimitador de trama.
+static const uint8_t SLIP_ESC = 0xDB;     ///< Prefijo de byte escapado.
+static const uint8_t SLIP_ESC_END = 0xDC; ///< ESC + ESC_END representa un 0xC0 del contenido.
+static const uint8_t SLIP_ESC_ESC = 0xDD; ///< ESC + ESC_ESC representa un 0xDB del contenido.
+
+/**
+ * @class DecodificadorSlip
+ * @brief Decodificador SLIP incremental sobre memoria proporcionada por el llamador.
+ * @details Se le entregan bytes uno a uno con `procesar()`. Cuando devuelve true, la trama
+ * completa está en `trama()` y permanece ahí hasta `liberar()`. Las tramas vacías
+ * (END consecutivos) se ignoran; las que no caben o tienen un escape inválido se
+ * descartan hasta el siguiente END.
+ */
+class DecodificadorSlip {
+public:
+  /**
+   * @brief Constructor.
+   * @param buffer Memoria para el contenido de la trama ya decodificado.
+   * @param capacidad Tamaño de `buffer` en bytes (longitud máxima de trama).
+   */
+  DecodificadorSlip(uint8_t* buffer, uint16_t capacidad)
+    : _buffer(buffer),
+      _capacidad(capacidad),
+      _longitud(0),
+      _escape(false),
+      _descartando(false),
+      _completa(false),
+      _errores(0) {}
+
+  /**
+   * @brief Procesa un byte recibido.
+   * @param byte Byte leído del `Stream`.
+   * @return true si con este byte se completó una trama no vacía (ver `trama()`).
+   */
+  bool procesar(uint8_t byte) {
+    if (_completa) return true; // Hay que llamar antes a liberar()
+
+    if (byte == SLIP_END) {
+      bool hayTrama = !_descartando && !_escape && _longitud > 0;
+      if (!hayTrama) {
+        _reiniciar();
+        return false;
+      }
+      _completa = true;
+      return true;
+    }
+    if (_descartando) return false;
+
+    if (_escape) {
+      _escape = false;
+      if (byte == SLIP_ESC_END) {
+        byte = SLIP_END;
+      } else if (byte == SLIP_ESC_ESC) {
+        byte = SLIP_ESC;
+      } else {
+        _descartar(); // Secuencia de escape inválida
+        return false;
+      }
+    } else if (byte == SLIP_ESC) {
+      _escape = true;
+      return false;
+    }
+
+    if (_longitud >= _capacidad) {
+      _descartar(); // La trama no cabe en el buffer
+      return false;
+    }
+    _buffer[_longitud++] = byte;
+    return false;
+  }
+
+  /**
+   * @brief Indica si hay una trama completa pendiente de `liberar()`.
+   */
+  bool completa() const { return _completa; }
+
+  /**
+   * @brief Contenido de la trama completa.
+   */
+  const uint8_t* trama() const { return _buffer; }
+
+  /**
+   * @brief Longitud de la trama completa.
+   */
+  uint16_t longitud() const { return _longitud; }
+
+  /**
+   * @brief Descarta la trama completa y prepara el decodificador para la siguiente.
+   */
+  void liberar() { _reiniciar(); }
+
+  /**
+   * @brief Tramas descartadas por exceder la capacidad o por un escape inválido.
+   */
+  uint32_t errores() const { return _errores; }
+
+private:
+  uint8_t* _buffer;
+  uint16_t _capacidad;
+  uint16_t _longitud;
+  bool _escape;
+  bool _descartando;
+  bool _completa;
+  uint32_t _errores;
+
+  void _reiniciar() {
+    _longitud = 0;
+    _escape = false;
+    _descartando = false;
+    _completa = false;
+  }
+
+  void _descartar() {
+    _errores++;
+    _longitud = 0;
+    _descartando = true;
+  }
+};
+
+/**
+ * @brief Escribe los segmentos como una sola trama SLIP: END, contenido escapado y END.
+ * @details Los tramos sin bytes especiales se escriben de una vez con `write(buffer, longitud)`,
+ * de modo que un contenido sin 0xC0/0xDB cuesta tres llamadas al `Print` por segmento.
+ * El END inicial descarta cualquier ruido que hubiera en la línea antes de la trama.
+ * @param destino `Stream` o `EscritorMemoria` donde se escribe la trama.
+ * @param segmentos Contenido de la trama, en orden.
+ * @param numSegmentos Número de elementos de `segmentos`.
+ * @return Número de bytes escritos en `destino` (incluidos delimitadores y escapes).
+ */
+inline size_t escribirTramaSlip(Print& destino, const Segmento* segmentos, size_t numSegmentos) {
+  static const uint8_t escapeEnd[2] = {SLIP_ESC, SLIP_ESC_END};
+  static const uint8_t escapeEsc[2] = {SLIP_ESC, SLIP_ESC_ESC};
+
+  size_t escritos = destino.write(SLIP_END);
+  for (size_t s = 0; s < numSegmentos; s++) {
+    const uint8_t* datos = segmentos[s].datos;
+    size_t inicioTramo = 0;
+    for (size_t i = 0; i < segmentos[s].longitud; i++) {
+      if (datos[i] != SLIP_END && datos[i] != SLIP_ESC) continue;
+      escritos += destino.write(datos + inicioTramo, i - inicioTramo);
+      escritos += destino.write(datos[i] == SLIP_END ? escapeEnd : escapeEsc, 2);
+      inicioTramo = i + 1;
+    }
+    escritos += destino.write(datos + inicioTramo, segmentos[s].longitud - inicioTramo);
+  }
+  escritos += destino.write(SLIP_END);
+  return escritos;
+}
+
+/**
+ * @brief Bytes que ocupa la trama SLIP de los segmentos (lo que `escribirTramaSlip()` debe escribir).
+ * @details Permite detectar escrituras cortas comparándolo con el resultado de `escribirTramaSlip()`.
+ */
+inline size_t longitudTramaSlip(const Segmento* segmentos, size_t numSegmentos) {
+  size_t longitud = 2; // END inicial y final
+  for (size_t s = 0; s < numSegmentos; s++) {
+    longitud += segmentos[s].longitud;
+    for (size_t i = 0; i < segmentos[s].longitud; i++) {
+      if (segmentos[s].datos[i] == SLIP_END || segmentos[s].datos[i] == SLIP_ESC) longitud++;
+    }
+  }
+  return longitud;
+}
+
+#endif // TRAMA_SLIP_H
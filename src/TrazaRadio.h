@@ -0,0 +1,172 @@
+/**
+ * @file TrazaRadio.h
+ * @brief Traza opcional de latencias de las operaciones de radio, en un anillo en RAM.
+ * @details Con `#define URWSN_TRAZA` (antes de incluir la librería), cada operación de
+ * las radios (`iniciar`, `enviar`, `hayDatosDisponibles`, `leer`, `tomarPaquete`, `dormir`,
+ * `despertar`) registra un evento de inicio y otro de fin con su instante. El anillo
+ * guarda los últimos `URWSN_TRAZA_EVENTOS` eventos y se vuelca en binario con
+ * `TrazaRadio::volcar(Serial)`; `extras/traza/decodificar_traza.cpp` lo convierte en
+ * histogramas de latencia por operación en el host.
+ *
+ * Sin `URWSN_TRAZA`, `URWSN_TRAZAR()` no genera código y el anillo no existe.
+ *
+ * Formato del volcado (little endian):
+ * - Cabecera de 12 bytes: "URT", versión (1), tics por µs (uint16), número de eventos
+ *   (uint16) y eventos sobrescritos antes del volcado (uint32).
+ * - Eventos de 5 bytes, del más antiguo al más reciente: instante en tics (uint32) y
+ *   código (uint8): operación (`OperacionTraza`) | `TRAZA_FIN` en los eventos de fin.
+ */
+
+#ifndef TRAZA_RADIO_H
+#define TRAZA_RADIO_H
+
+#include <Arduino.h>
+
+/**
+ * @enum OperacionTraza
+ * @brief Operaciones de radio que se registran en la traza.
+ */
+enum OperacionTraza {
+  TRAZA_INICIAR = 0,
+  TRAZA_ENVIAR = 1,
+  TRAZA_HAY_DATOS = 2,
+  TRAZA_LEER = 3,
+  TRAZA_TOMAR_PAQUETE = 4,
+  TRAZA_DORMIR = 5,
+  TRAZA_DESPERTAR = 6
+};
+
+static const uint8_t TRAZA_FIN = 0x80; ///< Bit de evento de fin en el código del evento.
+
+#ifdef URWSN_TRAZA
+
+#ifndef URWSN_TRAZA_EVENTOS
+/// Eventos que guarda el anillo (5 bytes cada uno en AVR).
+#define URWSN_TRAZA_EVENTOS 64
+#endif
+
+#ifndef URWSN_TRAZA_RELOJ
+#if defined(ESP32) || defined(ESP8266)
+/// Reloj de la traza: contador de ciclos de la CPU.
+#define URWSN_TRAZA_RELOJ() ESP.getCycleCount()
+#define URWSN_TRAZA_TICS_POR_US ESP.getCpuFreqMHz()
+#else
+/// Reloj de la traza. Se puede redefinir (junto con `URWSN_TRAZA_TICS_POR_US`) para usar
+/// un contador de ciclos, ej. `DWT->CYCCNT` en Cortex-M3/M4.
+#define URWSN_TRAZA_RELOJ() micros()
+#endif
+#endif
+
+#ifndef URWSN_TRAZA_TICS_POR_US
+#define URWSN_TRAZA_TICS_POR_US 1
+#endif
+
+/**
+ * @struct EventoTraza
+ * @brief Evento de la traza: instante y código (operación | `TRAZA_FIN`).
+ */
+struct EventoTraza {
+  uint32_t tics;
+  uint8_t codigo;
+};
+
+/**
+ * @class TrazaRadio
+ * @brief Anillo global de eventos de traza. Cuando se llena, sobrescribe los más antiguos.
+ * @note No se registra desde interrupciones: las operaciones trazadas son las del bucle principal.
+ */
+class TrazaRadio {
+public:
+  /**
+   * @brief Añade un evento con el instante actual.
+   */
+  static void registrar(uint8_t codigo) {
+    uint32_t tics = URWSN_TRAZA_RELOJ();
+    Anillo& anillo = _anillo();
+    anillo.eventos[anillo.siguiente].tics = tics;
+    anillo.eventos[anillo.siguiente].codigo = codigo;
+    if (++anillo.siguiente == URWSN_TRAZA_EVENTOS) anillo.siguiente = 0;
+    if (anillo.total < URWSN_TRAZA_EVENTOS) {
+      anillo.total++;
+    } else {
+      anillo.sobrescritos++;
+    }
+  }
+
+  /**
+   * @brief Escribe el contenido del anillo en binario (ver el formato en `TrazaRadio.h`) y lo vacía.
+   * @param destino Normalmente `Serial`.
+   */
+  static void volcar(Print& destino) {
+    Anillo& anillo = _anillo();
+    uint16_t ticsPorUs = (uint16_t)(URWSN_TRAZA_TICS_POR_US);
+    uint8_t cabecera[12] = {'U', 'R', 'T', 1,
+                            (uint8_t)ticsPorUs, (uint8_t)(ticsPorUs >> 8),
+                            (uint8_t)anillo.total, (uint8_t)(anillo.total >> 8),
+                            (uint8_t)anillo.sobrescritos, (uint8_t)(anillo.sobrescritos >> 8),
+                            (uint8_t)(anillo.sobrescritos >> 16), (uint8_t)(anillo.sobrescritos >> 24)};
+    destino.write(cabecera, sizeof(cabecera));
+
+    uint16_t posicion = (anillo.siguiente + URWSN_TRAZA_EVENTOS - anillo.total) % URWSN_TRAZA_EVENTOS;
+    for (uint16_t i = 0; i < anillo.total; i++) {
+      const EventoTraza& evento = anillo.eventos[posicion];
+      uint8_t bytes[5] = {(uint8_t)evento.tics, (uint8_t)(evento.tics >> 8),
+                          (uint8_t)(evento.tics >> 16), (uint8_t)(evento.tics >> 24), evento.codigo};
+      destino.write(bytes, sizeof(bytes));
+      if (++posicion == URWSN_TRAZA_EVENTOS) posicion = 0;
+    }
+    reiniciar();
+  }
+
+  /**
+   * @brief Vacía el anillo.
+   */
+  static void reiniciar() {
+    Anillo& anillo = _anillo();
+    anillo.siguiente = 0;
+    anillo.total = 0;
+    anillo.sobrescritos = 0;
+  }
+
+  /**
+   * @brief Eventos guardados en el anillo.
+   */
+  static uint16_t eventos() { return _anillo().total; }
+
+private:
+  struct Anillo {
+    EventoTraza eventos[URWSN_TRAZA_EVENTOS];
+    uint16_t siguiente;
+    uint16_t total;
+    uint32_t sobrescritos;
+  };
+
+  static Anillo& _anillo() {
+    static Anillo anillo; // Inicializado a cero (almacenamiento estático)
+    return anillo;
+  }
+};
+
+/**
+ * @class AmbitoTraza
+ * @brief Registra el inicio de una operación al construirse y el fin al destruirse.
+ */
+class AmbitoTraza {
+public:
+  explicit AmbitoTraza(uint8_t operacion) : _operacion(operacion) { TrazaRadio::registrar(operacion); }
+  ~AmbitoTraza() { TrazaRadio::registrar(_operacion | TRAZA_FIN); }
+
+private:
+  uint8_t _operacion;
+};
+
+/// Traza la operación desde este punto hasta el final del bloque que lo contiene.
+#define URWSN_TRAZAR(operacion) AmbitoTraza _ambitoTraza(operacion)
+
+#else
+
+#define URWSN_TRAZAR(operacion) do {} while (0)
+
+#endif // URWSN_TRAZA
+
+#endif // TRAZA_RADIO_H
@@ -7,18 +7,36 @@
  *
  * Al incluir este archivo, tienes acceso a:
  * - RadioInterface (La clase base abstracta)
- * - LoraRadio (Implementación para LoRa)
- * - NrfRadio (Implementación para NRF24L01)
- * - XbeeRadio (Implementación para Xbee)
+ * - RadioBase (La base con despacho estático, sin vtable)
+ * - LoraRadio / LoraNucleo (Implementación para LoRa)
+ * - Sx127xRadio / Sx127xNucleo (Driver LoRa nativo sobre los registros del SX127x)
+ * - NrfRadio / NrfNucleo (Implementación para NRF24L01)
+ * - XBeeRadio / XBeeNucleo (Implementación para Xbee)
+ * - tiempoEnAireLoRaUs() y ContadorCicloTrabajo (Tiempo en el aire y duty cycle)
+ * - RadioFragmentada (Mensajes mayores que el MTU de la radio)
+ * - RadioFiable (Entrega fiable con ventana deslizante y ACK selectivo)
+ * - RadioFEC (Corrección de errores Reed-Solomon con entrelazado)
+ * - RadioAgregada (Varios mensajes pequeños por trama)
+ * - CodificadorDelta / DecodificadorDelta (Series de lecturas en deltas zig-zag compactos)
+ * - TrazaRadio / URWSN_TRAZA (Traza de latencias de las operaciones de radio)
  */
 
 #ifndef UNIVERSAL_RADIO_WSN_H
 #define UNIVERSAL_RADIO_WSN_H
 
 // Estos archivos incluyen todas las clases de la librería.
+#include "RadioBase.h"
 #include "RadioInterface.h"
+#include "TiempoEnAire.h"
+#include "CicloTrabajo.h"
 #include "LoraRadio.h"
+#include "Sx127xRadio.h"
 #include "XbeeRadio.h"
 #include "NrfRadio.h" 
+#include "RadioFragmentada.h"
+#include "RadioFiable.h"
+#include "RadioFEC.h"
+#include "RadioAgregada.h"
+#include "CodificadorDelta.h"
 
 #endif 
@@ -0,0 +1,305 @@
+/**
+ * @file XBeeApi.h
+ * @brief Utilidades para el modo API de los módulos XBee 802.15.4 (Serie 1).
+ * @details Define las constantes de trama, un analizador incremental (`ParserTramaXBee`)
+ * que procesa el `Stream` byte a byte sin bloquear, y `escribirTramaXBee()`, que escribe
+ * una trama completa directamente en un `Print` (el `Stream` o un `EscritorMemoria`)
+ * sin buffer intermedio.
+ * Soporta el modo API sin escapes (AP=1) y con escapes (AP=2).
+ */
+
+#ifndef XBEE_API_H
+#define XBEE_API_H
+
+#include <Arduino.h>
+#include <Stream.h>
+#include "RadioBase.h"
+
+// --- Constantes del protocolo API ---
+
+static const uint8_t XBEE_API_INICIO = 0x7E;      ///< Delimitador de inicio de trama.
+static const uint8_t XBEE_API_ESCAPE = 0x7D;      ///< Prefijo de byte escapado (AP=2).
+static const uint8_t XBEE_API_XON = 0x11;         ///< Byte de control de flujo que se escapa (AP=2).
+static const uint8_t XBEE_API_XOFF = 0x13;        ///< Byte de control de flujo que se escapa (AP=2).
+static const uint8_t XBEE_API_MASCARA_ESCAPE = 0x20; ///< XOR aplicado a los bytes escapados.
+
+static const uint8_t XBEE_API_TX64 = 0x00;        ///< Petición de transmisión, destino de 64 bits.
+static const uint8_t XBEE_API_TX16 = 0x01;        ///< Petición de transmisión, destino de 16 bits.
+static const uint8_t XBEE_API_RX64 = 0x80;        ///< Paquete recibido, origen de 64 bits.
+static const uint8_t XBEE_API_RX16 = 0x81;        ///< Paquete recibido, origen de 16 bits.
+static const uint8_t XBEE_API_ESTADO_TX = 0x89;   ///< Estado de una transmisión (TX status).
+
+static const uint8_t XBEE_API_MAX_PAYLOAD = 100;  ///< Payload máximo de RF en 802.15.4.
+
+/**
+ * @enum EstadoTxXBee
+ * @brief Estado de una transmisión en modo API, tal como lo informa la trama TX status.
+ */
+enum EstadoTxXBee {
+  XBEE_TX_EXITO = 0,        ///< Entregada (ACK recibido, o difusión enviada).
+  XBEE_TX_SIN_ACK = 1,      ///< Sin ACK tras todos los reintentos.
+  XBEE_TX_CCA_FALLIDO = 2,  ///< Canal ocupado (Clear Channel Assessment).
+  XBEE_TX_PURGADA = 3,      ///< Descartada por el módulo.
+  XBEE_TX_PENDIENTE = 0xFE, ///< Enviada al módulo, aún sin TX status.
+  XBEE_TX_DESCONOCIDA = 0xFF ///< ID de trama no registrado (o ya olvidado).
+};
+
+/**
+ * @class ParserTramaXBee
+ * @brief Analizador incremental de tramas API sobre memoria proporcionada por el llamador.
+ * @details Se le entregan bytes uno a uno con `procesar()`. Cuando devuelve true, la trama
+ * completa y con checksum válido está en `trama()` y permanece ahí hasta `liberar()`.
+ * Coste constante por byte y sin memoria dinámica.
+ */
+class ParserTramaXBee {
+public:
+  /**
+   * @brief Constructor.
+   * @param buffer Memoria para los datos de trama (tipo de API + contenido, sin cabecera ni checksum).
+   * @param capacidad Tamaño de `buffer` en bytes.
+   */
+  ParserTramaXBee(uint8_t* buffer, uint16_t capacidad)
+    : _buffer(buffer),
+      _capacidad(capacidad),
+      _escapado(true),
+      _estado(ESPERANDO_INICIO),
+      _siguienteEscapado(false),
+      _longitud(0),
+      _recibidos(0),
+      _suma(0),
+      _errores(0) {}
+
+  /**
+   * @brief Selecciona el modo con escapes (AP=2, por defecto) o sin escapes (AP=1).
+   */
+  void fijarEscapado(bool escapado) { _escapado = escapado; }
+
+  /**
+   * @brief Indica si se trabaja con escapes (AP=2).
+   */
+  bool escapado() const { return _escapado; }
+
+  /**
+   * @brief Procesa un byte recibido del módulo.
+   * @param byte Byte leído del `Stream`.
+   * @return true si con este byte se completó una trama válida (ver `trama()`).
+   */
+  bool procesar(uint8_t byte) {
+    if (_estado == COMPLETA) return true; // Hay que llamar antes a liberar()
+
+    if (byte == XBEE_API_INICIO && (_escapado || _estado == ESPERANDO_INICIO)) {
+      // En AP=2 un 0x7E siempre es inicio de trama: resincroniza si había una a medias
+      if (_estado != ESPERANDO_INICIO) _errores++;
+      _estado = LONGITUD_ALTA;
+      _siguienteEscapado = false;
+      return false;
+    }
+    if (_estado == ESPERANDO_INICIO) return false;
+
+    if (_escapado) {
+      if (byte == XBEE_API_ESCAPE) {
+        _siguienteEscapado = true;
+        return false;
+      }
+      if (_siguienteEscapado) {
+        byte ^= XBEE_API_MASCARA_ESCAPE;
+        _siguienteEscapado = false;
+      }
+    }
+
+    switch (_estado) {
+      case LONGITUD_ALTA:
+        _longitud = (uint16_t)byte << 8;
+        _estado = LONGITUD_BAJA;
+        break;
+      case LONGITUD_BAJA:
+        _longitud |= byte;
+        _recibidos = 0;
+        _suma = 0;
+        if (_longitud == 0 || _longitud > _capacidad) {
+          _errores++; // Trama vacía o que no cabe: se descarta
+          _estado = ESPERANDO_INICIO;
+        } else {
+          _estado = DATOS;
+        }
+        break;
+      case DATOS:
+        _buffer[_recibidos++] = byte;
+        _suma += byte;
+        if (_recibidos == _longitud) _estado = CHECKSUM;
+        break;
+      case CHECKSUM:
+        if ((uint8_t)(_suma + byte) == 0xFF) {
+          _estado = COMPLETA;
+          return true;
+        }
+        _errores++;
+        _estado = ESPERANDO_INICIO;
+        break;
+      default:
+        break;
+    }
+    return false;
+  }
+
+  /**
+   * @brief Indica si hay una trama completa pendiente de `liberar()`.
+   */
+  bool completa() const { return _estado == COMPLETA; }
+
+  /**
+   * @brief Datos de la trama completa: `trama()[0]` es el tipo de API.
+   */
+  const uint8_t* trama() const { return _buffer; }
+
+  /**
+   * @brief Longitud de los datos de la trama completa.
+   */
+  uint16_t longitud() const { return _longitud; }
+
+  /**
+   * @brief Descarta la trama completa y prepara el analizador para la siguiente.
+   */
+  void liberar() { _estado = ESPERANDO_INICIO; }
+
+  /**
+   * @brief Tramas descartadas por checksum incorrecto, tamaño excesivo o resincronización.
+   */
+  uint32_t errores() const { return _errores; }
+
+private:
+  enum Estado { ESPERANDO_INICIO, LONGITUD_ALTA, LONGITUD_BAJA, DATOS, CHECKSUM, COMPLETA };
+
+  uint8_t* _buffer;
+  uint16_t _capacidad;
+  bool _escapado;
+  Estado _estado;
+  bool _siguienteEscapado;
+  uint16_t _longitud;
+  uint16_t _recibidos;
+  uint8_t _suma;
+  uint32_t _errores;
+};
+
+/**
+ * @class EscritorMemoria
+ * @brief `Print` que escribe en un buffer de tamaño fijo.
+ * @details Permite construir una trama con `escribirTramaXBee()` directamente en una
+ * ranura de `AnilloPaquetes`. Los bytes que no caben se descartan y se marca `desbordado()`.
+ */
+class EscritorMemoria : public Print {
+public:
+  EscritorMemoria(uint8_t* buffer, size_t capacidad)
+    : _buffer(buffer), _capacidad(capacidad), _longitud(0), _desbordado(false) {}
+
+  using Print::write;
+
+  size_t write(uint8_t byte) override {
+    if (_longitud >= _capacidad) {
+      _desbordado = true;
+      return 0;
+    }
+    _buffer[_longitud++] = byte;
+    return 1;
+  }
+
+  /**
+   * @brief Bytes escritos en el buffer.
+   */
+  size_t longitud() const { return _longitud; }
+
+  /**
+   * @brief true si algún byte no cupo en el buffer.
+   */
+  bool desbordado() const { return _desbordado; }
+
+private:
+  uint8_t* _buffer;
+  size_t _capacidad;
+  size_t _longitud;
+  bool _desbordado;
+};
+
+/**
+ * @brief Indica si un byte se escapa en AP=2.
+ */
+inline bool requiereEscapeXBee(uint8_t byte) {
+  return byte == XBEE_API_INICIO || byte == XBEE_API_ESCAPE || byte == XBEE_API_XON || byte == XBEE_API_XOFF;
+}
+
+/**
+ * @brief Escribe un byte en `puerto`, escapándolo si es necesario (AP=2).
+ * @return Número de bytes aceptados por `puerto` (1 o 2, menos si la escritura fue corta).
+ */
+inline size_t escribirByteXBee(Print& puerto, uint8_t byte, bool escapado) {
+  if (escapado && requiereEscapeXBee(byte)) {
+    size_t escritos = puerto.write(XBEE_API_ESCAPE);
+    return escritos + puerto.write((uint8_t)(byte ^ XBEE_API_MASCARA_ESCAPE));
+  }
+  return puerto.write(byte);
+}
+
+/**
+ * @brief Escribe una trama API completa: delimitador, longitud, cabecera, segmentos de datos y checksum.
+ * @details Los datos se escapan y se suman al checksum a medida que se escriben, por lo
+ * que no se necesita ningún buffer con la trama completa.
+ * @param puerto `Stream` conectado al XBee, o un `EscritorMemoria`.
+ * @param cabecera Tipo de API y campos fijos (ej. TX16: tipo, ID, destino, opciones).
+ * @param longitudCabecera Bytes de `cabecera`.
+ * @param segmentos Datos de la trama, en orden.
+ * @param numSegmentos Número de elementos de `segmentos`.
+ * @param escapado true para AP=2.
+ * @return Número de bytes aceptados por `puerto` (incluidos delimitador, escapes y checksum).
+ */
+inline size_t escribirTramaXBee(Print& puerto, const uint8_t* cabecera, uint8_t longitudCabecera,
+                                const Segmento* segmentos, size_t numSegmentos, bool escapado) {
+  uint16_t longitud = longitudCabecera;
+  for (size_t i = 0; i < numSegmentos; i++) longitud += segmentos[i].longitud;
+
+  uint8_t suma = 0;
+  size_t escritos = puerto.write(XBEE_API_INICIO);
+  escritos += escribirByteXBee(puerto, (uint8_t)(longitud >> 8), escapado);
+  escritos += escribirByteXBee(puerto, (uint8_t)(longitud & 0xFF), escapado);
+  for (uint8_t i = 0; i < longitudCabecera; i++) {
+    suma += cabecera[i];
+    escritos += escribirByteXBee(puerto, cabecera[i], escapado);
+  }
+  for (size_t s = 0; s < numSegmentos; s++) {
+    for (size_t i = 0; i < segmentos[s].longitud; i++) {
+      suma += segmentos[s].datos[i];
+      escritos += escribirByteXBee(puerto, segmentos[s].datos[i], escapado);
+    }
+  }
+  escritos += escribirByteXBee(puerto, (uint8_t)(0xFF - suma), escapado);
+  return escritos;
+}
+
+/**
+ * @brief Bytes que ocupa la trama API (lo que `escribirTramaXBee()` debe escribir).
+ * @details Permite detectar escrituras cortas comparándolo con el resultado de `escribirTramaXBee()`.
+ */
+inline size_t longitudTramaXBee(const uint8_t* cabecera, uint8_t longitudCabecera,
+                                const Segmento* segmentos, size_t numSegmentos, bool escapado) {
+  uint16_t longitud = longitudCabecera;
+  for (size_t i = 0; i < numSegmentos; i++) longitud += segmentos[i].longitud;
+
+  uint8_t suma = 0;
+  size_t bytes = 1 + 2 + longitud + 1; // Inicio, longitud, contenido y checksum
+  if (!escapado) return bytes;
+  if (requiereEscapeXBee((uint8_t)(longitud >> 8))) bytes++;
+  if (requiereEscapeXBee((uint8_t)(longitud & 0xFF))) bytes++;
+  for (uint8_t i = 0; i < longitudCabecera; i++) {
+    suma += cabecera[i];
+    if (requiereEscapeXBee(cabecera[i])) bytes++;
+  }
+  for (size_t s = 0; s < numSegmentos; s++) {
+    for (size_t i = 0; i < segmentos[s].longitud; i++) {
+      suma += segmentos[s].datos[i];
+      if (requiereEscapeXBee(segmentos[s].datos[i])) bytes++;
+    }
+  }
+  if (requiereEscapeXBee((uint8_t)(0xFF - suma))) bytes++;
+  return bytes;
+}
+
+#endif // XBEE_API_H
@@ -1,29 +1,169 @@
 /**
  * @file XbeeRadio.h
- * @brief Define la clase XBeeRadio, una implementación de RadioInterface para módulos XBee sobre Stream (Serial).
+ * @brief Define las clases XBeeNucleo y XBeeRadio para módulos XBee sobre Stream (Serial).
  * @details Esta clase permite tratar un módulo XBee conectado a un puerto serie (HardwareSerial,
  * SoftwareSerial, etc.) como un RadioInterface estándar. Asume que el XBee
- * está en modo transparente (AT).
+ * está en modo transparente (AT), salvo que se active el modo API (AP=1 o AP=2)
+ * con `usarModoAPI()`. En modo transparente, `usarTramasSlip()` delimita los mensajes con SLIP.
+ * `XBeeNucleo` es la implementación con despacho estático (`RadioBase`) y
+ * `XBeeRadio` la expone como `RadioInterface`.
  */
 
 #pragma once
 #include "RadioInterface.h"
+#include "AnilloPaquetes.h"
+#include "XBeeApi.h"
+#include "TramaSlip.h"
 #include <Stream.h> // Usamos la clase base Stream para UART
 
+#ifndef XBEE_RADIO_TAM_BUFFER_RX
+/// Tamaño del buffer propio usado por `XBeeNucleo::tomarPaquete()` y, en modo API o SLIP, para la
+/// trama recibida. Con 112 bytes cabe una trama RX64 con el payload máximo (100 bytes).
+#define XBEE_RADIO_TAM_BUFFER_RX 112
+#endif
+
+#ifndef XBEE_API_MAX_PENDIENTES
+/// Número de estados de transmisión (TX status) que recuerda `XBeeNucleo` en modo API.
+#define XBEE_API_MAX_PENDIENTES 8
+#endif
+
 /**
- * @class XBeeRadio
- * @brief Implementación de RadioInterface para módulos XBee que se comunican por un puerto Serie (Stream).
+ * @enum EstadoEnergiaXBee
+ * @brief Estado de energía del módulo en el modo de energía asíncrono (ver `habilitarEnergiaAsincrona()`).
+ */
+enum EstadoEnergiaXBee {
+  XBEE_DESPIERTO = 0,   ///< Despierto y listo para transmitir.
+  XBEE_DORMIDO = 1,     ///< Dormido (confirmado por `on_sleep`, o supuesto si no está conectado).
+  XBEE_DURMIENDO = 2,   ///< `sleep_rq` activado, esperando a que `on_sleep` lo confirme.
+  XBEE_DESPERTANDO = 3  ///< `sleep_rq` desactivado, esperando a que `on_sleep` lo confirme.
+};
+
+/**
+ * @class XBeeNucleo
+ * @brief Implementación con despacho estático (`RadioBase`) para módulos XBee que se comunican por un puerto Serie (Stream).
  * * @details Esta clase maneja la comunicación con un XBee en modo transparente (AT).
  * Envuelve un objeto `Stream` (como `Serial` o `SoftwareSerial`) para enviar y recibir
  * datos. Opcionalmente, puede controlar los pines de bajo consumo (SleepRq, OnSleep)
  * si se proporcionan en el constructor.
+ *
+ * Con `usarModoAPI()` pasa a trabajar con tramas API de XBee 802.15.4 (Serie 1): cada
+ * paquete recibido llega completo y con su RSSI y dirección de origen, y cada envío
+ * recibe un ID de trama cuyo resultado (TX status) se consulta sin bloquear.
+ *
+ * En modo transparente los bytes llegan sin límites de paquete. Con `usarTramasSlip()`
+ * cada `enviar()` se delimita con SLIP y cada `leer()` devuelve exactamente un mensaje,
+ * decodificado de forma incremental (ver `TramaSlip.h`).
+ *
+ * `enviar()` no espera a que el UART termine de transmitir: el `flush()` se hace solo
+ * en `dormir()`, antes de dormir el módulo. Con `habilitarTransmisionAsincrona()` las
+ * tramas se encolan en RAM y se entregan al UART según tenga sitio, sin bloquear nunca.
+ *
+ * `dormir()` y `despertar()` esperan (hasta `TIMEOUT_ENERGIA_MS`) a que el pin `on_sleep`
+ * confirme el cambio. Con `habilitarEnergiaAsincrona()` retornan de inmediato y el cambio
+ * se detecta por interrupción o con `procesarEnergia()`.
  */
-class XBeeRadio : public RadioInterface {
+class XBeeNucleo : public RadioBase<XBeeNucleo> {
+public:
+  static const uint16_t TIMEOUT_ENERGIA_MS = 200; ///< Espera máxima a que `on_sleep` confirme un cambio.
+
 private:
   Stream& _puertoSerial; ///< Referencia al puerto Stream (ej. Serial, Serial2) usado para la comunicación.
   long _baudios;         ///< Tasa de baudios. Informativo, no se usa para iniciar el puerto.
   int8_t _pinSleepRq;    ///< Pin de control para solicitar modo 'sleep' (activo BAJO). -1 si no se usa.
   int8_t _pinOnSleep;    ///< Pin de estado para leer si el XBee está dormido (BAJO) o despierto (ALTO). -1 si no se usa.
+  uint8_t _bufferRx[XBEE_RADIO_TAM_BUFFER_RX]; ///< Buffer de `tomarPaquete()`.
+  size_t _longitudVista; ///< Longitud de los datos en `_bufferRx`. 0 si no hay vista tomada.
+
+  // --- Modo API ---
+  bool _modoAPI;                ///< true si el módulo está configurado en modo API (AP=1 o AP=2).
+  ParserTramaXBee _parser;      ///< Analizador de tramas entrantes (usa `_bufferRx`).
+  bool _tramasSlip;             ///< true si, en modo transparente, los mensajes se delimitan con SLIP.
+  DecodificadorSlip _slip;      ///< Decodificador de tramas SLIP entrantes (usa `_bufferRx`).
+  uint8_t _inicioDatos;         ///< Posición del payload dentro de la trama RX retenida.
+  int _rssiUltimo;              ///< RSSI de la última trama RX, en dBm.
+  uint16_t _origen16;           ///< Dirección de 16 bits del emisor de la última trama RX.
+  uint64_t _origen64;           ///< Dirección de 64 bits del emisor de la última trama RX (0 si llegó por 16 bits).
+  bool _usarDestino64;          ///< true para enviar con TX64, false para TX16.
+  uint16_t _destino16;          ///< Destino de las tramas TX16.
+  uint64_t _destino64;          ///< Destino de las tramas TX64.
+  uint8_t _siguienteIdTrama;    ///< Próximo ID de trama (1-255; 0 desactiva el TX status).
+  uint8_t _ultimoIdTrama;       ///< ID asignado al último envío.
+  uint8_t _idsTx[XBEE_API_MAX_PENDIENTES];     ///< ID de trama registrado en cada posición.
+  uint8_t _estadosTx[XBEE_API_MAX_PENDIENTES]; ///< Estado (`EstadoTxXBee`) de cada ID registrado.
+  void (*_alEstadoTx)(uint8_t, uint8_t);       ///< Callback opcional al recibir un TX status.
+
+  // --- Transmisión asíncrona ---
+  AnilloPaquetes* _colaTx;   ///< Tramas pendientes de entregar al UART. nullptr = envío directo.
+  uint16_t _enviadosFrente;  ///< Bytes de la trama del frente ya entregados al UART.
+  int _capacidadTxUart;      ///< Mayor `availableForWrite()` observado (buffer TX del UART vacío).
+
+  EstadisticasRadio _estadisticas; ///< Contadores de actividad (salvo `tramasErroneas`).
+  uint32_t _erroresBase;           ///< `tramasErroneas()` en el último `reiniciarEstadisticas()`.
+
+  // --- Energía asíncrona ---
+  bool _energiaAsincrona;                        ///< true tras `habilitarEnergiaAsincrona()`.
+  volatile uint8_t _estadoEnergia;               ///< `EstadoEnergiaXBee` actual.
+  uint32_t _inicioTransicionMs;                  ///< `millis()` al iniciar la última transición.
+  void (*_alCambiarEnergia)(EstadoEnergiaXBee);  ///< Callback opcional al terminar una transición.
+
+  /**
+   * @brief Instancia que atiende la interrupción del pin `on_sleep`.
+   * @details `attachInterrupt()` solo admite funciones libres, por lo que solo puede haber
+   * una instancia con la interrupción activa.
+   */
+  static XBeeNucleo*& _instanciaIrq() {
+    static XBeeNucleo* instancia = nullptr;
+    return instancia;
+  }
+
+  /**
+   * @brief Interrupción de cambio del pin `on_sleep`.
+   */
+  static void _alCambiarPinOnSleep() {
+    XBeeNucleo* radio = _instanciaIrq();
+    if (radio != nullptr && radio->_comprobarTransicion(false)) radio->_notificarEnergia();
+  }
+
+  /**
+   * @brief Termina la transición en curso si `on_sleep` ya muestra el estado pedido o,
+   * con `comprobarTimeout`, si se agotó `TIMEOUT_ENERGIA_MS` (el estado pasa a ser el que
+   * indique el pin). Se llama con las interrupciones desactivadas.
+   * @return true si la transición terminó en esta llamada.
+   */
+  bool _comprobarTransicion(bool comprobarTimeout) {
+    uint8_t estado = _estadoEnergia;
+    if (estado != XBEE_DURMIENDO && estado != XBEE_DESPERTANDO) return false;
+    uint8_t final = (digitalRead(_pinOnSleep) == HIGH) ? XBEE_DESPIERTO : XBEE_DORMIDO;
+    bool alcanzado = (estado == XBEE_DURMIENDO) ? (final == XBEE_DORMIDO) : (final == XBEE_DESPIERTO);
+    if (!alcanzado && !(comprobarTimeout && millis() - _inicioTransicionMs >= TIMEOUT_ENERGIA_MS)) return false;
+    _estadoEnergia = final;
+    return true;
+  }
+
+  /**
+   * @brief Invoca el callback del usuario con el estado alcanzado.
+   */
+  void _notificarEnergia() {
+    if (_alCambiarEnergia) _alCambiarEnergia((EstadoEnergiaXBee)_estadoEnergia);
+  }
+
+  /**
+   * @brief Inicia una transición de energía sin esperar (modo asíncrono).
+   * @param destino `XBEE_DURMIENDO` o `XBEE_DESPERTANDO`.
+   */
+  void _iniciarTransicion(uint8_t destino) {
+    bool terminada = true;
+    if (_pinOnSleep < 0) { // No se puede confirmar, asumimos que funcionó
+      _estadoEnergia = (destino == XBEE_DURMIENDO) ? XBEE_DORMIDO : XBEE_DESPIERTO;
+    } else {
+      noInterrupts();
+      _inicioTransicionMs = millis();
+      _estadoEnergia = destino;
+      terminada = _comprobarTransicion(false); // Puede que el pin ya esté en el estado pedido
+      interrupts();
+    }
+    if (terminada) _notificarEnergia();
+  }
 
   /**
    * @brief Función de ayuda para esperar a que un pin alcance un estado específico.
@@ -45,20 +185,357 @@ private:
     return false; // Timeout
   }
 
+  /**
+   * @brief Indica si la recepción trabaja por tramas (modo API o SLIP) en lugar de bytes sueltos.
+   */
+  bool _recepcionPorTramas() const { return _modoAPI || _tramasSlip; }
+
+  /**
+   * @brief Consume bytes del `Stream` hasta retener una trama recibida o vaciar el puerto.
+   * @details En modo API, los TX status se registran y el resto de tramas (respuestas AT,
+   * estado del módem) se descartan. Mientras hay una trama retenida no se lee nada más,
+   * de modo que los bytes siguientes esperan en el buffer del UART.
+   * @return true si hay una trama retenida (payload en `_bufferRx + _inicioDatos`).
+   */
+  bool _procesarEntrada() {
+    if (_longitudVista > 0) return true;
+    while (_puertoSerial.available() > 0) {
+      uint8_t byte = (uint8_t)_puertoSerial.read();
+      if (_modoAPI) {
+        if (!_parser.procesar(byte)) continue;
+        if (_interpretarTrama()) return true;
+        _parser.liberar();
+      } else if (_slip.procesar(byte)) {
+        _inicioDatos = 0;
+        _longitudVista = _slip.longitud();
+        _estadisticas.registrarRecepcion(_longitudVista);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Interpreta la trama completa del analizador.
+   * @return true si es una trama RX con datos (queda retenida), false si ya se atendió.
+   */
+  bool _interpretarTrama() {
+    const uint8_t* trama = _parser.trama();
+    uint16_t longitud = _parser.longitud();
+    uint8_t cabecera;
+
+    switch (trama[0]) {
+      case XBEE_API_ESTADO_TX:
+        if (longitud >= 3) _registrarEstadoTx(trama[1], trama[2]);
+        return false;
+      case XBEE_API_RX16: // Tipo, origen (2), RSSI, opciones
+        cabecera = 5;
+        if (longitud <= cabecera) return false;
+        _origen16 = ((uint16_t)trama[1] << 8) | trama[2];
+        _origen64 = 0;
+        break;
+      case XBEE_API_RX64: // Tipo, origen (8), RSSI, opciones
+        cabecera = 11;
+        if (longitud <= cabecera) return false;
+        _origen64 = 0;
+        for (uint8_t i = 1; i <= 8; i++) _origen64 = (_origen64 << 8) | trama[i];
+        _origen16 = 0xFFFE; // El emisor no tiene dirección de 16 bits (MY=0xFFFE)
+        break;
+      default:
+        return false;
+    }
+    _rssiUltimo = -(int)trama[cabecera - 2]; // El módulo informa -dBm
+    _inicioDatos = cabecera;
+    _longitudVista = longitud - cabecera;
+    _estadisticas.registrarRecepcion(_longitudVista);
+    _estadisticas.registrarRSSI(_rssiUltimo);
+    return true;
+  }
+
+  /**
+   * @brief Guarda el estado de una transmisión y avisa al callback, si lo hay.
+   */
+  void _registrarEstadoTx(uint8_t idTrama, uint8_t estado) {
+    uint8_t posicion = idTrama % XBEE_API_MAX_PENDIENTES;
+    _idsTx[posicion] = idTrama;
+    _estadosTx[posicion] = estado;
+    if (estado != XBEE_TX_EXITO) _estadisticas.tramasNoEntregadas++;
+    if (_alEstadoTx) _alEstadoTx(idTrama, estado);
+  }
+
+  /**
+   * @brief Entrega al UART tantos bytes de la cola como quepan en su buffer, sin bloquear.
+   * @details Si el `Stream` no implementa `availableForWrite()` (ej. `SoftwareSerial`),
+   * escribe la cola completa con `write()`, que en esos puertos ya es bloqueante.
+   */
+  void _drenarTx() {
+    if (!_colaTx) return;
+    if (_energiaAsincrona && _estadoEnergia != XBEE_DESPIERTO) return; // Se entrega al despertar
+    while (!_colaTx->vacio()) {
+      size_t restantes = _colaTx->longitudFrente() - _enviadosFrente;
+      size_t bytes = restantes;
+      if (_capacidadTxUart > 0) {
+        int libre = _puertoSerial.availableForWrite();
+        if (libre <= 0) return;
+        if ((size_t)libre < bytes) bytes = (size_t)libre;
+      }
+      _enviadosFrente += _puertoSerial.write(_colaTx->frente() + _enviadosFrente, bytes);
+      if (_enviadosFrente < _colaTx->longitudFrente()) return; // Sin sitio: el resto, en la próxima llamada
+      _colaTx->liberarFrente();
+      _enviadosFrente = 0;
+    }
+  }
+
+  /**
+   * @brief Descarta la trama RX retenida (o la vista en modo transparente).
+   */
+  void _liberarRecepcion() {
+    _longitudVista = 0;
+    if (_modoAPI) _parser.liberar();
+    if (_tramasSlip) _slip.liberar();
+  }
+
 public:
   /**
-   * @brief Constructor para la clase XBeeRadio.
+   * @brief Constructor para la clase XBeeNucleo.
    * @param puerto Referencia a un objeto Stream (como `Serial`, `Serial2` o `SoftwareSerial`) para la comunicación.
    * @param baudios La velocidad en baudios del puerto serie. **Nota:** Este valor es solo informativo;
    * el puerto debe ser inicializado externamente con `puerto.begin(baudios)`.
    * @param pinSleepRq Pin de control (GPIO) para poner el XBee a dormir (activo en BAJO). Usar -1 si no se utiliza.
    * @param pinOnSleep Pin de estado (GPIO) que indica si el XBee está despierto (activo en ALTO). Usar -1 si no se utiliza.
    */
-  XBeeRadio(Stream& puerto, long baudios, int8_t pinSleepRq, int8_t pinOnSleep)
+  XBeeNucleo(Stream& puerto, long baudios, int8_t pinSleepRq, int8_t pinOnSleep)
     : _puertoSerial(puerto),
       _baudios(baudios),
       _pinSleepRq(pinSleepRq),
-      _pinOnSleep(pinOnSleep) {}
+      _pinOnSleep(pinOnSleep),
+      _longitudVista(0),
+      _modoAPI(false),
+      _parser(_bufferRx, sizeof(_bufferRx)),
+      _tramasSlip(false),
+      _slip(_bufferRx, sizeof(_bufferRx)),
+      _inicioDatos(0),
+      _rssiUltimo(0),
+      _origen16(0),
+      _origen64(0),
+      _usarDestino64(false),
+      _destino16(0xFFFF),
+      _destino64(0),
+      _siguienteIdTrama(1),
+      _ultimoIdTrama(0),
+      _alEstadoTx(nullptr),
+      _colaTx(nullptr),
+      _enviadosFrente(0),
+      _capacidadTxUart(0),
+      _erroresBase(0),
+      _energiaAsincrona(false),
+      _estadoEnergia(XBEE_DESPIERTO),
+      _inicioTransicionMs(0),
+      _alCambiarEnergia(nullptr) {
+    memset(_idsTx, 0, sizeof(_idsTx));
+    memset(&_estadisticas, 0, sizeof(_estadisticas));
+  }
+
+  /**
+   * @brief Destructor. Desregistra la interrupción si esta instancia la tenía asignada.
+   */
+  ~XBeeNucleo() {
+    if (_instanciaIrq() == this) {
+      detachInterrupt(digitalPinToInterrupt(_pinOnSleep));
+      _instanciaIrq() = nullptr;
+    }
+  }
+
+  /**
+   * @brief Activa el modo de energía asíncrono (opcional).
+   * @details A partir de esta llamada, `dormir()` y `despertar()` solo cambian `sleep_rq` y
+   * retornan, sin esperar a `on_sleep`, de modo que el MCU puede dormir mientras el módulo
+   * cambia de estado. El fin de la transición se detecta:
+   * - por interrupción de cambio en `on_sleep`, si el pin la admite y `usarInterrupcion`
+   *   es true (la interrupción también despierta al MCU);
+   * - si no, en cada llamada a `procesarEnergia()` o `estadoEnergia()` (una lectura del pin).
+   *
+   * Mientras el módulo no está despierto, la cola de `habilitarTransmisionAsincrona()`
+   * retiene las tramas y `enviar()` sin cola las rechaza.
+   * @param alCambiar Callback opcional con el estado final de cada transición
+   * (`XBEE_DESPIERTO` o `XBEE_DORMIDO`; si se agota `TIMEOUT_ENERGIA_MS`, el que indique el pin).
+   * Con interrupción se ejecuta en contexto de interrupción: mantenerlo breve.
+   * @param usarInterrupcion false para detectar el cambio solo con `procesarEnergia()`.
+   */
+  void habilitarEnergiaAsincrona(void (*alCambiar)(EstadoEnergiaXBee estado) = nullptr, bool usarInterrupcion = true) {
+    _energiaAsincrona = true;
+    _alCambiarEnergia = alCambiar;
+    if (usarInterrupcion && _pinOnSleep >= 0 && digitalPinToInterrupt(_pinOnSleep) != NOT_AN_INTERRUPT) {
+      _instanciaIrq() = this;
+      attachInterrupt(digitalPinToInterrupt(_pinOnSleep), _alCambiarPinOnSleep, CHANGE);
+    }
+  }
+
+  /**
+   * @brief Comprueba (sin bloquear) si terminó la transición de energía en curso.
+   * @details Necesario en el modo asíncrono sin interrupción; con interrupción solo
+   * detecta el timeout. Llamar periódicamente desde `loop()`.
+   */
+  void procesarEnergia() {
+    if (!_energiaAsincrona) return;
+    noInterrupts();
+    bool terminada = _comprobarTransicion(true);
+    interrupts();
+    if (terminada) _notificarEnergia();
+    _drenarTx();
+  }
+
+  /**
+   * @brief Estado de energía actual (tras comprobar la transición en curso).
+   */
+  EstadoEnergiaXBee estadoEnergia() {
+    procesarEnergia();
+    return (EstadoEnergiaXBee)_estadoEnergia;
+  }
+
+  /**
+   * @brief Activa el modo API. El módulo debe estar configurado con AP=2 (o AP=1).
+   * @details A partir de aquí `enviar()` genera tramas TX16 (por defecto, a difusión
+   * 0xFFFF) o TX64 y la recepción entrega paquetes completos con RSSI y origen.
+   * Llamar antes de `iniciar()` o con el puerto sin datos pendientes.
+   * @param escapado true para AP=2 (con escapes), false para AP=1.
+   * @param alEstadoTx Callback opcional `(idTrama, estado)` llamado al recibir cada TX status,
+   * desde `hayDatosDisponibles()`, `leer()`, `tomarPaquete()` o `estadoTransmision()`.
+   */
+  void usarModoAPI(bool escapado = true, void (*alEstadoTx)(uint8_t, uint8_t) = nullptr) {
+    _modoAPI = true;
+    _tramasSlip = false;
+    _parser.fijarEscapado(escapado);
+    _parser.liberar();
+    _alEstadoTx = alEstadoTx;
+    _longitudVista = 0;
+  }
+
+  /**
+   * @brief Activa la transmisión asíncrona (opcional).
+   * @details A partir de esta llamada, `enviar()` copia la trama (ya codificada, en modo API)
+   * en `colaTx` y retorna de inmediato. Los bytes se entregan al UART a medida que su
+   * buffer tiene sitio, desde `procesarTransmision()` y desde las funciones de recepción,
+   * por lo que el bucle principal nunca espera a que salgan por la línea serie.
+   * @param colaTx Cola de tramas pendientes (ej. `AnilloPaquetesEstatico<4, 128>`).
+   * En modo API AP=2 la ranura debe admitir la trama con escapes. Debe existir mientras la radio esté en uso.
+   * @note Pensado para `HardwareSerial`, que informa de su espacio libre con `availableForWrite()`.
+   */
+  void habilitarTransmisionAsincrona(AnilloPaquetes& colaTx) {
+    _colaTx = &colaTx;
+    _enviadosFrente = 0;
+  }
+
+  /**
+   * @brief Entrega al UART los bytes encolados que quepan en su buffer, sin bloquear.
+   * @details Llamar periódicamente desde `loop()` cuando se usa la transmisión asíncrona.
+   */
+  void procesarTransmision() {
+    _drenarTx();
+  }
+
+  /**
+   * @brief Número de tramas que aún no se han entregado por completo al UART.
+   */
+  uint8_t transmisionesPendientes() const {
+    return _colaTx ? _colaTx->pendientes() : 0;
+  }
+
+  /**
+   * @brief Indica si no queda nada por transmitir: cola vacía y buffer TX del UART vacío.
+   * @details Consulta barata (sin bloquear). El último byte puede estar todavía en el
+   * registro de desplazamiento del UART; `dormir()` espera también a ese byte.
+   */
+  bool transmisionVaciada() {
+    _drenarTx();
+    if (transmisionesPendientes() > 0) return false;
+    int libre = _puertoSerial.availableForWrite();
+    if (libre > _capacidadTxUart) _capacidadTxUart = libre;
+    return libre >= _capacidadTxUart;
+  }
+
+  /**
+   * @brief (Modo transparente) Delimita los mensajes con SLIP.
+   * @details `enviar()` escribe cada mensaje como una trama SLIP y `hayDatosDisponibles()`
+   * / `leer()` / `tomarPaquete()` trabajan con mensajes completos: `leer()` devuelve
+   * exactamente uno por llamada. Los mensajes de más de `XBEE_RADIO_TAM_BUFFER_RX` bytes
+   * se descartan. El otro extremo debe usar también SLIP.
+   */
+  void usarTramasSlip() {
+    _modoAPI = false;
+    _tramasSlip = true;
+    _slip.liberar();
+    _longitudVista = 0;
+  }
+
+  /**
+   * @brief (Modo API) Envía los siguientes paquetes con TX16 a la dirección dada (0xFFFF = difusión).
+   */
+  void fijarDestino16(uint16_t direccion) {
+    _usarDestino64 = false;
+    _destino16 = direccion;
+  }
+
+  /**
+   * @brief (Modo API) Envía los siguientes paquetes con TX64 a la dirección dada (SH:SL del destino).
+   */
+  void fijarDestino64(uint64_t direccion) {
+    _usarDestino64 = true;
+    _destino64 = direccion;
+  }
+
+  /**
+   * @brief (Modo API) ID de trama asignado al último `enviar()`.
+   */
+  uint8_t ultimoIdTrama() const { return _ultimoIdTrama; }
+
+  /**
+   * @brief (Modo API) Estado de la transmisión con el ID dado.
+   * @details Procesa antes los bytes pendientes del puerto, sin bloquear. Solo se recuerdan
+   * los últimos `XBEE_API_MAX_PENDIENTES` IDs; para uno más antiguo devuelve `XBEE_TX_DESCONOCIDA`.
+   * @return Un valor de `EstadoTxXBee`.
+   */
+  uint8_t estadoTransmision(uint8_t idTrama) {
+    if (_modoAPI) _procesarEntrada();
+    uint8_t posicion = idTrama % XBEE_API_MAX_PENDIENTES;
+    if (idTrama == 0 || _idsTx[posicion] != idTrama) return XBEE_TX_DESCONOCIDA;
+    return _estadosTx[posicion];
+  }
+
+  /**
+   * @brief (Modo API) Dirección de 16 bits del emisor del último paquete (0xFFFE si llegó con origen de 64 bits).
+   */
+  uint16_t ultimoOrigen16() const { return _origen16; }
+
+  /**
+   * @brief (Modo API) Dirección de 64 bits del emisor del último paquete (0 si llegó con origen de 16 bits).
+   */
+  uint64_t ultimoOrigen64() const { return _origen64; }
+
+  /**
+   * @brief (Modo API o SLIP) Tramas descartadas por checksum incorrecto, tamaño, escape inválido
+   * o pérdida de sincronía.
+   */
+  uint32_t tramasErroneas() const { return _parser.errores() + _slip.errores(); }
+
+  /**
+   * @brief Copia de los contadores de actividad.
+   * @details El RSSI solo se registra en modo API. En modo transparente sin SLIP, cada
+   * `leer()` con datos cuenta como una trama recibida.
+   */
+  EstadisticasRadio obtenerEstadisticas() {
+    EstadisticasRadio copia = _estadisticas;
+    copia.tramasErroneas = tramasErroneas() - _erroresBase;
+    return copia;
+  }
+
+  /**
+   * @brief Pone a cero los contadores de actividad.
+   */
+  void reiniciarEstadisticas() {
+    memset(&_estadisticas, 0, sizeof(_estadisticas));
+    _erroresBase = tramasErroneas();
+  }
 
   /**
    * @brief Configura los pines de control del XBee (si se especificaron).
@@ -68,13 +545,16 @@ public:
    * de que el módulo comience en estado despierto.
    * @return Siempre devuelve `true`.
    */
-  bool iniciar() override {
+  bool iniciar() {
+    URWSN_TRAZAR(TRAZA_INICIAR);
     if (_pinSleepRq >= 0) {
       pinMode(_pinSleepRq, OUTPUT);
     }
     if (_pinOnSleep >= 0) {
       pinMode(_pinOnSleep, INPUT);
     }
+    // Con el puerto recién iniciado y vacío, availableForWrite() es la capacidad del buffer TX.
+    _capacidadTxUart = _puertoSerial.availableForWrite();
     // Por defecto, al iniciar, nos aseguramos de que el módulo esté despierto.
     despertar();
     return true;
@@ -82,63 +562,118 @@ public:
 
   /**
    * @brief Pone el módulo XBee en modo de bajo consumo.
-   * @details Pone el pin `sleep_rq` en LOW. Si el pin `on_sleep` está configurado,
+   * @details Antes de dormir el módulo entrega al UART lo que quede en la cola de
+   * transmisión y espera con `flush()` a que salga el último byte (es el único punto
+   * donde se bloquea por la transmisión). En el modo de energía asíncrono solo lo hace si
+   * el módulo está despierto; si no, la cola se conserva hasta el próximo despertar.
+   * Pone el pin `sleep_rq` en LOW. Si el pin `on_sleep` está configurado,
    * espera (con timeout) a que este pin confirme el estado de 'dormido' (LOW).
+   * En el modo de energía asíncrono no espera a `on_sleep` (ver `habilitarEnergiaAsincrona()`).
    * @return true si la operación fue exitosa (o si `on_sleep` no está configurado).
+   * En modo asíncrono, true si la petición se hizo.
    * @return false si `sleep_rq` está configurado pero `on_sleep` no confirmó el estado a tiempo.
    */
-  bool dormir() override {
+  bool dormir() {
+    URWSN_TRAZAR(TRAZA_DORMIR);
     if (_pinSleepRq < 0) return true; // No se puede dormir si no hay pin de control
+
+    // enviar() no espera al UART: hay que vaciarlo antes de dormir el módulo. En el modo
+    // asíncrono, si el módulo no está despierto (ej. dormir() dos veces seguidas) la cola se
+    // conserva y se entrega al despertar, como en `_drenarTx()`.
+    if (_colaTx && (!_energiaAsincrona || _estadoEnergia == XBEE_DESPIERTO)) {
+      while (!_colaTx->vacio()) {
+        _enviadosFrente += _puertoSerial.write(_colaTx->frente() + _enviadosFrente,
+                                               _colaTx->longitudFrente() - _enviadosFrente);
+        if (_enviadosFrente < _colaTx->longitudFrente()) break; // Escritura corta: queda en la cola
+        _colaTx->liberarFrente();
+        _enviadosFrente = 0;
+      }
+    }
+    _puertoSerial.flush();
     
     digitalWrite(_pinSleepRq, LOW); // Solicitar 'sleep'
     
+    if (_energiaAsincrona) {
+      _iniciarTransicion(XBEE_DURMIENDO);
+      return true;
+    }
     if (_pinOnSleep < 0) return true; // No se puede confirmar, asumimos que funcionó
     
     // Esperar confirmación
-    return _esperarEstadoPin(_pinOnSleep, LOW, 200); 
+    return _esperarEstadoPin(_pinOnSleep, LOW, TIMEOUT_ENERGIA_MS); 
   }
 
   /**
    * @brief Saca al módulo XBee del modo de bajo consumo.
    * @details Pone el pin `sleep_rq` en HIGH. Si el pin `on_sleep` está configurado,
    * espera (con timeout) a que este pin confirme el estado de 'despierto' (HIGH).
+   * En el modo de energía asíncrono no espera a `on_sleep` (ver `habilitarEnergiaAsincrona()`).
    * @return true si la operación fue exitosa (o si `on_sleep` no está configurado).
+   * En modo asíncrono, true si la petición se hizo.
    * @return false si `sleep_rq` está configurado pero `on_sleep` no confirmó el estado a tiempo.
    */
-  bool despertar() override {
+  bool despertar() {
+    URWSN_TRAZAR(TRAZA_DESPERTAR);
     if (_pinSleepRq < 0) return true; // Ya está despierto si no hay pin de control
     
     digitalWrite(_pinSleepRq, HIGH); // Solicitar 'wake'
     
+    if (_energiaAsincrona) {
+      _iniciarTransicion(XBEE_DESPERTANDO);
+      return true;
+    }
     if (_pinOnSleep < 0) return true; // No se puede confirmar, asumimos que funcionó
         
     // Esperar confirmación
-    return _esperarEstadoPin(_pinOnSleep, HIGH, 200); 
+    return _esperarEstadoPin(_pinOnSleep, HIGH, TIMEOUT_ENERGIA_MS); 
   }
 
+  // Hace visibles las sobrecargas de RadioBase (ej. enviar(const String&)).
+  using RadioBase<XBeeNucleo>::enviar;
+
   /**
    * @brief Envía datos binarios a través del puerto serie.
-   * @details Llama a `_puertoSerial.write()` y luego a `_puertoSerial.flush()`
-   * para asegurar que la transmisión saliente se complete (bloqueante).
+   * @details Llama a `_puertoSerial.write()` sin esperar a que el UART termine
+   * (`dormir()` se encarga del `flush()`). Con la transmisión asíncrona, encola la trama.
+   * En modo API escribe una trama TX16/TX64; el resultado se consulta con
+   * `estadoTransmision(ultimoIdTrama())`.
    * @param buffer Puntero al buffer de datos a enviar.
    * @param longitud Número de bytes a enviar.
-   * @return true si se escribieron todos los bytes solicitados, false en caso contrario.
+   * @return true si se escribieron (o encolaron) todos los bytes solicitados, false en caso contrario.
    */
-  bool enviar(const uint8_t* buffer, size_t longitud) override {
-    size_t bytesEscritos = _puertoSerial.write(buffer, longitud);
-    
-    // flush() espera a que se complete la transmisión saliente.
-    // Útil para asegurar que un comando se envió antes de dormir el módulo.
-    _puertoSerial.flush(); 
-    
-    return bytesEscritos == longitud;
+  bool enviar(const uint8_t* buffer, size_t longitud) {
+    Segmento segmento = {buffer, longitud};
+    return enviar(&segmento, 1);
+  }
+
+  /**
+   * @brief Envía varios segmentos seguidos por el puerto serie.
+   * @details Escribe cada segmento directamente en el `Stream` (o en la ranura de la
+   * cola de transmisión), sin buffer intermedio.
+   * @param segmentos Array de segmentos, en orden de transmisión.
+   * @param numSegmentos Número de elementos de `segmentos`.
+   * @return true si se escribieron todos los bytes de todos los segmentos;
+   * false si la cola está llena o la trama no cabe en una ranura.
+   */
+  bool enviar(const Segmento* segmentos, size_t numSegmentos) {
+    URWSN_TRAZAR(TRAZA_ENVIAR);
+    size_t longitud = 0;
+    for (size_t i = 0; i < numSegmentos; i++) longitud += segmentos[i].longitud;
+    bool ok = _enviarTrama(segmentos, numSegmentos);
+    _estadisticas.registrarEnvio(ok, longitud);
+    return ok;
   }
 
   /**
    * @brief Comprueba cuántos bytes hay disponibles en el buffer de recepción del puerto serie.
+   * @details En modo API o SLIP procesa los bytes pendientes y devuelve la longitud del
+   * siguiente mensaje completo (0 si aún no ha llegado entero).
    * @return El número de bytes disponibles para leer, resultado de `_puertoSerial.available()`.
    */
-  int hayDatosDisponibles() override {
+  int hayDatosDisponibles() {
+    URWSN_TRAZAR(TRAZA_HAY_DATOS);
+    _drenarTx();
+    if (_recepcionPorTramas()) return _procesarEntrada() ? (int)_longitudVista : 0;
     return _puertoSerial.available();
   }
 
@@ -150,18 +685,194 @@ public:
    * @param maxLongitud El tamaño máximo del `buffer` de destino.
    * @return El número de bytes realmente leídos y almacenados en el buffer.
    */
-  size_t leer(uint8_t* buffer, size_t maxLongitud) override {
+  size_t leer(uint8_t* buffer, size_t maxLongitud) {
+    URWSN_TRAZAR(TRAZA_LEER);
     if (maxLongitud == 0) return 0;
+    _drenarTx();
+
+    if (_recepcionPorTramas()) {
+      // Un paquete por llamada; lo que no quepa en el buffer se descarta.
+      if (!_procesarEntrada()) return 0;
+      size_t bytesALeer = (_longitudVista < maxLongitud) ? _longitudVista : maxLongitud;
+      if (bytesALeer < _longitudVista) _estadisticas.lecturasTruncadas++;
+      memcpy(buffer, _bufferRx + _inicioDatos, bytesALeer);
+      _liberarRecepcion();
+      return bytesALeer;
+    }
 
     // Primero comprobamos cuántos bytes hay realmente
     int bytesDisponibles = _puertoSerial.available();
     
     if (bytesDisponibles > 0) {
       // Leemos el mínimo entre lo disponible y el tamaño del buffer
-      size_t bytesALeer = min((size_t)bytesDisponibles, maxLongitud);
-      return _puertoSerial.readBytes(buffer, bytesALeer);
+      size_t bytesALeer = ((size_t)bytesDisponibles < maxLongitud) ? (size_t)bytesDisponibles : maxLongitud;
+      // Los bytes ya están en el buffer del UART: `read()` directo evita el timeout de
+      // `readBytes()` y sus dos llamadas a `millis()` por byte.
+      for (size_t i = 0; i < bytesALeer; i++) {
+        buffer[i] = (uint8_t)_puertoSerial.read();
+      }
+      _estadisticas.registrarRecepcion(bytesALeer);
+      return bytesALeer;
     }
     
     return 0; // No había nada que leer
   }
+
+  /**
+   * @brief Obtiene una vista de los bytes disponibles en el puerto serie.
+   * @details Los bytes se leen una sola vez del `Stream` al buffer interno de
+   * `XBEE_RADIO_TAM_BUFFER_RX` bytes. En modo transparente no hay límites de paquete:
+   * la vista contiene lo que hubiera en el buffer del UART.
+   * En modo API o SLIP la vista apunta al mensaje recibido completo, sin copias.
+   * @param vista Estructura que se rellena con los datos (RSSI 0 en modo transparente).
+   * @return true si había datos disponibles.
+   */
+  bool tomarPaquete(VistaPaquete& vista) {
+    URWSN_TRAZAR(TRAZA_TOMAR_PAQUETE);
+    _drenarTx();
+    if (_recepcionPorTramas()) {
+      if (!_procesarEntrada()) return false;
+      vista.datos = _bufferRx + _inicioDatos;
+      vista.longitud = _longitudVista;
+      vista.rssi = _rssiUltimo;
+      return true;
+    }
+
+    if (_longitudVista == 0) {
+      _longitudVista = leer(_bufferRx, sizeof(_bufferRx));
+      if (_longitudVista == 0) return false;
+    }
+    vista.datos = _bufferRx;
+    vista.longitud = _longitudVista;
+    vista.rssi = 0;
+    return true;
+  }
+
+  /**
+   * @brief Libera los datos obtenidos con `tomarPaquete()`.
+   */
+  void liberarPaquete() {
+    _liberarRecepcion();
+  }
+
+  /**
+   * @brief RSSI del último paquete recibido en modo API, en dBm (0 en modo transparente).
+   */
+  int obtenerRSSI() {
+    return _modoAPI ? _rssiUltimo : 0;
+  }
+
+  /**
+   * @brief Tamaño máximo de un mensaje.
+   * @details
+   * - Modo API: 100 bytes (`XBEE_API_MAX_PAYLOAD`), el payload de una trama TX.
+   * - Transparente con SLIP: `XBEE_RADIO_TAM_BUFFER_RX`, la trama más larga que cabe en el
+   *   buffer de recepción del otro extremo.
+   * - Transparente sin SLIP: no hay mensajes, solo un flujo de bytes. Es el tamaño de trozo
+   *   que entrega `tomarPaquete()` en cada lectura (`XBEE_RADIO_TAM_BUFFER_RX`), no un límite
+   *   de mensaje: un envío más largo llega partido y varios cortos pueden llegar juntos. Las
+   *   capas que necesitan límites de mensaje (`RadioFiable`, `RadioFEC`, `RadioFragmentada`...)
+   *   deben usar `usarTramasSlip()` o el modo API.
+   */
+  size_t obtenerMTU() {
+    return _modoAPI ? XBEE_API_MAX_PAYLOAD : XBEE_RADIO_TAM_BUFFER_RX;
+  }
+
+private:
+  /**
+   * @brief Cuerpo de `enviar(segmentos)`: encola la trama o la escribe en el puerto.
+   */
+  bool _enviarTrama(const Segmento* segmentos, size_t numSegmentos) {
+    if (_colaTx) {
+      uint8_t* ranura = _colaTx->reservarEscritura();
+      if (!ranura) {
+        _estadisticas.rechazosOcupada++; // Cola llena
+        return false;
+      }
+      EscritorMemoria escritor(ranura, _colaTx->tamRanura());
+      if (!_escribirTrama(escritor, segmentos, numSegmentos)) return false; // Incluye no caber en la ranura
+      _colaTx->confirmarEscritura(escritor.longitud(), 0);
+      _drenarTx();
+      return true;
+    }
+    if (_energiaAsincrona && _estadoEnergia != XBEE_DESPIERTO) {
+      _estadisticas.rechazosOcupada++; // El módulo no está despierto
+      return false;
+    }
+    return _escribirTrama(_puertoSerial, segmentos, numSegmentos);
+  }
+
+  /**
+   * @brief Escribe los segmentos en `destino`: tal cual en modo transparente, como una
+   * trama SLIP si está activa, o como una trama TX16/TX64 con un ID de trama nuevo en modo API.
+   * @return false si no se escribieron todos los bytes o si el payload supera
+   * `XBEE_API_MAX_PAYLOAD` bytes en modo API.
+   */
+  bool _escribirTrama(Print& destino, const Segmento* segmentos, size_t numSegmentos) {
+    if (_tramasSlip) {
+      return escribirTramaSlip(destino, segmentos, numSegmentos) == longitudTramaSlip(segmentos, numSegmentos);
+    }
+    if (!_modoAPI) {
+      bool completo = true;
+      for (size_t i = 0; i < numSegmentos; i++) {
+        if (destino.write(segmentos[i].datos, segmentos[i].longitud) != segmentos[i].longitud) {
+          completo = false;
+        }
+      }
+      return completo;
+    }
+
+    size_t total = 0;
+    for (size_t i = 0; i < numSegmentos; i++) total += segmentos[i].longitud;
+    if (total > XBEE_API_MAX_PAYLOAD) return false;
+
+    _ultimoIdTrama = _siguienteIdTrama;
+    _siguienteIdTrama = (_siguienteIdTrama == 255) ? 1 : _siguienteIdTrama + 1;
+    uint8_t posicion = _ultimoIdTrama % XBEE_API_MAX_PENDIENTES;
+    _idsTx[posicion] = _ultimoIdTrama;
+    _estadosTx[posicion] = XBEE_TX_PENDIENTE;
+
+    uint8_t cabecera[11];
+    uint8_t longitudCabecera = 0;
+    if (_usarDestino64) {
+      cabecera[longitudCabecera++] = XBEE_API_TX64;
+      cabecera[longitudCabecera++] = _ultimoIdTrama;
+      for (int8_t desplazamiento = 56; desplazamiento >= 0; desplazamiento -= 8) {
+        cabecera[longitudCabecera++] = (uint8_t)(_destino64 >> desplazamiento);
+      }
+    } else {
+      cabecera[longitudCabecera++] = XBEE_API_TX16;
+      cabecera[longitudCabecera++] = _ultimoIdTrama;
+      cabecera[longitudCabecera++] = (uint8_t)(_destino16 >> 8);
+      cabecera[longitudCabecera++] = (uint8_t)(_destino16 & 0xFF);
+    }
+    cabecera[longitudCabecera++] = 0; // Opciones: con ACK, sin PAN de difusión
+
+    bool escapado = _parser.escapado();
+    if (escribirTramaXBee(destino, cabecera, longitudCabecera, segmentos, numSegmentos, escapado) !=
+        longitudTramaXBee(cabecera, longitudCabecera, segmentos, numSegmentos, escapado)) {
+      _idsTx[posicion] = 0; // La trama no llegó entera: el ID no llegó a usarse
+      return false;
+    }
+    return true;
+  }
+};
+
+/**
+ * @class XBeeRadio
+ * @brief Implementación de RadioInterface para módulos XBee que se comunican por un puerto Serie (Stream).
+ * @details Adaptador polimórfico sobre `XBeeNucleo`. Para firmware con una sola radio,
+ * usar `XBeeNucleo` directamente evita la vtable y el despacho indirecto.
+ */
+class XBeeRadio : public RadioAdaptador<XBeeNucleo> {
+public:
+  /**
+   * @brief Constructor para la clase XBeeRadio.
+   * @param puerto Referencia a un objeto Stream (como `Serial`, `Serial2` o `SoftwareSerial`) para la comunicación.
+   * @param baudios La velocidad en baudios del puerto serie (solo informativo).
+   * @param pinSleepRq Pin de control (GPIO) para poner el XBee a dormir (activo en BAJO). Usar -1 si no se utiliza.
+   * @param pinOnSleep Pin de estado (GPIO) que indica si el XBee está despierto (activo en ALTO). Usar -1 si no se utiliza.
+   */
+  XBeeRadio(Stream& puerto, long baudios, int8_t pinSleepRq, int8_t pinOnSleep)
+    : RadioAdaptador<XBeeNucleo>(puerto, baudios, pinSleepRq, pinOnSleep) {}
 };